@@ -12,25 +12,49 @@
 #include <iomanip>
 #include <sstream>
 #include <atomic>
+#include <vector>
 #include <yaml-cpp/yaml.h>
+#include "image_writer.hpp"
 
 struct CameraConfig {
+    std::string name;
     std::string address;
     int port;
 };
 
+struct CaptureConfig {
+    std::vector<CameraConfig> cameras;
+    WriterOptions writer;
+    int burst_frames = 10;
+};
+
 class CameraCapture {
 private:
+    // Identifies the camera in the appsink callback
+    struct SinkContext {
+        CameraCapture *capture;
+        int camera;
+    };
+
+    // Result of a writer thread, shown from the GTK main loop
+    struct WrittenEvent {
+        CameraCapture *capture;
+        std::string file;
+        bool ok;
+    };
+
     GstElement *pipeline;
-    GstElement *appsink;
     GtkWidget *window;
     GtkWidget *capture_button;
+    GtkWidget *burst_button;
     GtkWidget *status_label;
     GtkWidget *counter_label;
     std::string save_folder;
     int capture_count;
-    std::atomic<bool> capture_requested;
-    CameraConfig config;
+    CaptureConfig config;
+    std::vector<SinkContext> sinks;
+    SnapshotTrigger trigger;
+    ImageWriterPool writer;
 
     std::string getCurrentTimestamp() {
         auto now = std::chrono::system_clock::now();
@@ -89,65 +113,101 @@ private:
     }
 
     static GstFlowReturn newSampleCallback(GstAppSink *appsink, gpointer data) {
-        CameraCapture *capture = static_cast<CameraCapture*>(data);
-        
-        if (!capture->capture_requested) {
-            return GST_FLOW_OK;
-        }
+        SinkContext *ctx = static_cast<SinkContext*>(data);
 
+        // Always pull: the sink only keeps the newest frame, nothing waits on us
         GstSample *sample = gst_app_sink_pull_sample(appsink);
         if (sample) {
-            capture->saveSample(sample);
+            ctx->capture->handleSample(ctx->camera, sample);
             gst_sample_unref(sample);
-            capture->capture_requested = false;
         }
-        
+
         return GST_FLOW_OK;
     }
 
-    void saveSample(GstSample *sample) {
+    // Streaming thread: copy the raw frame and hand it to the writers (no GTK calls here)
+    void handleSample(int camera, GstSample *sample) {
         GstBuffer *buffer = gst_sample_get_buffer(sample);
+        SnapshotTrigger::Shot shot;
+        if (!buffer || !trigger.take(camera, GST_BUFFER_PTS(buffer), shot)) {
+            return;
+        }
+
+        CaptureFrame frame;
+        GstCaps *caps = gst_sample_get_caps(sample);
+        gchar *caps_str = gst_caps_to_string(caps);
+        frame.caps = caps_str;
+        g_free(caps_str);
+        GstStructure *st = gst_caps_get_structure(caps, 0);
+        gst_structure_get_int(st, "width", &frame.width);
+        gst_structure_get_int(st, "height", &frame.height);
+
         GstMapInfo map;
-        
-        if (gst_buffer_map(buffer, &map, GST_MAP_READ)) {
+        if (!gst_buffer_map(buffer, &map, GST_MAP_READ)) {
+            return;
+        }
+        frame.data.assign(map.data, map.data + map.size);
+        gst_buffer_unmap(buffer, &map);
+
+        std::stringstream path_ss;
+        path_ss << save_folder << "/capture_" << shot.stamp << "_" << std::setfill('0') << std::setw(4) << shot.id;
+        if (config.cameras.size() > 1) {
+            path_ss << "_" << config.cameras[camera].name;
+        }
+        if (shot.frames > 1) {
+            path_ss << "_" << std::setw(3) << shot.frame;
+        }
+        frame.path = path_ss.str();
+
+        if (shot.spread_ns >= 0 && config.cameras.size() > 1) {
+            std::cout << "  Snapshot " << shot.id << ": cameras within "
+                      << shot.spread_ns / 1000000.0 << " ms" << std::endl;
+        }
+
+        if (!writer.submit(std::move(frame))) {
+            std::cerr << "WARNING: Writer queue full, frame dropped: " << path_ss.str() << std::endl;
+            g_idle_add(onImageWritten, new WrittenEvent{this, path_ss.str(), false});
+        }
+    }
+
+    static gboolean onImageWritten(gpointer data) {
+        WrittenEvent *event = static_cast<WrittenEvent*>(data);
+        event->capture->showWritten(event->file, event->ok);
+        delete event;
+        return G_SOURCE_REMOVE;
+    }
+
+    // GTK main loop
+    void showWritten(const std::string& file, bool ok) {
+        if (ok) {
             capture_count++;
-            
-            std::string timestamp = getCurrentTimestamp();
-            std::stringstream filename_ss;
-            filename_ss << save_folder << "/capture_" << timestamp 
-                        << "_" << std::setfill('0') << std::setw(4) << capture_count << ".jpg";
-            std::string filename = filename_ss.str();
-
-            // Write JPEG data to file
-            std::ofstream file(filename, std::ios::binary);
-            if (file.is_open()) {
-                file.write(reinterpret_cast<const char*>(map.data), map.size);
-                file.close();
-                
-                std::cout << "✓ Image " << capture_count << " saved: " << filename << std::endl;
-                
-                // Update GUI
-                std::string status_text = "✓ Image saved: " + filename;
-                gtk_label_set_text(GTK_LABEL(status_label), status_text.c_str());
-                
-                std::string counter_text = "Images captured: " + std::to_string(capture_count);
-                gtk_label_set_text(GTK_LABEL(counter_label), counter_text.c_str());
-                
-                // Re-enable button
-                gtk_widget_set_sensitive(capture_button, TRUE);
-            } else {
-                std::cerr << "Error: Could not open file for writing: " << filename << std::endl;
-                gtk_label_set_text(GTK_LABEL(status_label), "✗ Error: Could not save file");
-                gtk_widget_set_sensitive(capture_button, TRUE);
-            }
+            std::cout << "✓ Image " << capture_count << " saved: " << file << std::endl;
+
+            std::string status_text = "✓ Image saved: " + file;
+            gtk_label_set_text(GTK_LABEL(status_label), status_text.c_str());
+
+            std::string counter_text = "Images captured: " + std::to_string(capture_count);
+            gtk_label_set_text(GTK_LABEL(counter_label), counter_text.c_str());
+        } else {
+            std::cerr << "✗ Could not save: " << file << std::endl;
+            gtk_label_set_text(GTK_LABEL(status_label), "✗ Error: Could not save file");
+        }
 
-            gst_buffer_unmap(buffer, &map);
+        // Re-enable the buttons once every camera has its frames
+        if (!trigger.busy()) {
+            gtk_widget_set_sensitive(capture_button, TRUE);
+            gtk_widget_set_sensitive(burst_button, TRUE);
         }
     }
 
     static void onCaptureButtonClicked(GtkWidget *widget, gpointer data) {
         CameraCapture *capture = static_cast<CameraCapture*>(data);
-        capture->captureImage();
+        capture->captureImage(1);
+    }
+
+    static void onBurstButtonClicked(GtkWidget *widget, gpointer data) {
+        CameraCapture *capture = static_cast<CameraCapture*>(data);
+        capture->captureImage(capture->config.burst_frames);
     }
 
     static gboolean onWindowDelete(GtkWidget *widget, GdkEvent *event, gpointer data) {
@@ -157,11 +217,11 @@ private:
     }
 
 public:
-    CameraCapture(const std::string& folder, const CameraConfig& cfg) 
-        : pipeline(nullptr), appsink(nullptr), window(nullptr),
-          capture_button(nullptr), status_label(nullptr), counter_label(nullptr),
+    CameraCapture(const std::string& folder, const CaptureConfig& cfg) 
+        : pipeline(nullptr), window(nullptr),
+          capture_button(nullptr), burst_button(nullptr), status_label(nullptr), counter_label(nullptr),
           save_folder(folder), capture_count(0), 
-          capture_requested(false), config(cfg) {
+          config(cfg), trigger(static_cast<int>(cfg.cameras.size())) {
     }
 
     ~CameraCapture() {
@@ -173,18 +233,29 @@ public:
             return false;
         }
 
-        // Create pipeline with appsink for capture
+        // Writer threads report through the GTK main loop
+        if (!writer.start(config.writer, [this](const std::string& file, bool ok) {
+                g_idle_add(onImageWritten, new WrittenEvent{this, file, ok});
+            })) {
+            return false;
+        }
+
+        // One chain per camera in a single pipeline (one clock, comparable timestamps).
+        // The capture branch delivers raw frames; encoding is done by the writer threads
         std::stringstream pipeline_ss;
-        pipeline_ss << "udpsrc address=" << config.address << " port=" << config.port << " ! "
-                    << "application/x-rtp,encoding-name=H264,payload=96 ! "
-                    << "rtpjitterbuffer ! "
-                    << "rtph264depay ! "
-                    << "h264parse ! "
-                    << "nvv4l2decoder ! "
-                    << "tee name=t "
-                    << "t. ! queue ! nvvidconv ! autovideosink "
-                    << "t. ! queue ! nvvidconv ! video/x-raw,format=I420 ! "
-                    << "jpegenc ! appsink name=appsink emit-signals=true max-buffers=1 drop=true";
+        for (size_t i = 0; i < config.cameras.size(); i++) {
+            const CameraConfig& cam = config.cameras[i];
+            pipeline_ss << "udpsrc address=" << cam.address << " port=" << cam.port << " ! "
+                        << "application/x-rtp,encoding-name=H264,payload=96 ! "
+                        << "rtpjitterbuffer ! "
+                        << "rtph264depay ! "
+                        << "h264parse ! "
+                        << "nvv4l2decoder ! "
+                        << "tee name=t" << i << " "
+                        << "t" << i << ". ! queue ! nvvidconv ! autovideosink "
+                        << "t" << i << ". ! queue ! nvvidconv ! video/x-raw,format=I420 ! "
+                        << "appsink name=appsink" << i << " emit-signals=true max-buffers=2 drop=true sync=false ";
+        }
 
         std::string pipeline_str = pipeline_ss.str();
         
@@ -197,17 +268,21 @@ public:
             return false;
         }
 
-        // Get appsink element
-        appsink = gst_bin_get_by_name(GST_BIN(pipeline), "appsink");
-        if (!appsink) {
-            std::cerr << "Error: Could not get appsink element" << std::endl;
-            return false;
+        // Connect a callback for new samples on each camera's appsink
+        sinks.resize(config.cameras.size());
+        for (size_t i = 0; i < config.cameras.size(); i++) {
+            std::string name = "appsink" + std::to_string(i);
+            GstElement *appsink = gst_bin_get_by_name(GST_BIN(pipeline), name.c_str());
+            if (!appsink) {
+                std::cerr << "Error: Could not get appsink element" << std::endl;
+                return false;
+            }
+            sinks[i].capture = this;
+            sinks[i].camera = static_cast<int>(i);
+            g_signal_connect(appsink, "new-sample", G_CALLBACK(newSampleCallback), &sinks[i]);
+            gst_object_unref(appsink);
         }
 
-        // Connect callback for new samples
-        g_object_set(G_OBJECT(appsink), "emit-signals", TRUE, NULL);
-        g_signal_connect(appsink, "new-sample", G_CALLBACK(newSampleCallback), this);
-
         // Set up bus
         GstBus *bus = gst_element_get_bus(pipeline);
         gst_bus_add_watch(bus, busCallback, this);
@@ -231,12 +306,15 @@ public:
 
         // Add camera info label
         std::stringstream info_ss;
-        info_ss << "Camera: " << config.address << ":" << config.port;
+        for (size_t i = 0; i < config.cameras.size(); i++) {
+            info_ss << (i ? "\n" : "") << "Camera " << config.cameras[i].name << ": "
+                    << config.cameras[i].address << ":" << config.cameras[i].port;
+        }
         GtkWidget *info_label = gtk_label_new(info_ss.str().c_str());
         gtk_box_pack_start(GTK_BOX(vbox), info_label, FALSE, FALSE, 0);
 
         // Add folder info label
-        std::string folder_text = "Saving to: " + save_folder;
+        std::string folder_text = "Saving to: " + save_folder + " (" + config.writer.format + ")";
         GtkWidget *folder_label = gtk_label_new(folder_text.c_str());
         gtk_box_pack_start(GTK_BOX(vbox), folder_label, FALSE, FALSE, 0);
 
@@ -250,6 +328,12 @@ public:
         g_signal_connect(capture_button, "clicked", G_CALLBACK(onCaptureButtonClicked), this);
         gtk_box_pack_start(GTK_BOX(vbox), capture_button, FALSE, FALSE, 0);
 
+        // Add burst button
+        std::string burst_text = "Burst (" + std::to_string(config.burst_frames) + " frames)";
+        burst_button = gtk_button_new_with_label(burst_text.c_str());
+        g_signal_connect(burst_button, "clicked", G_CALLBACK(onBurstButtonClicked), this);
+        gtk_box_pack_start(GTK_BOX(vbox), burst_button, FALSE, FALSE, 0);
+
         // Add counter label
         counter_label = gtk_label_new("Images captured: 0");
         gtk_box_pack_start(GTK_BOX(vbox), counter_label, FALSE, FALSE, 0);
@@ -268,22 +352,35 @@ public:
         gtk_widget_show_all(window);
     }
 
-    void captureImage() {
-        if (capture_requested) {
+    // Every camera keeps its first `frames` frames from now on
+    void captureImage(int frames) {
+        GstClock *clock = gst_element_get_clock(pipeline);
+        if (!clock) {
+            gtk_label_set_text(GTK_LABEL(status_label), "Stream not running yet");
+            return;
+        }
+        const GstClockTime now = gst_clock_get_time(clock) - gst_element_get_base_time(pipeline);
+        gst_object_unref(clock);
+
+        if (trigger.arm(now, frames, getCurrentTimestamp()) < 0) {
             gtk_label_set_text(GTK_LABEL(status_label), "Already capturing, please wait...");
             return;
         }
 
-        gtk_label_set_text(GTK_LABEL(status_label), "📸 Capturing...");
+        gtk_label_set_text(GTK_LABEL(status_label), frames > 1 ? "📸 Capturing burst..." : "📸 Capturing...");
         gtk_widget_set_sensitive(capture_button, FALSE);
-        capture_requested = true;
+        gtk_widget_set_sensitive(burst_button, FALSE);
     }
 
     void start() {
         std::cout << "\n" << std::string(50, '=') << std::endl;
         std::cout << "Starting camera stream..." << std::endl;
-        std::cout << "Camera: " << config.address << ":" << config.port << std::endl;
-        std::cout << "Saving images to: " << save_folder << std::endl;
+        for (size_t i = 0; i < config.cameras.size(); i++) {
+            std::cout << "Camera " << config.cameras[i].name << ": "
+                      << config.cameras[i].address << ":" << config.cameras[i].port << std::endl;
+        }
+        std::cout << "Saving images to: " << save_folder << " (" << config.writer.format << ", "
+                  << config.writer.threads << " writer threads)" << std::endl;
         std::cout << std::string(50, '=') << std::endl;
 
         GstStateChangeReturn ret = gst_element_set_state(pipeline, GST_STATE_PLAYING);
@@ -305,6 +402,8 @@ public:
             gst_element_set_state(pipeline, GST_STATE_NULL);
         }
         gtk_main_quit();
+        // Frames already captured are still written (the GUI no longer updates)
+        writer.stop();
     }
 
     void cleanup() {
@@ -318,23 +417,52 @@ public:
         return capture_count;
     }
 
+    ImageWriterPool::Stats getWriterStats() const {
+        return writer.getStats();
+    }
+
     std::string getSaveFolder() const {
         return save_folder;
     }
 };
 
-bool loadConfig(const std::string& config_file, CameraConfig& config) {
+bool loadConfig(const std::string& config_file, CaptureConfig& config) {
     try {
         YAML::Node yaml_config = YAML::LoadFile(config_file);
         
-        if (yaml_config["camera"]) {
-            config.address = yaml_config["camera"]["address"].as<std::string>();
-            config.port = yaml_config["camera"]["port"].as<int>();
-            return true;
-        } else {
+        // Either one "camera" or a list of "cameras" (captured in sync)
+        if (yaml_config["cameras"]) {
+            for (size_t i = 0; i < yaml_config["cameras"].size(); i++) {
+                const YAML::Node& node = yaml_config["cameras"][i];
+                CameraConfig cam;
+                cam.name = node["name"] ? node["name"].as<std::string>() : "cam" + std::to_string(i);
+                cam.address = node["address"].as<std::string>();
+                cam.port = node["port"].as<int>();
+                config.cameras.push_back(cam);
+            }
+        } else if (yaml_config["camera"]) {
+            CameraConfig cam;
+            cam.name = "cam0";
+            cam.address = yaml_config["camera"]["address"].as<std::string>();
+            cam.port = yaml_config["camera"]["port"].as<int>();
+            config.cameras.push_back(cam);
+        }
+        if (config.cameras.empty()) {
             std::cerr << "Error: 'camera' section not found in config file" << std::endl;
             return false;
         }
+
+        // Optional output settings
+        if (const YAML::Node capture = yaml_config["capture"]) {
+            WriterOptions& w = config.writer;
+            if (capture["format"]) w.format = capture["format"].as<std::string>();
+            if (capture["jpeg_quality"]) w.jpeg_quality = capture["jpeg_quality"].as<int>();
+            if (capture["png_compression"]) w.png_compression = capture["png_compression"].as<int>();
+            if (capture["writer_threads"]) w.threads = capture["writer_threads"].as<int>();
+            if (capture["queue_frames"]) w.queue_frames = capture["queue_frames"].as<int>();
+            if (capture["burst_frames"]) config.burst_frames = capture["burst_frames"].as<int>();
+        }
+        return true;
     } catch (const YAML::Exception& e) {
         std::cerr << "Error parsing YAML config: " << e.what() << std::endl;
         return false;
@@ -352,6 +480,15 @@ bool createDefaultConfig(const std::string& config_file) {
     file << "camera:\n";
     file << "  address: \"192.168.45.3\"\n";
     file << "  port: 5020\n";
+    file << "\n";
+    file << "# Image output (optional)\n";
+    file << "capture:\n";
+    file << "  format: jpg            # jpg, png or raw\n";
+    file << "  jpeg_quality: 95\n";
+    file << "  png_compression: 3     # 0 (fast) - 9 (small)\n";
+    file << "  writer_threads: 2\n";
+    file << "  queue_frames: 32\n";
+    file << "  burst_frames: 10\n";
     file.close();
 
     std::cout << "Created default config file: " << config_file << std::endl;
@@ -373,7 +510,7 @@ int main(int argc, char *argv[]) {
 
     // Load configuration
     std::string config_file = "camera_config.yaml";
-    CameraConfig config;
+    CaptureConfig config;
 
     struct stat st;
     if (stat(config_file.c_str(), &st) != 0) {
@@ -390,8 +527,11 @@ int main(int argc, char *argv[]) {
     }
 
     std::cout << "\nLoaded configuration:" << std::endl;
-    std::cout << "  Camera Address: " << config.address << std::endl;
-    std::cout << "  Camera Port: " << config.port << std::endl;
+    for (size_t i = 0; i < config.cameras.size(); i++) {
+        std::cout << "  Camera " << config.cameras[i].name << ": "
+                  << config.cameras[i].address << ":" << config.cameras[i].port << std::endl;
+    }
+    std::cout << "  Image format: " << config.writer.format << std::endl;
 
     // Ask for folder name
     std::string folder_name;
@@ -422,7 +562,12 @@ int main(int argc, char *argv[]) {
 
     std::cout << "\n" << std::string(50, '=') << std::endl;
     std::cout << "Session Summary:" << std::endl;
-    std::cout << "Total images captured: " << capture.getCaptureCount() << std::endl;
+    const ImageWriterPool::Stats stats = capture.getWriterStats();
+    std::cout << "Total images captured: " << stats.written << std::endl;
+    if (stats.dropped || stats.failed) {
+        std::cout << "Dropped (writer queue full): " << stats.dropped << ", failed: " << stats.failed << std::endl;
+    }
+    std::cout << "Peak writer queue: " << stats.max_queued << " frames" << std::endl;
     std::cout << "Images saved in: " << capture.getSaveFolder() << std::endl;
     std::cout << std::string(50, '=') << std::endl;
 
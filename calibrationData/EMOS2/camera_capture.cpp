@@ -14,23 +14,40 @@
 #include <fcntl.h>
 #include <thread>
 #include <atomic>
+#include <memory>
+#include <vector>
 #include <yaml-cpp/yaml.h>
+#include "image_writer.hpp"
 
 struct CameraConfig {
+    std::string name;
     std::string address;
     int port;
 };
 
+struct CaptureConfig {
+    std::vector<CameraConfig> cameras;
+    WriterOptions writer;
+    int burst_frames = 10;
+};
+
 class CameraCapture {
 private:
+    // Identifies the camera in the appsink callback
+    struct SinkContext {
+        CameraCapture *capture;
+        int camera;
+    };
+
     GstElement *pipeline;
-    GstElement *appsink;
     GMainLoop *loop;
     std::string save_folder;
-    int capture_count;
-    std::atomic<bool> capture_requested;
+    std::atomic<int> capture_count;
     std::atomic<bool> running;
-    CameraConfig config;
+    CaptureConfig config;
+    std::vector<SinkContext> sinks;
+    SnapshotTrigger trigger;
+    ImageWriterPool writer;
 
     struct termios orig_termios;
 
@@ -106,54 +123,75 @@ private:
     }
 
     static GstFlowReturn newSampleCallback(GstAppSink *appsink, gpointer data) {
-        CameraCapture *capture = static_cast<CameraCapture*>(data);
-        
-        if (!capture->capture_requested) {
-            return GST_FLOW_OK;
-        }
+        SinkContext *ctx = static_cast<SinkContext*>(data);
 
+        // Always pull: the sink only keeps the newest frame, nothing waits on us
         GstSample *sample = gst_app_sink_pull_sample(appsink);
         if (sample) {
-            capture->saveSample(sample);
+            ctx->capture->handleSample(ctx->camera, sample);
             gst_sample_unref(sample);
-            capture->capture_requested = false;
         }
-        
+
         return GST_FLOW_OK;
     }
 
-    void saveSample(GstSample *sample) {
+    void handleSample(int camera, GstSample *sample) {
         GstBuffer *buffer = gst_sample_get_buffer(sample);
+        SnapshotTrigger::Shot shot;
+        if (!buffer || !trigger.take(camera, GST_BUFFER_PTS(buffer), shot)) {
+            return;
+        }
+
+        // Copy the raw frame and hand it to the writers; encoding happens there
+        CaptureFrame frame;
+        GstCaps *caps = gst_sample_get_caps(sample);
+        gchar *caps_str = gst_caps_to_string(caps);
+        frame.caps = caps_str;
+        g_free(caps_str);
+        GstStructure *st = gst_caps_get_structure(caps, 0);
+        gst_structure_get_int(st, "width", &frame.width);
+        gst_structure_get_int(st, "height", &frame.height);
+
         GstMapInfo map;
-        
-        if (gst_buffer_map(buffer, &map, GST_MAP_READ)) {
-            capture_count++;
-            
-            std::string timestamp = getCurrentTimestamp();
-            std::stringstream filename_ss;
-            filename_ss << save_folder << "/capture_" << timestamp 
-                        << "_" << std::setfill('0') << std::setw(4) << capture_count << ".jpg";
-            std::string filename = filename_ss.str();
-
-            // Write JPEG data to file
-            std::ofstream file(filename, std::ios::binary);
-            if (file.is_open()) {
-                file.write(reinterpret_cast<const char*>(map.data), map.size);
-                file.close();
-                std::cout << "✓ Image " << capture_count << " saved: " << filename << std::endl;
-            } else {
-                std::cerr << "Error: Could not open file for writing: " << filename << std::endl;
-            }
+        if (!gst_buffer_map(buffer, &map, GST_MAP_READ)) {
+            return;
+        }
+        frame.data.assign(map.data, map.data + map.size);
+        gst_buffer_unmap(buffer, &map);
+
+        std::stringstream path_ss;
+        path_ss << save_folder << "/capture_" << shot.stamp << "_" << std::setfill('0') << std::setw(4) << shot.id;
+        if (config.cameras.size() > 1) {
+            path_ss << "_" << config.cameras[camera].name;
+        }
+        if (shot.frames > 1) {
+            path_ss << "_" << std::setw(3) << shot.frame;
+        }
+        frame.path = path_ss.str();
+
+        if (shot.spread_ns >= 0 && config.cameras.size() > 1) {
+            std::cout << "  Snapshot " << shot.id << ": cameras within "
+                      << shot.spread_ns / 1000000.0 << " ms" << std::endl;
+        }
+
+        if (!writer.submit(std::move(frame))) {
+            std::cerr << "WARNING: Writer queue full, frame dropped: " << path_ss.str() << std::endl;
+        }
+    }
 
-            gst_buffer_unmap(buffer, &map);
+    void onImageWritten(const std::string& file, bool ok) {
+        if (ok) {
+            std::cout << "✓ Image " << ++capture_count << " saved: " << file << std::endl;
+        } else {
+            std::cerr << "✗ Could not save: " << file << std::endl;
         }
     }
 
 public:
-    CameraCapture(const std::string& folder, const CameraConfig& cfg) 
-        : pipeline(nullptr), appsink(nullptr), loop(nullptr), 
+    CameraCapture(const std::string& folder, const CaptureConfig& cfg) 
+        : pipeline(nullptr), loop(nullptr), 
           save_folder(folder), capture_count(0), 
-          capture_requested(false), running(false), config(cfg) {
+          running(false), config(cfg), trigger(static_cast<int>(cfg.cameras.size())) {
     }
 
     ~CameraCapture() {
@@ -165,18 +203,26 @@ public:
             return false;
         }
 
-        // Create pipeline with appsink for capture
+        if (!writer.start(config.writer, [this](const std::string& file, bool ok) { onImageWritten(file, ok); })) {
+            return false;
+        }
+
+        // One chain per camera in a single pipeline (one clock, comparable timestamps).
+        // The capture branch delivers raw frames; encoding is done by the writer threads
         std::stringstream pipeline_ss;
-        pipeline_ss << "udpsrc address=" << config.address << " port=" << config.port << " ! "
-                    << "application/x-rtp,encoding-name=H264,payload=96 ! "
-                    << "rtpjitterbuffer ! "
-                    << "rtph264depay ! "
-                    << "h264parse ! "
-                    << "nvv4l2decoder ! "
-                    << "tee name=t "
-                    << "t. ! queue ! nvvidconv ! autovideosink "
-                    << "t. ! queue ! nvvidconv ! video/x-raw,format=I420 ! "
-                    << "jpegenc ! appsink name=appsink emit-signals=true max-buffers=1 drop=true";
+        for (size_t i = 0; i < config.cameras.size(); i++) {
+            const CameraConfig& cam = config.cameras[i];
+            pipeline_ss << "udpsrc address=" << cam.address << " port=" << cam.port << " ! "
+                        << "application/x-rtp,encoding-name=H264,payload=96 ! "
+                        << "rtpjitterbuffer ! "
+                        << "rtph264depay ! "
+                        << "h264parse ! "
+                        << "nvv4l2decoder ! "
+                        << "tee name=t" << i << " "
+                        << "t" << i << ". ! queue ! nvvidconv ! autovideosink "
+                        << "t" << i << ". ! queue ! nvvidconv ! video/x-raw,format=I420 ! "
+                        << "appsink name=appsink" << i << " emit-signals=true max-buffers=2 drop=true sync=false ";
+        }
 
         std::string pipeline_str = pipeline_ss.str();
         
@@ -189,17 +235,21 @@ public:
             return false;
         }
 
-        // Get appsink element
-        appsink = gst_bin_get_by_name(GST_BIN(pipeline), "appsink");
-        if (!appsink) {
-            std::cerr << "Error: Could not get appsink element" << std::endl;
-            return false;
+        // Connect a callback for new samples on each camera's appsink
+        sinks.resize(config.cameras.size());
+        for (size_t i = 0; i < config.cameras.size(); i++) {
+            std::string name = "appsink" + std::to_string(i);
+            GstElement *appsink = gst_bin_get_by_name(GST_BIN(pipeline), name.c_str());
+            if (!appsink) {
+                std::cerr << "Error: Could not get appsink element" << std::endl;
+                return false;
+            }
+            sinks[i].capture = this;
+            sinks[i].camera = static_cast<int>(i);
+            g_signal_connect(appsink, "new-sample", G_CALLBACK(newSampleCallback), &sinks[i]);
+            gst_object_unref(appsink);
         }
 
-        // Connect callback for new samples
-        g_object_set(G_OBJECT(appsink), "emit-signals", TRUE, NULL);
-        g_signal_connect(appsink, "new-sample", G_CALLBACK(newSampleCallback), this);
-
         // Set up bus
         GstBus *bus = gst_element_get_bus(pipeline);
         gst_bus_add_watch(bus, busCallback, this);
@@ -208,24 +258,40 @@ public:
         return true;
     }
 
-    void captureImage() {
-        if (capture_requested) {
-            std::cout << "Already capturing, please wait..." << std::endl;
+    // Every camera keeps its first `frames` frames from now on
+    void captureImage(int frames) {
+        GstClock *clock = gst_element_get_clock(pipeline);
+        if (!clock) {
+            std::cout << "Stream not running yet" << std::endl;
             return;
         }
+        const GstClockTime now = gst_clock_get_time(clock) - gst_element_get_base_time(pipeline);
+        gst_object_unref(clock);
 
-        std::cout << "📸 Requesting capture..." << std::endl;
-        capture_requested = true;
+        if (trigger.arm(now, frames, getCurrentTimestamp()) < 0) {
+            std::cout << "Already capturing, please wait..." << std::endl;
+            return;
+        }
+        if (frames > 1) {
+            std::cout << "📸 Burst of " << frames << " frames..." << std::endl;
+        } else {
+            std::cout << "📸 Requesting capture..." << std::endl;
+        }
     }
 
     void start() {
         std::cout << "\n" << std::string(50, '=') << std::endl;
         std::cout << "Starting camera stream..." << std::endl;
-        std::cout << "Camera: " << config.address << ":" << config.port << std::endl;
-        std::cout << "Saving images to: " << save_folder << std::endl;
+        for (size_t i = 0; i < config.cameras.size(); i++) {
+            std::cout << "Camera " << config.cameras[i].name << ": "
+                      << config.cameras[i].address << ":" << config.cameras[i].port << std::endl;
+        }
+        std::cout << "Saving images to: " << save_folder << " (" << config.writer.format << ", "
+                  << config.writer.threads << " writer threads)" << std::endl;
         std::cout << std::string(50, '=') << std::endl;
         std::cout << "\nControls:" << std::endl;
-        std::cout << "  Press 'c' to capture image" << std::endl;
+        std::cout << "  Press 'c' to capture image" << (config.cameras.size() > 1 ? "s (all cameras)" : "") << std::endl;
+        std::cout << "  Press 'b' to capture a burst of " << config.burst_frames << " frames" << std::endl;
         std::cout << "  Press 'q' to quit\n" << std::endl;
 
         GstStateChangeReturn ret = gst_element_set_state(pipeline, GST_STATE_PLAYING);
@@ -253,7 +319,9 @@ public:
             char c;
             if (read(STDIN_FILENO, &c, 1) > 0) {
                 if (c == 'c' || c == 'C') {
-                    captureImage();
+                    captureImage(1);
+                } else if (c == 'b' || c == 'B') {
+                    captureImage(config.burst_frames);
                 } else if (c == 'q' || c == 'Q') {
                     std::cout << "\nQuitting..." << std::endl;
                     stop();
@@ -268,6 +336,8 @@ public:
         if (pipeline) {
             gst_element_set_state(pipeline, GST_STATE_NULL);
         }
+        // Frames already captured are still written
+        writer.stop();
         if (loop && g_main_loop_is_running(loop)) {
             g_main_loop_quit(loop);
         }
@@ -289,23 +359,52 @@ public:
         return capture_count;
     }
 
+    ImageWriterPool::Stats getWriterStats() const {
+        return writer.getStats();
+    }
+
     std::string getSaveFolder() const {
         return save_folder;
     }
 };
 
-bool loadConfig(const std::string& config_file, CameraConfig& config) {
+bool loadConfig(const std::string& config_file, CaptureConfig& config) {
     try {
         YAML::Node yaml_config = YAML::LoadFile(config_file);
         
-        if (yaml_config["camera"]) {
-            config.address = yaml_config["camera"]["address"].as<std::string>();
-            config.port = yaml_config["camera"]["port"].as<int>();
-            return true;
-        } else {
+        // Either one "camera" or a list of "cameras" (captured in sync)
+        if (yaml_config["cameras"]) {
+            for (size_t i = 0; i < yaml_config["cameras"].size(); i++) {
+                const YAML::Node& node = yaml_config["cameras"][i];
+                CameraConfig cam;
+                cam.name = node["name"] ? node["name"].as<std::string>() : "cam" + std::to_string(i);
+                cam.address = node["address"].as<std::string>();
+                cam.port = node["port"].as<int>();
+                config.cameras.push_back(cam);
+            }
+        } else if (yaml_config["camera"]) {
+            CameraConfig cam;
+            cam.name = "cam0";
+            cam.address = yaml_config["camera"]["address"].as<std::string>();
+            cam.port = yaml_config["camera"]["port"].as<int>();
+            config.cameras.push_back(cam);
+        }
+        if (config.cameras.empty()) {
             std::cerr << "Error: 'camera' section not found in config file" << std::endl;
             return false;
         }
+
+        // Optional output settings
+        if (const YAML::Node capture = yaml_config["capture"]) {
+            WriterOptions& w = config.writer;
+            if (capture["format"]) w.format = capture["format"].as<std::string>();
+            if (capture["jpeg_quality"]) w.jpeg_quality = capture["jpeg_quality"].as<int>();
+            if (capture["png_compression"]) w.png_compression = capture["png_compression"].as<int>();
+            if (capture["writer_threads"]) w.threads = capture["writer_threads"].as<int>();
+            if (capture["queue_frames"]) w.queue_frames = capture["queue_frames"].as<int>();
+            if (capture["burst_frames"]) config.burst_frames = capture["burst_frames"].as<int>();
+        }
+        return true;
     } catch (const YAML::Exception& e) {
         std::cerr << "Error parsing YAML config: " << e.what() << std::endl;
         return false;
@@ -323,6 +422,15 @@ bool createDefaultConfig(const std::string& config_file) {
     file << "camera:\n";
     file << "  address: \"192.168.45.3\"\n";
     file << "  port: 5020\n";
+    file << "\n";
+    file << "# Image output (optional)\n";
+    file << "capture:\n";
+    file << "  format: jpg            # jpg, png or raw\n";
+    file << "  jpeg_quality: 95\n";
+    file << "  png_compression: 3     # 0 (fast) - 9 (small)\n";
+    file << "  writer_threads: 2\n";
+    file << "  queue_frames: 32\n";
+    file << "  burst_frames: 10\n";
     file.close();
 
     std::cout << "Created default config file: " << config_file << std::endl;
@@ -339,7 +447,7 @@ int main(int argc, char *argv[]) {
 
     // Load configuration
     std::string config_file = "camera_config.yaml";
-    CameraConfig config;
+    CaptureConfig config;
 
     struct stat st;
     if (stat(config_file.c_str(), &st) != 0) {
@@ -356,8 +464,11 @@ int main(int argc, char *argv[]) {
     }
 
     std::cout << "\nLoaded configuration:" << std::endl;
-    std::cout << "  Camera Address: " << config.address << std::endl;
-    std::cout << "  Camera Port: " << config.port << std::endl;
+    for (size_t i = 0; i < config.cameras.size(); i++) {
+        std::cout << "  Camera " << config.cameras[i].name << ": "
+                  << config.cameras[i].address << ":" << config.cameras[i].port << std::endl;
+    }
+    std::cout << "  Image format: " << config.writer.format << std::endl;
 
     // Ask for folder name
     std::string folder_name;
@@ -385,6 +496,11 @@ int main(int argc, char *argv[]) {
     std::cout << "\n" << std::string(50, '=') << std::endl;
     std::cout << "Session Summary:" << std::endl;
     std::cout << "Total images captured: " << capture.getCaptureCount() << std::endl;
+    const ImageWriterPool::Stats stats = capture.getWriterStats();
+    if (stats.dropped || stats.failed) {
+        std::cout << "Dropped (writer queue full): " << stats.dropped << ", failed: " << stats.failed << std::endl;
+    }
+    std::cout << "Peak writer queue: " << stats.max_queued << " frames" << std::endl;
     std::cout << "Images saved in: " << capture.getSaveFolder() << std::endl;
     std::cout << std::string(50, '=') << std::endl;
 
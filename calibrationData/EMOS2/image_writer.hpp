@@ -0,0 +1,376 @@
+#ifndef EMOS2_IMAGE_WRITER_HPP
+#define EMOS2_IMAGE_WRITER_HPP
+
+// Capture-side helpers shared by camera_capture and camera_capture_gui:
+//  - ImageWriterPool: bounded queue of raw frames feeding encoder/writer threads
+//  - SnapshotTrigger: arms every camera at once for synchronized snapshots and bursts
+// Header-only, C++11, GStreamer only (gstreamer-1.0, gstreamer-app-1.0).
+
+#include <gst/gst.h>
+#include <gst/app/gstappsrc.h>
+#include <gst/app/gstappsink.h>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct WriterOptions {
+    std::string format = "jpg";     // jpg, png, or raw (frame bytes as received, no encoding)
+    int jpeg_quality = 95;          // 0-100
+    int png_compression = 3;        // 0-9, zlib level
+    int threads = 2;                // Encoder/writer threads
+    int queue_frames = 32;          // Frames waiting for a writer before capture has to wait
+};
+
+struct CaptureFrame {
+    std::vector<uint8_t> data;      // Raw video frame, as described by caps
+    std::string caps;               // e.g. video/x-raw,format=I420,width=1920,height=1080
+    int width = 0;
+    int height = 0;
+    std::string path;               // Output path without extension
+};
+
+/**
+ * Encodes and writes frames off the capture thread.
+ *
+ * submit() only moves the frame into a bounded queue; each writer thread
+ * owns an "appsrc ! videoconvert ! jpegenc|pngenc ! appsink" pipeline and
+ * encodes one frame at a time, so N threads encode N frames in parallel.
+ * When the queue is full submit() waits (up to a timeout) instead of
+ * silently losing the frame; only then is the frame counted as dropped.
+ */
+class ImageWriterPool {
+public:
+    // Called from a writer thread after each frame (ok = file written)
+    typedef std::function<void(const std::string& file, bool ok)> DoneCallback;
+
+    struct Stats {
+        uint64_t submitted = 0;
+        uint64_t written = 0;
+        uint64_t failed = 0;
+        uint64_t dropped = 0;
+        uint64_t bytes = 0;
+        size_t max_queued = 0;
+    };
+
+    ImageWriterPool() {}
+    ~ImageWriterPool() { stop(); }
+
+    ImageWriterPool(const ImageWriterPool&) = delete;
+    ImageWriterPool& operator=(const ImageWriterPool&) = delete;
+
+    bool start(const WriterOptions& options, DoneCallback callback = DoneCallback()) {
+        if (options.format != "jpg" && options.format != "png" && options.format != "raw") {
+            std::cerr << "Error: Unknown image format '" << options.format << "' (jpg, png or raw)" << std::endl;
+            return false;
+        }
+        opts = options;
+        opts.threads = std::max(1, opts.threads);
+        opts.queue_frames = std::max(1, opts.queue_frames);
+        done = callback;
+        stopping = false;
+        for (int i = 0; i < opts.threads; i++) {
+            workers.push_back(std::thread(&ImageWriterPool::workerLoop, this));
+        }
+        return true;
+    }
+
+    /**
+     * Queue a frame; waits up to timeout_ms while the queue is full.
+     * Returns false if the frame was dropped.
+     */
+    bool submit(CaptureFrame&& frame, int timeout_ms = 2000) {
+        std::unique_lock<std::mutex> lock(mutex);
+        const bool has_space = space.wait_for(lock, std::chrono::milliseconds(timeout_ms), [this] {
+            return stopping || static_cast<int>(queue.size()) < opts.queue_frames;
+        });
+        if (!has_space || stopping) {
+            stats.dropped++;
+            return false;
+        }
+        queue.push_back(std::move(frame));
+        stats.submitted++;
+        stats.max_queued = std::max(stats.max_queued, queue.size());
+        lock.unlock();
+        available.notify_one();
+        return true;
+    }
+
+    /**
+     * Write everything still queued, then stop the threads
+     */
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (workers.empty()) return;
+            stopping = true;
+        }
+        available.notify_all();
+        space.notify_all();
+        for (size_t i = 0; i < workers.size(); i++) {
+            workers[i].join();
+        }
+        workers.clear();
+    }
+
+    size_t queued() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return queue.size();
+    }
+
+    Stats getStats() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return stats;
+    }
+
+    const std::string& extension() const { return opts.format; }
+
+private:
+    struct Encoder {
+        GstElement* pipeline = nullptr;
+        GstElement* src = nullptr;
+        GstElement* sink = nullptr;
+        std::string caps;
+    };
+
+    void workerLoop() {
+        Encoder encoder;
+        for (;;) {
+            CaptureFrame frame;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                available.wait(lock, [this] { return stopping || !queue.empty(); });
+                if (queue.empty()) break;
+                frame = std::move(queue.front());
+                queue.pop_front();
+            }
+            space.notify_one();
+
+            std::string file = frame.path + "." + opts.format;
+            bool ok;
+            size_t size = 0;
+            if (opts.format == "raw") {
+                // As received; the size is part of the name so the file can be read back
+                std::stringstream ss;
+                ss << frame.path << "_" << frame.width << "x" << frame.height << ".yuv";
+                file = ss.str();
+                size = frame.data.size();
+                ok = writeFile(file, frame.data.data(), size);
+            } else {
+                ok = encodeAndWrite(encoder, frame, file, size);
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (ok) {
+                    stats.written++;
+                    stats.bytes += size;
+                } else {
+                    stats.failed++;
+                }
+            }
+            if (done) {
+                done(file, ok);
+            }
+        }
+        closeEncoder(encoder);
+    }
+
+    bool openEncoder(Encoder& enc, const std::string& caps) {
+        closeEncoder(enc);
+
+        std::stringstream ss;
+        ss << "appsrc name=src format=time ! videoconvert ! ";
+        if (opts.format == "png") {
+            ss << "pngenc snapshot=false compression-level=" << opts.png_compression;
+        } else {
+            ss << "jpegenc quality=" << opts.jpeg_quality;
+        }
+        ss << " ! appsink name=sink sync=false";
+
+        GError* error = nullptr;
+        enc.pipeline = gst_parse_launch(ss.str().c_str(), &error);
+        if (error) {
+            std::cerr << "Encoder pipeline error: " << error->message << std::endl;
+            g_error_free(error);
+            closeEncoder(enc);
+            return false;
+        }
+        enc.src = gst_bin_get_by_name(GST_BIN(enc.pipeline), "src");
+        enc.sink = gst_bin_get_by_name(GST_BIN(enc.pipeline), "sink");
+
+        GstCaps* src_caps = gst_caps_from_string(caps.c_str());
+        gst_app_src_set_caps(GST_APP_SRC(enc.src), src_caps);
+        gst_caps_unref(src_caps);
+
+        if (gst_element_set_state(enc.pipeline, GST_STATE_PLAYING) == GST_STATE_CHANGE_FAILURE) {
+            std::cerr << "Error: Could not start the image encoder" << std::endl;
+            closeEncoder(enc);
+            return false;
+        }
+        enc.caps = caps;
+        return true;
+    }
+
+    void closeEncoder(Encoder& enc) {
+        if (enc.pipeline) {
+            gst_element_set_state(enc.pipeline, GST_STATE_NULL);
+        }
+        if (enc.src) gst_object_unref(enc.src);
+        if (enc.sink) gst_object_unref(enc.sink);
+        if (enc.pipeline) gst_object_unref(enc.pipeline);
+        enc = Encoder();
+    }
+
+    bool encodeAndWrite(Encoder& enc, CaptureFrame& frame, const std::string& file, size_t& size) {
+        // Rebuilt only when the stream format changes
+        if (enc.caps != frame.caps && !openEncoder(enc, frame.caps)) {
+            return false;
+        }
+
+        // The buffer takes over the pixels; no copy
+        std::vector<uint8_t>* pixels = new std::vector<uint8_t>(std::move(frame.data));
+        GstBuffer* buffer = gst_buffer_new_wrapped_full(
+            GST_MEMORY_FLAG_READONLY, pixels->data(), pixels->size(), 0, pixels->size(), pixels,
+            [](gpointer p) { delete static_cast<std::vector<uint8_t>*>(p); });
+        if (gst_app_src_push_buffer(GST_APP_SRC(enc.src), buffer) != GST_FLOW_OK) {
+            closeEncoder(enc);
+            return false;
+        }
+
+        GstSample* sample = gst_app_sink_try_pull_sample(GST_APP_SINK(enc.sink), 5 * GST_SECOND);
+        if (!sample) {
+            std::cerr << "Error: Image encoder did not produce a frame" << std::endl;
+            closeEncoder(enc);
+            return false;
+        }
+
+        bool ok = false;
+        GstMapInfo map;
+        GstBuffer* encoded = gst_sample_get_buffer(sample);
+        if (gst_buffer_map(encoded, &map, GST_MAP_READ)) {
+            size = map.size;
+            ok = writeFile(file, map.data, map.size);
+            gst_buffer_unmap(encoded, &map);
+        }
+        gst_sample_unref(sample);
+        return ok;
+    }
+
+    static bool writeFile(const std::string& file, const uint8_t* data, size_t size) {
+        std::ofstream out(file, std::ios::binary);
+        if (!out.is_open()) {
+            std::cerr << "Error: Could not open file for writing: " << file << std::endl;
+            return false;
+        }
+        out.write(reinterpret_cast<const char*>(data), size);
+        return static_cast<bool>(out);
+    }
+
+    WriterOptions opts;
+    DoneCallback done;
+    std::vector<std::thread> workers;
+
+    mutable std::mutex mutex;
+    std::condition_variable available;      // Capture -> writers
+    std::condition_variable space;          // Writers -> submit()
+    std::deque<CaptureFrame> queue;
+    bool stopping = false;
+    Stats stats;
+};
+
+/**
+ * Arms all cameras at once so a snapshot (or burst) takes the same moment
+ * from every camera.
+ *
+ * arm() records the pipeline running time of the key press; each camera
+ * then keeps its first `frames` frames whose timestamp is at or after it.
+ * All cameras run in one pipeline and share its clock, so their buffer
+ * timestamps are directly comparable.
+ */
+class SnapshotTrigger {
+public:
+    struct Shot {
+        int id = 0;                 // Snapshot number (1, 2, ...)
+        int frame = 0;              // Frame within the burst
+        int frames = 1;
+        std::string stamp;          // Wall-clock time of the trigger, for file names
+        int64_t spread_ns = -1;     // Set on the frame that completes the first frame set
+    };
+
+    explicit SnapshotTrigger(int cameras) : states(cameras) {}
+
+    /**
+     * Returns the snapshot id, or -1 while the previous one is still being taken
+     */
+    int arm(uint64_t from_ns, int frames, const std::string& stamp) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (pending > 0) return -1;
+
+        shot.id++;
+        shot.frames = std::max(1, frames);
+        shot.stamp = stamp;
+        first_min = UINT64_MAX;
+        first_max = 0;
+        first_seen = 0;
+        for (size_t i = 0; i < states.size(); i++) {
+            states[i].from_ns = from_ns;
+            states[i].remaining = shot.frames;
+        }
+        pending = static_cast<int>(states.size()) * shot.frames;
+        return shot.id;
+    }
+
+    /**
+     * Called for every frame of a camera; true if the frame belongs to the armed snapshot
+     */
+    bool take(int camera, uint64_t pts_ns, Shot& out) {
+        std::lock_guard<std::mutex> lock(mutex);
+        State& s = states[camera];
+        if (s.remaining == 0 || pts_ns < s.from_ns) return false;
+
+        out = shot;
+        out.frame = shot.frames - s.remaining;
+        out.spread_ns = -1;
+        if (out.frame == 0) {
+            first_min = std::min(first_min, pts_ns);
+            first_max = std::max(first_max, pts_ns);
+            if (++first_seen == static_cast<int>(states.size())) {
+                out.spread_ns = static_cast<int64_t>(first_max - first_min);
+            }
+        }
+        s.remaining--;
+        pending--;
+        return true;
+    }
+
+    bool busy() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return pending > 0;
+    }
+
+private:
+    struct State {
+        uint64_t from_ns = 0;
+        int remaining = 0;
+    };
+
+    mutable std::mutex mutex;
+    std::vector<State> states;
+    Shot shot;
+    int pending = 0;
+    uint64_t first_min = 0;
+    uint64_t first_max = 0;
+    int first_seen = 0;
+};
+
+#endif // EMOS2_IMAGE_WRITER_HPP
@@ -4,10 +4,38 @@
 #include "SVEthernetCamera.hpp"
 #include "SVRenderSimple.hpp"
 #include "SVStitcherAuto.hpp"
+#include "SVFramePool.hpp"
+#include "SVFrameBuffer.hpp"
+#include "SVThreadPool.hpp"
 #include "SVConfig.hpp"
+#include "SVCameraRig.hpp"
+#include "SVIPMWarp.hpp"
+#include "SVViewSwitcher.hpp"
+#include "SVCalibWatcher.hpp"
+#include "SVStartupGraph.hpp"
+#if defined(EN_RECORDING) || defined(EN_RTP_OUTPUT)
+#include "SVVideoOutput.hpp"
+#endif
+#ifdef EN_SHM_OUTPUT
+#include "SVShmRing.hpp"
+#endif
+#ifdef EN_SCENE_SKIP
+#include "SVChangeDetector.hpp"
+#endif
+#ifdef EN_PIPELINE_TUNER
+#include "SVPipelineTuner.hpp"
+#endif
+#ifdef EN_VEHICLE_STATE
+#include "SVVehicleState.hpp"
+#include "SVCameraRatePolicy.hpp"
+#endif
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <memory>
-#include <array>
+#include <mutex>
 #include <string>
+#include <vector>
 
 
 // Include necessary OpenCV headers for warping and custom homography
@@ -19,8 +47,6 @@
 
 #define EN_STITCH
 
-#define NUM_CAMERAS 4
-
 /**
  * @brief Ultra-Simplified Surround View Application
  * 
@@ -51,48 +77,190 @@ public:
     void stop();
     
 private:
+    // Camera rig (camera count and placement, fixed at startup)
+    SVCameraRig rig;
+    int num_cameras;
+    
     // Camera source
     std::shared_ptr<MultiCameraSource> camera_source;
-    std::array<Frame, NUM_CAMERAS> frames;
+    std::vector<Frame> frames;
+    std::vector<cv::cuda::GpuMat> display_frames;     // Per-camera views handed to the renderer
+    
+    // Frame buffers shared by all stages (sized once during init)
+    std::shared_ptr<SVFramePool> frame_pool;
 
-    #ifdef WARPING
-        std::vector<cv::Mat> K_matrices;
-        std::vector<cv::Mat> R_matrices;
-        float focal_length;
-        bool loadCalibration(const std::string& folder);
-        bool setupWarpMaps();
+    #if defined(WARPING) || defined(EN_BOWL_VIEW) || defined(EN_VIEW_PRESETS)
+        // Per-camera intrinsics + pose (Camparam<i>.yaml)
+        std::vector<SVCameraCalib> camera_calibs;
+        bool loadCalibration(const std::string& folder, std::vector<SVCameraCalib>& calibs) const;
     #endif
 
     #if defined(WARPING) || defined(RENDER_PRESERVE_AS_CUSTOMHOMOGRAPHY)
-        std::vector<cv::cuda::GpuMat> warp_x_maps;
-        std::vector<cv::cuda::GpuMat> warp_y_maps;
+        // Everything derived from the calibration files; replaced as a whole on hot reload
+        struct WarpMaps {
+            std::vector<cv::cuda::GpuMat> x;
+            std::vector<cv::cuda::GpuMat> y;
+            std::vector<cv::Mat> valid;                   // IPM: canvas pixels each camera sees
+        };
+        WarpMaps warp_maps;                               // Render thread only
         float scale_factor;
+        
+        // Per-camera scaled/warped buffers drawn from frame_pool
+        std::vector<SVFramePool::Handle> scaled_handles;
+        std::vector<SVFramePool::Handle> warped_handles;
+        bool reserveWarpBuffers();
+        cv::Size scaledInputSize(int camera) const;       // Homography: what the maps index
+        
+        #ifdef EN_DECODE_CROP
+            // Region of the capture frame each camera delivers, from the first maps built
+            std::vector<cv::Rect> source_crops;
+            void cropWarpSource(int camera, cv::Mat& map_x, cv::Mat& map_y, const cv::Mat& valid);
+        #endif
+        
+        #ifdef EN_SCENE_SKIP
+            // Thumbnails of each captured frame decide which cameras are re-warped
+            SVChangeDetector change_detector;
+            std::vector<SVFramePool::Handle> thumb_handles;       // Device, area-resized frame
+            std::vector<SVFramePool::Handle> thumb_host_handles;  // Pinned copy read by the detector
+            SVFramePool::Handle thumb_stream = SVFramePool::INVALID_HANDLE;
+            std::vector<bool> camera_changed;                     // This frame
+            bool stitched_current = false;                        // stitched_output matches the warped buffers
+            void detectSceneChanges();
+        #endif
+    #endif
+
+    #ifdef WARPING
+        // Shared ground canvas for the IPM warp
+        SVIPMCanvas ipm_canvas;
+        bool setupWarpMaps(const std::vector<SVCameraCalib>& calibs, const std::vector<cv::Size>& image_sizes,
+                           WarpMaps& maps);
     #endif
 
     #ifdef RENDER_PRESERVE_AS_CUSTOMHOMOGRAPHY
         // Manual calibration points for each camera (4 points per camera)
         std::vector<std::vector<cv::Point2f>> manual_src_points;  // Source (perspective view)
         std::vector<std::vector<cv::Point2f>> manual_dst_points;  // Destination (bird's-eye)
-        bool selectManualCalibrationPoints(const std::array<Frame, NUM_CAMERAS>& sample_frames);
+        bool selectManualCalibrationPoints(const std::vector<Frame>& sample_frames);
         bool saveCalibrationPoints(const std::string& folder);
-        bool loadCalibrationPoints(const std::string& folder);
-        bool setupCustomHomographyMaps();
+        bool loadCalibrationPoints(const std::string& folder,
+                                   std::vector<std::vector<cv::Point2f>>& src_points,
+                                   std::vector<std::vector<cv::Point2f>>& dst_points) const;
+        bool setupCustomHomographyMaps(const std::vector<std::vector<cv::Point2f>>& src_points,
+                                       const std::vector<std::vector<cv::Point2f>>& dst_points, WarpMaps& maps);
     #endif
+
+    #ifdef EN_VIEW_PRESETS
+        // Virtual-viewpoint presets shown on the right half
+        std::shared_ptr<SVViewSwitcher> view_switcher;
+        bool show_view_preset = false;
+        SVFrameBuffer view_output;
+        bool renderViewPreset();
+    #endif
+
     #ifdef EN_STITCH
         std::shared_ptr<SVStitcherAuto> stitcher;
         bool show_stitched;
         std::vector<cv::cuda::GpuMat> stored_warped_frames;
-        cv::cuda::GpuMat stitched_output;
+        SVFrameBuffer stitched_output;                    // Storage reused every frame
+        std::vector<SVFrameBuffer> stitch_warped_vec;     // Attached to pool buffers, sized once
         void handleKeyboard();
         bool initStitcher();
+        #if defined(WARPING) || defined(RENDER_PRESERVE_AS_CUSTOMHOMOGRAPHY)
+            std::shared_ptr<SVStitcherAuto> createStitcher(const WarpMaps& maps,
+                                                           const std::vector<cv::cuda::GpuMat>& raw_samples,
+                                                           const std::shared_ptr<SVFramePool>& pool);
+        #endif
+    #endif
+
+    #ifdef EN_CALIB_HOT_RELOAD
+        // Rebuilt on the watcher thread, applied by the render loop at a frame boundary
+        struct CalibReload {
+            #ifdef WARPING
+                std::vector<SVCameraCalib> calibs;        // Replace camera_calibs
+            #else
+                std::vector<std::vector<cv::Point2f>> src_points;     // Replace manual_src/dst_points
+                std::vector<std::vector<cv::Point2f>> dst_points;
+            #endif
+            WarpMaps maps;
+            std::shared_ptr<SVStitcherAuto> stitcher;     // Null if stitching was not running
+        };
+        std::unique_ptr<SVCalibWatcher> calib_watcher;
+        std::shared_ptr<const CalibReload> pending_reload;    // std::atomic_store / atomic_exchange
+        std::atomic<bool> stitcher_active{false};
+        
+        // Raw frames handed from the render loop to the watcher thread
+        std::mutex reload_mutex;
+        std::condition_variable reload_cv;
+        std::atomic<bool> reload_wants_samples{false};
+        std::vector<cv::cuda::GpuMat> reload_samples;
+        
+        void reloadCalibration(const std::vector<std::string>& changed);
+        bool requestReloadSamples(std::vector<cv::cuda::GpuMat>& samples);
+        void provideReloadSamples();
+        void applyCalibReload();
     #endif
 
+    #ifdef EN_EVENT_BUFFER
+        std::shared_ptr<SVEventBuffer> event_buffer;      // Fed by the camera pipelines
+    #endif
+    
+    #ifdef EN_VEHICLE_STATE
+        // Driving context -> which cameras are captured and warped this frame
+        SVVehicleInput vehicle_input;
+        std::unique_ptr<SVCameraRatePolicy> rate_policy;
+        std::vector<bool> camera_due;
+        void updateCameraRates(uint64_t frame);
+    #endif
+    
+    #ifdef EN_PIPELINE_TUNER
+        // Saved profile for this platform, tuned first if there is none
+        SVPipelineProfile pipelineProfile();
+    #endif
+    
+    #ifdef EN_DUAL_RES_INGEST
+        // Keys 1-9: that camera at full resolution on the right half
+        int zoom_camera = -1;
+        Frame zoom_frame;
+        void handleZoomKeys();
+        const SVFrameBuffer* zoomFrame();
+    #endif
+    
+    #ifdef EN_RECORDING
+        // 'r' toggles; encoding runs on each recorder's own thread
+        bool recording = false;
+        std::string record_prefix;                        // RECORD_DIR/sv_<start time>
+        std::unique_ptr<SVVideoOutput> stitched_recorder; // Right-half content, started on its first frame
+        std::unique_ptr<SVVideoOutput> display_recorder;  // Window read-back
+        void toggleRecording();
+        void recordFrame(const SVFrameBuffer* right_frame, const cv::Mat* display);
+    #endif
+    
+    #ifdef EN_RTP_OUTPUT
+        std::unique_ptr<SVVideoOutput> rtp_output;        // Started on the first frame, runs until stop()
+        void streamFrame(const SVFrameBuffer* right_frame, const cv::Mat* display);
+    #endif
+    
+    #if defined(EN_RECORDING) || defined(EN_RTP_OUTPUT)
+        // Window read-back, fetched once per frame for every output that uses it
+        cv::Mat display_readback;
+        const cv::Mat* fetchDisplayReadBack();
+    #endif
+    
+    #ifdef EN_SHM_OUTPUT
+        // Rings are created on the first frame of each output (sizes known only then)
+        std::unique_ptr<SVShmPublisher> shm_stitched;
+        std::vector<std::unique_ptr<SVShmPublisher>> shm_warped;
+        uint64_t calib_generation = 1;                    // SVShmFrameInfo::calib_id, bumped on reload
+        void publishShm(const SVFrameBuffer* stitched);
+    #endif
     
     // Rendering (no stitching!)
     std::shared_ptr<SVRenderSimple> renderer;
     
     // State
     bool is_running;
+    std::string calib_folder = "../camparameters";         // Replaced by a session's own calibration on replay
+    std::chrono::steady_clock::time_point startup_begin;   // Start of init(), for time to first image
 };
 
 #endif // SV_APP_SIMPLE_HPP
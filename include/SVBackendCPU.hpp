@@ -0,0 +1,46 @@
+#ifndef SV_BACKEND_CPU_HPP
+#define SV_BACKEND_CPU_HPP
+
+#include "SVComputeBackend.hpp"
+
+/**
+ * @brief Multi-threaded CPU implementation of the pipeline primitives
+ *
+ * Arrays are cv::Mat. Element-wise primitives (convert, gain, blend, mask
+ * ops) are split into row stripes on SVThreadPool; resize, remap and
+ * cvtColor use OpenCV's own parallel_for_, which runs on the same pool once
+ * SVThreadPool::installAsOpenCVBackend() has been called.
+ */
+class SVBackendCPU : public SVComputeBackend {
+public:
+    SVBackendType type() const override { return SVBackendType::CPU; }
+    const char* name() const override { return "CPU"; }
+
+    void convert(cv::InputArray src, cv::OutputArray dst, int rtype,
+                 double alpha = 1.0, double beta = 0.0) override;
+    void cvtColor(cv::InputArray src, cv::OutputArray dst, int code) override;
+    void resize(cv::InputArray src, cv::OutputArray dst, cv::Size dsize,
+                int interpolation = cv::INTER_LINEAR) override;
+    void remap(cv::InputArray src, cv::OutputArray dst,
+               cv::InputArray map_x, cv::InputArray map_y,
+               int interpolation = cv::INTER_LINEAR,
+               int border_mode = cv::BORDER_CONSTANT) override;
+
+    void applyGain(cv::InputArray src, cv::OutputArray dst, const cv::Scalar& gains) override;
+
+    void blendPrepare(cv::Size canvas, cv::OutputArray acc, cv::OutputArray weight) override;
+    void blendFeed(cv::InputArray img, cv::InputArray mask, cv::Point tl,
+                   cv::InputOutputArray acc, cv::InputOutputArray weight) override;
+    void blendFinish(cv::InputArray acc, cv::InputArray weight,
+                     cv::OutputArray dst, cv::OutputArray dst_mask) override;
+
+    void compare(cv::InputArray src, double value, cv::OutputArray dst, int cmpop) override;
+    void setTo(cv::InputOutputArray img, const cv::Scalar& value,
+               cv::InputArray mask = cv::noArray()) override;
+
+    void upload(const cv::Mat& src, cv::OutputArray dst) override;
+    void download(cv::InputArray src, cv::Mat& dst) override;
+    void synchronize() override {}
+};
+
+#endif // SV_BACKEND_CPU_HPP
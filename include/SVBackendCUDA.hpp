@@ -0,0 +1,60 @@
+#ifndef SV_BACKEND_CUDA_HPP
+#define SV_BACKEND_CUDA_HPP
+
+#ifndef SV_CPU_ONLY
+
+#include "SVComputeBackend.hpp"
+#include <opencv2/core/cuda.hpp>
+
+/**
+ * @brief CUDA implementation of the pipeline primitives (Jetson path)
+ *
+ * Arrays are cv::cuda::GpuMat. All work is queued on the backend's own
+ * stream; call synchronize() before reading results on the host.
+ */
+class SVBackendCUDA : public SVComputeBackend {
+public:
+    SVBackendType type() const override { return SVBackendType::CUDA; }
+    const char* name() const override { return "CUDA"; }
+
+    cv::cuda::Stream& stream() { return cuda_stream; }
+
+    void convert(cv::InputArray src, cv::OutputArray dst, int rtype,
+                 double alpha = 1.0, double beta = 0.0) override;
+    void cvtColor(cv::InputArray src, cv::OutputArray dst, int code) override;
+    void resize(cv::InputArray src, cv::OutputArray dst, cv::Size dsize,
+                int interpolation = cv::INTER_LINEAR) override;
+    void remap(cv::InputArray src, cv::OutputArray dst,
+               cv::InputArray map_x, cv::InputArray map_y,
+               int interpolation = cv::INTER_LINEAR,
+               int border_mode = cv::BORDER_CONSTANT) override;
+
+    void applyGain(cv::InputArray src, cv::OutputArray dst, const cv::Scalar& gains) override;
+
+    void blendPrepare(cv::Size canvas, cv::OutputArray acc, cv::OutputArray weight) override;
+    void blendFeed(cv::InputArray img, cv::InputArray mask, cv::Point tl,
+                   cv::InputOutputArray acc, cv::InputOutputArray weight) override;
+    void blendFinish(cv::InputArray acc, cv::InputArray weight,
+                     cv::OutputArray dst, cv::OutputArray dst_mask) override;
+
+    void compare(cv::InputArray src, double value, cv::OutputArray dst, int cmpop) override;
+    void setTo(cv::InputOutputArray img, const cv::Scalar& value,
+               cv::InputArray mask = cv::noArray()) override;
+
+    void upload(const cv::Mat& src, cv::OutputArray dst) override;
+    void download(cv::InputArray src, cv::Mat& dst) override;
+    void synchronize() override { cuda_stream.waitForCompletion(); }
+
+private:
+    cv::cuda::Stream cuda_stream;
+
+    // Blend scratch, allocated on the first frame and reused afterwards
+    cv::cuda::GpuMat s_img32;   // CV_32FC3 weighted image
+    cv::cuda::GpuMat s_w;       // CV_32F weight
+    cv::cuda::GpuMat s_w3;      // CV_32FC3 weight broadcast to 3 channels
+    cv::cuda::GpuMat s_wsafe;   // CV_32F weight clamped away from 0
+};
+
+#endif // SV_CPU_ONLY
+
+#endif // SV_BACKEND_CUDA_HPP
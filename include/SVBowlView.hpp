@@ -0,0 +1,83 @@
+#ifndef SV_BOWL_VIEW_HPP
+#define SV_BOWL_VIEW_HPP
+
+#include "SVConfig.hpp"
+#include "SVIPMWarp.hpp"
+#include <opencv2/core.hpp>
+#include <opencv2/core/cuda.hpp>
+#include <glm/glm.hpp>
+#include <memory>
+#include <vector>
+
+class OGLShader;
+
+/**
+ * @brief 3D bowl surround view stitched entirely in the fragment shader
+ *
+ * At init the parabolic bowl (Bowl.cpp) is projected into every calibrated
+ * camera once. Each vertex stores a texture coordinate per camera and a blend
+ * weight per camera; at most the two best cameras get a non-zero weight, so a
+ * fragment costs one texture fetch away from the seams and two across them.
+ * Per frame only the raw camera images are uploaded into one texture array,
+ * no CPU/CUDA warping or blending runs for this view.
+ *
+ * Bowl units map to the vehicle ground frame (SVCameraCalib) as
+ * X = x * BOWL_SCALE_MM, Y = z * BOWL_SCALE_MM, Z = -height * BOWL_SCALE_MM,
+ * so OpenGL sees x right, y up, z towards the rear.
+ */
+class SVBowlView {
+public:
+    // Cameras one vertex can carry texture coordinates and weights for
+    static constexpr int MAX_CAMERAS = 8;
+
+    SVBowlView();
+    ~SVBowlView();
+
+    /**
+     * @brief Generate the bowl mesh and bake per-vertex camera UVs and blend weights
+     * @param calibs One calibration per camera, rig order
+     * @param image_size Raw camera image size the intrinsics refer to
+     * @return true if successful (CPU only, no GL context needed)
+     */
+    bool build(const std::vector<SVCameraCalib>& calibs, cv::Size image_size);
+
+    /**
+     * @brief Create the vertex buffers, camera texture array and shader
+     * @note Needs a current GL context; call after build()
+     */
+    bool initGL();
+
+    /**
+     * @brief Upload the raw camera frames into the texture array
+     * @param raw_frames One unwarped frame per camera, rig order
+     */
+    void uploadFrames(const std::vector<cv::cuda::GpuMat>& raw_frames);
+
+    /**
+     * @brief Draw the bowl into the current viewport
+     */
+    void draw(const glm::mat4& view, const glm::mat4& projection);
+
+    bool isReady() const { return gl_ready; }
+
+private:
+    bool createShader();
+
+    // Interleaved vertices: position (3), UV per camera slot (2 each), weight per slot
+    std::vector<float> vertices;
+    std::vector<unsigned int> indices;      // One triangle strip
+    size_t index_count;                     // Kept after the CPU copies are released
+    int num_cameras;
+    int slots;                              // Camera slots per vertex (4 or 8)
+    cv::Size image_size;
+
+    unsigned int vao;
+    unsigned int vbo;
+    unsigned int ebo;
+    unsigned int camera_array;              // GL_TEXTURE_2D_ARRAY, one layer per camera
+    std::vector<unsigned int> pbos;
+    std::unique_ptr<OGLShader> shader;
+    bool gl_ready;
+};
+
+#endif // SV_BOWL_VIEW_HPP
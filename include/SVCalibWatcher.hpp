@@ -0,0 +1,66 @@
+#ifndef SV_CALIB_WATCHER_HPP
+#define SV_CALIB_WATCHER_HPP
+
+#include <atomic>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Watches a calibration folder and reports finished edits (Linux inotify)
+ *
+ * Files matching one of the glob patterns (e.g. "Camparam*.yaml") are
+ * reported once they are closed after writing or renamed into the folder,
+ * which covers both in-place writes and editors that save via a temp file.
+ * Events are collected until the folder has been quiet for settle_ms, then
+ * the callback runs once with every changed file name.
+ *
+ * The callback runs on the watcher's own thread, so it may do slow work
+ * (rebuilding maps) without touching the frame loop. Events arriving while
+ * it runs are batched into the next call.
+ */
+class SVCalibWatcher {
+public:
+    using Callback = std::function<void(const std::vector<std::string>& changed)>;
+
+    SVCalibWatcher();
+    ~SVCalibWatcher();
+
+    SVCalibWatcher(const SVCalibWatcher&) = delete;
+    SVCalibWatcher& operator=(const SVCalibWatcher&) = delete;
+
+    /**
+     * @brief Start watching
+     * @param folder Directory holding the calibration files
+     * @param patterns fnmatch() globs of the file names to report
+     * @param on_change Called on the watcher thread with the changed names (no path)
+     * @param settle_ms Quiet time before a batch is reported
+     * @return false if inotify is unavailable or the folder cannot be watched
+     */
+    bool start(const std::string& folder, const std::vector<std::string>& patterns,
+               Callback on_change, int settle_ms);
+
+    /**
+     * @brief Stop the watcher thread (waits for a running callback)
+     */
+    void stop();
+
+    bool isRunning() const { return thread.joinable(); }
+
+private:
+    void loop();
+    bool matches(const std::string& name) const;
+
+    std::string folder;
+    std::vector<std::string> patterns;
+    Callback on_change;
+    int settle_ms;
+
+    int inotify_fd;
+    int stop_fd;            // eventfd that wakes poll() on stop()
+    std::thread thread;
+    std::atomic<bool> stopping;
+};
+
+#endif // SV_CALIB_WATCHER_HPP
@@ -0,0 +1,73 @@
+#ifndef SV_CAMERA_RATE_POLICY_HPP
+#define SV_CAMERA_RATE_POLICY_HPP
+
+#include "SVCameraRig.hpp"
+#include "SVVehicleState.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Per-camera processing rates from the driving context
+ *
+ * Each camera gets a frame divisor: 1 = every frame, N = every Nth frame,
+ * 0 = paused. Cameras are grouped by viewing direction (nearest of front,
+ * left, rear, right from SVCameraInfo::yaw_deg), so rigs of any size work.
+ *
+ *   no / stale state   every camera at full rate
+ *   R                  front at 1/reverse_front_divisor, the rest full
+ *   P, N               every camera at 1/parked_divisor
+ *   D above cruise_kmh front full, sides and rear decimated
+ *   D below            every camera at full rate
+ *   turn signal        cameras on that side (both for hazard) back to full rate
+ *   not visible        paused, whatever the above says
+ *
+ * Decimated cameras are staggered (due() offsets by camera index) so they
+ * do not all fall on the same frame.
+ */
+class SVCameraRatePolicy {
+public:
+    enum class Facing { FRONT, LEFT, REAR, RIGHT };
+
+    struct Options {
+        int reverse_front_divisor = 4;
+        int parked_divisor = 2;
+        float cruise_kmh = 30.0f;
+        int cruise_side_divisor = 2;
+        int cruise_rear_divisor = 3;
+    };
+
+    explicit SVCameraRatePolicy(const SVCameraRig& rig);
+    SVCameraRatePolicy(const SVCameraRig& rig, const Options& options);
+
+    /**
+     * @param visible Cameras the active view shows; empty = all
+     * @return true if any divisor changed
+     */
+    bool update(const SVVehicleState& state, const std::vector<bool>& visible = std::vector<bool>());
+
+    int divisor(int camera) const { return divisors[camera]; }
+    const std::vector<int>& getDivisors() const { return divisors; }
+
+    /**
+     * @brief Whether a camera is processed on this frame
+     */
+    bool due(int camera, uint64_t frame) const {
+        const int d = divisors[camera];
+        return d > 0 && (frame + camera) % d == 0;
+    }
+
+    /**
+     * @brief e.g. "Front 1/4, Left 1, Rear 1, Right 1"
+     */
+    std::string describe(const SVCameraRig& rig) const;
+
+    static Facing facing(float yaw_deg);
+
+private:
+    Options opts;
+    std::vector<Facing> facings;
+    std::vector<int> divisors;
+};
+
+#endif // SV_CAMERA_RATE_POLICY_HPP
@@ -0,0 +1,97 @@
+#ifndef SV_CAMERA_RIG_HPP
+#define SV_CAMERA_RIG_HPP
+
+#include <opencv2/core.hpp>
+#include <string>
+#include <vector>
+
+/**
+ * @brief How a camera image is turned upright in the camera viewports
+ */
+enum class SVDisplayRotation {
+    NONE = 0,
+    FLIP_V,       // Vertical flip
+    FLIP_H,       // Horizontal flip
+    TRANSPOSE,    // 90° CCW + vertical flip
+    TRANSVERSE    // 90° CW + vertical flip
+};
+
+/**
+ * @brief Stitch mask layout
+ */
+enum class SVStitchLayout {
+    DIAGONAL_X = 0,   // Hand-tuned 4-camera X pattern (two canvas diagonals)
+    SECTORS           // One angular sector per camera around the canvas centre, any N
+};
+
+/**
+ * @brief One camera of the rig
+ */
+struct SVCameraInfo {
+    std::string name;
+    std::string ip;
+    int port = 0;
+    int port_full = 0;      // Full-resolution second stream (dual-res ingest), 0 = none
+
+    // Viewing direction, degrees counter-clockwise from the front (0 = front, 90 = left)
+    float yaw_deg = 0.0f;
+
+    // Top-left of this camera's warped image on the stitch canvas
+    cv::Point canvas_origin;
+
+    SVDisplayRotation display = SVDisplayRotation::NONE;
+};
+
+/**
+ * @brief Camera count and per-camera configuration, fixed at startup
+ *
+ * Every stage sizes itself from the rig instead of a compile-time camera
+ * count. The built-in rig is the 4-camera car from CAMERA_CONFIGS in
+ * SVConfig.hpp; trucks and trailers load a YAML file instead:
+ *
+ *   %YAML:1.0
+ *   dest_ip: "192.168.45.3"
+ *   layout: "sectors"          # or "diagonal_x" (4 cameras only)
+ *   canvas: [ 640, 800 ]
+ *   fade: 40
+ *   cameras:
+ *     - { name: "Front", ip: "192.168.45.10", port: 5020, yaw: 0,
+ *         origin: [ 0, 0 ], display: "flip_v" }     # optional port_full: 5120
+ *     - ...
+ */
+class SVCameraRig {
+public:
+    /**
+     * @brief 4-camera rig matching CAMERA_CONFIGS and the diagonal stitch layout
+     */
+    static SVCameraRig defaultRig();
+
+    /**
+     * @brief Rig from SV_RIG, else CAMERA_RIG_FILE, else defaultRig()
+     *
+     * A file that fails to load falls back to defaultRig() with a warning.
+     */
+    static SVCameraRig fromConfig();
+
+    /**
+     * @brief Load a rig from YAML (see class description)
+     * @return false if the file is missing or malformed
+     */
+    bool load(const std::string& path);
+
+    int size() const { return static_cast<int>(cameras.size()); }
+    const SVCameraInfo& camera(int i) const { return cameras[i]; }
+
+    void print() const;
+
+    std::vector<SVCameraInfo> cameras;
+    std::string dest_ip = "192.168.45.3";
+    SVStitchLayout layout = SVStitchLayout::DIAGONAL_X;
+    cv::Size canvas_size = cv::Size(640, 800);
+    int fade_px = 40;
+};
+
+const char* displayRotationName(SVDisplayRotation r);
+const char* stitchLayoutName(SVStitchLayout layout);
+
+#endif // SV_CAMERA_RIG_HPP
@@ -0,0 +1,75 @@
+#ifndef SV_CHANGE_DETECTOR_HPP
+#define SV_CHANGE_DETECTOR_HPP
+
+#include <opencv2/core.hpp>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Per-camera scene-change test on small thumbnails
+ *
+ * The caller downsamples each camera frame to a thumbnail (a few thousand
+ * pixels, e.g. one area resize on the GPU) and asks update() whether the
+ * camera needs processing. A camera counts as changed when enough
+ * thumbnail pixels differ by more than a gray-level threshold from the
+ * thumbnail of the last frame that was processed (not the previous frame,
+ * so slow drift adds up until it triggers). Unchanged cameras are still
+ * processed every min_refresh_ms.
+ *
+ * Area averaging removes sensor noise, so the thresholds can be low
+ * enough to catch a person walking into view.
+ */
+class SVChangeDetector {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Options {
+        cv::Size thumb_size = cv::Size(96, 54);
+        int pixel_threshold = 12;           // Gray levels a thumbnail pixel must move to count
+        float changed_fraction = 0.002f;    // Changed thumbnail pixels that make a camera changed
+        int min_refresh_ms = 1000;          // Unchanged cameras are processed at least this often
+    };
+
+    struct Stats {
+        uint64_t processed = 0;
+        uint64_t skipped = 0;
+    };
+
+    SVChangeDetector() {}
+    explicit SVChangeDetector(const Options& options) : opts(options) {}
+
+    void reset(int num_cameras);
+
+    /**
+     * @brief Compare a camera's thumbnail (BGR or gray, thumbSize()) with its reference
+     * @return true if the camera must be processed this frame; its reference is updated
+     */
+    bool update(int camera, const cv::Mat& thumb, Clock::time_point now = Clock::now());
+
+    /**
+     * @brief Make the next update() of every camera report a change (calibration reload etc.)
+     */
+    void invalidate();
+
+    cv::Size thumbSize() const { return opts.thumb_size; }
+    float lastChangedFraction(int camera) const { return cameras[camera].last_fraction; }
+    const Stats& stats(int camera) const { return cameras[camera].stats; }
+    Stats total() const;
+
+private:
+    struct Camera {
+        cv::Mat reference;                  // Gray thumbnail of the last processed frame
+        cv::Mat gray;
+        cv::Mat diff;
+        Clock::time_point processed_at;
+        bool valid = false;
+        float last_fraction = 0.0f;
+        Stats stats;
+    };
+
+    Options opts;
+    std::vector<Camera> cameras;
+};
+
+#endif // SV_CHANGE_DETECTOR_HPP
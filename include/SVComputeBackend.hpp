@@ -0,0 +1,112 @@
+#ifndef SV_COMPUTE_BACKEND_HPP
+#define SV_COMPUTE_BACKEND_HPP
+
+#include "SVFrameBuffer.hpp"
+#include <opencv2/core.hpp>
+#include <memory>
+#include <string>
+
+enum class SVBackendType {
+    AUTO = 0,   // CUDA if a device is available, otherwise CPU
+    CPU,
+    CUDA
+};
+
+/**
+ * @brief Pipeline primitives implemented once per compute device
+ *
+ * Stages are written against this interface instead of cv::cuda directly.
+ * Array arguments are the backend's native type: cv::Mat for the CPU
+ * backend, cv::cuda::GpuMat for the CUDA backend. in() / out() / inout()
+ * fetch that view from an SVFrameBuffer, migrating only if it is stale.
+ *
+ * Blending is weighted: blendFeed() accumulates img * w and w (w = mask / 255)
+ * into a CV_32FC3 / CV_32F canvas pair, blendFinish() normalises it.
+ */
+class SVComputeBackend {
+public:
+    virtual ~SVComputeBackend() = default;
+
+    virtual SVBackendType type() const = 0;
+    virtual const char* name() const = 0;
+
+    /**
+     * @brief Location the backend reads and writes frames in
+     */
+    SVResidency residency() const {
+        return type() == SVBackendType::CUDA ? SVResidency::DEVICE : SVResidency::HOST;
+    }
+
+    // ---- SVFrameBuffer views in the backend's native type ----
+
+    cv::_InputArray in(const SVFrameBuffer& buf);
+    cv::_OutputArray out(SVFrameBuffer& buf);
+    cv::_InputOutputArray inout(SVFrameBuffer& buf);
+
+    // ---- Primitives ----
+
+    virtual void convert(cv::InputArray src, cv::OutputArray dst, int rtype,
+                         double alpha = 1.0, double beta = 0.0) = 0;
+    virtual void cvtColor(cv::InputArray src, cv::OutputArray dst, int code) = 0;
+    virtual void resize(cv::InputArray src, cv::OutputArray dst, cv::Size dsize,
+                        int interpolation = cv::INTER_LINEAR) = 0;
+    virtual void remap(cv::InputArray src, cv::OutputArray dst,
+                       cv::InputArray map_x, cv::InputArray map_y,
+                       int interpolation = cv::INTER_LINEAR,
+                       int border_mode = cv::BORDER_CONSTANT) = 0;
+
+    /**
+     * @brief dst = src * gains (per channel, saturated to src depth)
+     */
+    virtual void applyGain(cv::InputArray src, cv::OutputArray dst, const cv::Scalar& gains) = 0;
+
+    /**
+     * @brief Allocate and zero the blend accumulator (CV_32FC3) and weight (CV_32F) canvas
+     */
+    virtual void blendPrepare(cv::Size canvas, cv::OutputArray acc, cv::OutputArray weight) = 0;
+
+    /**
+     * @brief Accumulate one image at canvas offset tl, clipped to the canvas
+     * @param img CV_8UC3 or CV_16SC3
+     * @param mask CV_8U, same size as img (255 = full weight)
+     */
+    virtual void blendFeed(cv::InputArray img, cv::InputArray mask, cv::Point tl,
+                           cv::InputOutputArray acc, cv::InputOutputArray weight) = 0;
+
+    /**
+     * @brief dst = acc / weight as CV_8UC3; dst_mask = 255 where anything was fed
+     */
+    virtual void blendFinish(cv::InputArray acc, cv::InputArray weight,
+                             cv::OutputArray dst, cv::OutputArray dst_mask) = 0;
+
+    virtual void compare(cv::InputArray src, double value, cv::OutputArray dst, int cmpop) = 0;
+    virtual void setTo(cv::InputOutputArray img, const cv::Scalar& value,
+                       cv::InputArray mask = cv::noArray()) = 0;
+
+    // ---- Host exchange ----
+
+    virtual void upload(const cv::Mat& src, cv::OutputArray dst) = 0;
+    virtual void download(cv::InputArray src, cv::Mat& dst) = 0;
+
+    /**
+     * @brief Wait until all queued work has finished
+     */
+    virtual void synchronize() = 0;
+};
+
+/**
+ * @brief Parse "auto" / "cpu" / "cuda" (unknown names give AUTO)
+ */
+SVBackendType parseBackendType(const std::string& name);
+
+/**
+ * @brief Backend selected by SV_BACKEND, falling back to COMPUTE_BACKEND in SVConfig.hpp
+ */
+SVBackendType configuredBackendType();
+
+/**
+ * @brief Create a backend; AUTO and unavailable CUDA fall back to CPU
+ */
+std::shared_ptr<SVComputeBackend> createComputeBackend(SVBackendType type);
+
+#endif // SV_COMPUTE_BACKEND_HPP
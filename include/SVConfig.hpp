@@ -35,9 +35,14 @@
 // CAMERA CONFIGURATION
 // ============================================================
 
-// Number of cameras
+// Number of cameras in the built-in rig (CAMERA_CONFIGS below)
+// Other camera counts are configured with a rig file, see SVCameraRig.hpp
 #define NUM_CAMERAS 4
 
+// Rig file (YAML) with camera count, addresses, yaw and canvas placement
+// "" = built-in 4-camera rig; override at runtime with SV_RIG=<path>
+#define CAMERA_RIG_FILE ""
+
 // Camera resolution
 #define CAMERA_WIDTH 1280
 #define CAMERA_HEIGHT 800
@@ -77,6 +82,31 @@ static const CameraConfig CAMERA_CONFIGS[NUM_CAMERAS] = {
 // Higher = slower but higher quality
 #define PROCESS_SCALE 0.50f
 
+// Worker threads in the shared CPU pool (SVThreadPool)
+// 0 = hardware threads - 1 (one left for the capture/render loop)
+// Override at runtime with SV_THREADS=<n>
+#define THREAD_POOL_WORKERS 0
+
+// CPUs to pin pool workers to, comma separated ("" = no pinning)
+// Override at runtime with SV_THREAD_CPUS=<list>, e.g. "2,3,4,5"
+#define THREAD_POOL_CPUS ""
+
+// Compute backend for the stitching primitives: "auto", "cpu" or "cuda"
+// auto = CUDA when a device is present, otherwise the multi-threaded CPU backend
+// Override at runtime with SV_BACKEND=<name>
+#define COMPUTE_BACKEND "auto"
+
+// Inverse perspective mapping (WARPING + WARPING_IPM)
+// Metric top-down canvas built from Camparam<i>.yaml (K, distortion, pose);
+// the vehicle centre sits at the canvas centre, front at the top
+#define IPM_MM_PER_PIXEL 10.0f
+#define IPM_CANVAS_WIDTH 640
+#define IPM_CANVAS_HEIGHT 800
+
+// Tile edge (pixels) for the tile-parallel CPU stitch; 0 = whole-canvas blend
+// 64x64 keeps a tile and its sources in L1/L2
+#define STITCH_TILE_SIZE 64
+
 // Gain compensation update interval (seconds)
 // #define GAIN_UPDATE_INTERVAL 10
 
@@ -84,13 +114,154 @@ static const CameraConfig CAMERA_CONFIGS[NUM_CAMERAS] = {
 // RENDERING CONFIGURATION
 // ============================================================
 
-// Bowl rendering parameters
+// 3D bowl view (key 'b', right half of the screen)
+// Needs Camparam<i>.yaml for every camera; texture coordinates and blend
+// weights are baked per vertex at init, so the view costs no per-frame stitching
+// #define EN_BOWL_VIEW
+
+// Bowl rendering parameters (bowl units, scaled by BOWL_SCALE_MM)
+// Height over the flat disk: c * (x^2 / a^2 + z^2 / b^2)
 #define BOWL_DISK_RADIUS 0.4f
 #define BOWL_PARAB_RADIUS 0.55f
 #define BOWL_HOLE_RADIUS 0.08f
-#define BOWL_VERTICES 750
+#define BOWL_PARAB_A 0.4f
+#define BOWL_PARAB_B 0.5f
+#define BOWL_PARAB_C 0.2f
+#define BOWL_SCALE_MM 20000.0f    // 0.4 disk radius = 8 m of flat ground around the vehicle
+#define BOWL_VERTICES 256         // Mesh grid is BOWL_VERTICES x BOWL_VERTICES
+
+// Blend weights fade out this close to a camera's image border (pixels)
+#define BOWL_EDGE_FEATHER_PX 40.0f
+
+// Virtual-viewpoint presets (key 'v' cycles top / rear 3/4 / front wheel / sides)
+// Needs Camparam<i>.yaml; every preset's LUT and blend weights are built at init,
+// switching is a pointer swap. Canvas: IPM_CANVAS_WIDTH x IPM_CANVAS_HEIGHT
+// #define EN_VIEW_PRESETS
+#define VIEW_TRANSITION_FRAMES 15   // 0 = switch instantly
+
+// Calibration hot reload (Linux inotify on ../camparameters): edits to Camparam*.yaml
+// (WARPING) or custom_homography_points.yaml (RENDER_PRESERVE_AS_CUSTOMHOMOGRAPHY)
+// rebuild warp maps, blend masks and gain state in the background; the render loop
+// swaps them in at the next frame boundary. Warp output sizes must stay the same.
+#define EN_CALIB_HOT_RELOAD
+#define CALIB_RELOAD_SETTLE_MS 300  // Quiet time after the last write before rebuilding
+#if defined(EN_CALIB_HOT_RELOAD) && !defined(WARPING) && !defined(RENDER_PRESERVE_AS_CUSTOMHOMOGRAPHY)
+    #undef EN_CALIB_HOT_RELOAD
+#endif
+
+// Recording (key 'r' starts/stops): H.264 files in RECORD_DIR, encoded on a worker
+// thread. A frame that arrives while the encoder queue is full is dropped (and
+// counted), the render loop never waits for the encoder
+// #define EN_RECORDING
+#define RECORD_DIR "../recordings"
+#define RECORD_FPS 30
+#define RECORD_QUEUE_DEPTH 8        // Frames buffered per recording before dropping
+#define RECORD_EXTENSION ".mkv"     // ".mkv" survives a crash, ".mp4" needs a clean stop
+// Software encoder works on any Linux box; on Jetson use "nvvidconv ! nvv4l2h264enc"
+#define RECORD_ENCODER "x264enc tune=zerolatency speed-preset=ultrafast bitrate=8000"
+#define RECORD_STITCHED             // Stitched canvas at its native size
+#define RECORD_DISPLAY              // Whole window as shown (GL read-back)
+
+// Pre-event buffer (key 'e' saves an event): the last EVENT_PRE_SECONDS of every
+// camera's H.264 stream are kept in RAM as received (no decode, no re-encode);
+// a trigger writes them plus EVENT_POST_SECONDS more to EVENT_DIR/event_<time>/
+// as one .h264 file per camera. Nothing touches the disk until a trigger
+// #define EN_EVENT_BUFFER
+#define EVENT_PRE_SECONDS 10.0
+#define EVENT_POST_SECONDS 5.0
+#define EVENT_BUFFER_MB_PER_CAMERA 24   // Covers ~15 Mbit/s for EVENT_PRE_SECONDS + one GOP
+#define EVENT_DIR "../events"
 
-// Camera view parameters
+// Session files (.svs): every camera's H.264 access units with capture time and
+// sequence number, plus the calibration in use. Key 'w' starts/stops recording
+// #define EN_SESSION_RECORD
+#define SESSION_DIR "../sessions"
+
+// Replay a session instead of opening the cameras (synchronized, at recorded speed,
+// looping); its stored calibration is used. Decoder must emit one frame per unit
+// #define SESSION_REPLAY_FILE "../sessions/example.svs"
+#define SESSION_REPLAY_DECODER "avdec_h264 max-threads=1"   // Jetson: "nvv4l2decoder ! nvvidconv"
+
+// Network stream: RTP/H.264 over UDP of the right half (stitched canvas / view
+// preset) or, with RTP_STREAM_DISPLAY, the whole window. Starts with the first
+// frame and runs until exit; frames the encoder cannot keep up with are dropped.
+// Same packetization as the cameras (payload 96), receive with udpsrc port=RTP_PORT
+// #define EN_RTP_OUTPUT
+#define RTP_HOST "127.0.0.1"        // Receiver address (unicast or multicast group)
+#define RTP_PORT 5600
+#define RTP_FPS 30
+#define RTP_BITRATE_KBPS 4000
+#define RTP_GOP 30                  // Frames between keyframes = worst-case join delay
+#define RTP_LATENCY LOW             // LOW, BALANCED or QUALITY (SVVideoOutput::Latency)
+// #define RTP_STREAM_DISPLAY       // Whole window (GL read-back) instead of the right half
+// Overrides the x264enc settings above, e.g. on Jetson:
+// #define RTP_ENCODER "nvvidconv ! nvv4l2h264enc bitrate=4000000 iframeinterval=30 insert-sps-pps=1 maxperf-enable=1"
+
+// Shared-memory output for other processes on the same machine (/dev/shm/<prefix>_*):
+// the stitched canvas and each warped camera go into lock-free frame rings that
+// consumers link from sv_shm and read in place (see SVShmRing.hpp)
+// #define EN_SHM_OUTPUT
+#define SHM_PREFIX "sv"
+#define SHM_SLOTS 4                 // A consumer has SHM_SLOTS-1 frames to use one in place
+#define SHM_PUBLISH_WARPED          // Also publish <prefix>_warped<i> (WARPING / custom homography)
+
+// Scene-change frame skipping (saves power and heat while parked): right after
+// capture each camera frame is area-resized on the GPU to a small thumbnail;
+// a camera whose thumbnail has hardly changed since it was last processed is
+// not re-warped (its warped buffer keeps the previous result) and the stitched
+// canvas is reused while no camera changed. Every camera is still processed at
+// least every SCENE_MIN_REFRESH_MS (WARPING / custom homography)
+// #define EN_SCENE_SKIP
+#define SCENE_THUMB_WIDTH 96
+#define SCENE_THUMB_HEIGHT 54
+#define SCENE_PIXEL_THRESHOLD 12        // Gray levels a thumbnail pixel must move to count as changed
+#define SCENE_CHANGED_FRACTION 0.002f   // Changed share of the thumbnail (0.002 x 96x54 = 10 pixels)
+#define SCENE_MIN_REFRESH_MS 1000
+
+// Context-aware camera rates: gear, speed and turn signal decide how often each
+// camera is captured and warped (SVCameraRatePolicy), e.g. the front camera at
+// 1/4 rate while reversing. Skipped cameras keep their last frame; without a
+// current state every camera runs at full rate. Source "file:<path>" (file or
+// FIFO, lines like "gear=R speed=3 turn=left") or "can:<iface>" (SocketCAN,
+// vcan0 for testing, frame layout in SVVehicleState.hpp); SV_VEHICLE overrides
+// #define EN_VEHICLE_STATE
+#define VEHICLE_STATE_SOURCE "file:/tmp/sv_vehicle"
+#define VEHICLE_STATE_STALE_MS 1000     // No update for this long: full rate
+#define VEHICLE_CAN_ID 0x3E9
+
+// Dual-resolution ingest: cameras are captured and stitched at
+// STITCH_CAPTURE_WIDTH x HEIGHT, and one camera at a time (keys 1-9, same key
+// again to leave) is shown at CAMERA_WIDTH x HEIGHT in the right panel.
+// Cameras with port_full in the rig send the full stream there; the others
+// decode once and scale (tee). Calibration stays at CAMERA_WIDTH x HEIGHT
+// and is rescaled to the capture size
+// #define EN_DUAL_RES_INGEST
+#define STITCH_CAPTURE_WIDTH 640
+#define STITCH_CAPTURE_HEIGHT 400
+
+// Decoder-stage crop: each camera's converter only outputs the region its warp
+// map (and IPM visibility mask) reads, so less is converted, copied and
+// uploaded per frame. The camera panels then show that region. Crops are fixed
+// when the streams start; a hot-reloaded calibration that needs more of the
+// frame is warned about and takes effect after a restart. Bowl view and view
+// presets sample whole frames with the camera calibration, so they turn it off
+// #define EN_DECODE_CROP
+
+// Camera pipeline auto-tuning: decoder, converter, caps format and appsink
+// settings come from PIPELINE_PROFILE_DIR/pipeline_<platform>.yaml. Without
+// that file (or with SV_TUNE_PIPELINE=1) every installed candidate is run for
+// PIPELINE_TUNE_SECONDS against camera 0 before the cameras open, or against
+// a recorded session (SV_TUNE_SESSION=<file.svs>), and the lowest-latency one
+// is saved. Off: the Jetson chain (nvv4l2decoder + nvvidconv)
+// #define EN_PIPELINE_TUNER
+#define PIPELINE_PROFILE_DIR "../camparameters"
+#define PIPELINE_TUNE_SECONDS 3.0
+#if defined(EN_DECODE_CROP) && (defined(EN_BOWL_VIEW) || defined(EN_VIEW_PRESETS) || \
+    (!defined(WARPING) && !defined(RENDER_PRESERVE_AS_CUSTOMHOMOGRAPHY)))
+    #undef EN_DECODE_CROP
+#endif
+
+// Camera view parameters (3D bowl view: metres behind and above the vehicle centre)
 #define CAMERA_FOV 45.0f
 #define CAMERA_POSITION_Y 2.0f
 #define CAMERA_POSITION_Z 5.0f
@@ -104,4 +275,15 @@ static const CameraConfig CAMERA_CONFIGS[NUM_CAMERAS] = {
 // #define DEBUG_FRAMES
 // #define DEBUG_WARPING
 
+// Uncomment to count host/device allocations per frame and report any
+// steady-state frame that allocates (all buffers should come from SVFramePool)
+// #define DEBUG_ALLOCATIONS
+
+// Uncomment to report host/device transfers per frame and a per-path summary on exit
+// (every copy made through SVFrameBuffer / svDownload / svUpload is counted)
+// #define DEBUG_TRANSFERS
+
+// Frames allowed to allocate after init / stitcher enable before the check applies
+#define ALLOC_WARMUP_FRAMES 30
+
 #endif // SV_CONFIG_HPP
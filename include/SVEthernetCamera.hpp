@@ -13,9 +13,23 @@
 #include <gst/gst.h>
 #include <gst/app/gstappsink.h>
 #include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
 #include <vector>
 #include <string>
+#include <memory>
 #include <cuda_runtime.h>
+#include "SVFramePool.hpp"
+#include "SVFrameBuffer.hpp"
+#include "SVCameraRig.hpp"
+#include "SVEventBuffer.hpp"
+#include "SVSession.hpp"
+#include "SVPipelineProfile.hpp"
+#include "SVSessionPlayer.hpp"
 
 // Configuration
 #define CAMERA_WIDTH 1280
@@ -23,14 +37,12 @@
 
 
 #define MMAP_BUFFERS_COUNT 4
-constexpr int CAM_NUMS = 4;
 
 /**
  * @brief Frame structure - matches original SVCamera interface
  */
 struct Frame {
-    cv::cuda::GpuMat gpuFrame;
-    cv::Mat cpuFrame;  // Optional CPU copy
+    SVFrameBuffer image;  // Device-resident after capture; host copy made on demand
 };
 
 /**
@@ -58,9 +70,31 @@ struct CameraUndistortData {
 
 /**
  * @brief Single Ethernet camera source using GStreamer
+ *
+ * While streaming, a supervisor thread per camera watches the pipeline bus
+ * and frame arrival (appsink new-sample, not capture()) and restarts only
+ * this camera's pipeline, with exponential backoff, after an error or when
+ * frames stop. capture() never touches the pipeline: it takes the newest
+ * decoded sample and only waits for one while the camera is live.
  */
 class EthernetCameraSource {
 public:
+    enum class State {
+        STOPPED,
+        STARTING,       // Pipeline started, no frame yet
+        LIVE,
+        STALE,          // No frame for stale_ms, or none within two frame periods of capture(); not waited for
+        RECONNECTING    // Pipeline being rebuilt, or rebuilt and waiting for its first frame
+    };
+    
+    struct SupervisorOptions {
+        int stale_ms = 300;         // No frame for this long: STALE
+        int restart_ms = 2000;      // No frame for this long while live/stale: restart
+        int startup_ms = 8000;      // First frame after a (re)start may take this long
+        int backoff_min_ms = 500;   // Wait before a restart, doubled per failed attempt
+        int backoff_max_ms = 8000;
+    };
+    
     EthernetCameraSource(const std::string& sourceIP, int sourcePort, 
                          const std::string& destIP, const std::string& name);
     ~EthernetCameraSource();
@@ -69,9 +103,90 @@ public:
     bool deinit();
     bool startStream();
     bool stopStream();
+    
+    /**
+     * @brief Take the newest decoded frame
+     * @param timeout Waits up to this long (ms) for a frame while the camera is
+     *                STARTING; while LIVE at most two frame periods, after which
+     *                the camera is marked STALE. Returns at once when it is STALE
+     *                or RECONNECTING
+     */
     bool capture(cv::cuda::GpuMat& frame, size_t timeout = 1000);
     
+    /**
+     * @brief Change the output size of this camera only
+     * @note While streaming the supervisor rebuilds the pipeline in the background
+     */
+    void setFrameSize(const cv::Size& size);
+    
+    /**
+     * @brief Decoder, converter and appsink stages (default: Jetson hardware decode)
+     * @note Must be called before init()
+     */
+    void setPipelineProfile(const SVPipelineProfile& profile);
+    
+    /**
+     * @brief Deliver only this region of the init() frame; empty = whole frame
+     *
+     * The converter after the decoder crops, so only the region is converted,
+     * copied and uploaded. Clipped to the frame size.
+     * @note Must be called before init()
+     */
+    void setCrop(const cv::Rect& roi);
+    
+    /**
+     * @brief Add a full-resolution secondary stream, off until enableFullResolution(true)
+     *
+     * With a port, the camera sends a second RTP stream at full resolution;
+     * its pipeline (receive and decode) only exists while enabled. Without
+     * one (port 0) the primary decode is teed: the camera sends full
+     * resolution, the primary branch scales it to the init() size and a
+     * valve opens the full-resolution branch on demand.
+     * @note Must be called before init()
+     */
+    void setFullResolution(const cv::Size& size, int port);
+    bool hasFullResolution() const { return !fullSize.empty(); }
+    
+    /**
+     * @brief Request the full-resolution stream on or off; the supervisor applies it
+     */
+    void enableFullResolution(bool enable) { fullWanted = enable; }
+    
+    /**
+     * @brief Take the newest full-resolution frame; never waits
+     */
+    bool captureFull(cv::cuda::GpuMat& frame);
+    
+    /**
+     * @brief Supervisor state of the full-resolution stream; STOPPED while not enabled
+     *
+     * Watched like the primary stream: a port-mode pipeline that errors, ends
+     * or stops delivering is rebuilt with backoff; a tee branch that stops
+     * delivering only goes STALE (its errors restart the primary pipeline).
+     */
+    State getFullState() const { return fullState.load(std::memory_order_acquire); }
+    
+    /**
+     * @note Must be set before startStream()
+     */
+    void setSupervisorOptions(const SupervisorOptions& options) { supervisorOpts = options; }
+    
+    /**
+     * @brief Lock-free; safe to read from the frame loop every frame
+     */
+    State getState() const { return state.load(std::memory_order_acquire); }
+    static const char* stateName(State s);
+    uint32_t getReconnects() const { return reconnects.load(std::memory_order_relaxed); }
+    
+    /**
+     * @brief Receive every compressed access unit (Annex-B) as it leaves the parser
+     * @note Must be set before init(); runs on the GStreamer streaming thread, keep it short
+     */
+    using AccessUnitTap = std::function<void(const uint8_t* data, size_t size, bool keyframe)>;
+    void setAccessUnitTap(AccessUnitTap tap) { auTap = std::move(tap); }
+    
     const std::string& getCameraName() const { return cameraName; }
+    bool isInitialized() const { return isInit; }
     
 private:
     // GStreamer elements
@@ -91,61 +206,247 @@ private:
     bool isInit;
     bool isStreaming;
     
+    size_t cudaBufferBytes;
+    
+    AccessUnitTap auTap;
+    
+    // Newest sample from the appsink callback; capture() takes it
+    std::mutex sampleMutex;
+    std::condition_variable sampleReady;
+    GstSample* latestSample;
+    std::atomic<int64_t> lastFrameNs;       // steady_clock, set by the streaming thread
+    std::atomic<int64_t> framePeriodNs;     // Smoothed arrival interval, 0 until measured
+    
+    // Supervisor: owns the pipeline while streaming
+    SupervisorOptions supervisorOpts;
+    std::atomic<State> state;
+    std::atomic<uint32_t> reconnects;
+    std::thread supervisor;
+    std::mutex supervisorMutex;
+    std::condition_variable supervisorWake;
+    bool supervisorStop;
+    cv::Size pendingFrameSize;              // Non-empty: rebuild with this size
+    cv::Size requestedFrameSize;            // Last size asked for; frameSize is the supervisor's while streaming
+    cv::Rect crop;                          // Empty = whole frame
+    SVPipelineProfile profile;
+    
+    // Full-resolution secondary stream (dual-res ingest)
+    cv::Size fullSize;                      // Empty = single stream
+    int fullPort;                           // 0 = tee of the primary decode
+    std::atomic<bool> fullWanted;
+    bool fullApplied;                       // Supervisor only
+    GstElement* fullPipeline;               // Port mode, exists only while enabled
+    GstBus* fullBus;
+    GstElement* fullValve;                  // Tee mode, gates the full-resolution branch
+    GstSample* latestFullSample;            // Under sampleMutex
+    uchar* cuda_full_buffer;
+    size_t cudaFullBytes;
+    std::atomic<State> fullState;
+    std::atomic<int64_t> lastFullFrameNs;   // steady_clock, set by the streaming thread
+    int64_t fullStartedNs;                  // Supervisor only, like the rest below
+    int64_t fullRetryNs;                    // Port mode: no rebuild before this
+    int fullBackoffMs;
+    
     // Helper methods
     std::string createPipelineString() const;
+    std::string createFullPipelineString() const;
+    bool buildPipeline();
+    void destroyPipeline();
+    void applyFullResolution();
+    void destroyFullPipeline();
+    void retryFullLater(int64_t now_ns);
+    void superviseFull(int64_t now_ns);
+    bool uploadSample(GstSample* sample, uchar*& buffer, size_t& bytes, cv::cuda::GpuMat& frame);
+    void supervise();
+    void setState(State s);
     static GstFlowReturn newSampleCallback(GstElement* sink, gpointer data);
+    static GstFlowReturn newFullSampleCallback(GstElement* sink, gpointer data);
+    static GstPadProbeReturn accessUnitProbe(GstPad* pad, GstPadProbeInfo* info, gpointer data);
 };
 
 /**
  * @brief Multi-camera synchronized source - matches original interface
+ *
+ * One EthernetCameraSource per camera of the rig; capture() grabs all of
+ * them in parallel on the shared pool.
  */
 class MultiCameraSource {
 public:
-    MultiCameraSource();
+    explicit MultiCameraSource(const SVCameraRig& rig = SVCameraRig::defaultRig());
     ~MultiCameraSource();
     
     // Interface matching original SVCamera
+    // init() and startStream() bring all cameras up in parallel
     int init(const std::string& param_filepath, const cv::Size& calibSize, 
              const cv::Size& undistSize, const bool useUndist = false);
     bool startStream();
     bool stopStream();
-    bool capture(std::array<Frame, CAM_NUMS>& frames);
+    /**
+     * @brief Capture one frame per camera
+     *
+     * A live camera is waited for at most two frame periods; one that misses
+     * them is marked stale and, like a reconnecting one, not waited for again:
+     * its previous frame is kept and it does not count as a failure.
+     * @param frames Resized to getCamerasCount() if needed
+     */
+    bool capture(std::vector<Frame>& frames);
+    
+    /**
+     * @brief Wait for the first frame of every camera after startStream()
+     *
+     * Blocks on each camera's appsink until its pipeline delivers a sample
+     * (no polling) and logs how long each camera took since startStream().
+     * @param timeout_ms Per-camera limit
+     * @return true once every camera delivered a frame
+     */
+    bool waitForFrames(std::vector<Frame>& frames, size_t timeout_ms);
+    
+    /**
+     * @brief Resize every camera; streaming cameras are rebuilt one pipeline each, in the background
+     */
     bool setFrameSize(const cv::Size& size);
     
+    /**
+     * @brief Per camera, the region of the capture-size frame to deliver; empty rect = whole frame
+     *
+     * capture() then delivers frames of the region's size (see
+     * EthernetCameraSource::setCrop); a replayed session is cropped on the GPU.
+     * Not combined with undistortion.
+     * @note Must be called before init()
+     */
+    void setCropRegions(const std::vector<cv::Rect>& regions);
+    
+    /**
+     * @brief Same decode/convert profile for every camera (see SVPipelineTuner)
+     * @note Must be called before init()
+     */
+    void setPipelineProfile(const SVPipelineProfile& profile);
+    
+    /**
+     * @brief Dual-resolution ingest: capture() delivers the init() size, one camera at a time full size
+     *
+     * Cameras with port_full in the rig receive a second stream on it;
+     * the others tee their decode (see EthernetCameraSource::setFullResolution).
+     * @note Must be called before init()
+     */
+    void setFullResolution(const cv::Size& size);
+    
+    /**
+     * @brief Enable the full-resolution stream of one camera (-1 = none), disabling the others
+     */
+    void setZoomCamera(int index);
+    int getZoomCamera() const { return zoomCamera; }
+    
+    /**
+     * @brief Full-resolution frame of the zoom camera
+     * @return false while the zoom camera has not delivered one yet or its
+     *         full-resolution stream is stale or restarting (replay never delivers)
+     */
+    bool captureFull(Frame& frame);
+    
+    /**
+     * @brief Cameras to capture on the next capture() calls; empty = all
+     *
+     * A masked camera is not copied or converted, its previous frame is kept
+     * (its pipeline keeps decoding so it can resume on any frame).
+     */
+    void setCaptureMask(const std::vector<bool>& mask) { captureMask = mask; }
+    
+    /**
+     * @brief Supervisor state of one camera, lock-free
+     */
+    EthernetCameraSource::State getCameraState(int index) const { return _cams[index]->getState(); }
+    
+    /**
+     * @brief Draw per-camera capture buffers from a shared frame pool
+     * @note Must be called before init(); without a pool a private one is used
+     */
+    void setFramePool(const std::shared_ptr<SVFramePool>& pool) { framePool = pool; }
+    
+    /**
+     * @brief Feed each camera's compressed stream into a pre-event buffer (camera i -> ring i)
+     * @note Must be called before init()
+     */
+    void setEventBuffer(const std::shared_ptr<SVEventBuffer>& buffer) { eventBuffer = buffer; }
+    
+    /**
+     * @brief Tap the compressed streams so sessions can be recorded at runtime
+     * @note Must be called before init(); adds the parser tap to every pipeline
+     */
+    void setSessionRecordingEnabled(bool enabled) { sessionTap = enabled; }
+    
+    /**
+     * @brief Record every camera's H.264 access units and the calibration to a session file
+     */
+    bool startSession(const std::string& path, const std::vector<SVSessionCalibFile>& calibration);
+    void stopSession();
+    bool isSessionRecording() const { return std::atomic_load(&sessionWriter) != nullptr; }
+    
+    /**
+     * @brief Play a recorded session instead of opening the cameras
+     * @note Call after setFrameSize() and before init(); needs one stream per rig camera
+     */
+    bool openReplay(const std::string& sessionPath, SVSessionPlayer::Options opts = SVSessionPlayer::Options());
+    bool isReplay() const { return replay != nullptr; }
+    const SVSessionReader* replaySession() const { return replay ? &replay->session() : nullptr; }
+    
     void close();
     
     // Getters matching original interface
-    const EthernetCameraSource& getCamera(int index) const { return _cams[index]; }
-    size_t getCamerasCount() const { return CAM_NUMS; }
+    const EthernetCameraSource& getCamera(int index) const { return *_cams[index]; }
+    size_t getCamerasCount() const { return _cams.size(); }
     cv::Size getFramesize() const { return frameSize; }
     const CameraUndistortData& getUndistortData(const size_t idx) const { 
         return undistFrames[idx]; 
     }
     
     bool _undistort = true;
-    std::array<cv::Mat, CAM_NUMS> Ks;  // Camera matrices
+    std::vector<cv::Mat> Ks;  // Camera matrices
     
 private:
-    // Camera sources - 4 Ethernet cameras
-    std::array<EthernetCameraSource, CAM_NUMS> _cams;
+    // Camera sources - one Ethernet camera per rig entry
+    std::vector<std::unique_ptr<EthernetCameraSource>> _cams;
     
     // Frame processing
     cv::Size frameSize;
-    std::array<InternalCameraParams, CAM_NUMS> camIparams;
-    std::array<CameraUndistortData, CAM_NUMS> undistFrames;
+    std::vector<InternalCameraParams> camIparams;
+    std::vector<CameraUndistortData> undistFrames;
+    
+    // Capture buffers (reserved once in init, reused every frame)
+    std::shared_ptr<SVFramePool> framePool;
+    std::vector<SVFramePool::Handle> rawHandles;
+    
+    std::vector<bool> captureMask;
+    std::vector<cv::Rect> crops;                // Empty or one per camera
+    
+    // Dual-resolution ingest
+    std::vector<int> fullPorts;                 // From the rig, 0 = tee
+    cv::Size fullFrameSize;
+    SVFramePool::Handle fullHandle = SVFramePool::INVALID_HANDLE;
+    int zoomCamera = -1;
+    int fullFrameCamera = -1;                   // Camera whose frame is in fullHandle
+    
+    std::shared_ptr<SVEventBuffer> eventBuffer;
+    bool sessionTap = false;
+    std::shared_ptr<SVSessionWriter> sessionWriter;     // std::atomic_load / atomic_store
+    void onAccessUnit(int cam, const uint8_t* data, size_t size, bool keyframe);
+    
+    // Session replay (replaces the cameras when open)
+    std::unique_ptr<SVSessionPlayer> replay;
+    std::vector<cv::Mat> replayFrames;
+    bool replayNext(std::vector<Frame>& frames);
+    
+    bool isCaptured(size_t idx, const Frame& frame) const;
+    
+    // Undistort (if enabled) and hand the captured frame to the caller
+    void attachFrame(size_t idx, cv::cuda::GpuMat& rawFrame, Frame& frame);
+    
+    std::chrono::steady_clock::time_point streamStart;
     
     // CUDA streams for parallel processing
-    cudaStream_t _cudaStream[CAM_NUMS];
+    std::vector<cudaStream_t> _cudaStream;
     cv::cuda::Stream cudaStreamObj;
     
-    // Camera configuration
-    struct CameraConfig {
-        std::string sourceIP;
-        int sourcePort;
-        std::string name;
-    };
-    
-    std::array<CameraConfig, CAM_NUMS> cameraConfigs;
     std::string destIP;
 };
 
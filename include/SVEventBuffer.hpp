@@ -0,0 +1,135 @@
+#ifndef SV_EVENT_BUFFER_HPP
+#define SV_EVENT_BUFFER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Fixed-size ring of H.264 access units (Annex-B, one per entry)
+ *
+ * Access units are stored back to back in a byte arena allocated once;
+ * the oldest are evicted when a new one needs the space or falls outside
+ * the time window. Every unit gets a sequence number so a reader can walk
+ * the ring while the producer keeps appending.
+ */
+class SVAccessUnitRing {
+public:
+    struct Unit {
+        uint64_t seq = 0;
+        int64_t pts_ns = 0;
+        bool keyframe = false;
+        size_t offset = 0;
+        size_t size = 0;
+    };
+
+    /**
+     * @param capacity_bytes Arena size (the whole memory budget)
+     * @param max_units Index entries (bounds the unit count independently of size)
+     * @param window_ns Units older than the newest minus this are evicted
+     */
+    SVAccessUnitRing(size_t capacity_bytes, size_t max_units, int64_t window_ns);
+
+    SVAccessUnitRing(const SVAccessUnitRing&) = delete;
+    SVAccessUnitRing& operator=(const SVAccessUnitRing&) = delete;
+
+    /**
+     * @brief Append one access unit (producer; copies under a short lock)
+     * @return false if the unit is larger than the arena (dropped)
+     */
+    bool append(const uint8_t* data, size_t size, int64_t pts_ns, bool keyframe);
+
+    /**
+     * @brief Last keyframe at or before a time, or the oldest buffered keyframe if none is that old
+     * @return UINT64_MAX if no keyframe is buffered
+     */
+    uint64_t findKeyframe(int64_t at_ns) const;
+
+    /**
+     * @brief Copy unit seq out of the ring
+     * @return false if seq is not buffered yet or was already evicted (see oldestSeq())
+     */
+    bool read(uint64_t seq, std::vector<uint8_t>& data, Unit& unit) const;
+
+    uint64_t oldestSeq() const;
+    uint64_t nextSeq() const;
+    uint64_t dropped() const { return dropped_units; }
+
+private:
+    const Unit& at(uint64_t seq) const { return units[seq % units.size()]; }
+    void evictOldest();
+
+    mutable std::mutex mutex;
+    std::vector<uint8_t> arena;
+    std::vector<Unit> units;        // Circular, indexed by seq
+    uint64_t first_seq;             // Oldest buffered
+    uint64_t next_seq;              // Next to be appended
+    size_t write_pos;               // Arena offset after the newest unit
+    int64_t window_ns;
+    std::atomic<uint64_t> dropped_units;
+};
+
+/**
+ * @brief Pre-event buffer: the last seconds of every camera's H.264 stream, flushed on demand
+ *
+ * push() receives the compressed stream straight from each camera's
+ * parser (no decode, no re-encode) into one SVAccessUnitRing per camera,
+ * so memory is fixed at init. trigger() starts a background writer that
+ * saves, per camera, everything from the keyframe that opens the
+ * pre-event window up to post_seconds after the trigger, as a raw
+ * Annex-B .h264 file (plays in ffplay/VLC, remuxes without re-encoding).
+ *
+ * The writer reads the rings by sequence number and takes each ring's
+ * lock only to copy one access unit, so capture never waits on disk.
+ */
+class SVEventBuffer {
+public:
+    struct Options {
+        std::vector<std::string> camera_names;
+        double pre_seconds = 10.0;
+        double post_seconds = 5.0;
+        size_t bytes_per_camera = 16u << 20;
+        int max_fps = 60;                   // Sizes the unit index
+        std::string folder = "events";      // One sub-folder per event
+    };
+
+    SVEventBuffer() = default;
+    ~SVEventBuffer();
+
+    SVEventBuffer(const SVEventBuffer&) = delete;
+    SVEventBuffer& operator=(const SVEventBuffer&) = delete;
+
+    /**
+     * @brief Allocate one ring per camera
+     */
+    bool init(const Options& options);
+
+    /**
+     * @brief Add one access unit of a camera (called on the camera's streaming thread)
+     */
+    void push(int camera, const uint8_t* data, size_t size, bool keyframe);
+
+    /**
+     * @brief Save the pre-event window plus post_seconds from now in the background
+     * @return false while a previous event is still being written
+     */
+    bool trigger(const std::string& label = "event");
+
+    bool isFlushing() const { return flushing; }
+    int cameraCount() const { return static_cast<int>(rings.size()); }
+
+private:
+    void writeEvent(std::string dir, int64_t event_ns);
+
+    Options opts;
+    std::vector<std::unique_ptr<SVAccessUnitRing>> rings;
+    std::thread writer;
+    std::atomic<bool> flushing{false};
+    std::atomic<bool> stopping{false};
+};
+
+#endif // SV_EVENT_BUFFER_HPP
@@ -0,0 +1,202 @@
+#ifndef SV_FRAME_BUFFER_HPP
+#define SV_FRAME_BUFFER_HPP
+
+#include <opencv2/core.hpp>
+#ifndef SV_CPU_ONLY
+#include <opencv2/core/cuda.hpp>
+#endif
+#include <cstdint>
+
+/**
+ * @brief Memory locations a frame can be resident in
+ */
+enum class SVResidency : uint8_t {
+    HOST = 0,   // Pageable host memory (cv::Mat)
+    PINNED,     // Page-locked host memory (cv::cuda::HostMem PAGE_LOCKED)
+    DEVICE,     // Device memory (cv::cuda::GpuMat)
+    MAPPED,     // Host memory mapped into device space (HostMem SHARED / GL PBO)
+    COUNT
+};
+
+const char* residencyName(SVResidency r);
+
+/**
+ * @brief Process-wide counters for every host/device transfer
+ *
+ * All copies made by SVFrameBuffer and by the counted helpers below are
+ * recorded here per (source, destination) pair, so redundant transfers show
+ * up in printSummary() instead of hiding in the frame time.
+ */
+class SVTransferStats {
+public:
+    struct Entry {
+        uint64_t count = 0;
+        uint64_t bytes = 0;
+    };
+
+    static void record(SVResidency from, SVResidency to, size_t bytes);
+    static Entry get(SVResidency from, SVResidency to);
+
+    /**
+     * @brief Transfers that cross the host/device boundary (uploads + downloads)
+     */
+    static Entry crossings();
+
+    static void reset();
+    static void printSummary();
+};
+
+/**
+ * @brief Image with explicit residency and lazy host/device migration
+ *
+ * Each location (pageable host, pinned host, device, mapped) has its own
+ * storage, allocated on first use and reused afterwards. A validity mask
+ * records which locations currently hold the latest content:
+ *
+ *  - read accessors (host(), device(), ...) migrate only if the requested
+ *    location is stale, copying from the cheapest valid location;
+ *  - write accessors (writeHost(), writeDevice(), ...) and attach*() make the
+ *    written location the only valid copy.
+ *
+ * Read accessors are const: migration only refreshes a cached copy.
+ *
+ * In a CPU-only build (SV_CPU_ONLY) every location aliases the pageable host
+ * copy, so the frame is always host-resident and nothing is ever transferred.
+ */
+class SVFrameBuffer {
+public:
+    SVFrameBuffer() = default;
+    SVFrameBuffer(cv::Size size, int type) { create(size, type); }
+
+    /**
+     * @brief Set geometry; storage for each location is allocated lazily
+     *
+     * Changing size or type drops all valid copies.
+     */
+    void create(cv::Size size, int type);
+
+    /**
+     * @brief Drop all storage and content
+     */
+    void release();
+
+    /**
+     * @brief Mark all copies as stale (storage is kept)
+     */
+    void invalidate();
+
+    bool empty() const { return valid_mask == 0; }
+    bool isValid(SVResidency r) const;
+    cv::Size size() const { syncGeometry(); return buf_size; }
+    int type() const { syncGeometry(); return buf_type; }
+    size_t byteSize() const { syncGeometry(); return buf_size.area() * CV_ELEM_SIZE(buf_type); }
+
+    // ---- Read access (migrates if the location is stale) ----
+
+    const cv::Mat& host() const;
+
+#ifndef SV_CPU_ONLY
+    const cv::cuda::GpuMat& device(cv::cuda::Stream& stream = cv::cuda::Stream::Null()) const;
+    const cv::cuda::HostMem& pinned(cv::cuda::Stream& stream = cv::cuda::Stream::Null()) const;
+
+    /**
+     * @brief Mapped copy; usable on host (createMatHeader) and device (createGpuMatHeader)
+     */
+    const cv::cuda::HostMem& mapped(cv::cuda::Stream& stream = cv::cuda::Stream::Null()) const;
+#endif
+
+    /**
+     * @brief Copy the latest content into caller-owned memory (e.g. a mapped PBO)
+     * @param dst Destination with this buffer's size and type
+     * @param dst_kind Residency of dst, used for accounting
+     */
+    void readInto(cv::Mat& dst, SVResidency dst_kind) const;
+
+    // ---- Write access (the returned location becomes the only valid copy) ----
+
+    /**
+     * @brief Overwrite on host; previous content is not preserved
+     */
+    cv::Mat& writeHost();
+
+    /**
+     * @brief Update in place on host; content is migrated first
+     *
+     * An attached external buffer is copied before it is modified.
+     */
+    cv::Mat& modifyHost();
+
+#ifndef SV_CPU_ONLY
+    cv::cuda::GpuMat& writeDevice();
+    cv::cuda::GpuMat& modifyDevice(cv::cuda::Stream& stream = cv::cuda::Stream::Null());
+    cv::cuda::HostMem& writePinned();
+    cv::cuda::HostMem& writeMapped();
+
+    /**
+     * @brief Reference an externally owned device image (no copy)
+     *
+     * Used for buffers that live in SVFramePool or are produced by a decoder.
+     * The device view becomes the only valid copy.
+     */
+    void attachDevice(const cv::cuda::GpuMat& src);
+#endif
+
+    /**
+     * @brief Reference an externally owned host image (no copy)
+     */
+    void attachHost(const cv::Mat& src);
+
+private:
+    static uint8_t bit(SVResidency r) { return static_cast<uint8_t>(1u << static_cast<uint8_t>(r)); }
+
+    void ensureGeometry(cv::Size size, int type);
+
+    /**
+     * @brief Pick up size/type changes made through a write accessor
+     */
+    void syncGeometry() const;
+
+    /**
+     * @brief Forget attached external buffers that no longer hold valid content
+     */
+    void dropStaleAttachments();
+
+#ifndef SV_CPU_ONLY
+    void migrateTo(SVResidency target, cv::cuda::Stream& stream) const;
+    cv::Mat hostView(SVResidency r) const;
+#endif
+
+    // Storage is mutable: read accessors refresh cached copies
+    mutable cv::Size buf_size;
+    mutable int buf_type = 0;
+
+    mutable cv::Mat host_mat;
+#ifndef SV_CPU_ONLY
+    mutable cv::cuda::GpuMat device_mat;
+    mutable cv::cuda::HostMem pinned_mem{cv::cuda::HostMem::PAGE_LOCKED};
+    mutable cv::cuda::HostMem mapped_mem{cv::cuda::HostMem::SHARED};
+#endif
+    mutable uint8_t valid_mask = 0;
+
+    // host_mat / device_mat reference memory owned elsewhere
+    bool host_attached = false;
+    bool device_attached = false;
+};
+
+#ifndef SV_CPU_ONLY
+/**
+ * @brief Counted download for code that has no SVFrameBuffer (gain stats, PBOs)
+ */
+void svDownload(const cv::cuda::GpuMat& src, cv::OutputArray dst,
+                SVResidency dst_kind = SVResidency::HOST,
+                cv::cuda::Stream& stream = cv::cuda::Stream::Null());
+
+/**
+ * @brief Counted upload for code that has no SVFrameBuffer (maps, masks)
+ */
+void svUpload(cv::InputArray src, cv::cuda::GpuMat& dst,
+              SVResidency src_kind = SVResidency::HOST,
+              cv::cuda::Stream& stream = cv::cuda::Stream::Null());
+#endif
+
+#endif // SV_FRAME_BUFFER_HPP
@@ -0,0 +1,176 @@
+#ifndef SV_FRAME_POOL_HPP
+#define SV_FRAME_POOL_HPP
+
+#include <opencv2/core.hpp>
+#ifndef SV_CPU_ONLY
+#include <opencv2/core/cuda.hpp>
+#endif
+#include "SVFrameBuffer.hpp"
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+
+/**
+ * @brief Allocation counter for host (cv::Mat) and device (cv::cuda::GpuMat) memory
+ *
+ * Device allocations are always 0 in a CPU-only build.
+ * install() wraps the OpenCV default allocators so that every buffer created
+ * anywhere in the process is counted. beginFrame()/endFrame() bracket one
+ * iteration of the frame loop; endFrame() returns the allocations made in
+ * between. Frees are passed straight through and are not counted.
+ */
+class SVAllocTracker {
+public:
+    struct Counts {
+        uint64_t host = 0;
+        uint64_t device = 0;
+
+        uint64_t sum() const { return host + device; }
+    };
+
+    /**
+     * @brief Install counting allocators as the OpenCV defaults (idempotent)
+     */
+    static void install();
+
+    /**
+     * @brief Restore the allocators that were active before install()
+     */
+    static void uninstall();
+
+    static bool isInstalled();
+
+    /**
+     * @brief Mark the start of a frame
+     */
+    static void beginFrame();
+
+    /**
+     * @brief Mark the end of a frame
+     * @return Allocations made since the matching beginFrame()
+     */
+    static Counts endFrame();
+
+    /**
+     * @brief Allocations made since install()
+     */
+    static Counts total();
+};
+
+/**
+ * @brief Frame-buffer arena shared by all pipeline stages
+ *
+ * Stages reserve every buffer they need during init (size and type fixed),
+ * keep the returned handle, and fetch the buffer by handle in the frame loop.
+ * Buffers are allocated once at reserve() time and reused for the lifetime
+ * of the pool, so the steady-state frame loop performs no allocations.
+ *
+ * Once frozen the layout is considered final; further reservations still
+ * work but are reported, which makes late allocations easy to spot.
+ *
+ * Reservations may come from several startup tasks at once. Lookups by
+ * handle are not locked: a stage must not fetch buffers while another
+ * thread is still reserving (the startup graph orders this).
+ */
+class SVFramePool {
+public:
+    using Handle = int;
+    static constexpr Handle INVALID_HANDLE = -1;
+
+    SVFramePool() = default;
+
+    SVFramePool(const SVFramePool&) = delete;
+    SVFramePool& operator=(const SVFramePool&) = delete;
+
+    /**
+     * @brief Reserve a residency-tracked buffer, preallocated at the given location
+     *
+     * Used by backend-neutral stages: the location is the compute backend's
+     * working residency (SVComputeBackend::residency()).
+     */
+    Handle reserveBuffer(cv::Size size, int type, SVResidency where, const std::string& label);
+
+    SVFrameBuffer& buffer(Handle h) { return buffer_slots.at(h).mat; }
+
+    /**
+     * @brief Reserve a pageable host buffer
+     */
+    Handle reserveHost(cv::Size size, int type, const std::string& label);
+
+    cv::Mat& host(Handle h) { return host_slots.at(h).mat; }
+
+#ifndef SV_CPU_ONLY
+    /**
+     * @brief Reserve a device buffer
+     * @param size Buffer size
+     * @param type OpenCV type (e.g. CV_8UC3)
+     * @param label Name used in the summary
+     * @return Handle for device()
+     */
+    Handle reserveDevice(cv::Size size, int type, const std::string& label);
+
+    /**
+     * @brief Reserve a page-locked host buffer (fast async transfers)
+     */
+    Handle reservePinned(cv::Size size, int type, const std::string& label);
+
+    /**
+     * @brief Reserve a CUDA stream owned by the pool
+     */
+    Handle reserveStream(const std::string& label);
+
+    cv::cuda::GpuMat& device(Handle h) { return device_slots.at(h).mat; }
+    cv::cuda::HostMem& pinned(Handle h) { return pinned_slots.at(h).mat; }
+    cv::cuda::Stream& stream(Handle h) { return stream_slots.at(h).stream; }
+#endif
+
+    /**
+     * @brief Mark the buffer layout as final (or reopen it for a reconfiguration)
+     */
+    void setFrozen(bool value) { frozen = value; }
+    bool isFrozen() const { return frozen; }
+
+    size_t deviceBytes() const;
+    size_t hostBytes() const;
+
+    /**
+     * @brief Print all reserved buffers and total footprint
+     */
+    void printSummary() const;
+
+private:
+    template <typename T>
+    struct Slot {
+        T mat;
+        std::string label;
+    };
+
+    struct BufferSlot {
+        SVFrameBuffer mat;
+        std::string label;
+        SVResidency where;
+    };
+
+    void noteReservation(const char* kind, const std::string& label, cv::Size size, int type) const;
+
+    std::mutex reserve_mutex;
+
+    // std::deque keeps references stable while slots are appended
+    std::deque<BufferSlot> buffer_slots;
+    std::deque<Slot<cv::Mat>> host_slots;
+#ifndef SV_CPU_ONLY
+    struct StreamSlot {
+        cv::cuda::Stream stream;
+        std::string label;
+    };
+
+    std::deque<Slot<cv::cuda::GpuMat>> device_slots;
+    std::deque<Slot<cv::cuda::HostMem>> pinned_slots;
+    std::deque<StreamSlot> stream_slots;
+#endif
+
+    bool frozen = false;
+};
+
+#endif // SV_FRAME_POOL_HPP
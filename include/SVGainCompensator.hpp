@@ -2,7 +2,9 @@
 #include <vector>
 
 #include <opencv2/stitching/detail/exposure_compensate.hpp>
+#ifndef SV_CPU_ONLY
 #include <opencv2/core/cuda.hpp>
+#endif
 
 
 class SVExposureCompensator
@@ -10,12 +12,31 @@ class SVExposureCompensator
 protected:
     size_t imgs_num = 0;
     std::vector<cv::UMat> warp, mask;
+    std::vector<const uchar*> mask_src;  // Masks behind the cached copies
     cv::Ptr<cv::detail::ExposureCompensator> compens;
+
+    /**
+     * @brief Copy host images, and masks only when a different mask is passed (CPU backend)
+     */
+    void copyInputs(const std::vector<cv::Mat>& warp_imgs, const std::vector<cv::Mat>& warp_masks);
+
+#ifndef SV_CPU_ONLY
+    /**
+     * @brief Download warped images, and masks only when a different mask is passed
+     *
+     * Blend masks are fixed after init, so re-downloading them on every
+     * recompute was a redundant full-size transfer per camera.
+     */
+    void downloadInputs(const std::vector<cv::cuda::GpuMat>& warp_imgs,
+                        const std::vector<cv::cuda::GpuMat>& warp_masks);
+#endif
 public:
     SVExposureCompensator(const size_t imgs_num_);
+#ifndef SV_CPU_ONLY
     virtual void computeGains(const std::vector<cv::Point>& corners, const std::vector<cv::cuda::GpuMat>& warp_imgs,
                       const std::vector<cv::cuda::GpuMat>& warp_masks) = 0;
     virtual bool apply_compensator(const int idx, cv::cuda::GpuMat& warp_img, cv::cuda::Stream& streamObj = cv::cuda::Stream::Null()) = 0;
+#endif
 };
 
 
@@ -23,8 +44,21 @@ class SVGainCompensator : public SVExposureCompensator
 {
 private:
     cv::Mat_<double> gains;
+
+    /**
+     * @brief Solve for the gains from the cached warp / mask copies
+     */
+    void updateGains(const std::vector<cv::Point>& corners);
 public:
     SVGainCompensator(const size_t imgs_num_, const int nr_feeds=1);
+
+    /**
+     * @brief computeGains() on host images; apply the result with gain() (CPU backend)
+     */
+    void computeGains(const std::vector<cv::Point>& corners, const std::vector<cv::Mat>& warp_imgs,
+                      const std::vector<cv::Mat>& warp_masks);
+
+#ifndef SV_CPU_ONLY
     void computeGains(const std::vector<cv::Point>& corners, const std::vector<cv::cuda::GpuMat>& warp_imgs,
                       const std::vector<cv::cuda::GpuMat>& warp_masks) override;
     bool apply_compensator(const int idx, cv::cuda::GpuMat& warp_img, cv::cuda::Stream& streamObj = cv::cuda::Stream::Null()) override;
@@ -38,10 +72,16 @@ public:
     void recompute(const std::vector<cv::cuda::GpuMat>& images,
                    const std::vector<cv::Point>& corners,
                    const std::vector<cv::cuda::GpuMat>& masks);
-};
+#endif
 
+    /**
+     * @brief Current gain for one image (1.0 before the first computeGains)
+     */
+    double gain(int idx) const { return gains.empty() ? 1.0 : gains(idx, 0); }
+};
 
 
+#ifndef SV_CPU_ONLY
 class SVGainBlocksCompensator : public SVExposureCompensator
 {
 private:
@@ -69,3 +109,4 @@ public:
                       const std::vector<cv::cuda::GpuMat>& warp_masks) override;
     bool apply_compensator(const int idx, cv::cuda::GpuMat& warp_img, cv::cuda::Stream& streamObj = cv::cuda::Stream::Null()) override;
 };
+#endif
@@ -0,0 +1,148 @@
+#ifndef SV_IPM_WARP_HPP
+#define SV_IPM_WARP_HPP
+
+#include <opencv2/core.hpp>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Intrinsics and extrinsic pose of one camera (Camparam<i>.yaml)
+ *
+ * The pose maps the vehicle ground frame to the camera: X_cam = R * X_ground + t.
+ * Ground frame: origin at the vehicle centre on the ground plane (Z = 0),
+ * X to the right, Y towards the rear, Z down (right-handed), millimetres.
+ * Points above the ground have negative Z.
+ */
+struct SVCameraCalib {
+    cv::Matx33d K;
+    cv::Mat dist;               // OpenCV distortion coefficients (empty = none)
+    cv::Matx33d R;
+    cv::Vec3d t;
+
+    /**
+     * @brief Read "Intrisic", "Rotation", "Translation" and optional "Distortion"
+     */
+    bool load(const std::string& path);
+    
+    /**
+     * @brief Rescale the intrinsics from the resolution they were calibrated at to another one
+     *
+     * Distortion acts on normalized coordinates and is unchanged.
+     */
+    void scaleIntrinsics(cv::Size from, cv::Size to);
+    
+    /**
+     * @brief Project vehicle-frame points (mm) into the image (lens distortion included)
+     * @param image_points Projected pixels, also filled for points that are not visible
+     * @param visible 1 where the point is in front of the camera, inside the field of
+     *        view the image corners cover, and inside the image; 0 elsewhere
+     * @return Number of visible points
+     */
+    int project(const std::vector<cv::Point3d>& points, cv::Size image_size,
+                std::vector<cv::Point2d>& image_points, std::vector<uchar>& visible) const;
+    
+    /**
+     * @brief How well this camera sees a visible point, 0..1
+     *
+     * Fades to 0 within edge_feather_px of the image border and prefers the
+     * camera looking most directly at the point.
+     */
+    float viewScore(const cv::Point3d& point, const cv::Point2d& pixel, cv::Size image_size,
+                    float edge_feather_px) const;
+};
+
+/**
+ * @brief Blend weights from per-camera view scores
+ *
+ * Only the two best cameras get a weight (score^4, normalized to sum 1), so
+ * seams stay narrow but fade instead of switching between neighbouring samples.
+ *
+ * @param scores n scores, 0 = camera does not see the point
+ * @param weights n weights written (all 0 if no camera sees the point)
+ * @return Number of cameras with a non-zero weight (0-2)
+ */
+int blendWeightsFromScores(const float* scores, int n, float* weights);
+
+/**
+ * @brief Metric top-down canvas shared by all cameras
+ */
+struct SVIPMCanvas {
+    cv::Size size;
+    float mm_per_px = 10.0f;
+    cv::Point2f origin;         // Canvas pixel of the ground-frame origin
+
+    /**
+     * @brief IPM_CANVAS_WIDTH x IPM_CANVAS_HEIGHT at IPM_MM_PER_PIXEL, vehicle centred
+     */
+    static SVIPMCanvas fromConfig();
+
+    /**
+     * @brief Ground point (mm) under the centre of canvas pixel (x, y)
+     */
+    cv::Point2d groundAt(int x, int y) const {
+        return cv::Point2d((x - origin.x) * mm_per_px, (y - origin.y) * mm_per_px);
+    }
+};
+
+/**
+ * @brief Build the inverse perspective map from the canvas to a raw camera image
+ *
+ * Every canvas pixel is treated as a point on the ground plane and projected
+ * into the camera (lens distortion included), so a single cv::remap of the raw
+ * frame lands it in the common canvas. No per-frame placement or resize.
+ *
+ * @param calib Camera intrinsics and pose
+ * @param canvas Target canvas
+ * @param image_size Raw image size the intrinsics refer to
+ * @param map_x, map_y CV_32F canvas-sized maps (-1 where the ground is not visible)
+ * @param valid Optional CV_8U mask, 255 where the camera sees the ground point
+ * @return Number of canvas pixels the camera covers
+ */
+int buildIPMMaps(const SVCameraCalib& calib, const SVIPMCanvas& canvas, cv::Size image_size,
+                 cv::Mat& map_x, cv::Mat& map_y, cv::Mat* valid = nullptr);
+
+/**
+ * @brief Manual four-point correspondences per camera (custom_homography_points.yaml)
+ *
+ * Source points are in full-resolution camera pixels, destination points in
+ * the bird's-eye image of the frame scaled by scale_factor.
+ */
+struct SVHomographyPoints {
+    float scale_factor = 0.0f;                      // 0 if the file does not store it
+    std::vector<std::vector<cv::Point2f>> src;      // Perspective view
+    std::vector<std::vector<cv::Point2f>> dst;      // Bird's-eye view
+
+    /**
+     * @brief Read the points of num_cameras cameras
+     * @return false if the file is missing or was saved for another camera count
+     */
+    bool load(const std::string& path, int num_cameras);
+
+    /**
+     * @brief Homography from bird's-eye pixels to pixels of the frame scaled by scale
+     */
+    cv::Matx33d homography(int camera, float scale) const;
+};
+
+/**
+ * @brief Build the remap of a bird's-eye image from a perspective image
+ * @param H Homography from output pixels to source pixels
+ * @param map_x, map_y CV_32F maps of output_size (-1 where H has no finite image)
+ */
+void buildHomographyMaps(const cv::Matx33d& H, cv::Size output_size, cv::Mat& map_x, cv::Mat& map_y);
+
+/**
+ * @brief Source pixels a remap with these maps reads (bilinear neighbours included)
+ * @param source_size Size of the image the maps index; samples outside it read the border
+ * @param valid Optional CV_8U mask of the map size; output pixels at 0 are not needed
+ * @return Empty if no needed output pixel reads the source
+ */
+cv::Rect warpSourceBounds(const cv::Mat& map_x, const cv::Mat& map_y, cv::Size source_size,
+                          const cv::Mat& valid = cv::Mat());
+
+/**
+ * @brief Re-target maps to a source cropped at origin (pixels outside the crop read the border)
+ */
+void offsetWarpMaps(cv::Mat& map_x, cv::Mat& map_y, cv::Point2f origin);
+
+#endif // SV_IPM_WARP_HPP
@@ -0,0 +1,65 @@
+#ifndef SV_PIPELINE_PROFILE_HPP
+#define SV_PIPELINE_PROFILE_HPP
+
+#include <opencv2/core.hpp>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Decode and conversion stages of a camera pipeline
+ *
+ * A camera pipeline is
+ *
+ *   <RTP source> ! h264parse ! <decoder> ! <scaler> ! <scaled_caps>,width,height
+ *                [! videocrop] ! <converter> ! video/x-raw,format=<format> ! appsink
+ *
+ * The defaults are the Jetson chain (hardware decode, NVMM scaling, crop by
+ * the converter). SVPipelineTuner measures the built-in candidates on the
+ * target and saves the fastest per platform (save() / load()).
+ */
+struct SVPipelineProfile {
+    std::string name = "jetson-nvv4l2";
+    std::string decoder = "nvv4l2decoder enable-max-performance=1";
+    std::string scaler = "nvvidconv";
+    std::string scaled_caps = "video/x-raw(memory:NVMM),format=RGBA";
+    std::string converter = "nvvidconv";
+    std::string format = "BGRx";            // BGRx or BGR, what the appsink delivers
+    bool converter_crops = true;            // Converter takes a source rectangle; otherwise videocrop
+    int sink_buffers = 1;                   // appsink max-buffers (older ones are dropped)
+
+    /**
+     * @brief Everything after the decoder: scale to size, optional crop of the scaled frame, appsink
+     */
+    std::string sinkChain(const cv::Size& size, const char* sinkName, const cv::Rect& crop = cv::Rect()) const;
+
+    /**
+     * @brief GStreamer element factories the profile needs
+     */
+    std::vector<std::string> elements() const;
+
+    /**
+     * @brief Camera RTP/H.264 stream up to the depayloader (no trailing link)
+     */
+    static std::string rtpSource(const std::string& address, int port);
+
+    bool load(const std::string& path);
+
+    /**
+     * @param measured Written along for reference (e.g. latency_ms), not read back
+     */
+    bool save(const std::string& path,
+              const std::vector<std::pair<std::string, double>>& measured = {}) const;
+
+    /**
+     * @brief Built-in candidates for SVPipelineTuner, the default first
+     */
+    static std::vector<SVPipelineProfile> candidates();
+
+    /**
+     * @brief Board or CPU model, e.g. "nvidia_jetson_agx_orin_developer_kit"
+     */
+    static std::string platformId();
+};
+
+#endif // SV_PIPELINE_PROFILE_HPP
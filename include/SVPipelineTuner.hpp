@@ -0,0 +1,85 @@
+#ifndef SV_PIPELINE_TUNER_HPP
+#define SV_PIPELINE_TUNER_HPP
+
+#include "SVPipelineProfile.hpp"
+#include "SVSession.hpp"
+#include <opencv2/core.hpp>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+typedef struct _GstElement GstElement;
+
+/**
+ * @brief Picks the camera pipeline profile with the lowest decode latency on this machine
+ *
+ * Each candidate whose elements are installed runs as a real camera pipeline
+ * (same string the camera builds) against one camera's stream: live RTP, or
+ * one camera of a session file fed at recorded speed. After a warm-up it
+ * measures for measure_seconds:
+ *
+ *   latency   parser output -> appsink, matched by buffer PTS (median, p95)
+ *   CPU       process CPU time over wall time (100 = one core)
+ *   drops     access units in without a frame out
+ *
+ * Meant for calibration time, before the cameras are opened: a live
+ * camera's port must be free, and the process CPU time only counts the
+ * candidate while nothing else runs.
+ */
+class SVPipelineTuner {
+public:
+    struct Options {
+        cv::Size output_size = cv::Size(1280, 800);
+        double warmup_seconds = 1.0;        // Caps negotiation, first keyframe; not measured
+        double measure_seconds = 3.0;
+        double max_drop_rate = 0.02;        // Candidates dropping more are never picked
+    };
+
+    struct Result {
+        SVPipelineProfile profile;
+        bool ran = false;
+        std::string error;
+        uint64_t units_in = 0;
+        uint64_t frames_out = 0;
+        double latency_ms = 0.0;            // Median
+        double latency_p95_ms = 0.0;
+        double cpu_percent = 0.0;
+        double drop_rate = 0.0;
+    };
+
+    SVPipelineTuner() = default;
+
+    SVPipelineTuner(const SVPipelineTuner&) = delete;
+    SVPipelineTuner& operator=(const SVPipelineTuner&) = delete;
+
+    void setLiveSource(const std::string& address, int port);
+    bool setSessionSource(const std::string& path, int camera);
+
+    /**
+     * @brief Measure every candidate in turn, printing one line each
+     */
+    std::vector<Result> run(const std::vector<SVPipelineProfile>& candidates, const Options& options);
+    Result measure(const SVPipelineProfile& profile, const Options& options);
+
+    /**
+     * @brief Lowest median latency within max_drop_rate; within 10% of it, the lowest CPU
+     * @return nullptr if no candidate delivered frames
+     */
+    static const Result* best(const std::vector<Result>& results, double max_drop_rate);
+
+    /**
+     * @param missing First element factory not installed
+     */
+    static bool available(const SVPipelineProfile& profile, std::string* missing = nullptr);
+
+private:
+    void feedSession(GstElement* appsrc, const std::atomic<bool>& stop);
+
+    std::string address;
+    int port = 0;
+    SVSessionReader reader;
+    int session_camera = -1;                // >= 0: session source
+};
+
+#endif // SV_PIPELINE_TUNER_HPP
@@ -8,13 +8,18 @@
 #include <memory>
 #include <string>
 #include <array>
+#include <vector>
 #include "SVConfig.hpp"
+#include "SVFrameBuffer.hpp"
+#include "SVCameraRig.hpp"
+#include "SVIPMWarp.hpp"
 
 
 // Forward declarations to avoid full includes
 class OGLShader;
 class Model;
 class Shader;
+class SVBowlView;
 
 /**
  * @brief Simple fixed-view camera
@@ -36,18 +41,29 @@ struct Camera {
 };
 
 /**
- * @brief Simplified 4-Camera Display Renderer
+ * @brief Simplified Multi-Camera Display Renderer
  * 
  * Layout:
  *     [Front Camera]
  * [Left] [Car] [Right]
  *     [Rear Camera]
+ * 
+ * Cameras are assigned to a side by yaw (front 315°-45°, left 45°-135°,
+ * rear 135°-225°, right 225°-315°). A side with several cameras is split
+ * evenly between them in the order they appear around the vehicle, so the
+ * 4-camera rig gets exactly the layouts above.
  */
 class SVRenderSimple {
 public:
     SVRenderSimple(int width, int height);
     ~SVRenderSimple();
     
+    /**
+     * @brief Use a camera rig other than SVCameraRig::defaultRig()
+     * @note Must be called before init(); sets camera count, side layout and display flips
+     */
+    void setCameraRig(const SVCameraRig& rig);
+    
     /**
      * @brief Initialize renderer
      * @param car_model_path Path to 3D car model (.obj)
@@ -60,37 +76,63 @@ public:
               const std::string& car_frag_shader);
     
     /**
-     * @brief Render frame with 4 camera views around car
-     * @param camera_frames Array of 4 camera frames [Front, Left, Rear, Right]
+     * @brief Render frame with all camera views around car
+     * @param camera_frames One frame per rig camera, in rig order
      * @return true if successful
      */
-    bool render(const std::array<cv::cuda::GpuMat, 4>& camera_frames);
+    bool render(const std::vector<cv::cuda::GpuMat>& camera_frames);
+    
+    /**
+     * @brief Build the 3D bowl view from the camera calibration (see SVBowlView)
+     * @param calibs One calibration per rig camera
+     * @param image_size Raw camera frame size
+     * @note Call after init(); the bowl replaces the right half of the split layout while visible
+     */
+    bool initBowlView(const std::vector<SVCameraCalib>& calibs, cv::Size image_size);
+    bool hasBowlView() const;
+    void setBowlViewVisible(bool visible) { show_bowl = visible; }
+    bool isBowlViewVisible() const { return show_bowl; }
     
     /**
      * @brief Check if window should close
      */
     bool shouldClose() const;
     
+    /**
+     * @brief Copy every rendered frame into a pair of pixel-pack buffers (for recording)
+     * @note The read-back size is the framebuffer size when enabled
+     */
+    void setReadBackEnabled(bool enabled);
+    bool isReadBackEnabled() const { return readback_enabled; }
+    cv::Size readBackSize() const { return readback_size; }
+    
+    /**
+     * @brief Fetch the previous frame's read-back (one frame behind, so the copy never stalls)
+     * @param bgr Filled bottom-up (OpenGL row order), CV_8UC3 of readBackSize()
+     * @return false until two frames have been read back
+     */
+    bool readBackFrame(cv::Mat& bgr);
+    
     #ifdef EN_RENDER_STITCH
         /**
          * @brief Render split-screen view (50% normal + 50% stitched)
-         * @param camera_frames Array of 4 camera frames (warped)
+         * @param camera_frames One frame per rig camera (warped)
          * @param stitched_frame Stitched output frame
          * @return true if successful
          */
-        bool renderSplitScreen(const std::array<cv::cuda::GpuMat, 4>& camera_frames,
+        bool renderSplitScreen(const std::vector<cv::cuda::GpuMat>& camera_frames,
                             const cv::cuda::GpuMat& stitched_frame);
         
         /**
-         * @brief Render split-viewport layout (left half: 3D car + 4 viewports, right half: stitched/black)
-         * @param camera_frames Array of 4 camera frames (warped)
+         * @brief Render split-viewport layout (left half: 3D car + camera viewports, right half: stitched/black)
+         * @param camera_frames One frame per rig camera (warped)
          * @param show_right Whether to show stitched output on right half
-         * @param stitched_frame Optional stitched frame (nullptr = black screen)
+         * @param stitched_frame Optional stitched frame (nullptr = black screen), host or device resident
          * @return true if successful
          */
-        bool renderSplitViewportLayout(const std::array<cv::cuda::GpuMat, 4>& camera_frames,
+        bool renderSplitViewportLayout(const std::vector<cv::cuda::GpuMat>& camera_frames,
                                        bool show_right = false,
-                                       const cv::cuda::GpuMat* stitched_frame = nullptr);
+                                       const SVFrameBuffer* stitched_frame = nullptr);
         
         /**
          * @brief Get GLFW window pointer (for keyboard input)
@@ -99,20 +141,47 @@ public:
     #endif
 
 private:
+    // Screen sides camera viewports are grouped on
+    enum ViewSide { SIDE_FRONT = 0, SIDE_LEFT, SIDE_REAR, SIDE_RIGHT, SIDE_COUNT };
+    
+    // Display flip/rotation remap for one camera (built on first frame)
+    struct DisplayMap {
+        cv::cuda::GpuMat map_x;
+        cv::cuda::GpuMat map_y;
+        cv::cuda::GpuMat processed;
+        cv::Size frame_size;
+    };
+    
     void setupQuad();
     void setupCarModel(const std::string& model_path,
                        const std::string& vert_shader,
                        const std::string& frag_shader);
     void createTextureShader();
-    void uploadTexture(const cv::cuda::GpuMat& frame, unsigned int texture_id);
+    void uploadTexture(const cv::cuda::GpuMat& frame, int cam_idx);
+    void buildDisplayMap(int cam_idx, const cv::Size& frame_size);
+    void queueReadBack();
+    
+    /**
+     * @brief Region of slot k of n on one side (front/rear split across, left/right split down)
+     * @param y_up Region is in OpenGL window coordinates (origin bottom-left)
+     */
+    static cv::Rect sideSlot(const cv::Rect& region, int side, int k, int n, bool y_up);
+    
+    /**
+     * @brief Upload raw frames and draw the bowl into a GL viewport region
+     */
+    void drawBowlView(const std::vector<cv::cuda::GpuMat>& raw_frames, int x, int y, int w, int h);
     #ifdef RENDER_NOPRESERVE_AS
     void drawCameraView(unsigned int texture_id, int x, int y, int w, int h);
+    void drawSideViewsStretched(const std::array<cv::Rect, SIDE_COUNT>& regions);
     #endif
     #ifdef RENDER_PRESERVE_AS
     void drawCameraViewWithAspect(GLuint texture, 
                                    int region_x, int region_y, 
                                    int region_w, int region_h,
                                    float texture_aspect);
+    void drawSideViews(const std::array<cv::Rect, SIDE_COUNT>& regions,
+                       const std::array<float, SIDE_COUNT>& aspects);
     #endif
     
     // Window
@@ -133,9 +202,29 @@ private:
     unsigned int quad_VBO;
     OGLShader* texture_shader;
     
-    // Camera textures (Front, Left, Rear, Right)
-    std::array<unsigned int, 4> camera_textures;
-    std::array<unsigned int, 4> camera_pbos;
+    // Camera rig and per-camera textures (rig order)
+    SVCameraRig rig;
+    std::vector<unsigned int> camera_textures;
+    std::vector<unsigned int> camera_pbos;
+    std::vector<DisplayMap> display_maps;
+    
+    // Camera indices per side, in on-screen order
+    std::array<std::vector<int>, SIDE_COUNT> side_cameras;
+    
+    // 3D bowl view (optional, baked from calibration)
+    std::unique_ptr<SVBowlView> bowl_view;
+    bool show_bowl;
+    
+    // Stitched view texture (reused every frame; host staging lives in the SVFrameBuffer)
+    unsigned int stitched_texture;
+    cv::Size stitched_texture_size;
+    
+    // Frame read-back: glReadPixels into one PBO while the other is mapped
+    bool readback_enabled;
+    cv::Size readback_size;
+    std::array<unsigned int, 2> readback_pbos;
+    std::array<bool, 2> readback_filled;
+    int readback_index;
     
     // Camera frame dimensions (may be scaled)
     int camera_frame_width;
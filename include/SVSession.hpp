@@ -0,0 +1,201 @@
+#ifndef SV_SESSION_HPP
+#define SV_SESSION_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Multi-camera session file (.svs): compressed camera streams plus calibration
+ *
+ * Layout (little-endian):
+ *
+ *   header   "SVSESS01", camera names, calibration files (name + bytes)
+ *   records  one per access unit: camera, flags, seq, capture time, Annex-B payload
+ *   index    per camera, in capture order: time, file offset, seq, size, flags
+ *   trailer  index offset, "SVINDEX1"
+ *
+ * Records are written as they arrive, the index only on close(). A file
+ * without a trailer (recording interrupted) is still readable: the reader
+ * rebuilds the index by scanning the records.
+ */
+struct SVSessionCalibFile {
+    std::string name;               // File name only (e.g. Camparam0.yaml)
+    std::string data;
+};
+
+/**
+ * @brief Records access units from several camera threads into a session file
+ *
+ * append() only queues the unit; a writer thread does the file I/O. When
+ * more than max_queue_bytes are waiting the unit is dropped and counted,
+ * so a slow disk never stalls the camera pipelines. Sequence numbers are
+ * per camera and also advance for dropped units, so gaps stay visible.
+ */
+class SVSessionWriter {
+public:
+    struct Stats {
+        uint64_t units = 0;
+        uint64_t bytes = 0;
+        uint64_t dropped = 0;
+    };
+
+    SVSessionWriter() = default;
+    ~SVSessionWriter();
+
+    SVSessionWriter(const SVSessionWriter&) = delete;
+    SVSessionWriter& operator=(const SVSessionWriter&) = delete;
+
+    bool open(const std::string& path,
+              const std::vector<std::string>& camera_names,
+              const std::vector<SVSessionCalibFile>& calibration,
+              size_t max_queue_bytes = 64u << 20);
+
+    /**
+     * @brief Queue one access unit (any thread, never blocks on I/O)
+     * @param pts_ns Capture time (steady clock); must not decrease per camera
+     */
+    bool append(int camera, const uint8_t* data, size_t size, int64_t pts_ns, bool keyframe);
+
+    /**
+     * @brief Write what is queued, then the index, and close the file
+     */
+    void close();
+
+    bool isOpen() const { return file != nullptr; }
+    Stats stats() const;
+    const std::string& path() const { return file_path; }
+
+    /**
+     * @brief Read calibration files of a folder for open()
+     * @param patterns fnmatch patterns (e.g. "Camparam*.yaml")
+     */
+    static std::vector<SVSessionCalibFile> readCalibFolder(const std::string& folder,
+                                                           const std::vector<std::string>& patterns);
+
+private:
+    struct Pending {
+        int camera;
+        uint64_t seq;
+        int64_t pts_ns;
+        bool keyframe;
+        std::vector<uint8_t> data;
+    };
+
+    struct IndexEntry {
+        int64_t pts_ns;
+        uint64_t offset;
+        uint64_t seq;
+        uint32_t size;
+        uint32_t flags;
+    };
+
+    void writerLoop();
+
+    FILE* file = nullptr;
+    std::string file_path;
+    uint64_t file_offset = 0;
+    std::vector<std::vector<IndexEntry>> index;     // Writer thread only
+
+    std::mutex mutex;
+    std::condition_variable queued;
+    std::deque<Pending> queue;
+    size_t queue_bytes = 0;
+    size_t max_queue_bytes = 0;
+    std::vector<uint64_t> next_seq;
+    bool closing = false;
+    std::thread writer;
+
+    std::atomic<uint64_t> written_units{0};
+    std::atomic<uint64_t> written_bytes{0};
+    std::atomic<uint64_t> dropped_units{0};
+};
+
+/**
+ * @brief Memory-mapped read access to a session file
+ *
+ * Access units are returned as pointers into the mapping (no copies).
+ * Seeking by time is a binary search over the per-camera index.
+ */
+class SVSessionReader {
+public:
+    struct Unit {
+        const uint8_t* data = nullptr;
+        size_t size = 0;
+        int64_t pts_ns = 0;
+        uint64_t seq = 0;
+        bool keyframe = false;
+    };
+
+    static constexpr size_t NO_UNIT = static_cast<size_t>(-1);
+
+    SVSessionReader() = default;
+    ~SVSessionReader();
+
+    SVSessionReader(const SVSessionReader&) = delete;
+    SVSessionReader& operator=(const SVSessionReader&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return base != nullptr; }
+
+    int cameraCount() const { return static_cast<int>(camera_names.size()); }
+    const std::string& cameraName(int camera) const { return camera_names[camera]; }
+    const std::vector<SVSessionCalibFile>& calibration() const { return calib_files; }
+
+    /**
+     * @brief Write the stored calibration files into a folder (created if needed)
+     * @return false if a file could not be written or its name has a path separator or ".."
+     */
+    bool writeCalibration(const std::string& folder) const;
+
+    size_t unitCount(int camera) const { return index[camera].size(); }
+    Unit unit(int camera, size_t k) const;
+
+    /**
+     * @brief Last unit captured at or before t (NO_UNIT if t is before the first), O(log n)
+     */
+    size_t findUnit(int camera, int64_t t_ns) const;
+
+    /**
+     * @brief Last keyframe at or before t (first keyframe if none is that early), O(log n)
+     */
+    size_t findKeyframe(int camera, int64_t t_ns) const;
+
+    /**
+     * @brief Capture time span over all cameras
+     */
+    int64_t startNs() const { return start_ns; }
+    int64_t endNs() const { return end_ns; }
+
+private:
+    struct IndexEntry {
+        int64_t pts_ns;
+        uint64_t offset;        // Payload offset
+        uint64_t seq;
+        uint32_t size;
+        bool keyframe;
+    };
+
+    bool readHeader(size_t& pos);
+    bool readIndex(uint64_t index_offset);
+    bool scanRecords(size_t pos);
+
+    const uint8_t* base = nullptr;
+    size_t length = 0;
+
+    std::vector<std::string> camera_names;
+    std::vector<SVSessionCalibFile> calib_files;
+    std::vector<std::vector<IndexEntry>> index;
+    std::vector<std::vector<size_t>> keyframes;     // Positions in index, per camera
+    int64_t start_ns = 0;
+    int64_t end_ns = 0;
+};
+
+#endif // SV_SESSION_HPP
@@ -0,0 +1,217 @@
+#ifndef SV_SESSION_MANAGER_HPP
+#define SV_SESSION_MANAGER_HPP
+
+#include <opencv2/core.hpp>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "SVCameraRig.hpp"
+#include "SVComputeBackend.hpp"
+#include "SVThreadPool.hpp"
+
+class SVStitcherAuto;
+
+/**
+ * @brief Everything derived from one calibration: warp maps and a prepared stitcher
+ *
+ * Immutable once built and shared by every session whose calibration,
+ * frame sizes and warp settings hash to the same key.
+ */
+struct SVStitchAssets {
+    uint64_t key = 0;
+    bool ipm = false;
+    std::vector<cv::Size> image_sizes;      // Decoded frame size per camera
+    std::vector<cv::Size> scaled_sizes;     // Homography: input to the warp
+    std::vector<cv::Mat> map_x;
+    std::vector<cv::Mat> map_y;
+    std::vector<cv::Mat> valid;             // IPM: canvas pixels each camera sees
+    SVCameraRig rig;                        // Layout the stitcher uses
+    std::shared_ptr<SVStitcherAuto> prepared;   // Masks and tile plan; lanes use initShared()
+    size_t bytes = 0;                       // Warp maps and valid masks
+
+    /**
+     * @brief Warp one frame set (backend-native arrays) into warped, scaled is scratch
+     */
+    void warp(SVComputeBackend& backend, const std::vector<cv::Mat>& frames,
+              std::vector<cv::Mat>& scaled, std::vector<SVFrameBuffer>& warped) const;
+};
+
+/**
+ * @brief Runs many recorded sessions through independent stitch pipelines in one process
+ *
+ * Up to max_sessions runner threads each take a job (one .svs session),
+ * decode it (SVSessionPlayer) and feed a set of lanes, one per frame in
+ * flight, each with its own buffers and stitcher. What is shared:
+ *
+ *  - one SVThreadPool runs the warp/stitch tasks of every session;
+ *  - warp maps, blend masks and tile plans are built once per calibration
+ *    hash (calibration files + frame sizes + warp settings + rig) and
+ *    shared while any session uses them;
+ *  - frames in flight are limited process-wide and handed out fairly: a
+ *    free slot goes to the waiting session with the fewest frames in
+ *    flight, then the one served longest ago, so a fast decoder cannot
+ *    starve the others.
+ *
+ * Each session's lanes are limited by session_memory_cap. Results are
+ * written in frame order (video through SVVideoOutput, or an image
+ * sequence). metrics() aggregates over all sessions.
+ */
+class SVSessionManager {
+public:
+    struct Options {
+        int max_sessions = 4;                       // Sessions decoded concurrently
+        int max_frames_in_flight = 0;               // All sessions together, 0 = 2 x pool workers
+        int max_lanes_per_session = 0;              // 0 = max_frames_in_flight
+        size_t session_memory_cap = 512u << 20;     // Lane buffers per session (decoders not counted)
+        std::string decoder = "avdec_h264 max-threads=1";
+        std::string encoder = "x264enc speed-preset=medium bitrate=8000";
+        int fps = 30;                               // Output video frame rate
+        std::string warp;                           // "homography", "ipm" or empty = from the calibration
+        float scale = 0.0f;                         // Homography scale, 0 = saved scale_factor
+    };
+
+    struct Job {
+        std::string session_path;
+        std::string calib_folder;                   // Empty = extract the session's own next to the output
+        std::string output;                         // Video file (.mkv/.mp4), or folder with image_ext
+        std::string image_ext;                      // "jpg" / "png" = image sequence
+        int64_t max_frames = -1;
+    };
+
+    enum class State { QUEUED, RUNNING, DONE, FAILED };
+
+    struct SessionStats {
+        int id = 0;
+        std::string path;
+        State state = State::QUEUED;
+        uint64_t frames = 0;
+        uint64_t failed_frames = 0;
+        int lanes = 0;
+        size_t lane_bytes = 0;                      // Memory of one lane
+        uint64_t asset_key = 0;
+        bool shared_assets = false;                 // Assets came from the cache
+        double seconds = 0.0;
+        double recorded_seconds = 0.0;
+    };
+
+    struct Metrics {
+        int queued = 0;
+        int running = 0;
+        int done = 0;
+        int failed = 0;
+        uint64_t frames = 0;
+        double fps = 0.0;                           // All sessions, since the first one started
+        int frames_in_flight = 0;
+        size_t lane_bytes = 0;                      // Lanes of running sessions
+        int assets_cached = 0;                      // Distinct calibrations in use
+        size_t asset_bytes = 0;
+        uint64_t asset_hits = 0;
+        uint64_t asset_misses = 0;
+    };
+
+    explicit SVSessionManager(const Options& options, SVThreadPool& pool = SVThreadPool::instance());
+
+    /**
+     * @brief Finishes queued sessions, then stops the runner threads
+     */
+    ~SVSessionManager();
+
+    SVSessionManager(const SVSessionManager&) = delete;
+    SVSessionManager& operator=(const SVSessionManager&) = delete;
+
+    /**
+     * @brief Queue a session; it starts as soon as fewer than max_sessions run
+     * @return Session id
+     */
+    int submit(const Job& job);
+
+    /**
+     * @brief Block until every submitted session has finished
+     * @return Number of failed sessions
+     */
+    int waitAll();
+
+    /**
+     * @brief Wait at most timeout for every submitted session to finish
+     * @return true if none is queued or running
+     */
+    bool waitFor(std::chrono::milliseconds timeout);
+
+    Metrics metrics() const;
+    std::vector<SessionStats> sessions() const;
+    void printSummary() const;
+
+private:
+    struct Session;
+
+    // Process-wide frames-in-flight limit with fair hand-out
+    class FairGate {
+    public:
+        void setLimit(int limit) { max_in_flight = limit; }
+        void acquire(int session);
+        void release(int session);
+        int inFlight() const;
+        int limit() const { return max_in_flight; }
+
+    private:
+        struct Waiter {
+            int in_flight = 0;
+            uint64_t last_grant = 0;
+            bool waiting = false;
+        };
+
+        mutable std::mutex mutex;
+        std::condition_variable freed;
+        std::map<int, Waiter> sessions;
+        int total = 0;
+        int max_in_flight = 1;
+        uint64_t ticks = 0;
+    };
+
+    void runnerLoop();
+    bool runSession(Session& session);
+    std::shared_ptr<const SVStitchAssets> acquireAssets(const std::string& calib_folder, const SVCameraRig& rig,
+                                                        const std::vector<cv::Mat>& first_frames,
+                                                        bool& cache_hit);
+    bool buildAssets(const std::string& calib_folder, const SVCameraRig& rig,
+                     const std::vector<cv::Mat>& first_frames, SVStitchAssets& assets);
+
+    Options opts;
+    SVThreadPool& pool;
+    std::shared_ptr<SVComputeBackend> backend;
+    FairGate gate;
+
+    // Jobs and session state
+    mutable std::mutex mutex;
+    std::condition_variable changed;
+    std::deque<int> queue;
+    std::vector<std::unique_ptr<Session>> all_sessions;
+    std::vector<std::thread> runners;
+    int unfinished = 0;
+    bool stopping = false;
+    std::chrono::steady_clock::time_point first_start;
+    bool started = false;
+
+    // Calibration hash -> assets, kept while a session uses them
+    struct AssetSlot {
+        std::mutex build;                   // Held while the assets are built
+        std::weak_ptr<const SVStitchAssets> assets;
+        size_t bytes = 0;
+    };
+    mutable std::mutex assets_mutex;
+    std::map<uint64_t, std::shared_ptr<AssetSlot>> asset_cache;
+    std::atomic<uint64_t> asset_hits{0};
+    std::atomic<uint64_t> asset_misses{0};
+
+    std::atomic<uint64_t> total_frames{0};
+};
+
+#endif // SV_SESSION_MANAGER_HPP
@@ -0,0 +1,88 @@
+#ifndef SV_SESSION_PLAYER_HPP
+#define SV_SESSION_PLAYER_HPP
+
+#include <opencv2/core.hpp>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "SVSession.hpp"
+
+typedef struct _GstElement GstElement;
+typedef struct _GstSample GstSample;
+
+/**
+ * @brief Synchronized playback of a session file (SVSessionReader + one decoder per camera)
+ *
+ * Camera 0 sets the timeline: every next() takes its next access unit's
+ * capture time t and returns, for each camera, the last frame captured
+ * at or before t (plus a small tolerance). Each camera's decoder is
+ *
+ *   appsrc ! h264parse ! <decoder> ! videoconvert [! videoscale] ! BGR appsink
+ *
+ * fed straight from the memory-mapped file. seek() restarts the decoders
+ * at the keyframe before the target time, found by binary search.
+ */
+class SVSessionPlayer {
+public:
+    struct Options {
+        // Must output one frame per access unit (no frame threading)
+        std::string decoder = "avdec_h264 max-threads=1";
+        cv::Size output_size;               // Empty = recorded size
+        bool realtime = true;               // Pace next() to the recorded capture times
+        bool loop = true;                   // Restart at the end instead of returning false
+        int64_t sync_tolerance_ns = 20000000;
+    };
+
+    SVSessionPlayer() = default;
+    ~SVSessionPlayer();
+
+    SVSessionPlayer(const SVSessionPlayer&) = delete;
+    SVSessionPlayer& operator=(const SVSessionPlayer&) = delete;
+
+    bool open(const std::string& path, const Options& options);
+    void close();
+
+    const SVSessionReader& session() const { return reader; }
+    int cameraCount() const { return reader.cameraCount(); }
+
+    /**
+     * @brief Decode the next synchronized frame set
+     * @param frames One BGR frame per camera (empty until that camera's first keyframe)
+     * @param pts_ns Capture time of the set
+     * @return false at the end of the session (loop off) or on decoder failure
+     */
+    bool next(std::vector<cv::Mat>& frames, int64_t& pts_ns);
+
+    /**
+     * @brief Continue playback from a capture time
+     */
+    bool seek(int64_t t_ns);
+
+private:
+    struct Decoder {
+        GstElement* pipeline = nullptr;
+        GstElement* appsrc = nullptr;
+        GstElement* appsink = nullptr;
+        size_t next_unit = 0;               // Next access unit to feed
+        int64_t fed_pts = INT64_MIN;        // Capture time of the last unit fed
+        int64_t latest_pts = INT64_MIN;     // Capture time of the latest decoded frame
+        GstSample* latest = nullptr;
+    };
+
+    bool startDecoder(Decoder& dec, int camera);
+    void stopDecoder(Decoder& dec);
+    bool feedUntil(Decoder& dec, int camera, int64_t t_ns);
+    void collectDecoded(Decoder& dec, int camera);
+    bool copyFrame(GstSample* sample, cv::Mat& frame) const;
+
+    SVSessionReader reader;
+    Options opts;
+    std::vector<Decoder> decoders;
+    size_t master_unit = 0;                 // Next unit of camera 0
+
+    std::chrono::steady_clock::time_point wall_start;
+    int64_t pts_start = 0;
+};
+
+#endif // SV_SESSION_PLAYER_HPP
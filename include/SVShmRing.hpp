@@ -0,0 +1,140 @@
+#ifndef SV_SHM_RING_HPP
+#define SV_SHM_RING_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Frame formats carried by a shared-memory ring
+ */
+enum class SVShmFormat : uint32_t {
+    BGR8 = 1,
+    GRAY8 = 2
+};
+
+/**
+ * @brief Per-frame metadata stored next to each slot's pixels
+ */
+struct SVShmFrameInfo {
+    uint64_t seq = 0;               // Publisher sequence (1, 2, ...); set by commitFrame()
+    int64_t timestamp_ns = 0;       // Capture time, CLOCK_MONOTONIC
+    uint64_t calib_id = 0;          // Changes whenever the calibration is reloaded
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t stride = 0;            // Bytes per row
+    SVShmFormat format = SVShmFormat::BGR8;
+    int32_t source = -1;            // Camera index, -1 = stitched canvas
+};
+
+/**
+ * @brief Writer side of a POSIX shared-memory frame ring (/dev/shm/<name>)
+ *
+ * A fixed number of slots, each a small header plus room for one frame.
+ * Frame n goes to slot n % slots. Each slot carries its own sequence
+ * number, cleared while the slot is being written and set on commit
+ * (a per-slot seqlock), so readers never take a lock and never block the
+ * publisher. With N slots a reader has N-1 frame periods to use a frame
+ * in place before it is overwritten.
+ *
+ * No OpenCV dependency: consumer processes only link sv_shm.
+ */
+class SVShmPublisher {
+public:
+    SVShmPublisher() = default;
+    ~SVShmPublisher();
+
+    SVShmPublisher(const SVShmPublisher&) = delete;
+    SVShmPublisher& operator=(const SVShmPublisher&) = delete;
+
+    /**
+     * @brief Create (or replace) the shared-memory object
+     * @param name Object name, e.g. "sv_stitched" (a leading '/' is added)
+     * @param max_frame_bytes Largest frame that will be published
+     */
+    bool create(const std::string& name, size_t max_frame_bytes, int slots = 4);
+
+    /**
+     * @brief Mark the ring as closed for readers and remove the object
+     */
+    void close();
+
+    /**
+     * @brief Pixels of the next slot, to be filled in place (e.g. by a GPU download)
+     */
+    uint8_t* beginFrame();
+
+    /**
+     * @brief Publish the slot returned by beginFrame()
+     */
+    void commitFrame(SVShmFrameInfo info);
+
+    /**
+     * @brief Copy a frame (rows of row_bytes, source stride src_stride) and publish it
+     */
+    bool publish(const uint8_t* data, size_t src_stride, SVShmFrameInfo info);
+
+    bool isOpen() const { return base != nullptr; }
+    size_t maxFrameBytes() const { return max_bytes; }
+
+private:
+    std::string shm_name;
+    uint8_t* base = nullptr;
+    size_t mapped_bytes = 0;
+    size_t max_bytes = 0;
+    uint64_t next_seq = 1;
+};
+
+/**
+ * @brief Reader side: the latest frame of a ring, read in place
+ *
+ * latest() returns a pointer into shared memory and never copies. After
+ * using the pixels, validate() tells whether the publisher overwrote the
+ * slot meanwhile (then the result must be discarded).
+ */
+class SVShmConsumer {
+public:
+    struct View {
+        const uint8_t* data = nullptr;
+        SVShmFrameInfo info;
+
+        explicit operator bool() const { return data != nullptr; }
+    };
+
+    SVShmConsumer() = default;
+    ~SVShmConsumer();
+
+    SVShmConsumer(const SVShmConsumer&) = delete;
+    SVShmConsumer& operator=(const SVShmConsumer&) = delete;
+
+    /**
+     * @brief Map an existing ring read-only
+     * @return false if it does not exist (yet) or is not an SV ring
+     */
+    bool open(const std::string& name);
+    void close();
+    bool isOpen() const { return base != nullptr; }
+
+    /**
+     * @brief Most recent complete frame (empty View if none was published)
+     */
+    View latest() const;
+
+    /**
+     * @brief True while the slot still holds the frame of the View
+     */
+    bool validate(const View& view) const;
+
+    uint64_t latestSeq() const;
+
+    /**
+     * @brief False once the publisher closed the ring (reopen to follow a restart)
+     */
+    bool publisherAlive() const;
+
+private:
+    const uint8_t* base = nullptr;
+    size_t mapped_bytes = 0;
+};
+
+#endif // SV_SHM_RING_HPP
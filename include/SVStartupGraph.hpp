@@ -0,0 +1,74 @@
+#ifndef SV_STARTUP_GRAPH_HPP
+#define SV_STARTUP_GRAPH_HPP
+
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Startup as a dependency graph of named tasks
+ *
+ * Each task starts as soon as all of its dependencies have succeeded:
+ * WORKER tasks on their own thread (they may block, e.g. waiting for a
+ * camera's first frame), MAIN tasks on the thread that called run() (for
+ * work bound to the GL context). Completion is signalled through a
+ * condition variable, so nothing polls.
+ *
+ * A failed task skips everything that depends on it. run() returns once
+ * every task has finished or been skipped; report() prints when each task
+ * started and how long it took.
+ */
+class SVStartupGraph {
+public:
+    enum class Affinity {
+        WORKER,     // Own thread
+        MAIN        // Thread calling run()
+    };
+
+    using Task = std::function<bool()>;
+
+    /**
+     * @brief Add a task
+     * @param name Unique name, used in deps and the report
+     * @param deps Tasks that must succeed first (added before or after this one)
+     * @param task Returns false on failure
+     */
+    void add(const std::string& name, const std::vector<std::string>& deps, Task task,
+             Affinity affinity = Affinity::WORKER);
+
+    /**
+     * @brief Run all tasks (blocking)
+     * @return true if every task succeeded
+     */
+    bool run();
+
+    /**
+     * @brief Print per-task start offset, duration and result
+     */
+    void report() const;
+
+    /**
+     * @brief Wall time of the last run() in milliseconds
+     */
+    double elapsedMs() const { return elapsed_ms; }
+
+private:
+    enum class State { PENDING, RUNNING, DONE, FAILED, SKIPPED };
+
+    struct Node {
+        std::string name;
+        std::vector<int> deps;
+        std::vector<std::string> dep_names;
+        Task task;
+        Affinity affinity;
+        State state = State::PENDING;
+        double start_ms = 0.0;
+        double duration_ms = 0.0;
+    };
+
+    std::vector<Node> nodes;
+    double elapsed_ms = 0.0;
+};
+
+#endif // SV_STARTUP_GRAPH_HPP
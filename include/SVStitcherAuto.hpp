@@ -2,10 +2,13 @@
 #define SV_STITCHER_AUTO_HPP
 
 #include "SVConfig.hpp"
-#include "SVBlender.hpp"
+#include "SVComputeBackend.hpp"
+#include "SVFrameBuffer.hpp"
+#include "SVFramePool.hpp"
+#include "SVTileStitcher.hpp"
+#include "SVCameraRig.hpp"
 #include "SVGainCompensator.hpp"
 #include <opencv2/core.hpp>
-#include <opencv2/core/cuda.hpp>
 #include <vector>
 #include <string>
 #include <memory>
@@ -13,12 +16,16 @@
 /**
  * @brief Automotive Surround View Stitcher
  * 
- * Stitches 4 camera views into a seamless surround view using:
- * - Diagonal X-pattern layout (640×800 canvas divided by diagonal lines)
- * - Alpha blending with 40px fade zones along diagonals
- * - Gain compensation (exposure matching)
+ * Stitches the rig's camera views into a seamless surround view using:
+ * - Diagonal X-pattern layout for the 4-camera car (640×800 canvas divided by diagonal lines)
+ * - Angular sector layout for any other rig (see createSectorMasks)
+ * - Alpha blending with 40px fade zones along the seams
+ * - Gain compensation (exposure matching, optional)
  * - Custom homography warping (already done in your app)
  * 
+ * All per-pixel work goes through an SVComputeBackend, so the same
+ * stitcher runs on the Jetson (CUDA) and on GPU-less machines (CPU).
+ * 
  * Layout - Diagonal X-Pattern (640×800):
  * 
  *        TL (Front)      TR (Right)
@@ -40,41 +47,87 @@
  * 
  * Blending: Only along the two diagonal lines (40px fade zones)
  * Outside blend zones: Pure camera data displayed
+ * 
+ * Sector layout (SVStitchLayout::SECTORS, N cameras):
+ * The canvas centre is the vehicle centre. Each camera owns the directions
+ * closer to its yaw than to its neighbours' yaws; seams run along the
+ * bisectors between neighbouring cameras, with the same fade width.
  */
 class SVStitcherAuto {
 public:
     SVStitcherAuto();
     ~SVStitcherAuto();
     
+    /**
+     * @brief Use a camera rig other than SVCameraRig::defaultRig()
+     * @note Must be called before init(); sets camera count, canvas and seam layout
+     */
+    void setRig(const SVCameraRig& rig_);
+    
+    /**
+     * @brief Restrict each camera's blend mask to where it actually sees the canvas
+     * @param valid CV_8U masks, one per camera, same sizes as the warped frames (255 = visible)
+     * @note Must be called before init(); used with IPM maps that cover the whole canvas
+     */
+    void setValidMasks(const std::vector<cv::Mat>& valid) { valid_masks = valid; }
+    
+    /**
+     * @brief Use precomputed blend weights instead of the rig's seam layout
+     * @param masks CV_8U weights, one per camera, same sizes as the warped frames
+     * @note Must be called before init(); used by view presets (SVViewLUT::weights)
+     */
+    void setBlendMasks(const std::vector<cv::Mat>& masks) { preset_masks = masks; }
+    
     /**
      * @brief Initialize stitcher with camera configuration
-     * @param sample_frames Sample frames from all 4 cameras
-     * @param warp_x_maps X warp maps (from your homography)
-     * @param warp_y_maps Y warp maps (from your homography)
-     * @param scale_factor Processing scale (0.65)
+     * @param warped_samples Sample frames from all cameras, already scaled and warped
      * @return true if successful
      */
-    bool init(const std::vector<cv::cuda::GpuMat>& sample_frames,
-              const std::vector<cv::cuda::GpuMat>& warp_x_maps,
-              const std::vector<cv::cuda::GpuMat>& warp_y_maps,
-              float scale_factor);
+    bool init(const std::vector<SVFrameBuffer>& warped_samples);
     
     /**
-     * @brief Stitch 4 camera frames into seamless output
-     * @param raw_frames Raw camera frames (before warping)
+     * @brief Initialize from an initialized stitcher, sharing its masks and tile plan
+     * 
+     * Mask and tile weight pixels are reference-counted, so any number of
+     * stitchers of one calibration hold a single copy; only per-frame buffers
+     * are reserved. Gain compensation (per-sequence state) is not shared and
+     * stays off.
+     */
+    bool initShared(const SVStitcherAuto& prepared);
+    
+    /**
+     * @brief Stitch one frame per camera into seamless output
      * @param warped_frames Warped frames (after homography)
-     * @param output Stitched output frame (GPU)
+     * @param output Stitched output frame (8UC3, resident where the backend works)
      * @return true if successful
      */
-    bool stitch(const std::vector<cv::cuda::GpuMat>& raw_frames,
-                const std::vector<cv::cuda::GpuMat>& warped_frames,
-                cv::cuda::GpuMat& output);
+    bool stitch(const std::vector<SVFrameBuffer>& warped_frames, SVFrameBuffer& output);
     
     /**
      * @brief Recompute gain compensation (call periodically)
      * @param warped_frames Vector of warped camera frames
      */
-    void recomputeGain(const std::vector<cv::cuda::GpuMat>& warped_frames);
+    void recomputeGain(const std::vector<SVFrameBuffer>& warped_frames);
+    
+    /**
+     * @brief Use a specific compute backend
+     * @note Must be called before init(); without one createComputeBackend(configuredBackendType()) is used
+     */
+    void setBackend(const std::shared_ptr<SVComputeBackend>& backend_) { backend = backend_; }
+    
+    const std::shared_ptr<SVComputeBackend>& getBackend() const { return backend; }
+    
+    /**
+     * @brief Match exposure across cameras before blending (off by default)
+     * @note Must be called before init(); gains are re-estimated every GAIN_UPDATE_INTERVAL frames
+     */
+    void setGainCompensation(bool enable) { use_gain_compensation = enable; }
+    
+    /**
+     * @brief Draw per-frame buffers from a shared frame pool
+     * @note Must be called before init(); without a pool a private one is used
+     */
+    void setFramePool(const std::shared_ptr<SVFramePool>& pool) { frame_pool = pool; }
     
     /**
      * @brief Check if stitcher is initialized
@@ -88,33 +141,70 @@ public:
     
 private:
     /**
-     * @brief Create overlap masks for 4-camera layout
+     * @brief Create overlap masks for the rig's layout
      * @param sample_frames Sample frames to determine size
      * @return true if successful
      */
-    bool createOverlapMasks(const std::vector<cv::cuda::GpuMat>& sample_frames);
+    bool createOverlapMasks(const std::vector<SVFrameBuffer>& sample_frames);
+    
+    /**
+     * @brief Diagonal X-pattern masks (4-camera car)
+     */
+    bool createDiagonalMasks();
+    
+    /**
+     * @brief One angular sector per camera, seams on the bisectors between neighbouring yaws
+     */
+    bool createSectorMasks(const std::vector<SVFrameBuffer>& sample_frames);
     
     /**
      * @brief Compute ROI (region of interest) for stitched output
-     * @param corners Corner positions of warped images
-     * @param sizes Sizes of warped images
+     * @note The canvas is fixed by the rig, not by where the warped images land
      */
-    cv::Rect computeStitchROI(const std::vector<cv::Point>& corners,
-                               const std::vector<cv::Size>& sizes);
+    cv::Rect computeStitchROI();
     
-    // Simple blending
-    std::shared_ptr<SVBlender> blender;
+    /**
+     * @brief Re-estimate the gains from frames in the backend's residency
+     */
+    void computeGains(const std::vector<SVFrameBuffer>& warped_frames);
+    
+    /**
+     * @brief Reserve all per-frame buffers in the frame pool
+     */
+    void reserveBuffers();
+    
+    // Camera count, canvas placement and seam layout
+    SVCameraRig rig;
+    
+    // Pixel primitives (CPU or CUDA)
+    std::shared_ptr<SVComputeBackend> backend;
     
     // Gain compensation (optional - can disable for pure alpha blend)
     std::shared_ptr<SVGainCompensator> gain_comp;
     bool use_gain_compensation;
     
     // Masks for overlap regions (diagonal fade zones)
-    std::vector<cv::cuda::GpuMat> blend_masks;
+    std::vector<SVFrameBuffer> blend_masks;
+    std::vector<cv::Mat> valid_masks;                   // Optional per-camera coverage
+    std::vector<cv::Mat> preset_masks;                  // Optional precomputed blend weights
+    
+    // Tile-parallel blend (CPU backend, STITCH_TILE_SIZE > 0)
+    SVTileStitcher tiler;
+    bool use_tiles;
+    std::vector<const cv::Mat*> tile_inputs;
     
     // Warp information
     std::vector<cv::Point> warp_corners;
     std::vector<cv::Size> warp_sizes;
+    std::vector<int> warp_types;                        // Blend input type (8UC3 or 16SC3)
+    
+    // Per-frame buffers (reserved once in init, reused every stitch)
+    std::shared_ptr<SVFramePool> frame_pool;
+    std::vector<SVFramePool::Handle> resized_handles;   // Size-mismatch fallback (warp type)
+    std::vector<SVFramePool::Handle> gained_handles;    // Gain-compensated blend input
+    SVFramePool::Handle acc_handle;                     // Weighted sum (32FC3)
+    SVFramePool::Handle weight_handle;                  // Sum of weights (32F)
+    SVFramePool::Handle output_mask_handle;
     
     // Output configuration
     cv::Size output_size;
@@ -0,0 +1,146 @@
+#ifndef SV_THREAD_POOL_HPP
+#define SV_THREAD_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Process-wide work-stealing pool for CPU-side vision work
+ *
+ * Every worker owns a deque: it pushes and pops its own tasks at the back
+ * (LIFO, cache-warm) while idle workers steal from the front of other
+ * workers' deques. Tasks submitted from outside the pool are distributed
+ * round-robin. Threads waiting on a SVTaskGroup help execute queued tasks,
+ * so nested parallelFor() calls cannot deadlock.
+ *
+ * instance() creates the shared pool on first use. Its size and CPU pinning
+ * come from THREAD_POOL_WORKERS / THREAD_POOL_CPUS in SVConfig.hpp and can be
+ * overridden with the SV_THREADS / SV_THREAD_CPUS environment variables
+ * (e.g. SV_THREADS=3 SV_THREAD_CPUS=1,2,3).
+ */
+class SVThreadPool {
+public:
+    using Task = std::function<void()>;
+
+    struct WorkerStats {
+        uint64_t executed = 0;
+        uint64_t stolen = 0;
+        int cpu = -1;  // Pinned CPU, -1 if unpinned
+    };
+
+    /**
+     * @brief Shared pool used by all pipeline stages
+     */
+    static SVThreadPool& instance();
+
+    /**
+     * @brief Create a pool
+     * @param num_workers Worker threads (values < 1 become 1)
+     * @param cpus CPUs to pin workers to, assigned round-robin (empty = no pinning)
+     */
+    explicit SVThreadPool(int num_workers, const std::vector<int>& cpus = {});
+    ~SVThreadPool();
+
+    SVThreadPool(const SVThreadPool&) = delete;
+    SVThreadPool& operator=(const SVThreadPool&) = delete;
+
+    int workerCount() const { return static_cast<int>(workers.size()); }
+
+    /**
+     * @brief Index of the calling worker in this pool, or -1 for other threads
+     */
+    int currentWorker() const;
+
+    /**
+     * @brief Queue a fire-and-forget task (use SVTaskGroup to wait for results)
+     */
+    void submit(Task task);
+
+    /**
+     * @brief Run body(i) for every i in [begin, end), blocking until done
+     */
+    void parallelFor(int begin, int end, const std::function<void(int)>& body);
+
+    /**
+     * @brief Run body(lo, hi) over sub-ranges of [begin, end), blocking until done
+     * @param grain Minimum number of indices per task
+     */
+    void parallelForRange(int begin, int end, const std::function<void(int, int)>& body,
+                          int grain = 1);
+
+    /**
+     * @brief Execute one queued task on the calling thread if any is available
+     * @return true if a task was run
+     */
+    bool runPendingTask();
+
+    std::vector<WorkerStats> stats() const;
+
+    /**
+     * @brief Print worker count, pinning and per-worker task/steal counts
+     */
+    void printSummary() const;
+
+    /**
+     * @brief Route OpenCV's own CPU parallel_for_ (remap, gain feed, ...) through this pool
+     * @return false if the OpenCV build has no pluggable parallel backend
+     */
+    bool installAsOpenCVBackend();
+
+private:
+    struct Worker {
+        std::mutex mtx;
+        std::deque<Task> tasks;
+        std::thread thread;
+        std::atomic<uint64_t> executed{0};
+        std::atomic<uint64_t> stolen{0};
+        int cpu = -1;
+    };
+
+    void workerLoop(int index);
+    bool tryRunOne(int self);
+
+    std::vector<std::unique_ptr<Worker>> workers;
+
+    std::mutex sleep_mtx;
+    std::condition_variable sleep_cv;
+    std::atomic<int> pending{0};
+    std::atomic<bool> stopping{false};
+    std::atomic<unsigned> next_worker{0};
+};
+
+/**
+ * @brief Set of tasks that can be waited on together
+ *
+ * wait() blocks until every task passed to run() has finished, executing
+ * other queued pool tasks in the meantime, and rethrows the first exception
+ * thrown by a task. The destructor waits as well.
+ */
+class SVTaskGroup {
+public:
+    explicit SVTaskGroup(SVThreadPool& pool = SVThreadPool::instance());
+    ~SVTaskGroup();
+
+    SVTaskGroup(const SVTaskGroup&) = delete;
+    SVTaskGroup& operator=(const SVTaskGroup&) = delete;
+
+    void run(SVThreadPool::Task task);
+    void wait();
+
+private:
+    SVThreadPool& pool;
+    std::mutex mtx;
+    std::condition_variable done_cv;
+    int outstanding = 0;
+    std::exception_ptr error;
+};
+
+#endif // SV_THREAD_POOL_HPP
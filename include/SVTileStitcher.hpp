@@ -0,0 +1,84 @@
+#ifndef SV_TILE_STITCHER_HPP
+#define SV_TILE_STITCHER_HPP
+
+#include <opencv2/core.hpp>
+#include <vector>
+
+/**
+ * @brief Tile-parallel CPU stitch engine
+ *
+ * The output canvas is split into square tiles small enough that a tile and
+ * its sources stay in cache. prepare() looks at the (fixed) blend masks once
+ * and records, for every tile, which cameras cover it and how:
+ *
+ *  - EMPTY:       no camera, tile is cleared
+ *  - COPY:        one camera with non-zero weight over the whole tile,
+ *                 rows are copied straight from the warped image
+ *  - MASKED_COPY: one camera covering part of the tile
+ *  - BLEND:       two or more cameras; per-pixel weights are normalised
+ *                 once in prepare(), so stitching is a weighted sum
+ *
+ * stitch() then processes the tiles in parallel on SVThreadPool. The result
+ * is identical to the whole-canvas weighted blend of SVComputeBackend.
+ */
+class SVTileStitcher {
+public:
+    enum class TileKind : uint8_t {
+        EMPTY = 0,
+        COPY,
+        MASKED_COPY,
+        BLEND
+    };
+
+    /**
+     * @brief Build the per-tile coverage lists
+     * @param masks CV_8U blend masks, one per camera (255 = full weight)
+     * @param corners Canvas position of each camera image
+     * @param canvas Output canvas size
+     * @param tile_size Tile edge in pixels
+     */
+    void prepare(const std::vector<cv::Mat>& masks, const std::vector<cv::Point>& corners,
+                 cv::Size canvas, int tile_size);
+
+    /**
+     * @brief Stitch warped CV_8UC3 images (same sizes as the masks) into dst
+     */
+    void stitch(const std::vector<const cv::Mat*>& images, cv::Mat& dst) const;
+
+    bool isPrepared() const { return !tiles.empty(); }
+    cv::Size canvasSize() const { return canvas_size; }
+
+    /**
+     * @brief 255 where at least one camera contributes (fixed after prepare)
+     */
+    const cv::Mat& coverageMask() const { return coverage; }
+
+    /**
+     * @brief Print tile counts per kind
+     */
+    void printSummary() const;
+
+private:
+    struct TileSource {
+        int camera;
+        cv::Rect src_rect;      // Region of the camera image
+        cv::Point dst_offset;   // Where src_rect lands inside the tile
+        cv::Mat weight;         // BLEND only: normalised CV_32F weights, src_rect sized
+    };
+
+    struct Tile {
+        cv::Rect rect;          // Canvas region
+        TileKind kind = TileKind::EMPTY;
+        std::vector<TileSource> sources;
+    };
+
+    void stitchTile(const Tile& tile, const std::vector<const cv::Mat*>& images, cv::Mat& dst) const;
+
+    std::vector<Tile> tiles;
+    std::vector<cv::Mat> camera_masks;
+    cv::Mat coverage;
+    cv::Size canvas_size;
+    int tile_edge = 0;
+};
+
+#endif // SV_TILE_STITCHER_HPP
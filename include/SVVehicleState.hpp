@@ -0,0 +1,108 @@
+#ifndef SV_VEHICLE_STATE_HPP
+#define SV_VEHICLE_STATE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+enum class SVGear { UNKNOWN = 0, PARK, REVERSE, NEUTRAL, DRIVE };
+enum class SVTurnSignal { NONE = 0, LEFT, RIGHT, HAZARD };
+
+/**
+ * @brief Driving context: gear, speed and turn signal
+ */
+struct SVVehicleState {
+    SVGear gear = SVGear::UNKNOWN;
+    float speed_kmh = 0.0f;
+    SVTurnSignal turn = SVTurnSignal::NONE;
+    bool valid = false;             // false before the first update and once updates stop
+    std::chrono::steady_clock::time_point updated;
+};
+
+const char* gearName(SVGear gear);
+const char* turnSignalName(SVTurnSignal turn);
+
+/**
+ * @brief Reads the vehicle state on its own thread, from a text stream or a CAN bus
+ *
+ * Sources (no vehicle needed for either):
+ *
+ *   file:<path>  Regular file or FIFO, one update per line, keys optional:
+ *                  gear=R speed=4.5 turn=left
+ *                gear P/R/N/D, turn none/left/right/hazard. A regular file
+ *                is followed like tail -f; a FIFO is reopened when its
+ *                writer goes away.
+ *
+ *   can:<iface>  SocketCAN (e.g. vcan0), one frame with can_id:
+ *                  byte 0    gear 'P', 'R', 'N' or 'D'
+ *                  byte 1-2  speed in 0.01 km/h, little endian
+ *                  byte 3    turn 0 none, 1 left, 2 right, 3 hazard
+ *                e.g. cansend vcan0 3E9#52C20101 (R, 4.5 km/h, left)
+ *
+ * state() is cheap and may be called every frame. A state older than
+ * stale_ms is reported as not valid, so a dead source does not leave the
+ * last context applied forever; sources should repeat the state (CAN
+ * senders do, typically at 10-100 Hz).
+ */
+class SVVehicleInput {
+public:
+    struct Options {
+        int stale_ms = 1000;        // 0 = an update stays valid until the next one
+        uint32_t can_id = 0x3E9;
+    };
+
+    SVVehicleInput();
+    ~SVVehicleInput();
+
+    SVVehicleInput(const SVVehicleInput&) = delete;
+    SVVehicleInput& operator=(const SVVehicleInput&) = delete;
+
+    /**
+     * @param source "file:<path>" or "can:<interface>"
+     * @return false if the source cannot be opened
+     */
+    bool start(const std::string& source, const Options& options);
+    bool start(const std::string& source) { return start(source, Options()); }
+    void stop();
+    bool isRunning() const { return thread.joinable(); }
+
+    SVVehicleState state() const;
+    uint64_t updates() const { return update_count.load(); }
+
+    /**
+     * @brief Apply one text line; keys not present keep their value
+     * @return false if no key could be parsed
+     */
+    static bool parseLine(const std::string& line, SVVehicleState& state);
+
+    /**
+     * @brief Apply the payload of one CAN frame (see class description)
+     */
+    static bool parseCanFrame(const uint8_t* data, int len, SVVehicleState& state);
+
+private:
+    bool openFile();
+    bool openCan();
+    void loop();
+    void publish(const SVVehicleState& next);
+
+    enum class Kind { FILE, CAN };
+    Kind kind;
+    std::string path;               // File path or CAN interface
+    Options opts;
+    bool is_fifo;
+
+    int fd;
+    int stop_fd;                    // eventfd that wakes poll() on stop()
+    std::thread thread;
+    std::atomic<bool> stopping;
+
+    mutable std::mutex mutex;
+    SVVehicleState current;         // Reader thread writes, state() copies
+    std::atomic<uint64_t> update_count;
+};
+
+#endif // SV_VEHICLE_STATE_HPP
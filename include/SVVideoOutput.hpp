@@ -0,0 +1,148 @@
+#ifndef SV_VIDEO_OUTPUT_HPP
+#define SV_VIDEO_OUTPUT_HPP
+
+#include <opencv2/core.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+typedef struct _GstElement GstElement;
+
+/**
+ * @brief Asynchronous H.264 encoder fed from the frame loop
+ *
+ * push() copies a BGR frame into a preallocated slot of a lock-free
+ * single-producer/single-consumer ring and returns immediately. When the
+ * ring is full the frame is dropped and counted, the caller never waits
+ * (unless Options::block_when_full is set, for offline tools).
+ * A worker thread hands queued frames to a GStreamer pipeline:
+ *
+ *   appsrc ! [videoflip] ! [videocrop] ! videoconvert ! <encoder> ! h264parse ! <sink>
+ *
+ * The encoder and sink are pipeline fragments (gst-launch syntax), so the
+ * same class records to a file on a plain Linux box (x264enc), streams
+ * RTP over UDP, or uses the Jetson hardware encoder
+ * (nvvidconv ! nvv4l2h264enc). No CUDA needed.
+ */
+class SVVideoOutput {
+public:
+    /**
+     * @brief Encoder trade-off for live streams (see x264Live())
+     */
+    enum class Latency {
+        LOW,                                // One-frame VBV, no lookahead: lowest delay, bursty quality
+        BALANCED,                           // ~300 ms VBV, no lookahead
+        QUALITY                             // 1 s VBV with lookahead: steadier quality, ~0.5 s more delay
+    };
+
+    struct Options {
+        std::string name = "video";         // Used in log messages
+        cv::Size size;                      // Frame size (fixed for the session); odd sizes lose the last column/row
+        int fps = 30;                       // Nominal rate for caps and rate control
+        int queue_depth = 8;                // Ring slots between push() and the encoder
+        bool flip_vertical = false;         // Input is bottom-up (GL read-back)
+        bool block_when_full = false;       // Offline encoding: push() waits instead of dropping
+        std::string encoder = "x264enc tune=zerolatency speed-preset=ultrafast";
+        std::string sink;                   // Everything after h264parse
+
+        /**
+         * @brief Record to a file; the container follows the extension (.mp4 or .mkv)
+         * @note Matroska stays readable if the process dies; MP4 needs a clean stop()
+         */
+        static Options file(const std::string& path, cv::Size size, int fps);
+
+        /**
+         * @brief Send RTP/H.264 over UDP in the cameras' own format
+         *
+         * Payload type 96, 90 kHz clock, SPS/PPS before every keyframe so a
+         * receiver can join at any time. Receive it like a camera, e.g.
+         *
+         *   gst-launch-1.0 udpsrc port=5600
+         *     ! application/x-rtp,media=video,clock-rate=90000,encoding-name=H264,payload=96
+         *     ! rtpjitterbuffer latency=50 ! rtph264depay ! h264parse ! avdec_h264 ! autovideosink
+         *
+         * @param host Unicast or multicast address
+         */
+        static Options rtp(const std::string& host, int port, cv::Size size, int fps);
+    };
+
+    /**
+     * @brief x264enc fragment for live streaming
+     * @param bitrate_kbps Target rate in kbit/s
+     * @param gop Frames between keyframes (also the worst-case join delay)
+     */
+    static std::string x264Live(int bitrate_kbps, int gop, Latency latency, int fps);
+
+    struct Stats {
+        uint64_t pushed = 0;                // Accepted by push()
+        uint64_t dropped = 0;               // Rejected by push(): ring full or pipeline failed
+        uint64_t encoded = 0;               // Handed to the encoder
+    };
+
+    SVVideoOutput();
+    ~SVVideoOutput();
+
+    SVVideoOutput(const SVVideoOutput&) = delete;
+    SVVideoOutput& operator=(const SVVideoOutput&) = delete;
+
+    /**
+     * @brief Build and start the pipeline
+     * @return false if the pipeline cannot be created (missing element, bad path)
+     */
+    bool start(const Options& options);
+
+    /**
+     * @brief Queue one frame (producer thread only, never blocks unless block_when_full)
+     * @param bgr CV_8UC3 of Options::size
+     * @param pts_ns Capture time; the first pushed frame becomes time 0
+     * @return false if the frame was dropped
+     */
+    bool push(const cv::Mat& bgr, int64_t pts_ns);
+
+    /**
+     * @brief Drain the ring, finish the stream (EOS) and close the pipeline
+     */
+    void stop();
+
+    bool isRunning() const { return running; }
+    Stats stats() const;
+    const Options& options() const { return opts; }
+
+private:
+    struct Slot {
+        cv::Mat image;
+        int64_t pts_ns = 0;
+    };
+
+    void workerLoop();
+    bool pushToPipeline(const Slot& slot);
+    bool checkBus();
+
+    Options opts;
+    GstElement* pipeline;
+    GstElement* appsrc;
+
+    // SPSC ring: the producer owns head, the worker owns tail
+    std::vector<Slot> slots;
+    alignas(64) std::atomic<uint32_t> head;
+    alignas(64) std::atomic<uint32_t> tail;
+
+    std::thread worker;
+    std::mutex wake_mutex;                  // Sleep only; the ring itself is lock-free
+    std::condition_variable wake;           // push() -> worker
+    std::condition_variable space;          // Worker -> push() (block_when_full)
+    std::atomic<bool> running;
+    std::atomic<bool> failed;
+    int64_t first_pts_ns;
+
+    std::atomic<uint64_t> pushed;
+    std::atomic<uint64_t> dropped;
+    std::atomic<uint64_t> encoded;
+};
+
+#endif // SV_VIDEO_OUTPUT_HPP
@@ -0,0 +1,62 @@
+#ifndef SV_VIEW_PRESET_HPP
+#define SV_VIEW_PRESET_HPP
+
+#include "SVIPMWarp.hpp"
+#include <opencv2/core.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Where a view preset looks from
+ *
+ * TOP is the metric IPM canvas (SVIPMCanvas::fromConfig). PERSPECTIVE is a
+ * virtual pinhole camera at eye looking at target (vehicle ground frame, mm,
+ * Z down) whose rays hit the bowl: flat ground out to BOWL_DISK_RADIUS, then
+ * the paraboloid wall, the same surface the 3D bowl view draws.
+ */
+enum class SVViewKind {
+    TOP,
+    PERSPECTIVE
+};
+
+struct SVViewPresetSpec {
+    std::string name;
+    SVViewKind kind = SVViewKind::TOP;
+    cv::Point3d eye;            // PERSPECTIVE only
+    cv::Point3d target;
+    double fov_deg = 60.0;      // Horizontal field of view
+};
+
+/**
+ * @brief Top view, rear 3/4, front-wheel and both side views
+ */
+std::vector<SVViewPresetSpec> defaultViewPresets();
+
+/**
+ * @brief Precomputed mapping from raw camera pixels to one view's canvas
+ *
+ * Built once per preset and never modified afterwards, so it can be shared
+ * between threads and swapped in by pointer.
+ */
+struct SVViewLUT {
+    std::string name;
+    cv::Size size;
+    std::vector<cv::Mat> map_x;     // Per camera, CV_32F raw-frame x (-1 where unseen)
+    std::vector<cv::Mat> map_y;     // Per camera, CV_32F raw-frame y (-1 where unseen)
+    std::vector<cv::Mat> weights;   // Per camera, CV_8U blend weight (0-255, blendWeightsFromScores)
+    float coverage = 0.0f;          // Fraction of canvas pixels seen by any camera
+
+    /**
+     * @brief Build the LUT for one preset
+     * @param calibs One calibration per camera, rig order
+     * @param image_size Raw camera image size
+     * @param size Canvas size (all presets share it so transitions can interpolate)
+     * @return nullptr on invalid input
+     */
+    static std::shared_ptr<const SVViewLUT> build(const SVViewPresetSpec& spec,
+                                                  const std::vector<SVCameraCalib>& calibs,
+                                                  cv::Size image_size, cv::Size size);
+};
+
+#endif // SV_VIEW_PRESET_HPP
@@ -0,0 +1,103 @@
+#ifndef SV_VIEW_SWITCHER_HPP
+#define SV_VIEW_SWITCHER_HPP
+
+#include "SVViewPreset.hpp"
+#include "SVStitcherAuto.hpp"
+#include "SVFramePool.hpp"
+#include "SVFrameBuffer.hpp"
+#include <opencv2/core/cuda.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Virtual-viewpoint presets with cached mappings and instant switching
+ *
+ * Every preset's LUT (SVViewLUT) is built once at init and uploaded together
+ * with its own SVStitcherAuto carrying the preset's blend weights. Selecting a
+ * preset is a pointer swap; the next render() uses it without rebuilding
+ * anything. select() may be called from any thread.
+ *
+ * With a transition the raw-pixel maps of the two presets are interpolated
+ * per frame (where only one preset sees a pixel its map is used as is), so
+ * the view morphs geometrically. Blend weights switch at the halfway point.
+ */
+class SVViewSwitcher {
+public:
+    SVViewSwitcher();
+
+    /**
+     * @brief Draw per-frame buffers from a shared frame pool
+     * @note Must be called before init(); without a pool a private one is used
+     */
+    void setFramePool(const std::shared_ptr<SVFramePool>& pool) { frame_pool = pool; }
+
+    /**
+     * @brief Build, upload and stitch-initialize every preset
+     * @param specs Presets in selection order (see defaultViewPresets())
+     * @param rig Camera rig (camera count and names)
+     * @param calibs One calibration per camera, rig order
+     * @param raw_samples One raw frame per camera (sizes and stitcher init)
+     * @param size Canvas size shared by all presets
+     * @return true if at least one preset is usable
+     */
+    bool init(const std::vector<SVViewPresetSpec>& specs,
+              const SVCameraRig& rig,
+              const std::vector<SVCameraCalib>& calibs,
+              const std::vector<cv::cuda::GpuMat>& raw_samples,
+              cv::Size size);
+
+    /**
+     * @brief Switch to a preset
+     * @param transition_frames 0 = instant, otherwise morph over this many render() calls
+     * @return false for an unknown index
+     */
+    bool select(int index, int transition_frames = 0);
+    bool select(const std::string& name, int transition_frames = 0);
+
+    int count() const { return static_cast<int>(views.size()); }
+    int activeIndex() const;
+    const std::string& activeName() const;
+
+    /**
+     * @brief Map the raw frames into the active view and blend them
+     * @param raw_frames One raw frame per camera, rig order
+     * @param output Canvas-sized 8UC3 result
+     */
+    bool render(const std::vector<cv::cuda::GpuMat>& raw_frames, SVFrameBuffer& output);
+
+private:
+    // One cached preset: LUT on the device plus a stitcher holding its weights
+    struct View {
+        int index;
+        std::shared_ptr<const SVViewLUT> lut;
+        std::vector<cv::cuda::GpuMat> map_x;
+        std::vector<cv::cuda::GpuMat> map_y;
+        std::vector<cv::cuda::GpuMat> unseen;       // 255 where the camera does not see the pixel
+        std::shared_ptr<SVStitcherAuto> stitcher;
+    };
+
+    // Current selection; swapped atomically by select()
+    struct Selection {
+        std::shared_ptr<const View> from;           // Previous view while transitioning
+        std::shared_ptr<const View> to;
+        int transition_frames;
+    };
+
+    void interpolateMaps(const View& from, const View& to, float alpha);
+
+    std::vector<std::shared_ptr<const View>> views;
+    std::shared_ptr<const Selection> selection;
+    int transition_frame;                           // Render thread only
+    std::shared_ptr<const Selection> last_selection;
+
+    int num_cameras;
+    cv::Size canvas_size;
+    std::shared_ptr<SVFramePool> frame_pool;
+    std::vector<SVFramePool::Handle> warped_handles;    // Per camera, canvas-sized 8UC3
+    std::vector<SVFramePool::Handle> lerp_x_handles;    // Per camera, transition maps (32F)
+    std::vector<SVFramePool::Handle> lerp_y_handles;
+    std::vector<SVFrameBuffer> stitch_inputs;           // Attached to warped buffers
+};
+
+#endif // SV_VIEW_SWITCHER_HPP
@@ -38,8 +38,8 @@ bool Bowl::generate_mesh_(const float max_size_vert, std::vector<float>& vertice
 
         // Convert to rectangular coordinates
         // x = r*cos(theta), z = r*sin(theta), y/c = (x^2)/(a^2) + (z^2)/(b^2);
-        for (int i = 0; i < grid_size; ++i) {
-                for (int j = 0; j < grid_size; ++j) {
+        for (size_t i = 0; i < grid_size; ++i) {
+                for (size_t j = 0; j < grid_size; ++j) {
                         auto x = R(i, j) * cos(THETA(i, j));
                         auto z = R(i, j) * sin(THETA(i, j));
                         auto y = c * (pow((x / a), 2) + pow((z / b), 2));
@@ -54,8 +54,8 @@ bool Bowl::generate_mesh_(const float max_size_vert, std::vector<float>& vertice
         */
         auto min_y = 0.f;
         auto idx_min_y = 0u; // index y - component when transition between disk and paraboloid
-        for (int i = 0; i < grid_size; ++i) {
-                for (int j = 0; j < grid_size; ++j) {
+        for (size_t i = 0; i < grid_size; ++i) {
+                for (size_t j = 0; j < grid_size; ++j) {
                         auto x = x_grid[j + i * grid_size];
                         auto z = z_grid[j + i * grid_size];
                         if (lt_radius(x, z, inner_rad)) { // check level of paraboloid
@@ -73,8 +73,8 @@ bool Bowl::generate_mesh_(const float max_size_vert, std::vector<float>& vertice
         auto half_grid = grid_size / 2;
         auto vertices_size = 0;
         auto offset_idx_min_y = 0;
-        for (int i = 0; i < grid_size; ++i) {
-                for (int j = 0; j < grid_size; ++j) {
+        for (size_t i = 0; i < grid_size; ++i) {
+                for (size_t j = 0; j < grid_size; ++j) {
                         auto x = x_grid[j + i * grid_size];
                         auto z = z_grid[j + i * grid_size];
 
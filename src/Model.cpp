@@ -36,7 +36,7 @@ void Model::loadModel(const std::string& path)
     directory = path.substr(0, path.find_last_of('/'));
 
     if (scene->HasMaterials()){
-        for(auto i = 0; i < scene->mNumMaterials; ++i){
+        for (size_t i = 0; i < scene->mNumMaterials; ++i) {
             MaterialInfo mater = processMaterial(scene->mMaterials[i]);
             materials.emplace_back(mater);
         }
@@ -107,7 +107,7 @@ Mesh Model::processMesh(aiMesh* mesh, const aiScene* scene)
             textures.insert(textures.end(), heightMaps.begin(), heightMaps.end());
     }
 
-    return std::move(Mesh{ vertices, indices, textures, materials.at(mesh->mMaterialIndex) });
+    return Mesh{ vertices, indices, textures, materials.at(mesh->mMaterialIndex) };
 }
 
 
@@ -1,23 +1,54 @@
 #include "SVAppSimple.hpp"
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <thread>
 #include <chrono>
+#include <cstdlib>
+#if defined(EN_RECORDING) || defined(EN_SESSION_RECORD)
+#include <sys/stat.h>
+#include <ctime>
+#endif
 
 using namespace std::chrono_literals;
 
+#if defined(EN_RECORDING) || defined(EN_SESSION_RECORD)
+// Local time for output file names (sortable, no spaces)
+static std::string fileTimestamp() {
+    char stamp[32];
+    const std::time_t now = std::time(nullptr);
+    std::strftime(stamp, sizeof(stamp), "%Y%m%d_%H%M%S", std::localtime(&now));
+    return stamp;
+}
+#endif
+
 #if defined(EN_STITCH) || defined(EN_RENDER_STITCH)
-    SVAppSimple::SVAppSimple() : is_running(false), show_stitched(false) {
-        stored_warped_frames.resize(NUM_CAMERAS);
+    SVAppSimple::SVAppSimple()
+        : rig(SVCameraRig::fromConfig()), num_cameras(rig.size()), show_stitched(false), is_running(false) {
+        frames.resize(num_cameras);
+        display_frames.resize(num_cameras);
+        stored_warped_frames.resize(num_cameras);
+        stitch_warped_vec.resize(num_cameras);
+        frame_pool = std::make_shared<SVFramePool>();
 
         #if defined(WARPING) || defined(RENDER_PRESERVE_AS_CUSTOMHOMOGRAPHY)
             scale_factor = 0.50f;
+            scaled_handles.assign(num_cameras, SVFramePool::INVALID_HANDLE);
+            warped_handles.assign(num_cameras, SVFramePool::INVALID_HANDLE);
         #endif
         
 }
 #else
-    SVAppSimple::SVAppSimple() : is_running(false) {
+    SVAppSimple::SVAppSimple()
+        : rig(SVCameraRig::fromConfig()), num_cameras(rig.size()), is_running(false) {
+        frames.resize(num_cameras);
+        display_frames.resize(num_cameras);
+        frame_pool = std::make_shared<SVFramePool>();
+
         #if defined(WARPING) || defined(RENDER_PRESERVE_AS_CUSTOMHOMOGRAPHY)
             scale_factor = 0.65f;  // ADD THIS
+            scaled_handles.assign(num_cameras, SVFramePool::INVALID_HANDLE);
+            warped_handles.assign(num_cameras, SVFramePool::INVALID_HANDLE);
         #endif
     }
 #endif
@@ -27,147 +58,321 @@ SVAppSimple::~SVAppSimple() {
     stop();
 }
 
+// Size every camera delivers (before any decoder crop)
+static cv::Size captureSize() {
+    #ifdef EN_DUAL_RES_INGEST
+        return cv::Size(STITCH_CAPTURE_WIDTH, STITCH_CAPTURE_HEIGHT);
+    #else
+        return cv::Size(CAMERA_WIDTH, CAMERA_HEIGHT);
+    #endif
+}
+
+// Processing chain selected in SVConfig.hpp, for the startup banner
+static std::string processingMode() {
+    #if defined(WARPING) && defined(WARPING_IPM)
+        std::string mode = "Ground-plane IPM warp + stitching";
+    #elif defined(RENDER_PRESERVE_AS_CUSTOMHOMOGRAPHY)
+        std::string mode = "Custom homography warp + stitching";
+    #else
+        std::string mode = "Direct camera feed";
+    #endif
+    #ifdef EN_BOWL_VIEW
+        mode += " + 3D bowl view";
+    #endif
+    #ifdef EN_VIEW_PRESETS
+        mode += " + view presets";
+    #endif
+    #ifdef EN_DUAL_RES_INGEST
+        mode += " + full-resolution zoom";
+    #endif
+    #ifdef EN_DECODE_CROP
+        mode += " + decoder crop";
+    #endif
+    return mode;
+}
+
 bool SVAppSimple::init() {
+    startup_begin = std::chrono::steady_clock::now();
+    
     std::cout << "\n========================================" << std::endl;
-    std::cout << "Ultra-Simple 4-Camera Display System" << std::endl;
-    std::cout << "NO STITCHING - Direct Camera Feed" << std::endl;
+    std::cout << "Ultra-Simple " << num_cameras << "-Camera Display System" << std::endl;
+    std::cout << processingMode() << std::endl;
     std::cout << "========================================\n" << std::endl;
     
-    // ========================================
-    // STEP 1: Initialize Camera Source
-    // ========================================
-    std::cout << "[1/3] Initializing camera source..." << std::endl;
+    // One CPU pool for everything, including OpenCV's own parallel loops
+    SVThreadPool::instance().installAsOpenCVBackend();
     
-    camera_source = std::make_shared<MultiCameraSource>();
-    camera_source->setFrameSize(cv::Size(1280, 800));
+    rig.print();
     
-    // Initialize without undistortion (faster!)
-    if (camera_source->init("", cv::Size(1280, 800), 
-                            cv::Size(1280, 800), false) < 0) {
-        std::cerr << "ERROR: Failed to initialize cameras" << std::endl;
-        return false;
-    }
+    // Known before any camera is up, so LUTs can be built while pipelines preroll
+    const cv::Size capture_size = captureSize();
     
-    std::cout << "  ✓ Cameras initialized" << std::endl;
+    camera_source = std::make_shared<MultiCameraSource>(rig);
+    camera_source->setFramePool(frame_pool);
+    camera_source->setFrameSize(capture_size);
+    #ifdef EN_DUAL_RES_INGEST
+        camera_source->setFullResolution(cv::Size(CAMERA_WIDTH, CAMERA_HEIGHT));
+    #endif
+    #if defined(EN_PIPELINE_TUNER) && !defined(SESSION_REPLAY_FILE)
+        // Before the startup graph: tuning needs the camera ports and the CPU to itself
+        camera_source->setPipelineProfile(pipelineProfile());
+    #endif
     
-    // Start camera streams
-    if (!camera_source->startStream()) {
-        std::cerr << "ERROR: Failed to start camera streams" << std::endl;
-        return false;
-    }
+    #ifdef SESSION_REPLAY_FILE
+        // Recorded session instead of live cameras, with the calibration it was recorded with
+        SVSessionPlayer::Options replay_opts;
+        replay_opts.decoder = SESSION_REPLAY_DECODER;
+        if (!camera_source->openReplay(SESSION_REPLAY_FILE, replay_opts)) {
+            std::cerr << "ERROR: Cannot replay " << SESSION_REPLAY_FILE << std::endl;
+            return false;
+        }
+        const SVSessionReader* session = camera_source->replaySession();
+        if (!session->calibration().empty()) {
+            const std::string session_calib = std::string(SESSION_REPLAY_FILE) + ".calib";
+            if (session->writeCalibration(session_calib)) {
+                calib_folder = session_calib;
+                std::cout << "  ✓ Using session calibration (" << calib_folder << ")" << std::endl;
+            }
+        }
+    #endif
+    
+    #ifdef EN_SESSION_RECORD
+        camera_source->setSessionRecordingEnabled(true);
+    #endif
     
-    std::cout << "  ✓ Camera streams started" << std::endl;
+    #ifdef EN_EVENT_BUFFER
+        // Rings are allocated up front; the pipelines tap into them from the first packet
+        SVEventBuffer::Options event_opts;
+        for (const SVCameraInfo& cam : rig.cameras) {
+            event_opts.camera_names.push_back(cam.name);
+        }
+        event_opts.pre_seconds = EVENT_PRE_SECONDS;
+        event_opts.post_seconds = EVENT_POST_SECONDS;
+        event_opts.bytes_per_camera = static_cast<size_t>(EVENT_BUFFER_MB_PER_CAMERA) << 20;
+        event_opts.folder = EVENT_DIR;
+        event_buffer = std::make_shared<SVEventBuffer>();
+        if (event_buffer->init(event_opts)) {
+            camera_source->setEventBuffer(event_buffer);
+        } else {
+            event_buffer.reset();
+        }
+    #endif
     
     // ========================================
-    // STEP 2: Wait for Valid Frames
+    // Startup graph: every step starts as soon as its inputs are ready
+    //
+    //   cameras -> first_frames ----------------------> warp_buffers
+    //   [calibration] -> warp_maps ------------------/
+    //   renderer (main thread) -> [bowl_view]
+    //   first_frames + [calibration] + warp_buffers -> [view_presets]
+    //   [warp_maps -> source_crops -> cameras] with EN_DECODE_CROP
     // ========================================
-    std::cout << "\n[2/3] Waiting for camera frames..." << std::endl;
+    SVStartupGraph startup;
     
-    int attempts = 0;
-    bool got_frames = false;
+    #ifdef EN_DECODE_CROP
+        source_crops.assign(num_cameras, cv::Rect());
+        const std::vector<std::string> camera_deps = {"source_crops"};
+    #else
+        const std::vector<std::string> camera_deps;
+    #endif
     
-    while (attempts < 100 && !got_frames) {
-        if (camera_source->capture(frames)) {
-            bool all_valid = true;
-            for (int i = 0; i < NUM_CAMERAS; i++) {
-                if (frames[i].gpuFrame.empty()) {
-                    all_valid = false;
-                    break;
-                }
-            }
-            
-            if (all_valid) {
-                got_frames = true;
-                std::cout << "  ✓ Received valid frames from all " << NUM_CAMERAS 
-                          << " cameras" << std::endl;
-                
-                // Print frame info
-                for (int i = 0; i < NUM_CAMERAS; i++) {
-                    std::cout << "    Camera " << i << ": " 
-                              << frames[i].gpuFrame.size() << std::endl;
-                }
-            }
+    // Pipelines are created and set to PLAYING in parallel
+    startup.add("cameras", camera_deps, [this, capture_size] {
+        // Initialize without undistortion (faster!)
+        if (camera_source->init("", capture_size, capture_size, false) < 0) {
+            std::cerr << "ERROR: Failed to initialize cameras" << std::endl;
+            return false;
         }
-        
-        if (!got_frames) {
-            std::this_thread::sleep_for(100ms);
-            attempts++;
-            if (attempts % 10 == 0) {
-                std::cout << "  Still waiting for frames... (" << attempts << "/100)" << std::endl;
-            }
+        if (!camera_source->startStream()) {
+            std::cerr << "ERROR: Failed to start camera streams" << std::endl;
+            return false;
         }
-    }
+        std::cout << "  ✓ Camera streams started" << std::endl;
+        return true;
+    });
     
-    if (!got_frames) {
-        std::cerr << "ERROR: Failed to get valid frames from cameras" << std::endl;
-        return false;
-    }
-    // ========================================
-    // STEP 2A: load calibration & warp maps
-    // ========================================
-    #ifdef WARPING
-        std::cout << "\n[3/4] Setting up bird's-eye transformation..." << std::endl;
-
-        if (!loadCalibration("../camparameters")) {
-            std::cerr << "ERROR: Failed to load calibration" << std::endl;
+    // Readiness is the first decoded sample of each pipeline, not a sleep loop
+    startup.add("first_frames", {"cameras"}, [this] {
+        if (!camera_source->waitForFrames(frames, 10000)) {
+            std::cerr << "ERROR: Failed to get valid frames from cameras" << std::endl;
             return false;
         }
-
-        if (!setupWarpMaps()) {
-            std::cerr << "ERROR: Failed to setup warp maps" << std::endl;
-            return false;
+        std::cout << "  ✓ Received valid frames from all " << num_cameras << " cameras" << std::endl;
+        for (int i = 0; i < num_cameras; i++) {
+            std::cout << "    Camera " << i << ": " << frames[i].image.size() << std::endl;
         }
-
-        std::cout << "  ✓ Bird's-eye transformation ready" << std::endl;
+        return true;
+    });
+    
+    #if defined(WARPING) || defined(EN_BOWL_VIEW) || defined(EN_VIEW_PRESETS)
+        startup.add("calibration", {}, [this] {
+            if (loadCalibration(calib_folder, camera_calibs)) {
+                return true;
+            }
+            #ifdef WARPING
+                std::cerr << "ERROR: Failed to load calibration" << std::endl;
+                return false;
+            #else
+                // Only optional views need it; they disable themselves
+                camera_calibs.clear();
+                return true;
+            #endif
+        });
     #endif
-
-    // ========================================
-    // CUSTOM HOMOGRAPHY WITH MANUAL CALIBRATION
-    // ========================================
+    
+    // LUTs only need the calibration and the configured capture size
+    #ifdef WARPING
+        startup.add("warp_maps", {"calibration"}, [this, capture_size] {
+            ipm_canvas = SVIPMCanvas::fromConfig();
+            std::vector<cv::Size> image_sizes(num_cameras, capture_size);
+            if (!setupWarpMaps(camera_calibs, image_sizes, warp_maps)) {
+                std::cerr << "ERROR: Failed to setup warp maps" << std::endl;
+                return false;
+            }
+            std::cout << "  ✓ Bird's-eye transformation ready" << std::endl;
+            return true;
+        });
+    #endif
+    
     #ifdef RENDER_PRESERVE_AS_CUSTOMHOMOGRAPHY
-        std::cout << "\n[3/4] Setting up custom homography with manual points..." << std::endl;
-        
-        // Try to load existing calibration points
-        if (!loadCalibrationPoints("../camparameters")) {
+        std::vector<std::string> homography_deps;
+        if (!loadCalibrationPoints(calib_folder, manual_src_points, manual_dst_points)) {
             // If no saved points, perform manual calibration
             std::cout << "  No saved calibration found. Starting manual calibration..." << std::endl;
             
-            if (!selectManualCalibrationPoints(frames)) {
-                std::cerr << "ERROR: Failed to select calibration points" << std::endl;
+            #ifdef CUSTOM_HOMOGRAPHY_INTERACTIVE
+                // Point picking needs live frames and a HighGUI window
+                const std::vector<std::string> manual_deps = {"first_frames"};
+                const SVStartupGraph::Affinity manual_affinity = SVStartupGraph::Affinity::MAIN;
+            #else
+                const std::vector<std::string> manual_deps;
+                const SVStartupGraph::Affinity manual_affinity = SVStartupGraph::Affinity::WORKER;
+            #endif
+            startup.add("manual_points", manual_deps, [this] {
+                if (!selectManualCalibrationPoints(frames)) {
+                    std::cerr << "ERROR: Failed to select calibration points" << std::endl;
+                    return false;
+                }
+                
+                // Save the calibration points for future use
+                if (!saveCalibrationPoints(calib_folder)) {
+                    std::cerr << "WARNING: Failed to save calibration points" << std::endl;
+                }
+                return true;
+            }, manual_affinity);
+            homography_deps.push_back("manual_points");
+        }
+        
+        // Build warp maps from the calibration points
+        startup.add("warp_maps", homography_deps, [this] {
+            if (!setupCustomHomographyMaps(manual_src_points, manual_dst_points, warp_maps)) {
+                std::cerr << "ERROR: Failed to setup custom homography maps" << std::endl;
                 return false;
             }
-            
-            // Save the calibration points for future use
-            if (!saveCalibrationPoints("../camparameters")) {
-                std::cerr << "WARNING: Failed to save calibration points" << std::endl;
+            std::cout << "  ✓ Custom homography ready" << std::endl;
+            return true;
+        });
+    #endif
+    
+    #ifdef EN_DECODE_CROP
+        // The maps decide the crops, so they are built before the pipelines start,
+        // unless calibration points are still to be picked on live frames (whole frames this run)
+        std::vector<std::string> crop_deps = {"warp_maps"};
+        #if defined(RENDER_PRESERVE_AS_CUSTOMHOMOGRAPHY) && defined(CUSTOM_HOMOGRAPHY_INTERACTIVE)
+            if (!homography_deps.empty()) {
+                crop_deps.clear();
             }
-        }
+        #endif
+        startup.add("source_crops", crop_deps, [this, capture_size] {
+            for (cv::Rect& crop : source_crops) {
+                if (crop.empty()) {
+                    crop = cv::Rect(cv::Point(), capture_size);
+                }
+            }
+            camera_source->setCropRegions(source_crops);
+            return true;
+        });
+    #endif
+    
+    #if defined(WARPING) || defined(RENDER_PRESERVE_AS_CUSTOMHOMOGRAPHY)
+        // Scaled input sizes come from the captured frames
+        startup.add("warp_buffers", {"warp_maps", "first_frames"}, [this] {
+            return reserveWarpBuffers();
+        });
+    #endif
+    
+    // Window, GL context and car model: bound to this thread
+    startup.add("renderer", {}, [this] {
+        renderer = std::make_shared<SVRenderSimple>(1920, 1080);
+        renderer->setCameraRig(rig);
         
-        // Build warp maps from the calibration points
-        if (!setupCustomHomographyMaps()) {
-            std::cerr << "ERROR: Failed to setup custom homography maps" << std::endl;
+        if (!renderer->init(
+            "../models/Dodge Challenger SRT Hellcat 2015.obj",
+            "../shaders/carshadervert.glsl",
+            "../shaders/carshaderfrag.glsl")) {
+            std::cerr << "ERROR: Failed to initialize renderer" << std::endl;
             return false;
         }
-        
-        std::cout << "  ✓ Custom homography ready" << std::endl;
+        std::cout << "  ✓ Renderer ready" << std::endl;
+        return true;
+    }, SVStartupGraph::Affinity::MAIN);
+    
+    #ifdef EN_BOWL_VIEW
+        startup.add("bowl_view", {"renderer", "calibration"}, [this, capture_size] {
+            if (static_cast<int>(camera_calibs.size()) != num_cameras) {
+                std::cerr << "WARNING: No camera calibration, 3D bowl view disabled" << std::endl;
+            } else if (!renderer->initBowlView(camera_calibs, capture_size)) {
+                std::cerr << "WARNING: 3D bowl view disabled" << std::endl;
+            }
+            return true;
+        }, SVStartupGraph::Affinity::MAIN);
     #endif
-
-    // ========================================
-    // STEP 3: Initialize Renderer (NO STITCHER!)
-    // ========================================
-    std::cout << "\n[3/3] Initializing 4-camera display renderer..." << std::endl;
     
-    renderer = std::make_shared<SVRenderSimple>(1920, 1080);
+    #ifdef EN_VIEW_PRESETS
+        // After warp_buffers: the pool is not safe to read while another task reserves
+        #if defined(WARPING) || defined(RENDER_PRESERVE_AS_CUSTOMHOMOGRAPHY)
+            const std::vector<std::string> preset_deps = {"first_frames", "calibration", "warp_buffers"};
+        #else
+            const std::vector<std::string> preset_deps = {"first_frames", "calibration"};
+        #endif
+        startup.add("view_presets", preset_deps, [this] {
+            if (static_cast<int>(camera_calibs.size()) != num_cameras) {
+                std::cerr << "WARNING: No camera calibration, view presets disabled" << std::endl;
+                return true;
+            }
+            
+            std::vector<cv::cuda::GpuMat> raw_samples(num_cameras);
+            for (int i = 0; i < num_cameras; i++) {
+                raw_samples[i] = frames[i].image.device();
+            }
+            
+            view_switcher = std::make_shared<SVViewSwitcher>();
+            view_switcher->setFramePool(frame_pool);
+            if (!view_switcher->init(defaultViewPresets(), rig, camera_calibs, raw_samples,
+                                     cv::Size(IPM_CANVAS_WIDTH, IPM_CANVAS_HEIGHT))) {
+                std::cerr << "WARNING: View presets disabled" << std::endl;
+                view_switcher.reset();
+            }
+            return true;
+        });
+    #endif
     
-    if (!renderer->init(
-        "../models/Dodge Challenger SRT Hellcat 2015.obj",
-        "../shaders/carshadervert.glsl",
-        "../shaders/carshaderfrag.glsl")) {
-        std::cerr << "ERROR: Failed to initialize renderer" << std::endl;
+    const bool started = startup.run();
+    startup.report();
+    if (!started) {
+        std::cerr << "ERROR: Startup failed" << std::endl;
         return false;
     }
     
-    std::cout << "  ✓ Renderer ready" << std::endl;
+    // All steady-state buffers are reserved at this point
+    frame_pool->setFrozen(true);
+    frame_pool->printSummary();
+    
+    #ifdef DEBUG_ALLOCATIONS
+        SVAllocTracker::install();
+        std::cout << "Allocation tracking enabled (warm-up: " << ALLOC_WARMUP_FRAMES
+                  << " frames)" << std::endl;
+    #endif
     
     // ========================================
     // Initialization Complete
@@ -176,16 +381,53 @@ bool SVAppSimple::init() {
     std::cout << "✓ System Initialization Complete!" << std::endl;
     std::cout << "========================================" << std::endl;
     std::cout << "\nConfiguration:" << std::endl;
-    std::cout << "  Cameras: " << NUM_CAMERAS << std::endl;
-    std::cout << "  Input resolution: 1280x800" << std::endl;
+    std::cout << "  Cameras: " << num_cameras << std::endl;
+    std::cout << "  Capture resolution: " << capture_size.width << "x" << capture_size.height << std::endl;
+    #ifdef EN_DUAL_RES_INGEST
+        std::cout << "  Zoom resolution: " << CAMERA_WIDTH << "x" << CAMERA_HEIGHT << std::endl;
+    #endif
+    #if defined(WARPING) && defined(WARPING_IPM)
+        std::cout << "  Stitch canvas: " << ipm_canvas.size.width << "x" << ipm_canvas.size.height << std::endl;
+    #elif defined(RENDER_PRESERVE_AS_CUSTOMHOMOGRAPHY)
+        std::cout << "  Stitch canvas: " << rig.canvas_size.width << "x" << rig.canvas_size.height << std::endl;
+    #endif
     std::cout << "  Output resolution: 1920x1080" << std::endl;
-    std::cout << "  Mode: Direct camera feed (NO STITCHING)" << std::endl;
+    std::cout << "  Mode: " << processingMode() << std::endl;
     std::cout << "\nLayout:" << std::endl;
     std::cout << "       [Front]" << std::endl;
     std::cout << "  [Left] [Car] [Right]" << std::endl;
     std::cout << "       [Rear]" << std::endl;
     std::cout << "\nPress ESC or close window to exit\n" << std::endl;
     
+    #ifdef EN_CALIB_HOT_RELOAD
+        #ifdef WARPING
+            const std::vector<std::string> calib_files = {"Camparam*.yaml"};
+        #else
+            const std::vector<std::string> calib_files = {"custom_homography_points.yaml"};
+        #endif
+        
+        calib_watcher = std::make_unique<SVCalibWatcher>();
+        if (!calib_watcher->start(calib_folder, calib_files,
+                                  [this](const std::vector<std::string>& changed) { reloadCalibration(changed); },
+                                  CALIB_RELOAD_SETTLE_MS)) {
+            std::cerr << "WARNING: Calibration hot reload disabled" << std::endl;
+            calib_watcher.reset();
+        }
+    #endif
+    
+    #ifdef EN_VEHICLE_STATE
+        rate_policy = std::make_unique<SVCameraRatePolicy>(rig);
+        camera_due.assign(num_cameras, true);
+        
+        SVVehicleInput::Options vehicle_opts;
+        vehicle_opts.stale_ms = VEHICLE_STATE_STALE_MS;
+        vehicle_opts.can_id = VEHICLE_CAN_ID;
+        const char* vehicle_env = std::getenv("SV_VEHICLE");
+        if (!vehicle_input.start(vehicle_env ? vehicle_env : VEHICLE_STATE_SOURCE, vehicle_opts)) {
+            std::cerr << "WARNING: No vehicle state, every camera at full rate" << std::endl;
+        }
+    #endif
+    
     is_running = true;
     return true;
 }
@@ -194,6 +436,35 @@ bool SVAppSimple::init() {
 void SVAppSimple::stop() {
     is_running = false;
     
+    #ifdef EN_CALIB_HOT_RELOAD
+        if (calib_watcher) {
+            calib_watcher->stop();
+        }
+    #endif
+    
+    #ifdef EN_VEHICLE_STATE
+        vehicle_input.stop();
+    #endif
+    
+    #ifdef EN_RECORDING
+        if (recording) {
+            toggleRecording();
+        }
+    #endif
+    
+    #ifdef EN_SESSION_RECORD
+        if (camera_source) {
+            camera_source->stopSession();
+        }
+    #endif
+    
+    #ifdef EN_RTP_OUTPUT
+        if (rtp_output) {
+            rtp_output->stop();
+            rtp_output.reset();
+        }
+    #endif
+    
     if (camera_source) {
         std::cout << "Stopping camera streams..." << std::endl;
         camera_source->stopStream();
@@ -203,16 +474,486 @@ void SVAppSimple::stop() {
 }
 
 
+#ifdef EN_RECORDING
+void SVAppSimple::toggleRecording() {
+    if (recording) {
+        // stop() drains the queue and finalizes the file
+        recording = false;
+        if (stitched_recorder) stitched_recorder->stop();
+        if (display_recorder) display_recorder->stop();
+        stitched_recorder.reset();
+        display_recorder.reset();
+        #if !defined(EN_RTP_OUTPUT) || !defined(RTP_STREAM_DISPLAY)
+            if (renderer) renderer->setReadBackEnabled(false);
+        #endif
+        std::cout << ">>> Recording STOPPED" << std::endl;
+        return;
+    }
+    
+    mkdir(RECORD_DIR, 0755);   // EEXIST is fine; a real failure shows up when the file is opened
+    
+    record_prefix = std::string(RECORD_DIR) + "/sv_" + fileTimestamp();
+    recording = true;
+    
+    #ifdef RECORD_DISPLAY
+        renderer->setReadBackEnabled(true);
+        SVVideoOutput::Options opts = SVVideoOutput::Options::file(
+            record_prefix + "_display" + RECORD_EXTENSION, renderer->readBackSize(), RECORD_FPS);
+        opts.encoder = RECORD_ENCODER;
+        opts.queue_depth = RECORD_QUEUE_DEPTH;
+        opts.flip_vertical = true;     // glReadPixels rows are bottom-up
+        
+        display_recorder = std::make_unique<SVVideoOutput>();
+        if (!display_recorder->start(opts)) {
+            display_recorder.reset();
+            #if !defined(EN_RTP_OUTPUT) || !defined(RTP_STREAM_DISPLAY)
+                renderer->setReadBackEnabled(false);
+            #endif
+        }
+    #endif
+    
+    std::cout << ">>> Recording to " << record_prefix << "_*" << RECORD_EXTENSION << std::endl;
+}
+
+void SVAppSimple::recordFrame(const SVFrameBuffer* right_frame, const cv::Mat* display) {
+    if (!recording) return;
+    
+    const int64_t pts_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    
+    #ifdef RECORD_STITCHED
+        if (right_frame && !right_frame->empty()) {
+            // Size is known only once something is shown; frames of another size
+            // (stitched vs. view preset) are counted as drops
+            if (!stitched_recorder) {
+                SVVideoOutput::Options opts = SVVideoOutput::Options::file(
+                    record_prefix + "_stitched" + RECORD_EXTENSION, right_frame->size(), RECORD_FPS);
+                opts.encoder = RECORD_ENCODER;
+                opts.queue_depth = RECORD_QUEUE_DEPTH;
+                
+                stitched_recorder = std::make_unique<SVVideoOutput>();
+                stitched_recorder->start(opts);
+            }
+            if (stitched_recorder->isRunning()) {
+                stitched_recorder->push(right_frame->host(), pts_ns);
+            }
+        }
+    #else
+        (void)right_frame;
+    #endif
+    
+    #ifdef RECORD_DISPLAY
+        if (display_recorder && display) {
+            display_recorder->push(*display, pts_ns);
+        }
+    #else
+        (void)display;
+    #endif
+}
+#endif
+
+#ifdef EN_RTP_OUTPUT
+void SVAppSimple::streamFrame(const SVFrameBuffer* right_frame, const cv::Mat* display) {
+    #ifdef RTP_STREAM_DISPLAY
+        (void)right_frame;
+        const cv::Mat* frame = display;
+        if (!rtp_output) {
+            // Read-back starts now; its first frame arrives two frames later
+            renderer->setReadBackEnabled(true);
+        }
+        const cv::Size size = renderer->readBackSize();
+    #else
+        (void)display;
+        const cv::Mat* frame = right_frame && !right_frame->empty() ? &right_frame->host() : nullptr;
+        if (!frame) return;
+        const cv::Size size = frame->size();
+    #endif
+    
+    // Started once; a stream that failed to start is not retried every frame
+    if (!rtp_output) {
+        SVVideoOutput::Options opts = SVVideoOutput::Options::rtp(RTP_HOST, RTP_PORT, size, RTP_FPS);
+        #ifdef RTP_ENCODER
+            opts.encoder = RTP_ENCODER;
+        #else
+            opts.encoder = SVVideoOutput::x264Live(RTP_BITRATE_KBPS, RTP_GOP,
+                                                   SVVideoOutput::Latency::RTP_LATENCY, RTP_FPS);
+        #endif
+        #ifdef RTP_STREAM_DISPLAY
+            opts.flip_vertical = true;     // glReadPixels rows are bottom-up
+        #endif
+        
+        rtp_output = std::make_unique<SVVideoOutput>();
+        rtp_output->start(opts);
+    }
+    
+    if (frame && rtp_output->isRunning()) {
+        rtp_output->push(*frame, std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+}
+#endif
+
+#if defined(EN_RECORDING) || defined(EN_RTP_OUTPUT)
+const cv::Mat* SVAppSimple::fetchDisplayReadBack() {
+    // Read-back of the previous frame: its copy has finished, mapping does not stall
+    if (!renderer->isReadBackEnabled() || !renderer->readBackFrame(display_readback)) {
+        return nullptr;
+    }
+    return &display_readback;
+}
+#endif
+
+
+#ifdef EN_SHM_OUTPUT
+void SVAppSimple::publishShm(const SVFrameBuffer* stitched) {
+    SVShmFrameInfo info;
+    info.timestamp_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    info.calib_id = calib_generation;
+    
+    #if defined(SHM_PUBLISH_WARPED) && (defined(WARPING) || defined(RENDER_PRESERVE_AS_CUSTOMHOMOGRAPHY))
+        shm_warped.resize(num_cameras);
+        for (int i = 0; i < num_cameras; i++) {
+            const cv::cuda::GpuMat& warped = frame_pool->device(warped_handles[i]);
+            if (warped.empty()) continue;
+            
+            const size_t bytes = warped.rows * warped.cols * warped.elemSize();
+            if (!shm_warped[i]) {
+                shm_warped[i] = std::make_unique<SVShmPublisher>();
+                shm_warped[i]->create(std::string(SHM_PREFIX) + "_warped" + std::to_string(i), bytes, SHM_SLOTS);
+            }
+            if (!shm_warped[i]->isOpen() || bytes > shm_warped[i]->maxFrameBytes()) continue;
+            
+            // Download straight into the slot: the only copy off the GPU
+            cv::Mat slot(warped.rows, warped.cols, warped.type(), shm_warped[i]->beginFrame());
+            svDownload(warped, slot);
+            
+            info.width = warped.cols;
+            info.height = warped.rows;
+            info.stride = static_cast<uint32_t>(slot.step);
+            info.format = SVShmFormat::BGR8;
+            info.source = i;
+            shm_warped[i]->commitFrame(info);
+        }
+    #endif
+    
+    if (stitched && !stitched->empty()) {
+        const cv::Mat& canvas = stitched->host();
+        const size_t bytes = canvas.rows * canvas.cols * canvas.elemSize();
+        if (!shm_stitched) {
+            shm_stitched = std::make_unique<SVShmPublisher>();
+            shm_stitched->create(std::string(SHM_PREFIX) + "_stitched", bytes, SHM_SLOTS);
+        }
+        if (shm_stitched->isOpen()) {
+            info.width = canvas.cols;
+            info.height = canvas.rows;
+            info.format = SVShmFormat::BGR8;
+            info.source = -1;
+            shm_stitched->publish(canvas.data, canvas.step, info);
+        }
+    }
+}
+#endif
+
+
+
+
+#if defined(WARPING) || defined(RENDER_PRESERVE_AS_CUSTOMHOMOGRAPHY)
+// Map pixels per capture pixel: IPM maps index the captured frame, homography
+// maps the CAMERA_WIDTH x HEIGHT frame scaled by scale_factor
+static float mapScale(float scale_factor) {
+    #ifdef WARPING_IPM
+        (void)scale_factor;
+        return 1.0f;
+    #else
+        return scale_factor * CAMERA_WIDTH / captureSize().width;
+    #endif
+}
+
+cv::Size SVAppSimple::scaledInputSize(int camera) const {
+    cv::Size delivered = captureSize();
+    #ifdef EN_DECODE_CROP
+        if (!source_crops[camera].empty()) {
+            delivered = source_crops[camera].size();
+        }
+    #else
+        (void)camera;
+    #endif
+    const float k = mapScale(scale_factor);
+    return cv::Size(cvRound(delivered.width * k), cvRound(delivered.height * k));
+}
+
+#ifdef EN_DECODE_CROP
+void SVAppSimple::cropWarpSource(int camera, cv::Mat& map_x, cv::Mat& map_y, const cv::Mat& valid) {
+    const cv::Size capture = captureSize();
+    const cv::Rect frame(cv::Point(), capture);
+    const float k = mapScale(scale_factor);
+    
+    // Map pixels read -> capture pixels, widened to even edges for the converter
+    cv::Rect needed = frame;
+    const cv::Rect bounds = warpSourceBounds(map_x, map_y,
+                                             cv::Size(cvRound(capture.width * k), cvRound(capture.height * k)), valid);
+    if (!bounds.empty()) {
+        const int x0 = static_cast<int>(std::floor(bounds.x / k)) & ~1;
+        const int y0 = static_cast<int>(std::floor(bounds.y / k)) & ~1;
+        const int x1 = (static_cast<int>(std::ceil(bounds.br().x / k)) + 1) & ~1;
+        const int y1 = (static_cast<int>(std::ceil(bounds.br().y / k)) + 1) & ~1;
+        needed = cv::Rect(cv::Point(x0, y0), cv::Point(x1, y1)) & frame;
+    }
+    
+    cv::Rect& crop = source_crops[camera];
+    if (crop.empty()) {
+        // First build, before the streams start
+        crop = needed;
+        std::cout << "  ✓ Camera " << camera << ": decoding " << crop.size() << " at (" << crop.x << ", " << crop.y
+                  << "), " << (100 * crop.area() / frame.area()) << "% of the frame" << std::endl;
+    } else if ((needed & crop) != needed) {
+        std::cerr << "WARNING: Camera " << camera << " maps read outside its decoded region "
+                  << crop << "; restart to re-crop" << std::endl;
+    }
+    
+    offsetWarpMaps(map_x, map_y, cv::Point2f(crop.x * k, crop.y * k));
+}
+#endif
+
+bool SVAppSimple::reserveWarpBuffers() {
+    if (static_cast<int>(warp_maps.x.size()) != num_cameras) {
+        std::cerr << "ERROR: Warp maps must be built before reserving warp buffers" << std::endl;
+        return false;
+    }
+    
+    for (int i = 0; i < num_cameras; i++) {
+        const std::string cam = "app cam" + std::to_string(i);
+        
+        #ifndef WARPING_IPM
+            // IPM maps index the raw frame; everything else is warped from a scaled copy
+            const cv::Size scaled_size = scaledInputSize(i);
+            scaled_handles[i] = frame_pool->reserveDevice(scaled_size, CV_8UC3, cam + " scaled");
+        #endif
+        warped_handles[i] = frame_pool->reserveDevice(warp_maps.x[i].size(), CV_8UC3, cam + " warped");
+    }
+    
+    #ifdef EN_SCENE_SKIP
+        SVChangeDetector::Options scene_opts;
+        scene_opts.thumb_size = cv::Size(SCENE_THUMB_WIDTH, SCENE_THUMB_HEIGHT);
+        scene_opts.pixel_threshold = SCENE_PIXEL_THRESHOLD;
+        scene_opts.changed_fraction = SCENE_CHANGED_FRACTION;
+        scene_opts.min_refresh_ms = SCENE_MIN_REFRESH_MS;
+        change_detector = SVChangeDetector(scene_opts);
+        change_detector.reset(num_cameras);
+        camera_changed.assign(num_cameras, true);
+        
+        thumb_handles.resize(num_cameras);
+        thumb_host_handles.resize(num_cameras);
+        for (int i = 0; i < num_cameras; i++) {
+            const std::string cam = "scene cam" + std::to_string(i);
+            thumb_handles[i] = frame_pool->reserveDevice(scene_opts.thumb_size, CV_8UC3, cam + " thumb");
+            thumb_host_handles[i] = frame_pool->reservePinned(scene_opts.thumb_size, CV_8UC3, cam + " thumb host");
+        }
+        thumb_stream = frame_pool->reserveStream("scene thumbs");
+    #endif
+    
+    return true;
+}
+
+#ifdef EN_SCENE_SKIP
+void SVAppSimple::detectSceneChanges() {
+    // One area resize per camera (a few KB each come back), all on one stream
+    cv::cuda::Stream& stream = frame_pool->stream(thumb_stream);
+    for (int i = 0; i < num_cameras; i++) {
+        cv::cuda::GpuMat& thumb = frame_pool->device(thumb_handles[i]);
+        cv::cuda::resize(frames[i].image.device(), thumb, thumb.size(), 0, 0, cv::INTER_AREA, stream);
+        svDownload(thumb, frame_pool->pinned(thumb_host_handles[i]), SVResidency::PINNED, stream);
+    }
+    stream.waitForCompletion();
+    
+    const auto now = SVChangeDetector::Clock::now();
+    for (int i = 0; i < num_cameras; i++) {
+        camera_changed[i] = change_detector.update(i, frame_pool->pinned(thumb_host_handles[i]).createMatHeader(), now);
+        if (camera_changed[i]) {
+            stitched_current = false;
+        }
+    }
+}
+#endif
+#endif
+
+#ifdef EN_VEHICLE_STATE
+void SVAppSimple::updateCameraRates(uint64_t frame) {
+    // Every view here shows all cameras (panels or stitch), so nothing is paused for visibility
+    const SVVehicleState state = vehicle_input.state();
+    if (rate_policy->update(state)) {
+        if (state.valid) {
+            std::cout << ">>> Vehicle " << gearName(state.gear) << ", " << state.speed_kmh << " km/h, turn "
+                      << turnSignalName(state.turn) << ": " << rate_policy->describe(rig) << std::endl;
+        } else {
+            std::cout << ">>> No current vehicle state: every camera at full rate" << std::endl;
+        }
+    }
+    
+    for (int i = 0; i < num_cameras; i++) {
+        camera_due[i] = rate_policy->due(i, frame);
+    }
+    camera_source->setCaptureMask(camera_due);
+}
+#endif
+
+#ifdef EN_PIPELINE_TUNER
+SVPipelineProfile SVAppSimple::pipelineProfile() {
+    const std::string path = std::string(PIPELINE_PROFILE_DIR) + "/pipeline_" + SVPipelineProfile::platformId() + ".yaml";
+    const char* retune = std::getenv("SV_TUNE_PIPELINE");
+    
+    SVPipelineProfile profile;
+    if (!(retune && *retune && *retune != '0') && profile.load(path)) {
+        std::cout << "✓ Pipeline profile '" << profile.name << "' (" << path << ")" << std::endl;
+        return profile;
+    }
+    
+    SVPipelineTuner tuner;
+    const char* session = std::getenv("SV_TUNE_SESSION");
+    if (session && *session) {
+        if (!tuner.setSessionSource(session, 0)) {
+            return profile;
+        }
+    } else {
+        tuner.setLiveSource(rig.dest_ip, rig.camera(0).port);
+    }
+    
+    SVPipelineTuner::Options tune_opts;
+    tune_opts.output_size = captureSize();
+    tune_opts.measure_seconds = PIPELINE_TUNE_SECONDS;
+    const std::vector<SVPipelineTuner::Result> results = tuner.run(SVPipelineProfile::candidates(), tune_opts);
+    const SVPipelineTuner::Result* best = SVPipelineTuner::best(results, tune_opts.max_drop_rate);
+    if (!best) {
+        std::cerr << "WARNING: No pipeline candidate delivered frames, using '" << profile.name << "'" << std::endl;
+        return profile;
+    }
+    
+    if (best->profile.save(path, {{"latency_ms", best->latency_ms},
+                                  {"latency_p95_ms", best->latency_p95_ms},
+                                  {"cpu_percent", best->cpu_percent},
+                                  {"drop_rate", best->drop_rate}})) {
+        std::cout << "✓ Pipeline profile '" << best->profile.name << "' saved to " << path << std::endl;
+    }
+    return best->profile;
+}
+#endif
+
+#ifdef EN_DUAL_RES_INGEST
+void SVAppSimple::handleZoomKeys() {
+    static auto last_zoom_press = std::chrono::steady_clock::now();
+    auto now = std::chrono::steady_clock::now();
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        now - last_zoom_press).count();
+    if (elapsed <= 500) return;
+    
+    for (int i = 0; i < std::min(num_cameras, 9); i++) {
+        if (glfwGetKey(renderer->getWindow(), GLFW_KEY_1 + i) != GLFW_PRESS) continue;
+        
+        // Same key again leaves the zoom; only the zoomed camera sends or decodes full resolution
+        zoom_camera = (zoom_camera == i) ? -1 : i;
+        camera_source->setZoomCamera(zoom_camera);
+        if (zoom_camera >= 0) {
+            std::cout << ">>> " << rig.camera(i).name << " at full resolution" << std::endl;
+        } else {
+            std::cout << ">>> Full resolution view DISABLED" << std::endl;
+        }
+        last_zoom_press = now;
+        break;
+    }
+}
+
+const SVFrameBuffer* SVAppSimple::zoomFrame() {
+    if (zoom_camera < 0) {
+        return nullptr;
+    }
+    
+    // Until the full-resolution stream delivers, show the stitch-resolution frame
+    if (camera_source->captureFull(zoom_frame)) {
+        return &zoom_frame.image;
+    }
+    return &frames[zoom_camera].image;
+}
+#endif
+
+#if defined(WARPING) || defined(EN_BOWL_VIEW) || defined(EN_VIEW_PRESETS)
+// ============================================================================
+// CAMERA CALIBRATION (IPM warp, 3D bowl, view presets)
+// ============================================================================
+
+bool SVAppSimple::loadCalibration(const std::string& folder, std::vector<SVCameraCalib>& calibs) const {
+    // Parsed into the caller's vector only; hot reload must not touch camera_calibs
+    std::vector<SVCameraCalib> loaded(num_cameras);
+    
+    for (int i = 0; i < num_cameras; i++) {
+        const std::string filename = folder + "/Camparam" + std::to_string(i) + ".yaml";
+        if (!loaded[i].load(filename)) {
+            return false;
+        }
+        #ifdef EN_DUAL_RES_INGEST
+            // Calibrated at full resolution, applied to the stitch-resolution stream
+            loaded[i].scaleIntrinsics(cv::Size(CAMERA_WIDTH, CAMERA_HEIGHT),
+                                      cv::Size(STITCH_CAPTURE_WIDTH, STITCH_CAPTURE_HEIGHT));
+        #endif
+        std::cout << "  ✓ Camera " << i << " calibration: " << filename
+                  << (loaded[i].dist.empty() ? " (no distortion)" : "") << std::endl;
+    }
+    
+    calibs.swap(loaded);
+    return true;
+}
+#endif
+
+#ifdef WARPING
+// ============================================================================
+// GROUND-PLANE WARP FROM CALIBRATION (IPM)
+// ============================================================================
 
+bool SVAppSimple::setupWarpMaps(const std::vector<SVCameraCalib>& calibs, const std::vector<cv::Size>& image_sizes,
+                                WarpMaps& maps) {
+    #ifdef WARPING_IPM
+        maps.x.resize(num_cameras);
+        maps.y.resize(num_cameras);
+        maps.valid.resize(num_cameras);
+        
+        std::cout << "Creating IPM maps: canvas " << ipm_canvas.size << " at "
+                  << ipm_canvas.mm_per_px << " mm/px" << std::endl;
+        
+        for (int i = 0; i < num_cameras; i++) {
+            cv::Mat xmap, ymap;
+            int covered = buildIPMMaps(calibs[i], ipm_canvas, image_sizes[i],
+                                       xmap, ymap, &maps.valid[i]);
+            if (covered == 0) {
+                std::cerr << "ERROR: Camera " << i << " does not see the ground canvas" << std::endl;
+                return false;
+            }
+            
+            #ifdef EN_DECODE_CROP
+                cropWarpSource(i, xmap, ymap, maps.valid[i]);
+            #endif
+            maps.x[i].upload(xmap);
+            maps.y[i].upload(ymap);
+            
+            std::cout << "  ✓ Camera " << i << ": IPM map covers "
+                      << (100 * covered / ipm_canvas.size.area()) << "% of the canvas" << std::endl;
+        }
+        return true;
+    #else
+        std::cerr << "ERROR: WARPING needs WARPING_IPM (the only calibrated warp implemented)" << std::endl;
+        return false;
+    #endif
+}
+#endif
 
 #ifdef RENDER_PRESERVE_AS_CUSTOMHOMOGRAPHY
 // ============================================================================
 // CUSTOM HOMOGRAPHY WITH MANUAL POINT SELECTION
 // ============================================================================
 
-bool SVAppSimple::setupCustomHomographyMaps() {
-    warp_x_maps.resize(NUM_CAMERAS);
-    warp_y_maps.resize(NUM_CAMERAS);
+bool SVAppSimple::setupCustomHomographyMaps(const std::vector<std::vector<cv::Point2f>>& src_points,
+                                            const std::vector<std::vector<cv::Point2f>>& dst_points, WarpMaps& maps) {
+    maps.x.resize(num_cameras);
+    maps.y.resize(num_cameras);
     
     std::cout << "Creating custom homography warp maps from manual points..." << std::endl;
     
@@ -223,16 +964,16 @@ bool SVAppSimple::setupCustomHomographyMaps() {
     // Output size for bird's-eye view
     cv::Size output_size = scaled_input;  // Keep same size as scaled input
     
-    for (int i = 0; i < NUM_CAMERAS; i++) {
+    for (int i = 0; i < num_cameras; i++) {
         // Get source and destination points for this camera
-        if (manual_src_points.empty() || manual_src_points[i].size() != 4 ||
-            manual_dst_points.empty() || manual_dst_points[i].size() != 4) {
+        if (static_cast<int>(src_points.size()) != num_cameras || src_points[i].size() != 4 ||
+            static_cast<int>(dst_points.size()) != num_cameras || dst_points[i].size() != 4) {
             std::cerr << "ERROR: Invalid calibration points for camera " << i << std::endl;
             return false;
         }
         
-        std::vector<cv::Point2f> src_pts = manual_src_points[i];
-        std::vector<cv::Point2f> dst_pts = manual_dst_points[i];
+        std::vector<cv::Point2f> src_pts = src_points[i];
+        std::vector<cv::Point2f> dst_pts = dst_points[i];
         
         // Scale source points for processing scale
         for (auto& pt : src_pts) {
@@ -247,35 +988,16 @@ bool SVAppSimple::setupCustomHomographyMaps() {
         std::cout << "  Camera " << i << " homography matrix:" << std::endl;
         std::cout << H << std::endl;
         
-        // Build warp maps using the homography
-        cv::Mat xmap(output_size, CV_32F);
-        cv::Mat ymap(output_size, CV_32F);
-        //=========GKT=====verify this homography mapping is it needed =================
-        for (int y = 0; y < output_size.height; y++) {
-            for (int x = 0; x < output_size.width; x++) {
-                // For each output pixel in bird's-eye view, find where it comes from in input
-                cv::Mat pt_dst = (cv::Mat_<double>(3,1) << x, y, 1.0);
-                cv::Mat pt_src = H * pt_dst;  // Apply homography
-                
-                double w_coord = pt_src.at<double>(2);
-                if (w_coord > 1e-6) {
-                    float src_x = static_cast<float>(pt_src.at<double>(0) / w_coord);
-                    float src_y = static_cast<float>(pt_src.at<double>(1) / w_coord);
-                    
-                    xmap.at<float>(y, x) = src_x;
-                    ymap.at<float>(y, x) = src_y;
-                } else {
-                    // Invalid point (w = 0), mark as out of bounds
-                    xmap.at<float>(y, x) = -1.0f;
-                    ymap.at<float>(y, x) = -1.0f;
-                }
-            }
-        }
-        
+        // Build warp maps using the homography (same maps as the offline tools)
+        cv::Mat xmap, ymap;
+        buildHomographyMaps(cv::Matx33d(H), output_size, xmap, ymap);
+        #ifdef EN_DECODE_CROP
+            cropWarpSource(i, xmap, ymap, cv::Mat());
+        #endif
         
         // Upload to GPU
-        warp_x_maps[i].upload(xmap);
-        warp_y_maps[i].upload(ymap);
+        maps.x[i].upload(xmap);
+        maps.y[i].upload(ymap);
         
         std::cout << "  ✓ Camera " << i << ": custom homography warp maps created" << std::endl;
     }
@@ -287,7 +1009,7 @@ bool SVAppSimple::setupCustomHomographyMaps() {
     // INTERACTIVE CALIBRATION - Requires GTK support in OpenCV
     // ============================================================================
     #ifdef CUSTOM_HOMOGRAPHY_INTERACTIVE
-    bool SVAppSimple::selectManualCalibrationPoints(const std::array<Frame, NUM_CAMERAS>& sample_frames) {
+    bool SVAppSimple::selectManualCalibrationPoints(const std::vector<Frame>& sample_frames) {
         std::cout << "\n========================================" << std::endl;
         std::cout << "INTERACTIVE CALIBRATION: Select 4 Points per Camera" << std::endl;
         std::cout << "========================================" << std::endl;
@@ -299,8 +1021,8 @@ bool SVAppSimple::setupCustomHomographyMaps() {
         std::cout << "  - Press 'R' to reset current camera" << std::endl;
         std::cout << "========================================\n" << std::endl;
         
-        manual_src_points.resize(NUM_CAMERAS);
-        manual_dst_points.resize(NUM_CAMERAS);
+        manual_src_points.resize(num_cameras);
+        manual_dst_points.resize(num_cameras);
         
         // Create destination points (output bird's-eye view rectangle)
         cv::Size scaled_input(CAMERA_WIDTH * scale_factor, CAMERA_HEIGHT * scale_factor);
@@ -311,16 +1033,15 @@ bool SVAppSimple::setupCustomHomographyMaps() {
             cv::Point2f(0.0f, static_cast<float>(scaled_input.height))
         };
         // All cameras use same destination rectangle
-        for (int i = 1; i < NUM_CAMERAS; i++) {
+        for (int i = 1; i < num_cameras; i++) {
             manual_dst_points[i] = manual_dst_points[0];
         }
         
-        for (int cam = 0; cam < NUM_CAMERAS; cam++) {
+        for (int cam = 0; cam < num_cameras; cam++) {
             std::cout << "Camera " << cam << ": Select 4 points..." << std::endl;
             
             // Download frame to CPU for display
-            cv::Mat cpu_frame;
-            sample_frames[cam].gpuFrame.download(cpu_frame);
+            const cv::Mat& cpu_frame = sample_frames[cam].image.host();
             
             // Create window and display image
             std::string window_name = "Camera " + std::to_string(cam) + " - Click 4 Points";
@@ -331,7 +1052,7 @@ bool SVAppSimple::setupCustomHomographyMaps() {
             std::vector<cv::Point2f> temp_points;
             
             // Set mouse callback - capture temp_points by reference
-            cv::setMouseCallback(window_name, [](int event, int x, int y, int flags, void* userdata) {
+            cv::setMouseCallback(window_name, [](int event, int x, int y, int /*flags*/, void* userdata) {
                 auto* pThis = static_cast<std::vector<cv::Point2f>*>(userdata);
                 if (event == cv::EVENT_LBUTTONDOWN) {
                     pThis->push_back(cv::Point2f(static_cast<float>(x), static_cast<float>(y)));
@@ -380,7 +1101,7 @@ bool SVAppSimple::setupCustomHomographyMaps() {
     // NON-INTERACTIVE CALIBRATION - Uses Default Points (No GTK Required)
     // ============================================================================
     #ifdef CUSTOM_HOMOGRAPHY_NONINTERACTIVE
-    bool SVAppSimple::selectManualCalibrationPoints(const std::array<Frame, NUM_CAMERAS>& sample_frames) {
+    bool SVAppSimple::selectManualCalibrationPoints(const std::vector<Frame>& /*sample_frames*/) {
         std::cout << "\n========================================" << std::endl;
         std::cout << "NON-INTERACTIVE CALIBRATION: Using Default Points" << std::endl;
         std::cout << "========================================" << std::endl;
@@ -392,8 +1113,8 @@ bool SVAppSimple::setupCustomHomographyMaps() {
         std::cout << "  3. Change header: #define CUSTOM_HOMOGRAPHY_INTERACTIVE" << std::endl;
         std::cout << "========================================\n" << std::endl;
         
-        manual_src_points.resize(NUM_CAMERAS);
-        manual_dst_points.resize(NUM_CAMERAS);
+        manual_src_points.resize(num_cameras);
+        manual_dst_points.resize(num_cameras);
         
         // Create destination points (output bird's-eye view rectangle)
         // IMPORTANT: Destination should span the FULL scaled output canvas
@@ -411,7 +1132,7 @@ bool SVAppSimple::setupCustomHomographyMaps() {
         std::cout << "Destination canvas size: " << scaled_input.width << "x" << scaled_input.height << std::endl;
         
         // All cameras use same destination rectangle
-        for (int i = 1; i < NUM_CAMERAS; i++) {
+        for (int i = 1; i < num_cameras; i++) {
             manual_dst_points[i] = manual_dst_points[0];
         }
         
@@ -423,40 +1144,18 @@ bool SVAppSimple::setupCustomHomographyMaps() {
         std::cout << "Source (full frame): (0,0)→(1280,800)" << std::endl;
         std::cout << "Destination (full canvas): (0,0)→(" << scaled_input.width << "," << scaled_input.height << ")" << std::endl;
         
-        // Camera 0: Front
-        manual_src_points[0] = {
-            cv::Point2f(0.0f, 0.0f),   // Top-left
-            cv::Point2f(1280.0f, 0.0f),  // Top-right
-            cv::Point2f(1280.0f, 800.0f),  // Bottom-right
-            cv::Point2f(0.0f, 800.0f)      // Bottom-left
-        };
-        
-        // Camera 1: Left (90° left view)
-        manual_src_points[1] = {
-            cv::Point2f(0.0f, 0.0f),   // Top-left
-            cv::Point2f(1280.0f, 0.0f),  // Top-right
-            cv::Point2f(1280.0f, 800.0f),  // Bottom-right
-            cv::Point2f(0.0f, 800.0f)      // Bottom-left
-        };
-        
-        // Camera 2: Rear (opposite of front)
-        manual_src_points[2] = {
-            cv::Point2f(0.0f, 0.0f),   // Top-left
-            cv::Point2f(1280.0f, 0.0f),  // Top-right
-            cv::Point2f(1280.0f, 800.0f),  // Bottom-right
-            cv::Point2f(0.0f, 800.0f)      // Bottom-left
-        };
-        
-        // Camera 3: Right (90° right view)
-        manual_src_points[3] = {
-            cv::Point2f(0.0f, 0.0f),   // Top-left
-            cv::Point2f(1280.0f, 0.0f),  // Top-right
-            cv::Point2f(1280.0f, 800.0f),  // Bottom-right
-            cv::Point2f(0.0f, 800.0f)      // Bottom-left
-        };
+        // Every camera starts from the full frame; refine per camera in the YAML file
+        for (int cam = 0; cam < num_cameras; cam++) {
+            manual_src_points[cam] = {
+                cv::Point2f(0.0f, 0.0f),       // Top-left
+                cv::Point2f(1280.0f, 0.0f),    // Top-right
+                cv::Point2f(1280.0f, 800.0f),  // Bottom-right
+                cv::Point2f(0.0f, 800.0f)      // Bottom-left
+            };
+        }
         
         std::cout << "Using default calibration points:" << std::endl;
-        for (int cam = 0; cam < NUM_CAMERAS; cam++) {
+        for (int cam = 0; cam < num_cameras; cam++) {
             std::cout << "  Camera " << cam << ":" << std::endl;
             for (int j = 0; j < 4; j++) {
                 std::cout << "    Point " << j << ": (" << manual_src_points[cam][j].x 
@@ -483,10 +1182,10 @@ bool SVAppSimple::setupCustomHomographyMaps() {
         return false;
     }
     
-    fs << "num_cameras" << NUM_CAMERAS;
+    fs << "num_cameras" << num_cameras;
     fs << "scale_factor" << scale_factor;
     
-    for (int i = 0; i < NUM_CAMERAS; i++) {
+    for (int i = 0; i < num_cameras; i++) {
         std::string src_key = "camera_" + std::to_string(i) + "_src_points";
         std::string dst_key = "camera_" + std::to_string(i) + "_dst_points";
         
@@ -499,36 +1198,20 @@ bool SVAppSimple::setupCustomHomographyMaps() {
     return true;
 }
 
-bool SVAppSimple::loadCalibrationPoints(const std::string& folder) {
+bool SVAppSimple::loadCalibrationPoints(const std::string& folder,
+                                        std::vector<std::vector<cv::Point2f>>& src_points,
+                                        std::vector<std::vector<cv::Point2f>>& dst_points) const {
     std::string filename = folder + "/custom_homography_points.yaml";
-    cv::FileStorage fs(filename, cv::FileStorage::READ);
-    
-    if (!fs.isOpened()) {
-        std::cout << "Note: Calibration file not found. Will need manual calibration." << std::endl;
-        return false;
-    }
-    
-    int saved_cameras = 0;
-    fs["num_cameras"] >> saved_cameras;
+    SVHomographyPoints points;
     
-    if (saved_cameras != NUM_CAMERAS) {
-        std::cerr << "ERROR: Saved calibration has " << saved_cameras << " cameras, expected " 
-                    << NUM_CAMERAS << std::endl;
+    if (!points.load(filename, num_cameras)) {
+        std::cout << "Note: No usable calibration points in " << filename
+                  << ". Will need manual calibration." << std::endl;
         return false;
     }
     
-    manual_src_points.resize(NUM_CAMERAS);
-    manual_dst_points.resize(NUM_CAMERAS);
-    
-    for (int i = 0; i < NUM_CAMERAS; i++) {
-        std::string src_key = "camera_" + std::to_string(i) + "_src_points";
-        std::string dst_key = "camera_" + std::to_string(i) + "_dst_points";
-        
-        fs[src_key] >> manual_src_points[i];
-        fs[dst_key] >> manual_dst_points[i];
-    }
-    
-    fs.release();
+    src_points = points.src;
+    dst_points = points.dst;
     std::cout << "  ✓ Loaded calibration points from: " << filename << std::endl;
     return true;
 }
@@ -545,59 +1228,32 @@ bool SVAppSimple::loadCalibrationPoints(const std::string& folder) {
             return false;
         }
         
-        // Capture sample frames for stitcher initialization
-        std::array<Frame, NUM_CAMERAS> sample_frames;
-        int attempts = 0;
-        bool got_frames = false;
-        
-        while (attempts < 50 && !got_frames) {
-            if (camera_source->capture(sample_frames)) {
-                bool all_valid = true;
-                for (int i = 0; i < NUM_CAMERAS; i++) {
-                    if (sample_frames[i].gpuFrame.empty()) {
-                        all_valid = false;
-                        break;
-                    }
-                }
-                
-                if (all_valid) {
-                    got_frames = true;
-                }
-            }
-            
-            if (!got_frames) {
-                std::this_thread::sleep_for(100ms);
-                attempts++;
-            }
-        }
-        
-        if (!got_frames) {
+        // Sample frames for stitcher initialization: blocks on each camera's next sample
+        std::vector<Frame> sample_frames(num_cameras);
+        if (!camera_source->waitForFrames(sample_frames, 5000)) {
             std::cerr << "ERROR: Failed to get sample frames for stitcher" << std::endl;
             return false;
         }
         
-        // Prepare sample frames as vector - SCALE FIRST just like in run()
-        std::vector<cv::cuda::GpuMat> sample_vec;
-        for (int i = 0; i < NUM_CAMERAS; i++) {
-            // Scale sample frames to match what will be used at runtime
-            cv::cuda::GpuMat scaled;
-            cv::cuda::resize(sample_frames[i].gpuFrame, scaled, cv::Size(),
-                            scale_factor, scale_factor, cv::INTER_LINEAR);
-            sample_vec.push_back(scaled);
-        }
-        
-        // Create stitcher
-        stitcher = std::make_shared<SVStitcherAuto>();
-        
-        #if defined(RENDER_PRESERVE_AS_CUSTOMHOMOGRAPHY)
-            // Initialize with warp maps from homography
-            // Pass scale_factor = 1.0 since frames are already scaled
-            if (!stitcher->init(sample_vec, warp_x_maps, warp_y_maps, 1.0f)) {
-                std::cerr << "ERROR: Failed to initialize stitcher" << std::endl;
+        #if defined(WARPING) || defined(RENDER_PRESERVE_AS_CUSTOMHOMOGRAPHY)
+            std::vector<cv::cuda::GpuMat> raw_samples(num_cameras);
+            for (int i = 0; i < num_cameras; i++) {
+                raw_samples[i] = sample_frames[i].image.device();
+            }
+            
+            // Reserves its buffers from the shared pool
+            frame_pool->setFrozen(false);
+            stitcher = createStitcher(warp_maps, raw_samples, frame_pool);
+            frame_pool->setFrozen(true);
+            if (!stitcher) {
                 return false;
             }
+            
+            #ifdef EN_CALIB_HOT_RELOAD
+                stitcher_active = true;     // Calibration reloads now rebuild it too
+            #endif
         #else
-            std::cerr << "ERROR: Stitching requires RENDER_PRESERVE_AS_CUSTOMHOMOGRAPHY mode" << std::endl;
+            std::cerr << "ERROR: Stitching requires WARPING_IPM or RENDER_PRESERVE_AS_CUSTOMHOMOGRAPHY mode" << std::endl;
             return false;
         #endif
         
@@ -605,6 +1261,55 @@ bool SVAppSimple::loadCalibrationPoints(const std::string& folder) {
         return true;
     }
 
+    #if defined(WARPING) || defined(RENDER_PRESERVE_AS_CUSTOMHOMOGRAPHY)
+    std::shared_ptr<SVStitcherAuto> SVAppSimple::createStitcher(const WarpMaps& maps,
+                                                                const std::vector<cv::cuda::GpuMat>& raw_samples,
+                                                                const std::shared_ptr<SVFramePool>& pool) {
+        // Picks the compute backend from SV_BACKEND / COMPUTE_BACKEND;
+        // without a pool the stitcher allocates a private one
+        auto new_stitcher = std::make_shared<SVStitcherAuto>();
+        if (pool) {
+            new_stitcher->setFramePool(pool);
+        }
+        new_stitcher->setRig(rig);
+        
+        std::vector<SVFrameBuffer> sample_vec(num_cameras);
+        #if defined(WARPING) && defined(WARPING_IPM)
+            // Every camera is warped straight into the shared ground canvas
+            SVCameraRig canvas_rig = rig;
+            canvas_rig.canvas_size = ipm_canvas.size;
+            canvas_rig.layout = SVStitchLayout::SECTORS;
+            for (auto& cam : canvas_rig.cameras) {
+                cam.canvas_origin = cv::Point(0, 0);
+            }
+            new_stitcher->setRig(canvas_rig);
+            new_stitcher->setValidMasks(maps.valid);
+            
+            for (int i = 0; i < num_cameras; i++) {
+                cv::cuda::remap(raw_samples[i], sample_vec[i].writeDevice(),
+                               maps.x[i], maps.y[i],
+                               cv::INTER_LINEAR, cv::BORDER_CONSTANT);
+            }
+        #else
+            // Prepare sample frames exactly like run(): scale, then warp with the homography maps
+            for (int i = 0; i < num_cameras; i++) {
+                cv::cuda::GpuMat scaled;
+                cv::cuda::resize(raw_samples[i], scaled, scaledInputSize(i),
+                                0, 0, cv::INTER_LINEAR);
+                cv::cuda::remap(scaled, sample_vec[i].writeDevice(),
+                               maps.x[i], maps.y[i],
+                               cv::INTER_LINEAR, cv::BORDER_CONSTANT);
+            }
+        #endif
+        
+        if (!new_stitcher->init(sample_vec)) {
+            std::cerr << "ERROR: Failed to initialize stitcher" << std::endl;
+            return nullptr;
+        }
+        return new_stitcher;
+    }
+    #endif
+
     void SVAppSimple::run() {
         if (!is_running) {
             std::cerr << "ERROR: System not initialized" << std::endl;
@@ -618,16 +1323,46 @@ bool SVAppSimple::loadCalibrationPoints(const std::string& folder) {
         std::cout << "\n========================================" << std::endl;
         std::cout << "CONTROLS:" << std::endl;
         std::cout << "  't' - Toggle stitched view (split screen)" << std::endl;
+        #ifdef EN_BOWL_VIEW
+            std::cout << "  'b' - Toggle 3D bowl view (right half)" << std::endl;
+        #endif
+        #ifdef EN_VIEW_PRESETS
+            std::cout << "  'v' - Next view preset (right half; off after the last one)" << std::endl;
+        #endif
+        #ifdef EN_RECORDING
+            std::cout << "  'r' - Start/stop recording (" << RECORD_DIR << ")" << std::endl;
+        #endif
+        #ifdef EN_SESSION_RECORD
+            std::cout << "  'w' - Start/stop session recording (" << SESSION_DIR << ")" << std::endl;
+        #endif
+        #ifdef EN_RTP_OUTPUT
+            std::cout << "  Streaming RTP/H.264 to " << RTP_HOST << ":" << RTP_PORT << std::endl;
+        #endif
+        #ifdef EN_EVENT_BUFFER
+            std::cout << "  'e' - Save event: last " << EVENT_PRE_SECONDS << " s + next "
+                      << EVENT_POST_SECONDS << " s (" << EVENT_DIR << ")" << std::endl;
+        #endif
         std::cout << "  ESC - Exit" << std::endl;
         std::cout << "========================================\n" << std::endl;
         
         std::cout << "Starting main loop..." << std::endl;
         
-        #if defined(WARPING) || defined(RENDER_PRESERVE_AS_CUSTOMHOMOGRAPHY)
-            std::vector<cv::cuda::GpuMat> warped_frames(NUM_CAMERAS);
+        #ifdef DEBUG_ALLOCATIONS
+            // Frames before this index may still allocate (first-use buffers, stitcher init)
+            int steady_state_from = ALLOC_WARMUP_FRAMES;
+            int allocating_frames = 0;
         #endif
         
         while (is_running && !renderer->shouldClose()) {
+            #ifdef DEBUG_ALLOCATIONS
+                SVAllocTracker::beginFrame();
+            #endif
+            
+            #ifdef EN_CALIB_HOT_RELOAD
+                // Frame boundary: pick up a calibration rebuilt in the background
+                applyCalibReload();
+            #endif
+            
             // ================================================
             // KEYBOARD INPUT
             // ================================================
@@ -645,6 +1380,9 @@ bool SVAppSimple::loadCalibrationPoints(const std::string& folder) {
                             show_stitched = true;
                             std::cout << ">>> Stitched view ENABLED" << std::endl;
                         }
+                        #ifdef DEBUG_ALLOCATIONS
+                            steady_state_from = frame_count + ALLOC_WARMUP_FRAMES;
+                        #endif
                     } else if (stitcher) {
                         show_stitched = !show_stitched;
                         std::cout << ">>> Stitched view " 
@@ -654,9 +1392,109 @@ bool SVAppSimple::loadCalibrationPoints(const std::string& folder) {
                 }
             }
             
+            #ifdef EN_BOWL_VIEW
+                if (glfwGetKey(renderer->getWindow(), GLFW_KEY_B) == GLFW_PRESS) {
+                    static auto last_b_press = std::chrono::steady_clock::now();
+                    auto now = std::chrono::steady_clock::now();
+                    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                        now - last_b_press).count();
+                    
+                    if (elapsed > 500 && renderer->hasBowlView()) {
+                        renderer->setBowlViewVisible(!renderer->isBowlViewVisible());
+                        std::cout << ">>> 3D bowl view "
+                                  << (renderer->isBowlViewVisible() ? "ENABLED" : "DISABLED") << std::endl;
+                        last_b_press = now;
+                    }
+                }
+            #endif
+            
+            #ifdef EN_VIEW_PRESETS
+                if (view_switcher && glfwGetKey(renderer->getWindow(), GLFW_KEY_V) == GLFW_PRESS) {
+                    static auto last_v_press = std::chrono::steady_clock::now();
+                    auto now = std::chrono::steady_clock::now();
+                    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                        now - last_v_press).count();
+                    
+                    if (elapsed > 500) {
+                        // Cached presets: selecting one only swaps a pointer
+                        const int next = show_view_preset ? view_switcher->activeIndex() + 1 : 0;
+                        show_view_preset = next < view_switcher->count();
+                        if (show_view_preset) {
+                            view_switcher->select(next, next == 0 ? 0 : VIEW_TRANSITION_FRAMES);
+                            std::cout << ">>> View preset: " << view_switcher->activeName() << std::endl;
+                        } else {
+                            std::cout << ">>> View presets DISABLED" << std::endl;
+                        }
+                        last_v_press = now;
+                    }
+                }
+            #endif
+            
+            #ifdef EN_RECORDING
+                if (glfwGetKey(renderer->getWindow(), GLFW_KEY_R) == GLFW_PRESS) {
+                    static auto last_r_press = std::chrono::steady_clock::now();
+                    auto now = std::chrono::steady_clock::now();
+                    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                        now - last_r_press).count();
+                    
+                    if (elapsed > 500) {
+                        toggleRecording();
+                        last_r_press = now;
+                    }
+                }
+            #endif
+            
+            #ifdef EN_SESSION_RECORD
+                if (glfwGetKey(renderer->getWindow(), GLFW_KEY_W) == GLFW_PRESS) {
+                    static auto last_w_press = std::chrono::steady_clock::now();
+                    auto now = std::chrono::steady_clock::now();
+                    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                        now - last_w_press).count();
+                    
+                    if (elapsed > 500) {
+                        if (camera_source->isSessionRecording()) {
+                            camera_source->stopSession();
+                        } else {
+                            mkdir(SESSION_DIR, 0755);
+                            const std::string path = std::string(SESSION_DIR) + "/sv_" + fileTimestamp() + ".svs";
+                            camera_source->startSession(path, SVSessionWriter::readCalibFolder(
+                                calib_folder, {"Camparam*.yaml", "custom_homography_points.yaml"}));
+                        }
+                        last_w_press = now;
+                    }
+                }
+            #endif
+            
+            #ifdef EN_EVENT_BUFFER
+                if (event_buffer && glfwGetKey(renderer->getWindow(), GLFW_KEY_E) == GLFW_PRESS) {
+                    static auto last_e_press = std::chrono::steady_clock::now();
+                    auto now = std::chrono::steady_clock::now();
+                    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                        now - last_e_press).count();
+                    
+                    if (elapsed > 500) {
+                        // Written in the background; capture and render carry on
+                        if (event_buffer->trigger()) {
+                            std::cout << ">>> Event triggered, saving " << EVENT_POST_SECONDS
+                                      << " s more footage" << std::endl;
+                        } else {
+                            std::cout << ">>> Previous event still being saved" << std::endl;
+                        }
+                        last_e_press = now;
+                    }
+                }
+            #endif
+            
+            #ifdef EN_DUAL_RES_INGEST
+                handleZoomKeys();
+            #endif
+            
             // ================================================
             // CAPTURE FRAMES
             // ================================================
+            #ifdef EN_VEHICLE_STATE
+                updateCameraRates(frame_count);
+            #endif
             if (!camera_source->capture(frames)) {
                 std::cerr << "WARNING: Frame capture failed" << std::endl;
                 std::this_thread::sleep_for(1ms);
@@ -665,8 +1503,8 @@ bool SVAppSimple::loadCalibrationPoints(const std::string& folder) {
             
             // Validate frames
             bool all_valid = true;
-            for (int i = 0; i < NUM_CAMERAS; i++) {
-                if (frames[i].gpuFrame.empty()) {
+            for (int i = 0; i < num_cameras; i++) {
+                if (frames[i].image.empty()) {
                     all_valid = false;
                     break;
                 }
@@ -677,41 +1515,78 @@ bool SVAppSimple::loadCalibrationPoints(const std::string& folder) {
                 continue;
             }
             
+            #ifdef EN_CALIB_HOT_RELOAD
+                if (reload_wants_samples) {
+                    provideReloadSamples();
+                }
+            #endif
+            
             #if defined(WARPING) || defined(RENDER_PRESERVE_AS_CUSTOMHOMOGRAPHY)
+                #ifdef EN_SCENE_SKIP
+                    detectSceneChanges();
+                #endif
+                
                 // ================================================
                 // WARP FRAMES
                 // ================================================
-                for (int i = 0; i < NUM_CAMERAS; i++) {
-                    // 1. Resize to processing scale
-                    cv::cuda::GpuMat scaled;
-                    cv::cuda::resize(frames[i].gpuFrame, scaled, cv::Size(),
-                                    scale_factor, scale_factor, cv::INTER_LINEAR);
-                    
-                    // 2. Apply  NON-INTERACTIVE CALIBRATION - Uses Default Points (No GTK Required) warp (bird's-eye transformation)
-                    cv::cuda::remap(scaled, warped_frames[i],
-                                warp_x_maps[i], warp_y_maps[i],
-                                cv::INTER_LINEAR, cv::BORDER_CONSTANT);
+                for (int i = 0; i < num_cameras; i++) {
+                    #ifdef EN_VEHICLE_STATE
+                        if (!camera_due[i]) {
+                            continue;   // Not captured this frame either
+                        }
+                    #endif
+                    #ifdef EN_SCENE_SKIP
+                        if (!camera_changed[i]) {
+                            continue;   // Warped buffer still holds this camera's last result
+                        }
+                    #endif
+                    cv::cuda::GpuMat& warped = frame_pool->device(warped_handles[i]);
                     
+                    #ifdef WARPING_IPM
+                        // IPM: one remap from the raw frame into the shared ground canvas
+                        cv::cuda::remap(frames[i].image.device(), warped,
+                                    warp_maps.x[i], warp_maps.y[i],
+                                    cv::INTER_LINEAR, cv::BORDER_CONSTANT);
+                    #else
+                        cv::cuda::GpuMat& scaled = frame_pool->device(scaled_handles[i]);
+                        cv::cuda::GpuMat input = frames[i].image.device();
+                        
+                        // 1. Resize to processing scale (dual-resolution ingest may already capture at it)
+                        if (input.size() != scaled.size()) {
+                            cv::cuda::resize(input, scaled, scaled.size(),
+                                            0, 0, cv::INTER_LINEAR);
+                            input = scaled;
+                        }
+                        
+                        // 2. Apply  NON-INTERACTIVE CALIBRATION - Uses Default Points (No GTK Required) warp (bird's-eye transformation)
+                        cv::cuda::remap(input, warped,
+                                    warp_maps.x[i], warp_maps.y[i],
+                                    cv::INTER_LINEAR, cv::BORDER_CONSTANT);
+                    #endif
                 }
                 
                 // ================================================
                 // STITCHING (if enabled)
                 // ================================================
-                if (show_stitched && stitcher && stitcher->isInitialized()) {
-                    std::vector<cv::cuda::GpuMat> raw_vec, warped_vec;
-                    
+                bool stitch_due = true;
+                #ifdef EN_SCENE_SKIP
+                    stitch_due = !stitched_current;     // Reuse the canvas while no camera changed
+                #endif
+                if (show_stitched && stitcher && stitcher->isInitialized() && stitch_due) {
                     // Use the SAME frames that are being rendered
-                    // warped_frames are already scaled at scale_factor (0.5)
-                    for (int i = 0; i < NUM_CAMERAS; i++) {
-                        raw_vec.push_back(frames[i].gpuFrame);      // Original raw frames (for gain compensation reference)
-                        // raw_vec.push_back(warped_frames[i]);        // Use scaled & warped frames as "raw"
-                        warped_vec.push_back(warped_frames[i]);      // Already scaled & warped
+                    // warped frames are already scaled at scale_factor (0.5)
+                    // (vectors are sized once; buffers are attached, not copied)
+                    for (int i = 0; i < num_cameras; i++) {
+                        stitch_warped_vec[i].attachDevice(frame_pool->device(warped_handles[i]));    // Already scaled & warped
                     }
                     
-                    if (!stitcher->stitch(raw_vec, warped_vec, stitched_output)) {
+                    if (!stitcher->stitch(stitch_warped_vec, stitched_output)) {
                         std::cerr << "WARNING: Stitching failed" << std::endl;
                         show_stitched = false; // Disable on error
                     }
+                    #ifdef EN_SCENE_SKIP
+                        stitched_current = show_stitched;
+                    #endif
                 }
                 
                 // ================================================
@@ -719,9 +1594,8 @@ bool SVAppSimple::loadCalibrationPoints(const std::string& folder) {
                 // ================================================
                 // USE RAW UNWARPED FRAMES for display to see full camera view
                 // Don't use warped_frames which are perspective-transformed and appear zoomed
-                std::array<cv::cuda::GpuMat, 4> display_frames;
-                for (int i = 0; i < NUM_CAMERAS; i++) {
-                    display_frames[i] = frames[i].gpuFrame;  // Use RAW frame - FULL VIEW
+                for (int i = 0; i < num_cameras; i++) {
+                    display_frames[i] = frames[i].image.device();  // Use RAW frame - FULL VIEW
                     // display_frames[i] = warped_frames[i];  // This would use warped/perspective view
                 }
                 
@@ -737,8 +1611,8 @@ bool SVAppSimple::loadCalibrationPoints(const std::string& folder) {
                     
                     // Download GPU frames to CPU
                     cv::Mat warped_cpu, display_cpu;
-                    warped_frames[cam_idx].download(warped_cpu);
-                    display_frames[cam_idx].download(display_cpu);
+                    svDownload(frame_pool->device(warped_handles[cam_idx]), warped_cpu);
+                    svDownload(display_frames[cam_idx], display_cpu);
                     
                     // Save images in build folder
                     std::string warped_path = "./camera_" + std::to_string(cam_idx) + "_warped.png";
@@ -763,34 +1637,87 @@ bool SVAppSimple::loadCalibrationPoints(const std::string& folder) {
                 // ================================================
                 // RENDER - Always use split-viewport layout
                 // ================================================
-                const cv::cuda::GpuMat* stitch_ptr = nullptr;
+                const SVFrameBuffer* stitch_ptr = nullptr;
                 if (show_stitched && !stitched_output.empty()) {
                     stitch_ptr = &stitched_output;
                 }
+                #ifdef EN_VIEW_PRESETS
+                    if (renderViewPreset()) {
+                        stitch_ptr = &view_output;
+                    }
+                #endif
+                #ifdef EN_DUAL_RES_INGEST
+                    if (const SVFrameBuffer* zoom = zoomFrame()) {
+                        stitch_ptr = zoom;
+                    }
+                #endif
                 
-                if (!renderer->renderSplitViewportLayout(display_frames, show_stitched, stitch_ptr)) {
+                if (!renderer->renderSplitViewportLayout(display_frames, stitch_ptr != nullptr, stitch_ptr)) {
                     std::cerr << "ERROR: Split-viewport rendering failed" << std::endl;
                     break;
                 }
+                #if defined(EN_RECORDING) || defined(EN_RTP_OUTPUT)
+                    {
+                        const SVFrameBuffer* right_frame = renderer->isBowlViewVisible() ? nullptr : stitch_ptr;
+                        const cv::Mat* display = fetchDisplayReadBack();
+                        #ifdef EN_RECORDING
+                            recordFrame(right_frame, display);
+                        #endif
+                        #ifdef EN_RTP_OUTPUT
+                            streamFrame(right_frame, display);
+                        #endif
+                    }
+                #endif
+                #ifdef EN_SHM_OUTPUT
+                    publishShm(show_stitched && !stitched_output.empty() ? &stitched_output : nullptr);
+                #endif
                 
             #else
                 // Original non-warped rendering
-                std::array<cv::cuda::GpuMat, 4> gpu_frames;
-                for (int i = 0; i < NUM_CAMERAS; i++) {
-                    gpu_frames[i] = frames[i].gpuFrame;
+                for (int i = 0; i < num_cameras; i++) {
+                    display_frames[i] = frames[i].image.device();
                 }
                 
+                const SVFrameBuffer* right_ptr = nullptr;
+                #ifdef EN_VIEW_PRESETS
+                    if (renderViewPreset()) {
+                        right_ptr = &view_output;
+                    }
+                #endif
+                #ifdef EN_DUAL_RES_INGEST
+                    if (const SVFrameBuffer* zoom = zoomFrame()) {
+                        right_ptr = zoom;
+                    }
+                #endif
+                
                 // Always use split-viewport layout (right panel black until 't' pressed)
-                if (!renderer->renderSplitViewportLayout(gpu_frames, show_stitched, nullptr)) {
+                if (!renderer->renderSplitViewportLayout(display_frames, show_stitched || right_ptr, right_ptr)) {
                     std::cerr << "ERROR: Split-viewport rendering failed" << std::endl;
                     break;
                 }
+                #if defined(EN_RECORDING) || defined(EN_RTP_OUTPUT)
+                    {
+                        const SVFrameBuffer* right_frame = renderer->isBowlViewVisible() ? nullptr : right_ptr;
+                        const cv::Mat* display = fetchDisplayReadBack();
+                        #ifdef EN_RECORDING
+                            recordFrame(right_frame, display);
+                        #endif
+                        #ifdef EN_RTP_OUTPUT
+                            streamFrame(right_frame, display);
+                        #endif
+                    }
+                #endif
             #endif
             
             // ================================================
             // FPS CALCULATION
             // ================================================
             frame_count++;
+            if (frame_count == 1) {
+                auto first_image = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::steady_clock::now() - startup_begin).count();
+                std::cout << "✓ First image on screen " << first_image << " ms after startup" << std::endl;
+            }
             if (frame_count % 30 == 0) {
                 auto now = std::chrono::steady_clock::now();
                 auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
@@ -803,14 +1730,215 @@ bool SVAppSimple::loadCalibrationPoints(const std::string& folder) {
                             << std::endl;
                 }
                 
+                // Cameras being reconnected show their last frame
+                if (!camera_source->isReplay()) {
+                    for (int i = 0; i < num_cameras; i++) {
+                        const EthernetCameraSource::State s = camera_source->getCameraState(i);
+                        if (s != EthernetCameraSource::State::LIVE) {
+                            std::cout << "  WARNING: Camera " << i << " " << EthernetCameraSource::stateName(s)
+                                      << " (" << camera_source->getCamera(i).getReconnects() << " reconnects)" << std::endl;
+                        }
+                    }
+                }
+                
+                #ifdef EN_SCENE_SKIP
+                    static SVChangeDetector::Stats last_scene;
+                    const SVChangeDetector::Stats scene = change_detector.total();
+                    const uint64_t skipped = scene.skipped - last_scene.skipped;
+                    const uint64_t seen = skipped + scene.processed - last_scene.processed;
+                    std::cout << "  Scene: " << skipped << "/" << seen << " camera frames reused"
+                              << (stitched_current ? ", canvas unchanged" : "") << std::endl;
+                    last_scene = scene;
+                #endif
+                
+                #ifdef DEBUG_TRANSFERS
+                    static SVTransferStats::Entry last_crossings;
+                    SVTransferStats::Entry crossings = SVTransferStats::crossings();
+                    std::cout << "  Host/device transfers: "
+                              << (crossings.count - last_crossings.count) / 30.0f << " per frame, "
+                              << (crossings.bytes - last_crossings.bytes) / (30 * 1024) << " KB per frame"
+                              << std::endl;
+                    last_crossings = crossings;
+                #endif
+                
                 last_fps_time = now;
             }
             
+            #ifdef DEBUG_ALLOCATIONS
+                // Steady-state frames must not allocate: every buffer comes from frame_pool
+                SVAllocTracker::Counts allocs = SVAllocTracker::endFrame();
+                if (frame_count > steady_state_from && allocs.sum() > 0) {
+                    allocating_frames++;
+                    std::cerr << "✗ ALLOC: steady-state frame " << frame_count
+                              << " allocated host=" << allocs.host
+                              << " device=" << allocs.device << std::endl;
+                }
+            #endif
+            
             std::this_thread::sleep_for(1ms);
         }
         
+        #ifdef DEBUG_ALLOCATIONS
+            std::cout << "\nAllocation check: " << allocating_frames
+                      << " steady-state frame(s) allocated"
+                      << (allocating_frames == 0 ? " ✓" : " ✗") << std::endl;
+        #endif
+        
+        #ifdef DEBUG_TRANSFERS
+            SVTransferStats::printSummary();
+        #endif
+        
+        SVThreadPool::instance().printSummary();
+        
         std::cout << "\nMain loop exited" << std::endl;
     }
 
+    #ifdef EN_VIEW_PRESETS
+    bool SVAppSimple::renderViewPreset() {
+        if (!show_view_preset || !view_switcher) {
+            return false;
+        }
+        
+        // Raw frames straight through the active preset's cached LUT
+        if (!view_switcher->render(display_frames, view_output)) {
+            std::cerr << "WARNING: View preset rendering failed" << std::endl;
+            show_view_preset = false;
+            return false;
+        }
+        return true;
+    }
+    #endif
+
+
+#endif
 
+#ifdef EN_CALIB_HOT_RELOAD
+// ============================================================================
+// CALIBRATION HOT RELOAD
+// ============================================================================
+
+void SVAppSimple::reloadCalibration(const std::vector<std::string>& changed) {
+    // Runs on the watcher thread; only hands results to the render loop via pending_reload
+    std::cout << "\n>>> Calibration changed:";
+    for (const auto& name : changed) {
+        std::cout << " " << name;
+    }
+    std::cout << std::endl;
+    auto start = std::chrono::steady_clock::now();
+    
+    // Current raw frames for the stitcher's gain state
+    std::vector<cv::cuda::GpuMat> samples;
+    if (!requestReloadSamples(samples)) {
+        std::cerr << "WARNING: No frames from the render loop, calibration not reloaded" << std::endl;
+        return;
+    }
+    
+    // Parsed into the update only: the render loop reads the current calibration until it is applied
+    auto update = std::make_shared<CalibReload>();
+    #ifdef WARPING
+        // Maps index the whole capture frame (as at init); cropWarpSource offsets them to the decoded region
+        std::vector<cv::Size> image_sizes(num_cameras, captureSize());
+        bool built = loadCalibration(calib_folder, update->calibs) &&
+                     setupWarpMaps(update->calibs, image_sizes, update->maps);
+    #else
+        bool built = loadCalibrationPoints(calib_folder, update->src_points, update->dst_points) &&
+                     setupCustomHomographyMaps(update->src_points, update->dst_points, update->maps);
+    #endif
+    if (!built) {
+        std::cerr << "WARNING: Calibration reload failed, keeping the current maps" << std::endl;
+        return;
+    }
+    
+    // Warp buffers were reserved at init and the pool is frozen: sizes must not change
+    for (int i = 0; i < num_cameras; i++) {
+        if (update->maps.x[i].size() != frame_pool->device(warped_handles[i]).size()) {
+            std::cerr << "WARNING: Camera " << i << " warp size changed to " << update->maps.x[i].size()
+                      << ", restart to apply this calibration" << std::endl;
+            return;
+        }
+    }
+    
+    // Blend masks and gain state follow the maps (private pool: the shared one is frozen)
+    if (stitcher_active) {
+        update->stitcher = createStitcher(update->maps, samples, nullptr);
+        if (!update->stitcher) {
+            std::cerr << "WARNING: Calibration reload failed, keeping the current maps" << std::endl;
+            return;
+        }
+    }
+    
+    std::atomic_store(&pending_reload, std::shared_ptr<const CalibReload>(update));
+    
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start).count();
+    std::cout << "✓ Calibration rebuilt in " << elapsed << " ms, applied on the next frame" << std::endl;
+}
+
+bool SVAppSimple::requestReloadSamples(std::vector<cv::cuda::GpuMat>& samples) {
+    std::unique_lock<std::mutex> lock(reload_mutex);
+    reload_samples.clear();
+    reload_wants_samples = true;
+    
+    if (!reload_cv.wait_for(lock, 2s, [this] { return !reload_wants_samples; })) {
+        reload_wants_samples = false;
+        return false;
+    }
+    
+    samples.swap(reload_samples);
+    return true;
+}
+
+void SVAppSimple::provideReloadSamples() {
+    {
+        std::lock_guard<std::mutex> lock(reload_mutex);
+        if (!reload_wants_samples) {
+            return;
+        }
+        
+        // Own copies: capture buffers are reused by the next frame
+        reload_samples.resize(num_cameras);
+        for (int i = 0; i < num_cameras; i++) {
+            frames[i].image.device().copyTo(reload_samples[i]);
+        }
+        reload_wants_samples = false;
+    }
+    reload_cv.notify_one();
+}
+
+void SVAppSimple::applyCalibReload() {
+    std::shared_ptr<const CalibReload> update =
+        std::atomic_exchange(&pending_reload, std::shared_ptr<const CalibReload>());
+    if (!update) {
+        return;
+    }
+    
+    // Pointer swap only: the maps were uploaded on the watcher thread
+    warp_maps = update->maps;
+    #ifdef WARPING
+        camera_calibs = update->calibs;
+    #else
+        manual_src_points = update->src_points;
+        manual_dst_points = update->dst_points;
+    #endif
+    if (update->stitcher) {
+        stitcher = update->stitcher;
+    } else if (stitcher) {
+        // Stitching was started while the reload was built: its masks match the old maps
+        stitcher.reset();
+        stitcher_active = false;
+        show_stitched = false;
+        std::cout << ">>> Stitched view DISABLED by calibration change, press 't' to rebuild" << std::endl;
+    }
+    
+    #ifdef EN_SHM_OUTPUT
+        calib_generation++;
+    #endif
+    #ifdef EN_SCENE_SKIP
+        // New maps: every camera is re-warped and the canvas re-stitched
+        change_detector.invalidate();
+        stitched_current = false;
+    #endif
+    
+    std::cout << ">>> Calibration reloaded" << std::endl;
+}
 #endif
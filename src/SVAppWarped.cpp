@@ -150,7 +150,7 @@ bool SVAppWarped::init() {
         if (camera_source->capture(frames)) {
             bool all_valid = true;
             for (int i = 0; i < NUM_CAMERAS; i++) {
-                if (frames[i].gpuFrame.empty()) {
+                if (frames[i].image.empty()) {
                     all_valid = false;
                     break;
                 }
@@ -246,7 +246,7 @@ void SVAppWarped::run() {
         // Validate frames
         bool all_valid = true;
         for (int i = 0; i < NUM_CAMERAS; i++) {
-            if (frames[i].gpuFrame.empty()) {
+            if (frames[i].image.empty()) {
                 all_valid = false;
                 break;
             }
@@ -263,7 +263,7 @@ void SVAppWarped::run() {
         for (int i = 0; i < NUM_CAMERAS; i++) {
             // 1. Resize to processing scale
             cv::cuda::GpuMat scaled;
-            cv::cuda::resize(frames[i].gpuFrame, scaled, cv::Size(),
+            cv::cuda::resize(frames[i].image.device(), scaled, cv::Size(),
                             scale_factor, scale_factor, cv::INTER_LINEAR);
             
             // 2. Apply spherical warp (bird's-eye transformation)
@@ -0,0 +1,183 @@
+#include "SVBackendCPU.hpp"
+#include "SVThreadPool.hpp"
+#include <opencv2/imgproc.hpp>
+
+namespace {
+
+// Rows per pool task; keeps stripes large enough to amortise scheduling
+constexpr int ROW_GRAIN = 16;
+
+// Weight below which a canvas pixel counts as not covered by any camera
+constexpr float BLEND_EPS = 1e-5f;
+
+void forRows(int rows, const std::function<void(int, int)>& body) {
+    SVThreadPool::instance().parallelForRange(0, rows, body, ROW_GRAIN);
+}
+
+template <typename T>
+void feedRows(const cv::Mat& img, const cv::Mat& mask, cv::Mat& acc, cv::Mat& weight,
+              const cv::Rect& src_rect, const cv::Rect& dst_rect, int y0, int y1) {
+    const float inv255 = 1.0f / 255.0f;
+
+    for (int y = y0; y < y1; y++) {
+        const T* img_row = img.ptr<T>(src_rect.y + y) + src_rect.x * 3;
+        const uchar* mask_row = mask.ptr<uchar>(src_rect.y + y) + src_rect.x;
+        float* acc_row = acc.ptr<float>(dst_rect.y + y) + dst_rect.x * 3;
+        float* weight_row = weight.ptr<float>(dst_rect.y + y) + dst_rect.x;
+
+        for (int x = 0; x < dst_rect.width; x++) {
+            if (mask_row[x] == 0) continue;
+            float w = mask_row[x] * inv255;
+            acc_row[3 * x + 0] += img_row[3 * x + 0] * w;
+            acc_row[3 * x + 1] += img_row[3 * x + 1] * w;
+            acc_row[3 * x + 2] += img_row[3 * x + 2] * w;
+            weight_row[x] += w;
+        }
+    }
+}
+
+} // namespace
+
+// ============================================================================
+// SVBackendCPU Implementation
+// ============================================================================
+
+void SVBackendCPU::convert(cv::InputArray src_, cv::OutputArray dst_, int rtype,
+                           double alpha, double beta) {
+    cv::Mat src = src_.getMat();
+    dst_.create(src.size(), CV_MAKETYPE(CV_MAT_DEPTH(rtype), src.channels()));
+    cv::Mat dst = dst_.getMat();
+
+    forRows(src.rows, [&](int y0, int y1) {
+        cv::Mat dst_rows = dst.rowRange(y0, y1);
+        src.rowRange(y0, y1).convertTo(dst_rows, rtype, alpha, beta);
+    });
+}
+
+void SVBackendCPU::cvtColor(cv::InputArray src, cv::OutputArray dst, int code) {
+    cv::cvtColor(src, dst, code);
+}
+
+void SVBackendCPU::resize(cv::InputArray src, cv::OutputArray dst, cv::Size dsize,
+                          int interpolation) {
+    cv::resize(src, dst, dsize, 0, 0, interpolation);
+}
+
+void SVBackendCPU::remap(cv::InputArray src, cv::OutputArray dst,
+                         cv::InputArray map_x, cv::InputArray map_y,
+                         int interpolation, int border_mode) {
+    cv::remap(src, dst, map_x, map_y, interpolation, border_mode);
+}
+
+void SVBackendCPU::applyGain(cv::InputArray src_, cv::OutputArray dst_, const cv::Scalar& gains) {
+    cv::Mat src = src_.getMat();
+    dst_.create(src.size(), src.type());
+    cv::Mat dst = dst_.getMat();
+
+    forRows(src.rows, [&](int y0, int y1) {
+        cv::Mat dst_rows = dst.rowRange(y0, y1);
+        cv::multiply(src.rowRange(y0, y1), gains, dst_rows);
+    });
+}
+
+void SVBackendCPU::blendPrepare(cv::Size canvas, cv::OutputArray acc, cv::OutputArray weight) {
+    acc.create(canvas, CV_32FC3);
+    weight.create(canvas, CV_32F);
+    cv::Mat acc_mat = acc.getMat();
+    cv::Mat weight_mat = weight.getMat();
+
+    forRows(canvas.height, [&](int y0, int y1) {
+        acc_mat.rowRange(y0, y1).setTo(cv::Scalar::all(0));
+        weight_mat.rowRange(y0, y1).setTo(cv::Scalar::all(0));
+    });
+}
+
+void SVBackendCPU::blendFeed(cv::InputArray img_, cv::InputArray mask_, cv::Point tl,
+                             cv::InputOutputArray acc_, cv::InputOutputArray weight_) {
+    cv::Mat img = img_.getMat();
+    cv::Mat mask = mask_.getMat();
+    cv::Mat acc = acc_.getMat();
+    cv::Mat weight = weight_.getMat();
+
+    CV_Assert(img.type() == CV_8UC3 || img.type() == CV_16SC3);
+    CV_Assert(mask.type() == CV_8U && mask.size() == img.size());
+
+    // Warped frames may hang over the canvas edge
+    cv::Rect dst_rect = cv::Rect(tl, img.size()) & cv::Rect(cv::Point(), acc.size());
+    if (dst_rect.empty()) return;
+    cv::Rect src_rect = dst_rect - tl;
+
+    forRows(dst_rect.height, [&](int y0, int y1) {
+        if (img.depth() == CV_8U) {
+            feedRows<uchar>(img, mask, acc, weight, src_rect, dst_rect, y0, y1);
+        } else {
+            feedRows<short>(img, mask, acc, weight, src_rect, dst_rect, y0, y1);
+        }
+    });
+}
+
+void SVBackendCPU::blendFinish(cv::InputArray acc_, cv::InputArray weight_,
+                               cv::OutputArray dst_, cv::OutputArray dst_mask_) {
+    cv::Mat acc = acc_.getMat();
+    cv::Mat weight = weight_.getMat();
+    dst_.create(acc.size(), CV_8UC3);
+    dst_mask_.create(acc.size(), CV_8U);
+    cv::Mat dst = dst_.getMat();
+    cv::Mat dst_mask = dst_mask_.getMat();
+
+    forRows(acc.rows, [&](int y0, int y1) {
+        for (int y = y0; y < y1; y++) {
+            const float* acc_row = acc.ptr<float>(y);
+            const float* weight_row = weight.ptr<float>(y);
+            uchar* dst_row = dst.ptr<uchar>(y);
+            uchar* mask_row = dst_mask.ptr<uchar>(y);
+
+            for (int x = 0; x < acc.cols; x++) {
+                float w = weight_row[x];
+                if (w > BLEND_EPS) {
+                    float inv = 1.0f / w;
+                    dst_row[3 * x + 0] = cv::saturate_cast<uchar>(acc_row[3 * x + 0] * inv);
+                    dst_row[3 * x + 1] = cv::saturate_cast<uchar>(acc_row[3 * x + 1] * inv);
+                    dst_row[3 * x + 2] = cv::saturate_cast<uchar>(acc_row[3 * x + 2] * inv);
+                    mask_row[x] = 255;
+                } else {
+                    dst_row[3 * x + 0] = dst_row[3 * x + 1] = dst_row[3 * x + 2] = 0;
+                    mask_row[x] = 0;
+                }
+            }
+        }
+    });
+}
+
+void SVBackendCPU::compare(cv::InputArray src_, double value, cv::OutputArray dst_, int cmpop) {
+    cv::Mat src = src_.getMat();
+    dst_.create(src.size(), CV_8UC(src.channels()));
+    cv::Mat dst = dst_.getMat();
+
+    forRows(src.rows, [&](int y0, int y1) {
+        cv::Mat dst_rows = dst.rowRange(y0, y1);
+        cv::compare(src.rowRange(y0, y1), cv::Scalar::all(value), dst_rows, cmpop);
+    });
+}
+
+void SVBackendCPU::setTo(cv::InputOutputArray img_, const cv::Scalar& value, cv::InputArray mask_) {
+    cv::Mat img = img_.getMat();
+    cv::Mat mask = mask_.getMat();
+
+    forRows(img.rows, [&](int y0, int y1) {
+        cv::Mat img_rows = img.rowRange(y0, y1);
+        if (mask.empty()) {
+            img_rows.setTo(value);
+        } else {
+            img_rows.setTo(value, mask.rowRange(y0, y1));
+        }
+    });
+}
+
+void SVBackendCPU::upload(const cv::Mat& src, cv::OutputArray dst) {
+    src.copyTo(dst);
+}
+
+void SVBackendCPU::download(cv::InputArray src, cv::Mat& dst) {
+    src.copyTo(dst);
+}
@@ -0,0 +1,109 @@
+#ifndef SV_CPU_ONLY
+
+#include "SVBackendCUDA.hpp"
+#include <opencv2/cudaarithm.hpp>
+#include <opencv2/cudaimgproc.hpp>
+#include <opencv2/cudawarping.hpp>
+
+namespace {
+
+// Weight below which a canvas pixel counts as not covered by any camera
+constexpr double BLEND_EPS = 1e-5;
+
+} // namespace
+
+// ============================================================================
+// SVBackendCUDA Implementation
+// ============================================================================
+
+void SVBackendCUDA::convert(cv::InputArray src, cv::OutputArray dst, int rtype,
+                            double alpha, double beta) {
+    src.getGpuMat().convertTo(dst, rtype, alpha, beta, cuda_stream);
+}
+
+void SVBackendCUDA::cvtColor(cv::InputArray src, cv::OutputArray dst, int code) {
+    cv::cuda::cvtColor(src, dst, code, 0, cuda_stream);
+}
+
+void SVBackendCUDA::resize(cv::InputArray src, cv::OutputArray dst, cv::Size dsize,
+                           int interpolation) {
+    cv::cuda::resize(src, dst, dsize, 0, 0, interpolation, cuda_stream);
+}
+
+void SVBackendCUDA::remap(cv::InputArray src, cv::OutputArray dst,
+                          cv::InputArray map_x, cv::InputArray map_y,
+                          int interpolation, int border_mode) {
+    cv::cuda::remap(src, dst, map_x, map_y, interpolation, border_mode, cv::Scalar(), cuda_stream);
+}
+
+void SVBackendCUDA::applyGain(cv::InputArray src, cv::OutputArray dst, const cv::Scalar& gains) {
+    cv::cuda::multiply(src, gains, dst, 1.0, -1, cuda_stream);
+}
+
+void SVBackendCUDA::blendPrepare(cv::Size canvas, cv::OutputArray acc, cv::OutputArray weight) {
+    cv::cuda::GpuMat& acc_mat = acc.getGpuMatRef();
+    cv::cuda::GpuMat& weight_mat = weight.getGpuMatRef();
+    acc_mat.create(canvas, CV_32FC3);
+    weight_mat.create(canvas, CV_32F);
+    acc_mat.setTo(cv::Scalar::all(0), cuda_stream);
+    weight_mat.setTo(cv::Scalar::all(0), cuda_stream);
+}
+
+void SVBackendCUDA::blendFeed(cv::InputArray img_, cv::InputArray mask_, cv::Point tl,
+                              cv::InputOutputArray acc_, cv::InputOutputArray weight_) {
+    cv::cuda::GpuMat img = img_.getGpuMat();
+    cv::cuda::GpuMat mask = mask_.getGpuMat();
+    cv::cuda::GpuMat& acc = acc_.getGpuMatRef();
+    cv::cuda::GpuMat& weight = weight_.getGpuMatRef();
+
+    CV_Assert(img.type() == CV_8UC3 || img.type() == CV_16SC3);
+    CV_Assert(mask.type() == CV_8U && mask.size() == img.size());
+
+    // Warped frames may hang over the canvas edge
+    cv::Rect dst_rect = cv::Rect(tl, img.size()) & cv::Rect(cv::Point(), acc.size());
+    if (dst_rect.empty()) return;
+    cv::Rect src_rect = dst_rect - tl;
+
+    img(src_rect).convertTo(s_img32, CV_32FC3, cuda_stream);
+    mask(src_rect).convertTo(s_w, CV_32F, 1.0 / 255.0, cuda_stream);
+
+    cv::cuda::GpuMat w_planes[] = {s_w, s_w, s_w};
+    cv::cuda::merge(w_planes, 3, s_w3, cuda_stream);
+    cv::cuda::multiply(s_img32, s_w3, s_img32, 1.0, -1, cuda_stream);
+
+    cv::cuda::GpuMat acc_roi = acc(dst_rect);
+    cv::cuda::GpuMat weight_roi = weight(dst_rect);
+    cv::cuda::add(acc_roi, s_img32, acc_roi, cv::noArray(), -1, cuda_stream);
+    cv::cuda::add(weight_roi, s_w, weight_roi, cv::noArray(), -1, cuda_stream);
+}
+
+void SVBackendCUDA::blendFinish(cv::InputArray acc, cv::InputArray weight,
+                                cv::OutputArray dst, cv::OutputArray dst_mask) {
+    cv::cuda::max(weight, cv::Scalar::all(BLEND_EPS), s_wsafe, cuda_stream);
+
+    cv::cuda::GpuMat w_planes[] = {s_wsafe, s_wsafe, s_wsafe};
+    cv::cuda::merge(w_planes, 3, s_w3, cuda_stream);
+    cv::cuda::divide(acc, s_w3, s_img32, 1.0, -1, cuda_stream);
+
+    s_img32.convertTo(dst, CV_8UC3, cuda_stream);
+    cv::cuda::compare(weight, cv::Scalar::all(BLEND_EPS), dst_mask, cv::CMP_GT, cuda_stream);
+}
+
+void SVBackendCUDA::compare(cv::InputArray src, double value, cv::OutputArray dst, int cmpop) {
+    cv::cuda::compare(src, cv::Scalar::all(value), dst, cmpop, cuda_stream);
+}
+
+void SVBackendCUDA::setTo(cv::InputOutputArray img, const cv::Scalar& value, cv::InputArray mask) {
+    img.getGpuMatRef().setTo(value, mask, cuda_stream);
+}
+
+void SVBackendCUDA::upload(const cv::Mat& src, cv::OutputArray dst) {
+    svUpload(src, dst.getGpuMatRef(), SVResidency::HOST, cuda_stream);
+}
+
+void SVBackendCUDA::download(cv::InputArray src, cv::Mat& dst) {
+    svDownload(src.getGpuMat(), dst, SVResidency::HOST, cuda_stream);
+    cuda_stream.waitForCompletion();
+}
+
+#endif // SV_CPU_ONLY
@@ -5,8 +5,6 @@
 #include <opencv2/cudawarping.hpp>
 
 
-#include <omp.h>
-
 
 typedef unsigned char uchar;
 
@@ -113,7 +111,7 @@ void SVBlender::blend(cv::cuda::GpuMat &dst, cv::cuda::GpuMat &dst_mask, cv::cud
 
 // ------------------------------- CUDAFeatherBlender --------------------------------
 SVFeatherBlender::SVFeatherBlender(const float sharpness) :
-      sharpness_(sharpness), use_cache_weight_(false)
+      use_cache_weight_(false), sharpness_(sharpness)
 {
 
     if (cudaStreamCreate(&_cudaStreamDst) != cudaError::cudaSuccess)
@@ -227,7 +225,7 @@ void SVFeatherBlender::prepare(const std::vector<cv::Point> &corners, const std:
     prepare(cv::detail::resultRoi(corners, sizes));
     weight_maps_ = std::move(std::vector<cv::cuda::GpuMat>(sizes.size()));
 
-    for (auto i = 0; i < masks.size(); ++i)
+    for (size_t i = 0; i < masks.size(); ++i)
         createWeightMap(masks[i], weight_maps_[i]);
 
     use_cache_weight_ = true;
@@ -258,7 +256,7 @@ void SVMultiBandBlender::prepare_roi(const std::vector<cv::Point> &corners, cons
 {
 	prepare_pyr(cv::detail::resultRoi(corners, sizes));
 
-	for (auto i = 0; i < sizes.size(); ++i){
+	for (size_t i = 0; i < sizes.size(); ++i){
 	    const auto& tl =  corners[i];
 	    const auto& size_ = sizes[i];
 	     // Keep source image in memory with small border
@@ -298,7 +296,7 @@ void SVMultiBandBlender::prepare_roi(const std::vector<cv::Point> &corners, cons
 	    gpu_ups_.push_back(std::vector<cv::cuda::GpuMat>(numbands));
 	}
 
-	for (auto i = 0; i < sizes.size(); ++i){
+	for (size_t i = 0; i < sizes.size(); ++i){
 	    gpu_ups_.push_back(std::vector<cv::cuda::GpuMat>(numbands + 1));
 	}
 
@@ -344,7 +342,7 @@ void SVMultiBandBlender::prepare(const std::vector<cv::Point> &corners, const st
 
       constexpr auto weight_coef = 1. / 255.;
 
-      for(auto i = 0; i < masks.size(); ++i){
+      for (size_t i = 0; i < masks.size(); ++i){
           cv::cuda::GpuMat gpu_weight_map_;
           masks[i].convertTo(gpu_weight_map_, CV_32F, weight_coef);
           auto top = gpu_imgs_borders_[i].top;
@@ -428,9 +426,7 @@ void SVMultiBandBlender::blend(cv::cuda::GpuMat &dst, cv::cuda::GpuMat &dst_mask
     dst_mask_.copyTo(dst_mask, streamObj);
 
 
-#ifndef NO_OMP
-    #pragma omp parallel for default(none)
-#endif
+    // Plain loop: these are asynchronous GPU launches, CPU threads add nothing
     for(auto i = 0; i < numbands+1; ++i){
         gpu_dst_band_weights_[i].setTo(0);
         gpu_dst_pyr_laplace_[i].setTo(cv::Scalar::all(0), loopStreamObj);
@@ -467,9 +463,7 @@ void SVMultiBandBlender::blend(cv::cuda::GpuMat &dst, const bool apply_mask, cv:
 
     gpu_dst_pyr_laplace_[0](dst_rc_).convertTo(dst, CV_8U, streamObj);
 
-#ifndef NO_OMP
-  #pragma omp parallel for default(none)
-#endif
+    // Plain loop: these are asynchronous GPU launches, CPU threads add nothing
     for(auto i = 0; i < numbands+1; ++i){
         gpu_dst_band_weights_[i].setTo(0);
         gpu_dst_pyr_laplace_[i].setTo(cv::Scalar::all(0), loopStreamObj);
@@ -0,0 +1,352 @@
+#include "SVBowlView.hpp"
+#include "OGLShader.hpp"
+#include "Bowl.hpp"
+#include "SVFrameBuffer.hpp"
+#include "SVThreadPool.hpp"
+#include <GL/gl.h>
+#include <GL/glext.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <iostream>
+
+static const char* bowlVertexShader = R"(
+#version 330 core
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec4 aUV01;
+layout (location = 2) in vec4 aUV23;
+layout (location = 3) in vec4 aUV45;
+layout (location = 4) in vec4 aUV67;
+layout (location = 5) in vec4 aWeight0123;
+layout (location = 6) in vec4 aWeight4567;
+
+out vec4 UV[4];
+out vec4 Weight[2];
+
+uniform mat4 view;
+uniform mat4 projection;
+
+void main()
+{
+    gl_Position = projection * view * vec4(aPos, 1.0);
+    UV[0] = aUV01;
+    UV[1] = aUV23;
+    UV[2] = aUV45;
+    UV[3] = aUV67;
+    Weight[0] = aWeight0123;
+    Weight[1] = aWeight4567;
+}
+)";
+
+static const char* bowlFragmentShader = R"(
+#version 330 core
+out vec4 FragColor;
+
+in vec4 UV[4];
+in vec4 Weight[2];
+
+uniform sampler2DArray cameras;
+uniform int num_cameras;
+
+void main()
+{
+    vec3 color = vec3(0.0);
+    float total = 0.0;
+    for (int i = 0; i < num_cameras; i++) {
+        float w = Weight[i / 4][i % 4];
+        if (w <= 0.001) continue;
+        vec2 uv = (i % 2 == 0) ? UV[i / 2].xy : UV[i / 2].zw;
+        if (any(lessThan(uv, vec2(0.0))) || any(greaterThan(uv, vec2(1.0)))) continue;
+        color += w * texture(cameras, vec3(uv, float(i))).rgb;
+        total += w;
+    }
+    if (total <= 0.0) discard;
+    FragColor = vec4(color / total, 1.0);
+}
+)";
+
+SVBowlView::SVBowlView()
+    : index_count(0)
+    , num_cameras(0)
+    , slots(4)
+    , vao(0)
+    , vbo(0)
+    , ebo(0)
+    , camera_array(0)
+    , gl_ready(false) {
+}
+
+SVBowlView::~SVBowlView() {
+    if (vao) glDeleteVertexArrays(1, &vao);
+    if (vbo) glDeleteBuffers(1, &vbo);
+    if (ebo) glDeleteBuffers(1, &ebo);
+    if (camera_array) glDeleteTextures(1, &camera_array);
+    for (auto pbo : pbos) {
+        if (pbo) glDeleteBuffers(1, &pbo);
+    }
+}
+
+// ============================================================================
+// MESH + PROJECTION BAKE (CPU)
+// ============================================================================
+
+bool SVBowlView::build(const std::vector<SVCameraCalib>& calibs, cv::Size image_size_) {
+    num_cameras = static_cast<int>(calibs.size());
+    if (num_cameras == 0 || num_cameras > MAX_CAMERAS) {
+        std::cerr << "✗ Bowl view supports 1-" << MAX_CAMERAS << " cameras, got "
+                  << num_cameras << std::endl;
+        return false;
+    }
+    slots = num_cameras <= 4 ? 4 : MAX_CAMERAS;
+    image_size = image_size_;
+
+    ConfigBowl config(BOWL_PARAB_A, BOWL_PARAB_B, BOWL_PARAB_C,
+                      BOWL_DISK_RADIUS, BOWL_PARAB_RADIUS, BOWL_HOLE_RADIUS, BOWL_VERTICES);
+    Bowl bowl(config);
+    std::vector<float> mesh;
+    if (!bowl.generate_mesh_hole(config.vertices_num, config.hole_radius, mesh, indices)) {
+        std::cerr << "✗ Bowl mesh generation failed (check BOWL_* in SVConfig.hpp)" << std::endl;
+        return false;
+    }
+
+    const int n = static_cast<int>(mesh.size() / 3);
+    const int stride = 3 + 3 * slots;
+    const int uv_offset = 3;
+    const int weight_offset = 3 + 2 * slots;
+
+    // The flat disk is the lowest level of the bowl: that is the ground
+    float floor_y = mesh[1];
+    for (int v = 0; v < n; v++) {
+        floor_y = std::min(floor_y, mesh[v * 3 + 1]);
+    }
+
+    vertices.assign(static_cast<size_t>(n) * stride, 0.0f);
+    std::vector<cv::Point3d> points(n);
+    for (int v = 0; v < n; v++) {
+        const float x = mesh[v * 3 + 0];
+        const float h = mesh[v * 3 + 1] - floor_y;
+        const float z = mesh[v * 3 + 2];
+
+        float* vert = &vertices[static_cast<size_t>(v) * stride];
+        vert[0] = x;
+        vert[1] = h;
+        vert[2] = z;
+        points[v] = cv::Point3d(x * BOWL_SCALE_MM, z * BOWL_SCALE_MM, -h * BOWL_SCALE_MM);
+    }
+
+    // Score every camera per vertex (SVCameraCalib::viewScore)
+    std::vector<float> scores(static_cast<size_t>(n) * num_cameras, 0.0f);
+    const float inv_w = 1.0f / image_size.width;
+    const float inv_h = 1.0f / image_size.height;
+
+    for (int cam = 0; cam < num_cameras; cam++) {
+        const SVCameraCalib& calib = calibs[cam];
+
+        SVThreadPool::instance().parallelForRange(0, n, [&](int v0, int v1) {
+            std::vector<cv::Point3d> chunk(points.begin() + v0, points.begin() + v1);
+            std::vector<cv::Point2d> projected;
+            std::vector<uchar> visible;
+            calib.project(chunk, image_size, projected, visible);
+
+            for (int v = v0; v < v1; v++) {
+                const cv::Point2d& p = projected[v - v0];
+                float* vert = &vertices[static_cast<size_t>(v) * stride];
+                vert[uv_offset + 2 * cam + 0] = static_cast<float>(p.x) * inv_w;
+                vert[uv_offset + 2 * cam + 1] = static_cast<float>(p.y) * inv_h;
+
+                if (!visible[v - v0]) continue;
+                scores[static_cast<size_t>(v) * num_cameras + cam] =
+                    calib.viewScore(points[v], p, image_size, BOWL_EDGE_FEATHER_PX);
+            }
+        }, 4096);
+    }
+
+    // Keep the two best cameras per vertex
+    std::atomic<int> covered{0};
+    SVThreadPool::instance().parallelForRange(0, n, [&](int v0, int v1) {
+        int chunk_covered = 0;
+        for (int v = v0; v < v1; v++) {
+            float* vert = &vertices[static_cast<size_t>(v) * stride];
+            if (blendWeightsFromScores(&scores[static_cast<size_t>(v) * num_cameras], num_cameras,
+                                       vert + weight_offset) > 0) {
+                chunk_covered++;
+            }
+        }
+        covered += chunk_covered;
+    }, 4096);
+
+    index_count = indices.size();
+    std::cout << "  ✓ Bowl baked: " << n << " vertices, " << num_cameras << " cameras, "
+              << (100 * covered / n) << "% of the bowl seen" << std::endl;
+    return true;
+}
+
+// ============================================================================
+// GL RESOURCES
+// ============================================================================
+
+bool SVBowlView::createShader() {
+    shader = std::make_unique<OGLShader>();
+
+    auto compile = [](GLenum type, const char* source) {
+        unsigned int id = glCreateShader(type);
+        glShaderSource(id, 1, &source, NULL);
+        glCompileShader(id);
+
+        int success;
+        glGetShaderiv(id, GL_COMPILE_STATUS, &success);
+        if (!success) {
+            char infoLog[512];
+            glGetShaderInfoLog(id, 512, NULL, infoLog);
+            std::cerr << "Bowl shader compilation failed:\n" << infoLog << std::endl;
+        }
+        return id;
+    };
+
+    unsigned int vertex = compile(GL_VERTEX_SHADER, bowlVertexShader);
+    unsigned int fragment = compile(GL_FRAGMENT_SHADER, bowlFragmentShader);
+
+    shader->ID = glCreateProgram();
+    glAttachShader(shader->ID, vertex);
+    glAttachShader(shader->ID, fragment);
+    glLinkProgram(shader->ID);
+    glDeleteShader(vertex);
+    glDeleteShader(fragment);
+
+    int success;
+    glGetProgramiv(shader->ID, GL_LINK_STATUS, &success);
+    if (!success) {
+        char infoLog[512];
+        glGetProgramInfoLog(shader->ID, 512, NULL, infoLog);
+        std::cerr << "Bowl shader linking failed:\n" << infoLog << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool SVBowlView::initGL() {
+    if (vertices.empty() || indices.empty()) {
+        std::cerr << "✗ Bowl view: build() must succeed before initGL()" << std::endl;
+        return false;
+    }
+
+    if (!createShader()) {
+        return false;
+    }
+
+    // Static mesh: uploaded once, CPU copies released
+    glGenVertexArrays(1, &vao);
+    glGenBuffers(1, &vbo);
+    glGenBuffers(1, &ebo);
+
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+
+    const GLsizei stride = (3 + 3 * slots) * sizeof(float);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, (void*)0);
+    glEnableVertexAttribArray(0);
+
+    // Locations 1-4: UVs of camera pairs, 5-6: weights of camera quads.
+    // Slots a 4-camera rig does not have read as zero.
+    for (int k = 0; k < MAX_CAMERAS / 2; k++) {
+        const GLuint loc = 1 + k;
+        if (2 * k < slots) {
+            glVertexAttribPointer(loc, 4, GL_FLOAT, GL_FALSE, stride, (void*)((3 + 4 * k) * sizeof(float)));
+            glEnableVertexAttribArray(loc);
+        } else {
+            glDisableVertexAttribArray(loc);
+            glVertexAttrib4f(loc, 0.0f, 0.0f, 0.0f, 0.0f);
+        }
+    }
+    for (int k = 0; k < MAX_CAMERAS / 4; k++) {
+        const GLuint loc = 5 + k;
+        if (4 * k < slots) {
+            glVertexAttribPointer(loc, 4, GL_FLOAT, GL_FALSE, stride,
+                                  (void*)((3 + 2 * slots + 4 * k) * sizeof(float)));
+            glEnableVertexAttribArray(loc);
+        } else {
+            glDisableVertexAttribArray(loc);
+            glVertexAttrib4f(loc, 0.0f, 0.0f, 0.0f, 0.0f);
+        }
+    }
+    glBindVertexArray(0);
+
+    std::vector<float>().swap(vertices);
+    std::vector<unsigned int>().swap(indices);
+
+    // One texture layer and one PBO per camera, raw frames
+    glGenTextures(1, &camera_array);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, camera_array);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGB, image_size.width, image_size.height, num_cameras,
+                 0, GL_BGR, GL_UNSIGNED_BYTE, nullptr);
+
+    pbos.assign(num_cameras, 0);
+    glGenBuffers(num_cameras, pbos.data());
+    for (auto pbo : pbos) {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pbo);
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, image_size.area() * 3, nullptr, GL_STREAM_DRAW);
+    }
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    gl_ready = true;
+    std::cout << "  ✓ Bowl view ready (" << index_count << " strip indices)" << std::endl;
+    return true;
+}
+
+// ============================================================================
+// PER FRAME
+// ============================================================================
+
+void SVBowlView::uploadFrames(const std::vector<cv::cuda::GpuMat>& raw_frames) {
+    if (!gl_ready) return;
+
+    const size_t bytes = static_cast<size_t>(image_size.area()) * 3;
+    const int count = std::min<int>(raw_frames.size(), num_cameras);
+
+    // PBO rows are packed (width * 3 bytes), not padded to 4
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    for (int i = 0; i < count; i++) {
+        const cv::cuda::GpuMat& frame = raw_frames[i];
+        // UVs were baked for the calibrated size; anything else would be sampled wrongly
+        if (frame.empty() || frame.size() != image_size || frame.type() != CV_8UC3) continue;
+
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pbos[i]);
+        void* ptr = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, bytes,
+                                     GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+        if (ptr) {
+            cv::Mat cpu_frame(image_size, CV_8UC3, ptr);
+            svDownload(frame, cpu_frame, SVResidency::MAPPED);
+            glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+
+            glBindTexture(GL_TEXTURE_2D_ARRAY, camera_array);
+            glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, i, image_size.width, image_size.height, 1,
+                            GL_BGR, GL_UNSIGNED_BYTE, 0);
+        }
+    }
+
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+}
+
+void SVBowlView::draw(const glm::mat4& view, const glm::mat4& projection) {
+    if (!gl_ready) return;
+
+    shader->use();
+    shader->setMat4("view", view);
+    shader->setMat4("projection", projection);
+    shader->setInt("num_cameras", num_cameras);
+
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, camera_array);
+    shader->setInt("cameras", 0);
+
+    glBindVertexArray(vao);
+    glDrawElements(GL_TRIANGLE_STRIP, static_cast<GLsizei>(index_count), GL_UNSIGNED_INT, 0);
+    glBindVertexArray(0);
+}
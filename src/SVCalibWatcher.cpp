@@ -0,0 +1,151 @@
+#include "SVCalibWatcher.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <fnmatch.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+SVCalibWatcher::SVCalibWatcher()
+    : settle_ms(0)
+    , inotify_fd(-1)
+    , stop_fd(-1)
+    , stopping(false) {
+}
+
+SVCalibWatcher::~SVCalibWatcher() {
+    stop();
+}
+
+bool SVCalibWatcher::start(const std::string& folder_, const std::vector<std::string>& patterns_,
+                           Callback on_change_, int settle_ms_) {
+    stop();
+
+    folder = folder_;
+    patterns = patterns_;
+    on_change = std::move(on_change_);
+    settle_ms = std::max(0, settle_ms_);
+
+    inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotify_fd < 0) {
+        std::cerr << "✗ Calibration watcher: inotify_init1 failed: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    // Finished writes and renames into the folder; not IN_MODIFY (fires per write() call)
+    if (inotify_add_watch(inotify_fd, folder.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+        std::cerr << "✗ Calibration watcher: cannot watch " << folder << ": "
+                  << std::strerror(errno) << std::endl;
+        close(inotify_fd);
+        inotify_fd = -1;
+        return false;
+    }
+
+    stop_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (stop_fd < 0) {
+        std::cerr << "✗ Calibration watcher: eventfd failed: " << std::strerror(errno) << std::endl;
+        close(inotify_fd);
+        inotify_fd = -1;
+        return false;
+    }
+
+    stopping = false;
+    thread = std::thread(&SVCalibWatcher::loop, this);
+
+    std::cout << "✓ Watching " << folder << " for calibration changes" << std::endl;
+    return true;
+}
+
+void SVCalibWatcher::stop() {
+    if (thread.joinable()) {
+        stopping = true;
+        const uint64_t one = 1;
+        if (write(stop_fd, &one, sizeof(one)) < 0) {
+            std::cerr << "✗ Calibration watcher: cannot wake thread" << std::endl;
+        }
+        thread.join();
+    }
+    if (inotify_fd >= 0) {
+        close(inotify_fd);
+        inotify_fd = -1;
+    }
+    if (stop_fd >= 0) {
+        close(stop_fd);
+        stop_fd = -1;
+    }
+}
+
+bool SVCalibWatcher::matches(const std::string& name) const {
+    for (const auto& pattern : patterns) {
+        if (fnmatch(pattern.c_str(), name.c_str(), 0) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void SVCalibWatcher::loop() {
+    using clock = std::chrono::steady_clock;
+
+    // Big enough for many events; inotify never splits one event across reads
+    alignas(inotify_event) char buffer[16 * 1024];
+    std::vector<std::string> changed;
+    clock::time_point last_event;
+
+    pollfd fds[2];
+    fds[0] = {inotify_fd, POLLIN, 0};
+    fds[1] = {stop_fd, POLLIN, 0};
+
+    while (!stopping) {
+        // Block until something happens; with a batch pending, only until it settles
+        int timeout = -1;
+        if (!changed.empty()) {
+            const auto quiet = std::chrono::duration_cast<std::chrono::milliseconds>(
+                clock::now() - last_event).count();
+            timeout = std::max(0, settle_ms - static_cast<int>(quiet));
+        }
+
+        const int ready = poll(fds, 2, timeout);
+        if (ready < 0) {
+            if (errno == EINTR) continue;
+            std::cerr << "✗ Calibration watcher: poll failed: " << std::strerror(errno) << std::endl;
+            break;
+        }
+        if (stopping || (fds[1].revents & POLLIN)) {
+            break;
+        }
+
+        if (fds[0].revents & POLLIN) {
+            ssize_t len;
+            while ((len = read(inotify_fd, buffer, sizeof(buffer))) > 0) {
+                for (char* p = buffer; p < buffer + len; ) {
+                    const inotify_event* event = reinterpret_cast<const inotify_event*>(p);
+                    if (event->len > 0 && matches(event->name)) {
+                        if (std::find(changed.begin(), changed.end(), event->name) == changed.end()) {
+                            changed.push_back(event->name);
+                        }
+                        last_event = clock::now();
+                    }
+                    if (event->mask & IN_Q_OVERFLOW) {
+                        std::cerr << "WARNING: Calibration watcher queue overflow, events lost" << std::endl;
+                    }
+                    p += sizeof(inotify_event) + event->len;
+                }
+            }
+            continue;
+        }
+
+        // Timed out: the folder has been quiet for settle_ms
+        if (!changed.empty()) {
+            std::vector<std::string> batch;
+            batch.swap(changed);
+            if (on_change) {
+                on_change(batch);
+            }
+        }
+    }
+}
@@ -0,0 +1,85 @@
+#include "SVCameraRatePolicy.hpp"
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+SVCameraRatePolicy::SVCameraRatePolicy(const SVCameraRig& rig)
+    : SVCameraRatePolicy(rig, Options()) {
+}
+
+SVCameraRatePolicy::SVCameraRatePolicy(const SVCameraRig& rig, const Options& options)
+    : opts(options)
+    , divisors(rig.size(), 1) {
+    for (const SVCameraInfo& cam : rig.cameras) {
+        facings.push_back(facing(cam.yaw_deg));
+    }
+}
+
+SVCameraRatePolicy::Facing SVCameraRatePolicy::facing(float yaw_deg) {
+    // Nearest quadrant, yaw counter-clockwise from the front
+    float yaw = std::fmod(yaw_deg, 360.0f);
+    if (yaw < 0.0f) yaw += 360.0f;
+    const int quadrant = static_cast<int>(std::lround(yaw / 90.0f)) % 4;
+    static const Facing order[4] = {Facing::FRONT, Facing::LEFT, Facing::REAR, Facing::RIGHT};
+    return order[quadrant];
+}
+
+bool SVCameraRatePolicy::update(const SVVehicleState& state, const std::vector<bool>& visible) {
+    std::vector<int> next(facings.size(), 1);
+
+    if (state.valid) {
+        for (size_t i = 0; i < facings.size(); i++) {
+            const Facing f = facings[i];
+            switch (state.gear) {
+                case SVGear::REVERSE:
+                    next[i] = (f == Facing::FRONT) ? opts.reverse_front_divisor : 1;
+                    break;
+                case SVGear::PARK:
+                case SVGear::NEUTRAL:
+                    next[i] = opts.parked_divisor;
+                    break;
+                case SVGear::DRIVE:
+                    if (state.speed_kmh > opts.cruise_kmh) {
+                        next[i] = (f == Facing::FRONT) ? 1 :
+                                  (f == Facing::REAR)  ? opts.cruise_rear_divisor : opts.cruise_side_divisor;
+                    }
+                    break;
+                default:
+                    break;
+            }
+
+            const bool left = state.turn == SVTurnSignal::LEFT || state.turn == SVTurnSignal::HAZARD;
+            const bool right = state.turn == SVTurnSignal::RIGHT || state.turn == SVTurnSignal::HAZARD;
+            if ((left && f == Facing::LEFT) || (right && f == Facing::RIGHT)) {
+                next[i] = 1;
+            }
+        }
+    }
+
+    for (size_t i = 0; i < next.size(); i++) {
+        if (i < visible.size() && !visible[i]) {
+            next[i] = 0;
+        }
+        next[i] = std::max(0, next[i]);
+    }
+
+    if (next == divisors) return false;
+    divisors.swap(next);
+    return true;
+}
+
+std::string SVCameraRatePolicy::describe(const SVCameraRig& rig) const {
+    std::ostringstream out;
+    for (size_t i = 0; i < divisors.size(); i++) {
+        if (i > 0) out << ", ";
+        out << rig.camera(static_cast<int>(i)).name << " ";
+        if (divisors[i] == 0) {
+            out << "paused";
+        } else if (divisors[i] == 1) {
+            out << "1";
+        } else {
+            out << "1/" << divisors[i];
+        }
+    }
+    return out.str();
+}
@@ -0,0 +1,171 @@
+#include "SVCameraRig.hpp"
+#include "SVConfig.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <iostream>
+
+namespace {
+
+std::string toLower(std::string s) {
+    std::transform(s.begin(), s.end(), s.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return s;
+}
+
+SVDisplayRotation parseDisplayRotation(const std::string& name) {
+    std::string lower = toLower(name);
+    if (lower == "flip_v") return SVDisplayRotation::FLIP_V;
+    if (lower == "flip_h") return SVDisplayRotation::FLIP_H;
+    if (lower == "transpose") return SVDisplayRotation::TRANSPOSE;
+    if (lower == "transverse") return SVDisplayRotation::TRANSVERSE;
+    if (lower != "none" && !lower.empty()) {
+        std::cerr << "WARNING: Unknown display rotation '" << name << "', using none" << std::endl;
+    }
+    return SVDisplayRotation::NONE;
+}
+
+} // namespace
+
+const char* displayRotationName(SVDisplayRotation r) {
+    switch (r) {
+        case SVDisplayRotation::NONE:       return "none";
+        case SVDisplayRotation::FLIP_V:     return "flip_v";
+        case SVDisplayRotation::FLIP_H:     return "flip_h";
+        case SVDisplayRotation::TRANSPOSE:  return "transpose";
+        case SVDisplayRotation::TRANSVERSE: return "transverse";
+    }
+    return "?";
+}
+
+const char* stitchLayoutName(SVStitchLayout layout) {
+    switch (layout) {
+        case SVStitchLayout::DIAGONAL_X: return "diagonal_x";
+        case SVStitchLayout::SECTORS:    return "sectors";
+    }
+    return "?";
+}
+
+// ============================================================================
+// SVCameraRig Implementation
+// ============================================================================
+
+SVCameraRig SVCameraRig::defaultRig() {
+    // Canvas placement and display flips of the original 4-camera car
+    static const float yaws[NUM_CAMERAS] = {0.0f, 90.0f, 180.0f, 270.0f};
+    static const cv::Point origins[NUM_CAMERAS] = {
+        cv::Point(0, 0), cv::Point(0, 720), cv::Point(640, 800), cv::Point(640, 80)
+    };
+    static const SVDisplayRotation displays[NUM_CAMERAS] = {
+        SVDisplayRotation::FLIP_V, SVDisplayRotation::TRANSPOSE,
+        SVDisplayRotation::FLIP_H, SVDisplayRotation::TRANSVERSE
+    };
+
+    SVCameraRig rig;
+    for (int i = 0; i < NUM_CAMERAS; i++) {
+        SVCameraInfo cam;
+        cam.name = CAMERA_CONFIGS[i].name;
+        cam.ip = CAMERA_CONFIGS[i].ip;
+        cam.port = CAMERA_CONFIGS[i].port;
+        cam.yaw_deg = yaws[i];
+        cam.canvas_origin = origins[i];
+        cam.display = displays[i];
+        rig.cameras.push_back(cam);
+    }
+    rig.layout = SVStitchLayout::DIAGONAL_X;
+    return rig;
+}
+
+SVCameraRig SVCameraRig::fromConfig() {
+    std::string path = CAMERA_RIG_FILE;
+    if (const char* env = std::getenv("SV_RIG")) {
+        path = env;
+    }
+
+    if (!path.empty()) {
+        SVCameraRig rig;
+        if (rig.load(path)) {
+            return rig;
+        }
+        std::cerr << "WARNING: Could not load camera rig '" << path << "', using built-in rig" << std::endl;
+    }
+    return defaultRig();
+}
+
+bool SVCameraRig::load(const std::string& path) {
+    cv::FileStorage fs(path, cv::FileStorage::READ);
+    if (!fs.isOpened()) {
+        std::cerr << "✗ Cannot open rig file: " << path << std::endl;
+        return false;
+    }
+
+    cv::FileNode cams_node = fs["cameras"];
+    if (cams_node.type() != cv::FileNode::SEQ || cams_node.size() == 0) {
+        std::cerr << "✗ Rig file has no 'cameras' list: " << path << std::endl;
+        return false;
+    }
+
+    std::vector<SVCameraInfo> loaded;
+    for (const cv::FileNode& node : cams_node) {
+        SVCameraInfo cam;
+        node["name"] >> cam.name;
+        node["ip"] >> cam.ip;
+        cam.port = static_cast<int>(node["port"]);
+        cam.port_full = static_cast<int>(node["port_full"]);
+        cam.yaw_deg = static_cast<float>(node["yaw"]);
+
+        std::vector<int> origin;
+        node["origin"] >> origin;
+        if (origin.size() != 2 || cam.ip.empty() || cam.port <= 0) {
+            std::cerr << "✗ Rig camera " << loaded.size() << " needs ip, port and origin [x, y]" << std::endl;
+            return false;
+        }
+        cam.canvas_origin = cv::Point(origin[0], origin[1]);
+
+        std::string display;
+        node["display"] >> display;
+        cam.display = parseDisplayRotation(display);
+
+        if (cam.name.empty()) {
+            cam.name = "Cam" + std::to_string(loaded.size());
+        }
+        loaded.push_back(cam);
+    }
+
+    std::string dest;
+    fs["dest_ip"] >> dest;
+    if (!dest.empty()) dest_ip = dest;
+
+    std::vector<int> canvas;
+    fs["canvas"] >> canvas;
+    if (canvas.size() == 2) canvas_size = cv::Size(canvas[0], canvas[1]);
+
+    if (!fs["fade"].empty()) fade_px = static_cast<int>(fs["fade"]);
+
+    std::string layout_name;
+    fs["layout"] >> layout_name;
+    layout = toLower(layout_name) == "diagonal_x" ? SVStitchLayout::DIAGONAL_X : SVStitchLayout::SECTORS;
+    if (layout == SVStitchLayout::DIAGONAL_X && loaded.size() != 4) {
+        std::cerr << "WARNING: diagonal_x layout needs 4 cameras, using sectors" << std::endl;
+        layout = SVStitchLayout::SECTORS;
+    }
+
+    cameras = std::move(loaded);
+    std::cout << "✓ Loaded camera rig: " << path << std::endl;
+    return true;
+}
+
+void SVCameraRig::print() const {
+    std::cout << "  Camera rig: " << size() << " cameras, layout " << stitchLayoutName(layout)
+              << ", canvas " << canvas_size.width << "x" << canvas_size.height << std::endl;
+    for (int i = 0; i < size(); i++) {
+        const SVCameraInfo& cam = cameras[i];
+        std::cout << "    [" << i << "] " << cam.name << " " << cam.ip << ":" << cam.port;
+        if (cam.port_full > 0) {
+            std::cout << " (full res :" << cam.port_full << ")";
+        }
+        std::cout << " yaw " << cam.yaw_deg << "°"
+                  << " origin (" << cam.canvas_origin.x << "," << cam.canvas_origin.y << ")"
+                  << " display " << displayRotationName(cam.display) << std::endl;
+    }
+}
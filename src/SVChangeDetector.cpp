@@ -0,0 +1,52 @@
+#include "SVChangeDetector.hpp"
+#include <opencv2/imgproc.hpp>
+
+void SVChangeDetector::reset(int num_cameras) {
+    cameras.assign(num_cameras, Camera());
+}
+
+bool SVChangeDetector::update(int camera, const cv::Mat& thumb, Clock::time_point now) {
+    Camera& cam = cameras[camera];
+
+    if (thumb.channels() == 3) {
+        cv::cvtColor(thumb, cam.gray, cv::COLOR_BGR2GRAY);
+    } else {
+        thumb.copyTo(cam.gray);
+    }
+
+    bool changed = !cam.valid || cam.reference.size() != cam.gray.size();
+    if (!changed) {
+        cv::absdiff(cam.gray, cam.reference, cam.diff);
+        cv::threshold(cam.diff, cam.diff, opts.pixel_threshold, 255, cv::THRESH_BINARY);
+        cam.last_fraction = static_cast<float>(cv::countNonZero(cam.diff)) / cam.diff.total();
+        changed = cam.last_fraction > opts.changed_fraction ||
+                  now - cam.processed_at >= std::chrono::milliseconds(opts.min_refresh_ms);
+    }
+
+    if (!changed) {
+        cam.stats.skipped++;
+        return false;
+    }
+
+    // Swap instead of copy: the old reference becomes next frame's gray scratch
+    cv::swap(cam.reference, cam.gray);
+    cam.processed_at = now;
+    cam.valid = true;
+    cam.stats.processed++;
+    return true;
+}
+
+void SVChangeDetector::invalidate() {
+    for (Camera& cam : cameras) {
+        cam.valid = false;
+    }
+}
+
+SVChangeDetector::Stats SVChangeDetector::total() const {
+    Stats sum;
+    for (const Camera& cam : cameras) {
+        sum.processed += cam.stats.processed;
+        sum.skipped += cam.stats.skipped;
+    }
+    return sum;
+}
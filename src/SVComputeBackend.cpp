@@ -0,0 +1,91 @@
+#include "SVComputeBackend.hpp"
+#include "SVBackendCPU.hpp"
+#include "SVConfig.hpp"
+#ifndef SV_CPU_ONLY
+#include "SVBackendCUDA.hpp"
+#endif
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <iostream>
+
+// ============================================================================
+// SVComputeBackend Implementation
+// ============================================================================
+
+cv::_InputArray SVComputeBackend::in(const SVFrameBuffer& buf) {
+#ifndef SV_CPU_ONLY
+    if (residency() == SVResidency::DEVICE) {
+        return cv::_InputArray(buf.device());
+    }
+#endif
+    return cv::_InputArray(buf.host());
+}
+
+cv::_OutputArray SVComputeBackend::out(SVFrameBuffer& buf) {
+#ifndef SV_CPU_ONLY
+    if (residency() == SVResidency::DEVICE) {
+        return cv::_OutputArray(buf.writeDevice());
+    }
+#endif
+    return cv::_OutputArray(buf.writeHost());
+}
+
+cv::_InputOutputArray SVComputeBackend::inout(SVFrameBuffer& buf) {
+#ifndef SV_CPU_ONLY
+    if (residency() == SVResidency::DEVICE) {
+        return cv::_InputOutputArray(buf.modifyDevice());
+    }
+#endif
+    return cv::_InputOutputArray(buf.modifyHost());
+}
+
+// ============================================================================
+// Backend selection
+// ============================================================================
+
+SVBackendType parseBackendType(const std::string& name) {
+    std::string lower = name;
+    std::transform(lower.begin(), lower.end(), lower.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+    if (lower == "cpu") return SVBackendType::CPU;
+    if (lower == "cuda" || lower == "gpu") return SVBackendType::CUDA;
+    if (lower != "auto" && !lower.empty()) {
+        std::cerr << "WARNING: Unknown compute backend '" << name << "', using auto" << std::endl;
+    }
+    return SVBackendType::AUTO;
+}
+
+SVBackendType configuredBackendType() {
+    if (const char* env = std::getenv("SV_BACKEND")) {
+        return parseBackendType(env);
+    }
+    return parseBackendType(COMPUTE_BACKEND);
+}
+
+std::shared_ptr<SVComputeBackend> createComputeBackend(SVBackendType type) {
+    std::shared_ptr<SVComputeBackend> backend;
+
+#ifndef SV_CPU_ONLY
+    bool has_device = cv::cuda::getCudaEnabledDeviceCount() > 0;
+
+    if (type == SVBackendType::CUDA && !has_device) {
+        std::cerr << "WARNING: CUDA backend requested but no CUDA device found, using CPU" << std::endl;
+    }
+    if (type != SVBackendType::CPU && has_device) {
+        backend = std::make_shared<SVBackendCUDA>();
+    }
+#else
+    if (type == SVBackendType::CUDA) {
+        std::cerr << "WARNING: CUDA backend requested but this build has no CUDA support, using CPU" << std::endl;
+    }
+#endif
+
+    if (!backend) {
+        backend = std::make_shared<SVBackendCPU>();
+    }
+
+    std::cout << "✓ Compute backend: " << backend->name() << std::endl;
+    return backend;
+}
@@ -4,9 +4,12 @@
  */
 
 #include "SVEthernetCamera.hpp"
+#include "SVThreadPool.hpp"
 #include <opencv2/cudawarping.hpp>  // For cv::cuda::remap
 #include <opencv2/cudaimgproc.hpp>  // ADD THIS LINE for cv::cuda::cvtColor
+#include <atomic>
 #include <fstream>
+#include <mutex>
 #include <thread>
 #include <chrono>
 #include <sstream>
@@ -55,18 +58,52 @@ bool InternalCameraParams::read(const std::string& filepath, const int num,
 // EthernetCameraSource Implementation
 // ============================================================================
 
+static std::string busMessageReason(GstMessage* msg) {
+    if (GST_MESSAGE_TYPE(msg) != GST_MESSAGE_ERROR) {
+        return "end of stream";
+    }
+    GError* err;
+    gchar* debug;
+    gst_message_parse_error(msg, &err, &debug);
+    std::string reason = err->message;
+    g_error_free(err);
+    g_free(debug);
+    return reason;
+}
+
 EthernetCameraSource::EthernetCameraSource(const std::string& sourceIP, int sourcePort,
                                            const std::string& destIP, const std::string& name)
-    : sourceIP(sourceIP)
+    : pipeline(nullptr)
+    , appsink(nullptr)
+    , bus(nullptr)
+    , sourceIP(sourceIP)
     , sourcePort(sourcePort)
     , destIP(destIP)
     , cameraName(name)
-    , pipeline(nullptr)
-    , appsink(nullptr)
-    , bus(nullptr)
     , cuda_out_buffer(nullptr)
     , isInit(false)
     , isStreaming(false)
+    , cudaBufferBytes(0)
+    , latestSample(nullptr)
+    , lastFrameNs(0)
+    , framePeriodNs(0)
+    , state(State::STOPPED)
+    , reconnects(0)
+    , supervisorStop(false)
+    , fullPort(0)
+    , fullWanted(false)
+    , fullApplied(false)
+    , fullPipeline(nullptr)
+    , fullBus(nullptr)
+    , fullValve(nullptr)
+    , latestFullSample(nullptr)
+    , cuda_full_buffer(nullptr)
+    , cudaFullBytes(0)
+    , fullState(State::STOPPED)
+    , lastFullFrameNs(0)
+    , fullStartedNs(0)
+    , fullRetryNs(0)
+    , fullBackoffMs(0)
 {
 }
 
@@ -76,24 +113,70 @@ EthernetCameraSource::~EthernetCameraSource() {
 
 std::string EthernetCameraSource::createPipelineString() const {
     std::ostringstream pipeline;
+    const bool teeFull = !fullSize.empty() && fullPort == 0;
     
-    pipeline << "udpsrc address=" << destIP 
-             << " port=" << sourcePort
-             << " ! application/x-rtp,media=video,clock-rate=90000,encoding-name=H264,payload=96 "
-             << " ! rtpjitterbuffer drop-on-latency=true latency=200 "
-             << " ! rtph264depay "
-             << " ! h264parse "
-             << " ! nvv4l2decoder enable-max-performance=1 "
-             << " ! nvvidconv "
-             << " ! video/x-raw(memory:NVMM),format=RGBA,width=" << frameSize.width 
-             << ",height=" << frameSize.height
-             << " ! nvvidconv "
-             << " ! video/x-raw,format=BGRx "  // Use BGRx instead of BGR
-             << " ! appsink name=sink emit-signals=true max-buffers=1 drop=true sync=false";
+    pipeline << SVPipelineProfile::rtpSource(destIP, sourcePort);
+    if (auTap) {
+        // Whole access units with SPS/PPS repeated on every IDR, so any keyframe
+        // in the tapped stream starts an independently decodable segment
+        pipeline << " ! h264parse name=parse config-interval=-1 "
+                 << " ! video/x-h264,stream-format=byte-stream,alignment=au ";
+    } else {
+        pipeline << " ! h264parse ";
+    }
+    pipeline << " ! " << profile.decoder << " ";
+    if (teeFull) {
+        pipeline << " ! tee name=t  t. ! queue max-size-buffers=1 leaky=downstream ";
+    }
+    cv::Rect roi = crop & cv::Rect(cv::Point(), frameSize);
+    if (roi.size() == frameSize) {
+        roi = cv::Rect();
+    }
+    // The converter crops, so only the region is copied out of the decoder's memory
+    pipeline << profile.sinkChain(frameSize, "sink", roi);
+    if (teeFull) {
+        // Closed valve: the full-resolution branch converts and copies nothing
+        pipeline << "  t. ! valve name=full_valve drop=true "
+                 << " ! queue max-size-buffers=1 leaky=downstream "
+                 << profile.sinkChain(fullSize, "sink_full");
+    }
     
     return pipeline.str();
 }
 
+std::string EthernetCameraSource::createFullPipelineString() const {
+    std::ostringstream pipeline;
+    pipeline << SVPipelineProfile::rtpSource(destIP, fullPort)
+             << " ! h264parse ! " << profile.decoder
+             << profile.sinkChain(fullSize, "sink_full");
+    return pipeline.str();
+}
+
+void EthernetCameraSource::setPipelineProfile(const SVPipelineProfile& p) {
+    if (isInit) {
+        LOG_WARNING("Camera %s: pipeline profile must be set before init", cameraName.c_str());
+        return;
+    }
+    profile = p;
+}
+
+void EthernetCameraSource::setCrop(const cv::Rect& roi) {
+    if (isInit) {
+        LOG_WARNING("Camera %s: crop must be set before init", cameraName.c_str());
+        return;
+    }
+    crop = roi;
+}
+
+void EthernetCameraSource::setFullResolution(const cv::Size& size, int port) {
+    if (isInit) {
+        LOG_WARNING("Camera %s: full-resolution stream must be set before init", cameraName.c_str());
+        return;
+    }
+    fullSize = size;
+    fullPort = port;
+}
+
 bool EthernetCameraSource::init(const cv::Size& frameSize_) {
     if (isInit) {
         LOG_WARNING("Camera %s already initialized", cameraName.c_str());
@@ -101,18 +184,68 @@ bool EthernetCameraSource::init(const cv::Size& frameSize_) {
     }
     
     frameSize = frameSize_;
-    
-    // Initialize GStreamer (only once globally)
-    static bool gst_initialized = false;
-    if (!gst_initialized) {
-        gst_init(nullptr, nullptr);
-        gst_initialized = true;
+    {
+        std::lock_guard<std::mutex> lock(supervisorMutex);
+        requestedFrameSize = frameSize_;
     }
     
+    // Initialize GStreamer (only once globally; cameras are initialized in parallel)
+    static std::once_flag gst_initialized;
+    std::call_once(gst_initialized, [] { gst_init(nullptr, nullptr); });
+    
     LOG_DEBUG("Initializing Ethernet camera %s (%s:%d)...", 
               cameraName.c_str(), sourceIP.c_str(), sourcePort);
     
-    // Create pipeline
+    if (!buildPipeline()) {
+        return false;
+    }
+    
+    // Allocate CUDA output buffer (grown in capture() if the size changes)
+    size_t size = frameSize.width * frameSize.height * 4;
+    if (cudaMalloc(&cuda_out_buffer, size) != cudaSuccess) {
+        LOG_ERROR("Failed to allocate CUDA memory for camera %s", cameraName.c_str());
+        cuda_out_buffer = nullptr;
+        destroyPipeline();
+        return false;
+    }
+    cudaBufferBytes = size;
+    
+    isInit = true;
+    LOG_DEBUG("Camera %s initialized successfully", cameraName.c_str());
+    
+    return true;
+}
+
+bool EthernetCameraSource::deinit() {
+    if (!isInit) return true;
+    
+    stopStream();
+    
+    if (cuda_out_buffer) {
+        cudaFree(cuda_out_buffer);
+        cuda_out_buffer = nullptr;
+        cudaBufferBytes = 0;
+    }
+    if (cuda_full_buffer) {
+        cudaFree(cuda_full_buffer);
+        cuda_full_buffer = nullptr;
+        cudaFullBytes = 0;
+    }
+    
+    destroyPipeline();
+    {
+        std::lock_guard<std::mutex> lock(sampleMutex);
+        if (latestFullSample) {
+            gst_sample_unref(latestFullSample);
+            latestFullSample = nullptr;
+        }
+    }
+    
+    isInit = false;
+    return true;
+}
+
+bool EthernetCameraSource::buildPipeline() {
     std::string pipelineStr = createPipelineString();
     GError* error = nullptr;
     pipeline = gst_parse_launch(pipelineStr.c_str(), &error);
@@ -121,6 +254,8 @@ bool EthernetCameraSource::init(const cv::Size& frameSize_) {
         LOG_ERROR("Failed to create pipeline for camera %s: %s", 
                   cameraName.c_str(), error ? error->message : "unknown");
         if (error) g_error_free(error);
+        if (pipeline) gst_object_unref(pipeline);
+        pipeline = nullptr;
         return false;
     }
     
@@ -133,32 +268,41 @@ bool EthernetCameraSource::init(const cv::Size& frameSize_) {
         return false;
     }
     
-    // Get bus for error monitoring
-    bus = gst_element_get_bus(pipeline);
+    // Frames are taken as they arrive, so the supervisor sees arrival without capture()
+    g_signal_connect(appsink, "new-sample", G_CALLBACK(newSampleCallback), this);
     
-    // Allocate CUDA output buffer
-    size_t size = frameSize.width * frameSize.height * 4;
-    if (cudaMalloc(&cuda_out_buffer, size) != cudaSuccess) {
-        LOG_ERROR("Failed to allocate CUDA memory for camera %s", cameraName.c_str());
-        gst_object_unref(appsink);
-        gst_object_unref(pipeline);
-        return false;
+    // Tee mode: the valve keeps its state across restarts
+    fullValve = gst_bin_get_by_name(GST_BIN(pipeline), "full_valve");
+    if (fullValve) {
+        GstElement* sinkFull = gst_bin_get_by_name(GST_BIN(pipeline), "sink_full");
+        g_signal_connect(sinkFull, "new-sample", G_CALLBACK(newFullSampleCallback), this);
+        gst_object_unref(sinkFull);
+        fullApplied = fullWanted;
+        g_object_set(fullValve, "drop", fullApplied ? FALSE : TRUE, nullptr);
     }
     
-    isInit = true;
-    LOG_DEBUG("Camera %s initialized successfully", cameraName.c_str());
+    // Tap the compressed stream after the parser (no decode, no copy on the decode path)
+    if (auTap) {
+        GstElement* parse = gst_bin_get_by_name(GST_BIN(pipeline), "parse");
+        GstPad* pad = parse ? gst_element_get_static_pad(parse, "src") : nullptr;
+        if (pad) {
+            gst_pad_add_probe(pad, GST_PAD_PROBE_TYPE_BUFFER, accessUnitProbe, this, nullptr);
+            gst_object_unref(pad);
+        } else {
+            LOG_WARNING("Camera %s: no parser to tap, compressed stream not captured", cameraName.c_str());
+        }
+        if (parse) gst_object_unref(parse);
+    }
     
+    // Get bus for error monitoring
+    bus = gst_element_get_bus(pipeline);
     return true;
 }
 
-bool EthernetCameraSource::deinit() {
-    if (!isInit) return true;
-    
-    stopStream();
-    
-    if (cuda_out_buffer) {
-        cudaFree(cuda_out_buffer);
-        cuda_out_buffer = nullptr;
+void EthernetCameraSource::destroyPipeline() {
+    // NULL first: waits for the streaming threads, so no callback runs afterwards
+    if (pipeline) {
+        gst_element_set_state(pipeline, GST_STATE_NULL);
     }
     
     if (bus) {
@@ -171,14 +315,151 @@ bool EthernetCameraSource::deinit() {
         appsink = nullptr;
     }
     
+    if (fullValve) {
+        gst_object_unref(fullValve);
+        fullValve = nullptr;
+    }
+    
     if (pipeline) {
-        gst_element_set_state(pipeline, GST_STATE_NULL);
         gst_object_unref(pipeline);
         pipeline = nullptr;
     }
     
-    isInit = false;
-    return true;
+    std::lock_guard<std::mutex> lock(sampleMutex);
+    if (latestSample) {
+        gst_sample_unref(latestSample);
+        latestSample = nullptr;
+    }
+}
+
+void EthernetCameraSource::applyFullResolution() {
+    const bool want = fullWanted;
+    if (!want && !fullApplied && getFullState() != State::STOPPED) {
+        // Turned off while waiting to be rebuilt
+        fullState.store(State::STOPPED, std::memory_order_release);
+        fullRetryNs = 0;
+        fullBackoffMs = supervisorOpts.backoff_min_ms;
+    }
+    if (fullSize.empty() || want == fullApplied) return;
+    
+    const int64_t now_ns = std::chrono::steady_clock::now().time_since_epoch().count();
+    if (fullPort == 0) {
+        if (!fullValve) return;     // Applied when the pipeline is rebuilt
+        g_object_set(fullValve, "drop", want ? FALSE : TRUE, nullptr);
+    } else if (want) {
+        if (now_ns < fullRetryNs) return;       // Backing off after a failure
+        
+        // Own receive + decode pipeline, only while someone looks at it
+        GError* error = nullptr;
+        fullPipeline = gst_parse_launch(createFullPipelineString().c_str(), &error);
+        if (!fullPipeline || error) {
+            LOG_ERROR("Camera %s: full-resolution pipeline failed: %s", cameraName.c_str(),
+                      error ? error->message : "unknown");
+            if (error) g_error_free(error);
+            destroyFullPipeline();
+            retryFullLater(now_ns);
+            return;
+        }
+        GstElement* sinkFull = gst_bin_get_by_name(GST_BIN(fullPipeline), "sink_full");
+        g_signal_connect(sinkFull, "new-sample", G_CALLBACK(newFullSampleCallback), this);
+        gst_object_unref(sinkFull);
+        fullBus = gst_element_get_bus(fullPipeline);
+        if (gst_element_set_state(fullPipeline, GST_STATE_PLAYING) == GST_STATE_CHANGE_FAILURE) {
+            LOG_ERROR("Camera %s: full-resolution pipeline failed to start", cameraName.c_str());
+            destroyFullPipeline();
+            retryFullLater(now_ns);
+            return;
+        }
+    } else {
+        destroyFullPipeline();
+    }
+    fullApplied = want;
+    
+    // Frames are timed from here, as after a primary (re)start
+    fullStartedNs = now_ns;
+    lastFullFrameNs = now_ns;
+    if (want) {
+        State s = fullState.load(std::memory_order_acquire);
+        fullState.store(s == State::RECONNECTING ? s : State::STARTING, std::memory_order_release);
+    } else {
+        fullState.store(State::STOPPED, std::memory_order_release);
+        fullRetryNs = 0;
+        fullBackoffMs = supervisorOpts.backoff_min_ms;
+    }
+    
+    if (!want) {
+        // A later zoom must not start with an old frame
+        std::lock_guard<std::mutex> lock(sampleMutex);
+        if (latestFullSample) {
+            gst_sample_unref(latestFullSample);
+            latestFullSample = nullptr;
+        }
+    }
+    LOG_DEBUG("Camera %s: full resolution %s", cameraName.c_str(), want ? "on" : "off");
+}
+
+void EthernetCameraSource::destroyFullPipeline() {
+    if (fullPipeline) {
+        gst_element_set_state(fullPipeline, GST_STATE_NULL);
+    }
+    if (fullBus) {
+        gst_object_unref(fullBus);
+        fullBus = nullptr;
+    }
+    if (fullPipeline) {
+        gst_object_unref(fullPipeline);
+        fullPipeline = nullptr;
+    }
+}
+
+void EthernetCameraSource::retryFullLater(int64_t now_ns) {
+    // Port mode: applyFullResolution() rebuilds once the backoff has passed, while still wanted
+    fullRetryNs = now_ns + fullBackoffMs * 1000000LL;
+    fullBackoffMs = std::min(fullBackoffMs * 2, supervisorOpts.backoff_max_ms);
+    fullState.store(State::RECONNECTING, std::memory_order_release);
+}
+
+void EthernetCameraSource::superviseFull(int64_t now_ns) {
+    if (!fullApplied) return;
+    
+    const SupervisorOptions& o = supervisorOpts;
+    std::string reason;
+    if (fullBus) {
+        // Port mode: own bus; the tee branch posts on the primary one
+        if (GstMessage* msg = gst_bus_pop_filtered(fullBus,
+                static_cast<GstMessageType>(GST_MESSAGE_ERROR | GST_MESSAGE_EOS))) {
+            reason = busMessageReason(msg);
+            gst_message_unref(msg);
+        }
+    }
+    
+    const int64_t last_ns = lastFullFrameNs.load();
+    const int64_t age_ms = (now_ns - last_ns) / 1000000;
+    const bool waiting_first = (last_ns == fullStartedNs);
+    const State s = getFullState();
+    if (reason.empty()) {
+        if (age_ms < o.stale_ms && !waiting_first) {
+            if (s != State::LIVE) {
+                LOG_DEBUG("Camera %s: full resolution live", cameraName.c_str());
+                fullState.store(State::LIVE, std::memory_order_release);
+                fullBackoffMs = o.backoff_min_ms;
+            }
+        } else if (s == State::LIVE) {
+            LOG_WARNING("Camera %s: no full-resolution frame for %lld ms, stale", cameraName.c_str(),
+                        static_cast<long long>(age_ms));
+            fullState.store(State::STALE, std::memory_order_release);
+        }
+        if (fullPipeline && age_ms >= (waiting_first ? o.startup_ms : o.restart_ms)) {
+            reason = "no frame for " + std::to_string(age_ms) + " ms";
+        }
+    }
+    if (reason.empty()) return;
+    
+    LOG_WARNING("Camera %s: full resolution %s, restarting in %d ms", cameraName.c_str(), reason.c_str(),
+                fullBackoffMs);
+    destroyFullPipeline();
+    fullApplied = false;
+    retryFullLater(now_ns);
 }
 
 bool EthernetCameraSource::startStream() {
@@ -199,6 +480,11 @@ bool EthernetCameraSource::startStream() {
     }
     
     isStreaming = true;
+    lastFrameNs = std::chrono::steady_clock::now().time_since_epoch().count();
+    setState(State::STARTING);
+    
+    supervisorStop = false;
+    supervisor = std::thread(&EthernetCameraSource::supervise, this);
     LOG_DEBUG("Camera %s stream started", cameraName.c_str());
     
     return true;
@@ -209,36 +495,249 @@ bool EthernetCameraSource::stopStream() {
     
     LOG_DEBUG("Stopping stream for camera %s...", cameraName.c_str());
     
-    gst_element_set_state(pipeline, GST_STATE_NULL);
+    {
+        std::lock_guard<std::mutex> lock(supervisorMutex);
+        supervisorStop = true;
+    }
+    supervisorWake.notify_all();
+    if (supervisor.joinable()) {
+        supervisor.join();
+    }
+    
+    if (pipeline) {
+        gst_element_set_state(pipeline, GST_STATE_NULL);
+    }
+    destroyFullPipeline();
+    if (fullPort != 0) {
+        fullApplied = false;
+    }
+    fullState.store(State::STOPPED, std::memory_order_release);
     isStreaming = false;
+    setState(State::STOPPED);
     
     return true;
 }
 
+void EthernetCameraSource::setFrameSize(const cv::Size& size) {
+    if (!isStreaming) {
+        // No supervisor: frameSize is ours
+        if (size == frameSize) return;
+        if (isInit) {
+            deinit();
+            init(size);
+        } else {
+            frameSize = size;
+        }
+        return;
+    }
+    
+    // While streaming only the supervisor touches frameSize
+    {
+        std::lock_guard<std::mutex> lock(supervisorMutex);
+        if (size == requestedFrameSize) return;
+        requestedFrameSize = size;
+        pendingFrameSize = size;
+    }
+    supervisorWake.notify_all();
+}
+
+const char* EthernetCameraSource::stateName(State s) {
+    switch (s) {
+        case State::STOPPED:      return "stopped";
+        case State::STARTING:     return "starting";
+        case State::LIVE:         return "live";
+        case State::STALE:        return "stale";
+        case State::RECONNECTING: return "reconnecting";
+    }
+    return "unknown";
+}
+
+void EthernetCameraSource::setState(State s) {
+    state.store(s, std::memory_order_release);
+    
+    // A capture() waiting for a frame gives up as soon as the camera is no longer live
+    { std::lock_guard<std::mutex> lock(sampleMutex); }
+    sampleReady.notify_all();
+}
+
+void EthernetCameraSource::supervise() {
+    const SupervisorOptions& o = supervisorOpts;
+    int backoff_ms = o.backoff_min_ms;
+    int64_t started_ns = lastFrameNs.load();   // Set by startStream(); frames arriving later are newer
+    fullBackoffMs = o.backoff_min_ms;
+    fullRetryNs = 0;
+    
+    for (;;) {
+        // Errors are seen as soon as they are posted; the timeout paces the frame-age checks
+        GstMessage* msg = bus ? gst_bus_timed_pop_filtered(bus, 100 * GST_MSECOND,
+                                    static_cast<GstMessageType>(GST_MESSAGE_ERROR | GST_MESSAGE_EOS))
+                              : nullptr;
+        
+        cv::Size newSize;
+        {
+            std::lock_guard<std::mutex> lock(supervisorMutex);
+            if (supervisorStop) {
+                if (msg) gst_message_unref(msg);
+                return;
+            }
+            std::swap(newSize, pendingFrameSize);
+        }
+        
+        applyFullResolution();
+        
+        std::string reason;
+        if (msg) {
+            reason = busMessageReason(msg);
+            gst_message_unref(msg);
+        }
+        
+        const int64_t now_ns = std::chrono::steady_clock::now().time_since_epoch().count();
+        superviseFull(now_ns);
+        const int64_t last_ns = lastFrameNs.load();
+        const int64_t age_ms = (now_ns - last_ns) / 1000000;
+        const State s = getState();
+        
+        if (!pipeline) {
+            reason = "pipeline not running";
+        } else if (reason.empty() && newSize.empty()) {
+            const bool waiting_first = (last_ns == started_ns);     // No frame since the (re)start
+            if (age_ms < o.stale_ms && !waiting_first) {
+                // A stale camera is made live again by its next frame (newSampleCallback)
+                if (s == State::STARTING || s == State::RECONNECTING) {
+                    LOG_DEBUG("Camera %s: live", cameraName.c_str());
+                    setState(State::LIVE);
+                    backoff_ms = o.backoff_min_ms;
+                }
+            } else if (s == State::LIVE) {
+                LOG_WARNING("Camera %s: no frame for %lld ms, stale", cameraName.c_str(), static_cast<long long>(age_ms));
+                setState(State::STALE);
+            }
+            if (age_ms >= (waiting_first ? o.startup_ms : o.restart_ms)) {
+                reason = "no frame for " + std::to_string(age_ms) + " ms";
+            }
+        }
+        
+        if (reason.empty() && newSize.empty()) continue;
+        
+        if (!newSize.empty()) {
+            LOG_DEBUG("Camera %s: restarting at %dx%d", cameraName.c_str(), newSize.width, newSize.height);
+            frameSize = newSize;
+        } else {
+            LOG_WARNING("Camera %s: %s, restarting in %d ms", cameraName.c_str(), reason.c_str(), backoff_ms);
+            setState(State::RECONNECTING);
+            
+            std::unique_lock<std::mutex> lock(supervisorMutex);
+            if (supervisorWake.wait_for(lock, std::chrono::milliseconds(backoff_ms), [this] { return supervisorStop; })) {
+                return;
+            }
+            backoff_ms = std::min(backoff_ms * 2, o.backoff_max_ms);
+        }
+        
+        // Only this camera's pipeline; the others keep streaming
+        setState(State::RECONNECTING);
+        destroyPipeline();
+        started_ns = std::chrono::steady_clock::now().time_since_epoch().count();
+        lastFrameNs = started_ns;
+        if (buildPipeline() && gst_element_set_state(pipeline, GST_STATE_PLAYING) != GST_STATE_CHANGE_FAILURE) {
+            reconnects++;
+        } else {
+            LOG_ERROR("Camera %s: pipeline restart failed", cameraName.c_str());
+            destroyPipeline();
+        }
+    }
+}
+
+GstFlowReturn EthernetCameraSource::newSampleCallback(GstElement* sink, gpointer data) {
+    auto* self = static_cast<EthernetCameraSource*>(data);
+    GstSample* sample = gst_app_sink_pull_sample(GST_APP_SINK(sink));
+    if (!sample) return GST_FLOW_OK;
+    
+    {
+        std::lock_guard<std::mutex> lock(self->sampleMutex);
+        if (self->latestSample) {
+            gst_sample_unref(self->latestSample);   // Not taken in time, newest wins
+        }
+        self->latestSample = sample;
+    }
+    const int64_t now_ns = std::chrono::steady_clock::now().time_since_epoch().count();
+    const int64_t interval_ns = now_ns - self->lastFrameNs.exchange(now_ns);
+    if (interval_ns > 0 && interval_ns < self->supervisorOpts.stale_ms * 1000000LL) {
+        // Only this streaming thread writes it
+        const int64_t period_ns = self->framePeriodNs.load(std::memory_order_relaxed);
+        self->framePeriodNs.store(period_ns ? (period_ns * 7 + interval_ns) / 8 : interval_ns,
+                                  std::memory_order_relaxed);
+    }
+    
+    // Marked stale by capture(), but still sending
+    State stale = State::STALE;
+    self->state.compare_exchange_strong(stale, State::LIVE, std::memory_order_acq_rel);
+    
+    self->sampleReady.notify_all();
+    return GST_FLOW_OK;
+}
+
 bool EthernetCameraSource::capture(cv::cuda::GpuMat& frame, size_t timeout) {
     if (!isStreaming) {
         LOG_WARNING("Camera %s: capture called while not streaming", cameraName.c_str());
         return false;
     }
     
-    // Pull sample from appsink
-    GstSample* sample = gst_app_sink_try_pull_sample(GST_APP_SINK(appsink), 
-                                                       timeout * 1000000); // ns
+    // A live camera delivers within a frame period; waiting longer for one that
+    // has just gone away would hold up every other camera's capture
+    std::chrono::nanoseconds wait = std::chrono::milliseconds(timeout);
+    bool liveWait = false;
+    if (getState() == State::LIVE) {
+        const int64_t period_ns = framePeriodNs.load(std::memory_order_relaxed);
+        const std::chrono::nanoseconds bound = period_ns > 0 ? std::chrono::nanoseconds(2 * period_ns)
+                                                             : std::chrono::milliseconds(supervisorOpts.stale_ms);
+        liveWait = bound < wait;
+        wait = std::min(wait, bound);
+    }
+    
+    // Take the newest sample; bus errors and restarts are the supervisor's
+    GstSample* sample = nullptr;
+    {
+        std::unique_lock<std::mutex> lock(sampleMutex);
+        sampleReady.wait_for(lock, wait, [this] {
+            const State s = getState();
+            return latestSample || (s != State::LIVE && s != State::STARTING);
+        });
+        std::swap(sample, latestSample);
+    }
     
     if (!sample) {
-        // Check for errors on bus
-        GstMessage* msg = gst_bus_pop_filtered(bus, GST_MESSAGE_ERROR);
-        if (msg) {
-            GError* err;
-            gchar* debug;
-            gst_message_parse_error(msg, &err, &debug);
-            LOG_ERROR("Camera %s error: %s", cameraName.c_str(), err->message);
-            g_error_free(err);
-            g_free(debug);
-            gst_message_unref(msg);
+        // Not waited for again until it sends; the supervisor restarts it if it does not
+        State live = State::LIVE;
+        if (liveWait && state.compare_exchange_strong(live, State::STALE, std::memory_order_acq_rel)) {
+            LOG_WARNING("Camera %s: no frame within two frame periods, stale", cameraName.c_str());
         }
         return false;
     }
+    return uploadSample(sample, cuda_out_buffer, cudaBufferBytes, frame);
+}
+
+bool EthernetCameraSource::captureFull(cv::cuda::GpuMat& frame) {
+    GstSample* sample = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(sampleMutex);
+        std::swap(sample, latestFullSample);
+    }
+    if (!sample) {
+        return false;
+    }
+    return uploadSample(sample, cuda_full_buffer, cudaFullBytes, frame);
+}
+
+bool EthernetCameraSource::uploadSample(GstSample* sample, uchar*& cudaBuffer, size_t& cudaBytes,
+                                        cv::cuda::GpuMat& frame) {
+    // Size from the caps: a restarted pipeline may have a new size
+    int width = 0;
+    int height = 0;
+    if (GstCaps* caps = gst_sample_get_caps(sample)) {
+        const GstStructure* st = gst_caps_get_structure(caps, 0);
+        gst_structure_get_int(st, "width", &width);
+        gst_structure_get_int(st, "height", &height);
+    }
     
     // Get buffer from sample
     GstBuffer* buffer = gst_sample_get_buffer(sample);
@@ -254,16 +753,43 @@ bool EthernetCameraSource::capture(cv::cuda::GpuMat& frame, size_t timeout) {
         return false;
     }
     
+    // BGRx or BGR (pipeline profile); BGR rows are padded to 4 bytes
+    const int channels = profile.format == "BGR" ? 3 : 4;
+    const size_t step = (static_cast<size_t>(width) * channels + 3) & ~static_cast<size_t>(3);
+    const size_t bytes = step * height;
+    if (width <= 0 || height <= 0 || map.size < bytes) {
+        LOG_ERROR("Camera %s: unexpected frame (%zu bytes for %dx%d)", cameraName.c_str(), map.size, width, height);
+        gst_buffer_unmap(buffer, &map);
+        gst_sample_unref(sample);
+        return false;
+    }
+    if (bytes > cudaBytes) {
+        cudaFree(cudaBuffer);
+        cudaBytes = 0;
+        if (cudaMalloc(&cudaBuffer, bytes) != cudaSuccess) {
+            LOG_ERROR("Failed to allocate CUDA memory for camera %s", cameraName.c_str());
+            cudaBuffer = nullptr;
+            gst_buffer_unmap(buffer, &map);
+            gst_sample_unref(sample);
+            return false;
+        }
+        cudaBytes = bytes;
+    }
+    
     // Copy data to CUDA buffer
-    cudaMemcpy(cuda_out_buffer, map.data, map.size, cudaMemcpyHostToDevice);
+    cudaMemcpy(cudaBuffer, map.data, bytes, cudaMemcpyHostToDevice);
     
     // ✅ ADD THIS LINE: Create GpuMat wrapper around CUDA buffer (BGRx = 4 channels)
-    cv::cuda::GpuMat temp(frameSize, CV_8UC4, cuda_out_buffer);
+    cv::cuda::GpuMat temp(cv::Size(width, height), CV_8UC(channels), cudaBuffer, step);
     
     // old Create GpuMat wrapper around CUDA buffer
     //frame = cv::cuda::GpuMat(frameSize, CV_8UC4, cuda_out_buffer);
     
-    cv::cuda::cvtColor(temp, frame, cv::COLOR_BGRA2BGR);  // Convert 4-channel to 3-channel
+    if (channels == 4) {
+        cv::cuda::cvtColor(temp, frame, cv::COLOR_BGRA2BGR);  // Convert 4-channel to 3-channel
+    } else {
+        temp.copyTo(frame);
+    }
 
     
     // Cleanup
@@ -273,33 +799,61 @@ bool EthernetCameraSource::capture(cv::cuda::GpuMat& frame, size_t timeout) {
     return true;
 }
 
+GstFlowReturn EthernetCameraSource::newFullSampleCallback(GstElement* sink, gpointer data) {
+    auto* self = static_cast<EthernetCameraSource*>(data);
+    GstSample* sample = gst_app_sink_pull_sample(GST_APP_SINK(sink));
+    if (!sample) return GST_FLOW_OK;
+    
+    {
+        std::lock_guard<std::mutex> lock(self->sampleMutex);
+        if (self->latestFullSample) {
+            gst_sample_unref(self->latestFullSample);
+        }
+        self->latestFullSample = sample;
+    }
+    self->lastFullFrameNs = std::chrono::steady_clock::now().time_since_epoch().count();
+    return GST_FLOW_OK;
+}
+
+GstPadProbeReturn EthernetCameraSource::accessUnitProbe(GstPad*, GstPadProbeInfo* info, gpointer data) {
+    auto* self = static_cast<EthernetCameraSource*>(data);
+    GstBuffer* buffer = GST_PAD_PROBE_INFO_BUFFER(info);
+    
+    GstMapInfo map;
+    if (buffer && gst_buffer_map(buffer, &map, GST_MAP_READ)) {
+        const bool keyframe = !GST_BUFFER_FLAG_IS_SET(buffer, GST_BUFFER_FLAG_DELTA_UNIT);
+        self->auTap(map.data, map.size, keyframe);
+        gst_buffer_unmap(buffer, &map);
+    }
+    return GST_PAD_PROBE_OK;
+}
+
 // ============================================================================
 // MultiCameraSource Implementation
 // ============================================================================
 
-MultiCameraSource::MultiCameraSource()
-    : _cams({
-          EthernetCameraSource("192.168.45.10", 5020, "192.168.45.3", "Front"),
-          EthernetCameraSource("192.168.45.11", 5021, "192.168.45.3", "Left"),
-          EthernetCameraSource("192.168.45.12", 5022, "192.168.45.3", "Rear"),
-          EthernetCameraSource("192.168.45.13", 5023, "192.168.45.3", "Right")
-          
-        //   EthernetCameraSource("192.168.45.11", 5021, "192.168.45.3", "Right"),   // Index 0 ✅
-        //   EthernetCameraSource("192.168.45.12", 5022, "192.168.45.3", "Front"),  // Index 1 ✅
-        //   EthernetCameraSource("192.168.45.13", 5023, "192.168.45.3", "Left"),   // Index 2 ✅ 
-        //   EthernetCameraSource("192.168.45.10", 5020, "192.168.45.3", "Rear")    // Index 3 ✅ MUST BE LAST!
-
-
-          
-      })
-    , destIP("192.168.45.3")
-    , cudaStreamObj(cv::cuda::Stream::Null())
+MultiCameraSource::MultiCameraSource(const SVCameraRig& rig)
+    : cudaStreamObj(cv::cuda::Stream::Null())
+    , destIP(rig.dest_ip)
 {
+    const size_t count = static_cast<size_t>(rig.size());
+    
+    for (const SVCameraInfo& cam : rig.cameras) {
+        _cams.push_back(std::make_unique<EthernetCameraSource>(cam.ip, cam.port, destIP, cam.name));
+        fullPorts.push_back(cam.port_full);
+    }
+    
+    Ks.resize(count);
+    camIparams.resize(count);
+    undistFrames.resize(count);
+    rawHandles.assign(count, SVFramePool::INVALID_HANDLE);
+    _cudaStream.assign(count, nullptr);
+    
     // Initialize CUDA streams
-    for (int i = 0; i < CAM_NUMS; ++i) {
+    for (size_t i = 0; i < count; ++i) {
         if (cudaStreamCreate(&_cudaStream[i]) != cudaSuccess) {
             _cudaStream[i] = nullptr;
-            LOG_ERROR("Failed to create CUDA stream %d", i);
+            LOG_ERROR("Failed to create CUDA stream %zu", i);
         }
     }
 }
@@ -316,25 +870,67 @@ int MultiCameraSource::init(const std::string& param_filepath, const cv::Size& c
     frameSize = undistSize;
     _undistort = useUndist;
     
-    // Initialize all cameras
-    bool allCamsOk = true;
-    for (size_t i = 0; i < CAM_NUMS; ++i) {
-        LOG_DEBUG("Initializing camera %zu: %s...", i, _cams[i].getCameraName().c_str());
-        bool res = _cams[i].init(frameSize);
-        LOG_DEBUG("Camera %zu init %s", i, res ? "OK" : "FAILED");
-        allCamsOk &= res;
+    if (_undistort && !crops.empty()) {
+        // Undistortion maps are built for whole frames
+        LOG_WARNING("Crop regions are ignored with undistortion");
+        crops.clear();
+        for (auto& cam : _cams) {
+            cam->setCrop(cv::Rect());
+        }
     }
     
-    if (!allCamsOk) {
-        LOG_ERROR("One or more cameras failed to initialize");
-        return -1;
+    if (replay) {
+        if (replay->cameraCount() != static_cast<int>(_cams.size())) {
+            LOG_ERROR("Session has %d camera streams, rig has %zu cameras",
+                      replay->cameraCount(), _cams.size());
+            return -1;
+        }
+        LOG_DEBUG("Replaying session instead of opening the cameras");
+    } else {
+        if (eventBuffer || sessionTap) {
+            for (size_t i = 0; i < _cams.size(); ++i) {
+                const int cam = static_cast<int>(i);
+                _cams[i]->setAccessUnitTap([this, cam](const uint8_t* data, size_t size, bool keyframe) {
+                    onAccessUnit(cam, data, size, keyframe);
+                });
+            }
+        }
+        
+        // Initialize all cameras in parallel (pipeline creation dominates startup)
+        std::atomic<bool> allCamsOk{true};
+        SVThreadPool::instance().parallelFor(0, static_cast<int>(_cams.size()), [&](int i) {
+            LOG_DEBUG("Initializing camera %d: %s...", i, _cams[i]->getCameraName().c_str());
+            bool res = _cams[i]->init(frameSize);
+            LOG_DEBUG("Camera %d init %s", i, res ? "OK" : "FAILED");
+            if (!res) allCamsOk = false;
+        });
+        
+        if (!allCamsOk) {
+            LOG_ERROR("One or more cameras failed to initialize");
+            return -1;
+        }
+    }
+    
+    // Reserve capture buffers once; capture() only ever writes into these
+    if (!framePool) {
+        framePool = std::make_shared<SVFramePool>();
+    }
+    for (size_t i = 0; i < _cams.size(); ++i) {
+        // Replay decodes whole frames and crops a view of them
+        const bool cropped = !crops.empty() && !crops[i].empty() && !replay;
+        rawHandles[i] = framePool->reserveDevice(cropped ? crops[i].size() : frameSize, CV_8UC3,
+                                                 "camera " + _cams[i]->getCameraName() + " raw");
+    }
+    if (!fullFrameSize.empty()) {
+        // Only one camera is shown at full resolution at a time
+        fullHandle = framePool->reserveDevice(fullFrameSize, CV_8UC3, "camera full resolution");
     }
     
     // ✅ ONLY load calibration if undistortion is enabled AND path is provided
     if (_undistort && !param_filepath.empty()) {
         LOG_DEBUG("Loading calibration files from: %s", param_filepath.c_str());
         
-        for (size_t i = 0; i < CAM_NUMS; ++i) {
+        for (size_t i = 0; i < _cams.size(); ++i) {
             if (!camIparams[i].read(param_filepath, i, calibSize, frameSize)) {
                 LOG_ERROR("Failed to read calibration for camera %zu", i);
                 LOG_WARNING("Disabling undistortion due to missing calibration files");
@@ -374,10 +970,14 @@ int MultiCameraSource::init(const std::string& param_filepath, const cv::Size& c
 bool MultiCameraSource::startStream() {
     LOG_DEBUG("Starting all camera streams...");
     
-    bool allStarted = true;
-    for (auto& cam : _cams) {
-        allStarted &= cam.startStream();
-    }
+    // State changes can block on the decoder; start all pipelines at once
+    streamStart = std::chrono::steady_clock::now();
+    if (replay) return true;
+    
+    std::atomic<bool> allStarted{true};
+    SVThreadPool::instance().parallelFor(0, static_cast<int>(_cams.size()), [&](int i) {
+        if (!_cams[i]->startStream()) allStarted = false;
+    });
     
     return allStarted;
 }
@@ -387,81 +987,275 @@ bool MultiCameraSource::stopStream() {
     
     bool allStopped = true;
     for (auto& cam : _cams) {
-        allStopped &= cam.stopStream();
+        allStopped &= cam->stopStream();
     }
     
     return allStopped;
 }
 
-bool MultiCameraSource::capture(std::array<Frame, CAM_NUMS>& frames) {
-    bool allCaptured = true;
+bool MultiCameraSource::capture(std::vector<Frame>& frames) {
+    std::atomic<bool> allCaptured{true};
     
-    // Capture from all cameras in parallel
-    #pragma omp parallel for
-    for (size_t i = 0; i < CAM_NUMS; ++i) {
-        cv::cuda::GpuMat rawFrame;
+    if (frames.size() != _cams.size()) {
+        frames.resize(_cams.size());
+    }
+    
+    if (replay) return replayNext(frames);
+    
+    // Capture from all cameras in parallel on the shared pool
+    SVThreadPool::instance().parallelFor(0, static_cast<int>(_cams.size()), [&](int i) {
+        if (!isCaptured(i, frames[i])) return;
         
-        if (!_cams[i].capture(rawFrame, 5000)) {
-            LOG_WARNING("Failed to capture from camera %zu", i);
-            frames[i].gpuFrame = cv::cuda::GpuMat();  // ✅ ADD: Set to empty GpuMat
+        cv::cuda::GpuMat& rawFrame = framePool->device(rawHandles[i]);
+        
+        if (!_cams[i]->capture(rawFrame, 5000)) {
+            // Stale (no frame within two periods) or being restarted by its supervisor;
+            // keep its last frame so the other cameras run on
+            const EthernetCameraSource::State s = _cams[i]->getState();
+            if (s != EthernetCameraSource::State::LIVE && s != EthernetCameraSource::State::STARTING &&
+                !frames[i].image.empty()) {
+                return;
+            }
+            LOG_WARNING("Failed to capture from camera %d", i);
+            frames[i].image.invalidate();
             allCaptured = false;
-            continue;
+            return;
         }
         
         // Check if frame is valid before processing
         if (rawFrame.empty()) {
-            LOG_WARNING("Camera %zu returned empty frame", i);
-            frames[i].gpuFrame = cv::cuda::GpuMat();  // ✅ ADD: Set to empty GpuMat
+            LOG_WARNING("Camera %d returned empty frame", i);
+            frames[i].image.invalidate();
             allCaptured = false;
-            continue;
+            return;
         }
         
-        // Apply undistortion if enabled
-        if (_undistort && !undistFrames[i].remapX.empty()) {
-            cv::cuda::remap(rawFrame, undistFrames[i].undistFrame,
-                           undistFrames[i].remapX, undistFrames[i].remapY,
-                           cv::INTER_LINEAR, cv::BORDER_CONSTANT, cv::Scalar());
-            
-            // Validate ROI before cropping
-            if (undistFrames[i].roiFrame.x >= 0 && 
-                undistFrames[i].roiFrame.y >= 0 &&
-                undistFrames[i].roiFrame.x + undistFrames[i].roiFrame.width <= undistFrames[i].undistFrame.cols &&
-                undistFrames[i].roiFrame.y + undistFrames[i].roiFrame.height <= undistFrames[i].undistFrame.rows) {
-                
-                frames[i].gpuFrame = undistFrames[i].undistFrame(undistFrames[i].roiFrame);
-            } else {
-                LOG_WARNING("Invalid ROI for camera %zu, using full undistorted frame", i);
-                frames[i].gpuFrame = undistFrames[i].undistFrame;
+        attachFrame(i, rawFrame, frames[i]);
+    });
+    
+    return allCaptured;
+}
+
+bool MultiCameraSource::waitForFrames(std::vector<Frame>& frames, size_t timeout_ms) {
+    std::atomic<bool> allReady{true};
+    
+    if (frames.size() != _cams.size()) {
+        frames.resize(_cams.size());
+    }
+    
+    if (replay) {
+        // A camera's stream may start with a few units before its first keyframe
+        while (!replayNext(frames)) {
+            if (std::chrono::steady_clock::now() - streamStart > std::chrono::milliseconds(timeout_ms)) {
+                LOG_ERROR("Session replay: no frame from every camera within %zu ms", timeout_ms);
+                return false;
             }
-        } else {
-            frames[i].gpuFrame = rawFrame;
         }
+        return true;
     }
     
-    return allCaptured;
+    SVThreadPool::instance().parallelFor(0, static_cast<int>(_cams.size()), [&](int i) {
+        cv::cuda::GpuMat& rawFrame = framePool->device(rawHandles[i]);
+        
+        // Blocks on the appsink until the pipeline has prerolled and decoded a frame
+        if (!_cams[i]->capture(rawFrame, timeout_ms) || rawFrame.empty()) {
+            LOG_ERROR("Camera %s: no frame within %zu ms", _cams[i]->getCameraName().c_str(), timeout_ms);
+            frames[i].image.invalidate();
+            allReady = false;
+            return;
+        }
+        
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - streamStart).count();
+        LOG_DEBUG("Camera %s: first frame %lld ms after stream start",
+                  _cams[i]->getCameraName().c_str(), static_cast<long long>(elapsed));
+        
+        attachFrame(i, rawFrame, frames[i]);
+    });
+    
+    return allReady;
+}
+
+void MultiCameraSource::setPipelineProfile(const SVPipelineProfile& profile) {
+    for (auto& cam : _cams) {
+        cam->setPipelineProfile(profile);
+    }
+}
+
+void MultiCameraSource::setCropRegions(const std::vector<cv::Rect>& regions) {
+    if (regions.size() != _cams.size()) {
+        LOG_ERROR("Crop regions: %zu for %zu cameras", regions.size(), _cams.size());
+        return;
+    }
+    crops = regions;
+    for (size_t i = 0; i < _cams.size(); ++i) {
+        _cams[i]->setCrop(crops[i]);
+    }
+}
+
+void MultiCameraSource::setFullResolution(const cv::Size& size) {
+    fullFrameSize = size;
+    for (size_t i = 0; i < _cams.size(); ++i) {
+        _cams[i]->setFullResolution(size, fullPorts[i]);
+    }
+}
+
+void MultiCameraSource::setZoomCamera(int index) {
+    if (fullFrameSize.empty()) return;
+    
+    zoomCamera = index;
+    fullFrameCamera = -1;           // Re-zooming must not show a frame from before
+    for (size_t i = 0; i < _cams.size(); ++i) {
+        _cams[i]->enableFullResolution(static_cast<int>(i) == index);
+    }
+}
+
+bool MultiCameraSource::captureFull(Frame& frame) {
+    if (zoomCamera < 0 || fullHandle == SVFramePool::INVALID_HANDLE || replay) {
+        return false;
+    }
+    
+    cv::cuda::GpuMat& full = framePool->device(fullHandle);
+    if (_cams[zoomCamera]->captureFull(full)) {
+        fullFrameCamera = zoomCamera;
+    } else if (_cams[zoomCamera]->getFullState() != EthernetCameraSource::State::LIVE) {
+        // Stale or restarting: the caller falls back to the stitch-resolution frame
+        return false;
+    }
+    // No new frame: the previous one is still right if it is from this camera
+    if (fullFrameCamera != zoomCamera) return false;
+    
+    frame.image.attachDevice(full);
+    return true;
+}
+
+bool MultiCameraSource::isCaptured(size_t i, const Frame& frame) const {
+    // Until a camera has a frame it is always captured
+    return captureMask.empty() || captureMask[i] || frame.image.empty();
+}
+
+void MultiCameraSource::attachFrame(size_t i, cv::cuda::GpuMat& rawFrame, Frame& frame) {
+    // Apply undistortion if enabled
+    if (_undistort && !undistFrames[i].remapX.empty()) {
+        cv::cuda::remap(rawFrame, undistFrames[i].undistFrame,
+                       undistFrames[i].remapX, undistFrames[i].remapY,
+                       cv::INTER_LINEAR, cv::BORDER_CONSTANT, cv::Scalar());
+        
+        // Validate ROI before cropping
+        if (undistFrames[i].roiFrame.x >= 0 && 
+            undistFrames[i].roiFrame.y >= 0 &&
+            undistFrames[i].roiFrame.x + undistFrames[i].roiFrame.width <= undistFrames[i].undistFrame.cols &&
+            undistFrames[i].roiFrame.y + undistFrames[i].roiFrame.height <= undistFrames[i].undistFrame.rows) {
+            
+            frame.image.attachDevice(undistFrames[i].undistFrame(undistFrames[i].roiFrame));
+        } else {
+            LOG_WARNING("Invalid ROI for camera %zu, using full undistorted frame", i);
+            frame.image.attachDevice(undistFrames[i].undistFrame);
+        }
+    } else {
+        frame.image.attachDevice(rawFrame);
+    }
 }
 
 bool MultiCameraSource::setFrameSize(const cv::Size& size) {
     frameSize = size;
     
-    // Reinitialize cameras with new size
+    // Streaming cameras are rebuilt by their own supervisors; the others pick the size up in init()
     for (auto& cam : _cams) {
-        cam.stopStream();
-        cam.deinit();
-        cam.init(size);
+        if (!cam->isInitialized()) continue;
+        cam->setFrameSize(size);
     }
     
     return true;
 }
 
+bool MultiCameraSource::replayNext(std::vector<Frame>& frames) {
+    int64_t pts_ns = 0;
+    if (!replay->next(replayFrames, pts_ns)) {
+        return false;
+    }
+    
+    bool all = true;
+    for (size_t i = 0; i < _cams.size(); ++i) {
+        if (!isCaptured(i, frames[i])) continue;
+        if (replayFrames[i].empty()) {
+            frames[i].image.invalidate();
+            all = false;
+            continue;
+        }
+        cv::cuda::GpuMat& rawFrame = framePool->device(rawHandles[i]);
+        rawFrame.upload(replayFrames[i]);
+        if (!crops.empty() && !crops[i].empty()) {
+            // Same region the live pipeline would have delivered
+            cv::cuda::GpuMat region = rawFrame(crops[i] & cv::Rect(cv::Point(), rawFrame.size()));
+            attachFrame(i, region, frames[i]);
+        } else {
+            attachFrame(i, rawFrame, frames[i]);
+        }
+    }
+    return all;
+}
+
+bool MultiCameraSource::openReplay(const std::string& sessionPath, SVSessionPlayer::Options opts) {
+    opts.output_size = frameSize;   // Decoded straight to the capture size
+    
+    replay = std::make_unique<SVSessionPlayer>();
+    if (!replay->open(sessionPath, opts)) {
+        replay.reset();
+        return false;
+    }
+    return true;
+}
+
+void MultiCameraSource::onAccessUnit(int cam, const uint8_t* data, size_t size, bool keyframe) {
+    if (eventBuffer) {
+        eventBuffer->push(cam, data, size, keyframe);
+    }
+    
+    if (std::shared_ptr<SVSessionWriter> session = std::atomic_load(&sessionWriter)) {
+        const int64_t now_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+        session->append(cam, data, size, now_ns, keyframe);
+    }
+}
+
+bool MultiCameraSource::startSession(const std::string& path, const std::vector<SVSessionCalibFile>& calibration) {
+    if (!sessionTap || replay) {
+        LOG_ERROR("Session recording needs setSessionRecordingEnabled(true) before init and live cameras");
+        return false;
+    }
+    
+    std::vector<std::string> names;
+    for (auto& cam : _cams) {
+        names.push_back(cam->getCameraName());
+    }
+    
+    auto writer = std::make_shared<SVSessionWriter>();
+    if (!writer->open(path, names, calibration)) {
+        return false;
+    }
+    stopSession();
+    std::atomic_store(&sessionWriter, writer);
+    return true;
+}
+
+void MultiCameraSource::stopSession() {
+    // Streaming threads may still hold the writer for one more append; it then refuses
+    if (std::shared_ptr<SVSessionWriter> writer = std::atomic_exchange(&sessionWriter, std::shared_ptr<SVSessionWriter>())) {
+        writer->close();
+    }
+}
+
 void MultiCameraSource::close() {
+    stopSession();
+    replay.reset();
     stopStream();
     
     for (auto& cam : _cams) {
-        cam.deinit();
+        cam->deinit();
     }
     
-    for (size_t i = 0; i < CAM_NUMS; ++i) {
+    for (size_t i = 0; i < _cudaStream.size(); ++i) {
         if (_cudaStream[i]) {
             cudaStreamDestroy(_cudaStream[i]);
             _cudaStream[i] = nullptr;
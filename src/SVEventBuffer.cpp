@@ -0,0 +1,264 @@
+#include "SVEventBuffer.hpp"
+#include <sys/stat.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+
+using namespace std::chrono_literals;
+
+namespace {
+
+int64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+constexpr uint64_t NO_UNIT = UINT64_MAX;
+
+// Keyframes this far apart still leave a full pre-event window to start from
+constexpr double GOP_SLACK_SECONDS = 2.0;
+
+}  // namespace
+
+// ============================================================================
+// SVAccessUnitRing
+// ============================================================================
+
+SVAccessUnitRing::SVAccessUnitRing(size_t capacity_bytes, size_t max_units, int64_t window_ns_)
+    : arena(capacity_bytes)
+    , units(std::max<size_t>(1, max_units))
+    , first_seq(0)
+    , next_seq(0)
+    , write_pos(0)
+    , window_ns(window_ns_)
+    , dropped_units(0) {
+}
+
+void SVAccessUnitRing::evictOldest() {
+    first_seq++;
+    if (first_seq == next_seq) {
+        write_pos = 0;
+    }
+}
+
+bool SVAccessUnitRing::append(const uint8_t* data, size_t size, int64_t pts_ns, bool keyframe) {
+    if (size == 0) return true;
+    if (size > arena.size()) {
+        dropped_units.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    while (first_seq < next_seq && pts_ns - at(first_seq).pts_ns > window_ns) {
+        evictOldest();
+    }
+    if (next_seq - first_seq == units.size()) {
+        evictOldest();
+    }
+
+    // Units sit in the arena in sequence order, wrapping at most once: the
+    // oldest always follow the write position, so space is made by evicting
+    // from the front until the new range is free
+    size_t pos = write_pos;
+    if (pos + size > arena.size()) {
+        while (first_seq < next_seq && at(first_seq).offset >= write_pos) {
+            evictOldest();
+        }
+        pos = 0;
+    }
+    while (first_seq < next_seq) {
+        const Unit& oldest = at(first_seq);
+        if (oldest.offset >= pos + size || oldest.offset + oldest.size <= pos) break;
+        evictOldest();
+    }
+
+    std::memcpy(arena.data() + pos, data, size);
+
+    Unit& unit = units[next_seq % units.size()];
+    unit.seq = next_seq;
+    unit.pts_ns = pts_ns;
+    unit.keyframe = keyframe;
+    unit.offset = pos;
+    unit.size = size;
+
+    next_seq++;
+    write_pos = pos + size;
+    return true;
+}
+
+uint64_t SVAccessUnitRing::findKeyframe(int64_t at_ns) const {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    uint64_t found = NO_UNIT;
+    for (uint64_t seq = first_seq; seq < next_seq; seq++) {
+        const Unit& unit = at(seq);
+        if (!unit.keyframe) continue;
+        if (unit.pts_ns > at_ns) {
+            return found != NO_UNIT ? found : seq;
+        }
+        found = seq;
+    }
+    return found;
+}
+
+bool SVAccessUnitRing::read(uint64_t seq, std::vector<uint8_t>& data, Unit& unit) const {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (seq < first_seq || seq >= next_seq) return false;
+
+    unit = at(seq);
+    data.assign(arena.data() + unit.offset, arena.data() + unit.offset + unit.size);
+    return true;
+}
+
+uint64_t SVAccessUnitRing::oldestSeq() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return first_seq;
+}
+
+uint64_t SVAccessUnitRing::nextSeq() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return next_seq;
+}
+
+// ============================================================================
+// SVEventBuffer
+// ============================================================================
+
+SVEventBuffer::~SVEventBuffer() {
+    stopping = true;
+    if (writer.joinable()) {
+        writer.join();
+    }
+}
+
+bool SVEventBuffer::init(const Options& options) {
+    opts = options;
+    rings.clear();
+
+    const int64_t window_ns = static_cast<int64_t>((opts.pre_seconds + GOP_SLACK_SECONDS) * 1e9);
+    const size_t max_units = static_cast<size_t>((opts.pre_seconds + GOP_SLACK_SECONDS + 1.0) * opts.max_fps);
+
+    for (size_t i = 0; i < opts.camera_names.size(); i++) {
+        rings.push_back(std::make_unique<SVAccessUnitRing>(opts.bytes_per_camera, max_units, window_ns));
+    }
+
+    std::cout << "✓ Event buffer: " << rings.size() << " cameras x "
+              << (opts.bytes_per_camera >> 20) << " MB, " << opts.pre_seconds << " s before / "
+              << opts.post_seconds << " s after a trigger" << std::endl;
+    return !rings.empty();
+}
+
+void SVEventBuffer::push(int camera, const uint8_t* data, size_t size, bool keyframe) {
+    if (camera < 0 || camera >= static_cast<int>(rings.size())) return;
+    rings[camera]->append(data, size, nowNs(), keyframe);
+}
+
+bool SVEventBuffer::trigger(const std::string& label) {
+    if (rings.empty() || flushing) return false;
+    if (writer.joinable()) {
+        writer.join();      // Previous event, already finished
+    }
+
+    char stamp[32];
+    const std::time_t now = std::time(nullptr);
+    std::strftime(stamp, sizeof(stamp), "%Y%m%d_%H%M%S", std::localtime(&now));
+
+    flushing = true;
+    writer = std::thread(&SVEventBuffer::writeEvent, this,
+                         opts.folder + "/" + label + "_" + stamp, nowNs());
+    return true;
+}
+
+void SVEventBuffer::writeEvent(std::string dir, int64_t event_ns) {
+    mkdir(opts.folder.c_str(), 0755);
+    mkdir(dir.c_str(), 0755);
+
+    const int64_t start_ns = event_ns - static_cast<int64_t>(opts.pre_seconds * 1e9);
+    const int64_t end_ns = event_ns + static_cast<int64_t>(opts.post_seconds * 1e9);
+    const int64_t give_up_ns = end_ns + 2'000'000'000;     // Camera stopped delivering
+
+    struct Cursor {
+        FILE* file = nullptr;
+        uint64_t seq = NO_UNIT;
+        int64_t last_pts = 0;
+        size_t units = 0;
+        size_t bytes = 0;
+        int gaps = 0;
+        bool done = false;
+    };
+    std::vector<Cursor> cursors(rings.size());
+
+    for (size_t i = 0; i < rings.size(); i++) {
+        const std::string path = dir + "/" + opts.camera_names[i] + ".h264";
+        cursors[i].file = std::fopen(path.c_str(), "wb");
+        if (!cursors[i].file) {
+            std::cerr << "✗ Event buffer: cannot write " << path << std::endl;
+            cursors[i].done = true;
+        }
+    }
+
+    std::vector<uint8_t> data;
+    SVAccessUnitRing::Unit unit;
+    bool all_done = false;
+
+    while (!all_done && !stopping) {
+        bool progressed = false;
+        all_done = true;
+
+        for (size_t i = 0; i < rings.size(); i++) {
+            Cursor& c = cursors[i];
+            if (c.done) continue;
+            all_done = false;
+
+            const SVAccessUnitRing& ring = *rings[i];
+            if (c.seq == NO_UNIT) {
+                c.seq = ring.findKeyframe(start_ns);    // NO_UNIT until a keyframe arrives
+                if (c.seq == NO_UNIT) continue;
+            }
+
+            // Overtaken by the producer: resume at the next decodable unit
+            if (c.seq < ring.oldestSeq()) {
+                c.seq = ring.findKeyframe(c.last_pts);
+                c.gaps++;
+                if (c.seq == NO_UNIT) continue;
+            }
+
+            // Copy out whatever is buffered; one lock per unit
+            while (ring.read(c.seq, data, unit)) {
+                if (unit.pts_ns > end_ns) {
+                    c.done = true;
+                    break;
+                }
+                std::fwrite(data.data(), 1, data.size(), c.file);
+                c.last_pts = unit.pts_ns;
+                c.units++;
+                c.bytes += data.size();
+                c.seq++;
+                progressed = true;
+            }
+        }
+
+        if (!progressed && !all_done) {
+            if (nowNs() > give_up_ns) break;
+            std::this_thread::sleep_for(10ms);
+        }
+    }
+
+    std::cout << "✓ Event saved to " << dir << std::endl;
+    for (size_t i = 0; i < rings.size(); i++) {
+        Cursor& c = cursors[i];
+        if (c.file) std::fclose(c.file);
+        std::cout << "    " << opts.camera_names[i] << ": " << c.units << " access units, "
+                  << (c.bytes >> 10) << " KB";
+        if (c.gaps) std::cout << ", " << c.gaps << " gaps";
+        if (!c.done) std::cout << " (incomplete)";
+        std::cout << std::endl;
+    }
+
+    flushing = false;
+}
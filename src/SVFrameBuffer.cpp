@@ -0,0 +1,388 @@
+#include "SVFrameBuffer.hpp"
+#include <atomic>
+#include <initializer_list>
+#include <iomanip>
+#include <iostream>
+
+// ============================================================================
+// SVTransferStats Implementation
+// ============================================================================
+
+namespace {
+
+constexpr int RES_COUNT = static_cast<int>(SVResidency::COUNT);
+
+std::atomic<uint64_t> g_transfer_count[RES_COUNT][RES_COUNT];
+std::atomic<uint64_t> g_transfer_bytes[RES_COUNT][RES_COUNT];
+
+int idx(SVResidency r) { return static_cast<int>(r); }
+
+} // namespace
+
+const char* residencyName(SVResidency r) {
+    switch (r) {
+        case SVResidency::HOST:   return "host";
+        case SVResidency::PINNED: return "pinned";
+        case SVResidency::DEVICE: return "device";
+        case SVResidency::MAPPED: return "mapped";
+        default:                  return "?";
+    }
+}
+
+void SVTransferStats::record(SVResidency from, SVResidency to, size_t bytes) {
+    g_transfer_count[idx(from)][idx(to)].fetch_add(1, std::memory_order_relaxed);
+    g_transfer_bytes[idx(from)][idx(to)].fetch_add(bytes, std::memory_order_relaxed);
+}
+
+SVTransferStats::Entry SVTransferStats::get(SVResidency from, SVResidency to) {
+    Entry e;
+    e.count = g_transfer_count[idx(from)][idx(to)].load(std::memory_order_relaxed);
+    e.bytes = g_transfer_bytes[idx(from)][idx(to)].load(std::memory_order_relaxed);
+    return e;
+}
+
+SVTransferStats::Entry SVTransferStats::crossings() {
+    Entry total;
+    const int dev = idx(SVResidency::DEVICE);
+    for (int from = 0; from < RES_COUNT; ++from) {
+        for (int to = 0; to < RES_COUNT; ++to) {
+            if ((from == dev) == (to == dev)) continue;
+            total.count += g_transfer_count[from][to].load(std::memory_order_relaxed);
+            total.bytes += g_transfer_bytes[from][to].load(std::memory_order_relaxed);
+        }
+    }
+    return total;
+}
+
+void SVTransferStats::reset() {
+    for (int from = 0; from < RES_COUNT; ++from) {
+        for (int to = 0; to < RES_COUNT; ++to) {
+            g_transfer_count[from][to].store(0, std::memory_order_relaxed);
+            g_transfer_bytes[from][to].store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+void SVTransferStats::printSummary() {
+    std::cout << "\n=== Transfers ===" << std::endl;
+    bool any = false;
+    for (int from = 0; from < RES_COUNT; ++from) {
+        for (int to = 0; to < RES_COUNT; ++to) {
+            Entry e = get(static_cast<SVResidency>(from), static_cast<SVResidency>(to));
+            if (e.count == 0) continue;
+            any = true;
+            std::cout << "  " << std::setw(6) << residencyName(static_cast<SVResidency>(from))
+                      << " -> " << std::setw(6) << std::left << residencyName(static_cast<SVResidency>(to))
+                      << std::right << ": " << e.count << " copies, "
+                      << e.bytes / (1024 * 1024) << " MB" << std::endl;
+        }
+    }
+    if (!any) {
+        std::cout << "  (none)" << std::endl;
+    }
+    Entry cross = crossings();
+    std::cout << "  Host/device crossings: " << cross.count << " ("
+              << cross.bytes / (1024 * 1024) << " MB)" << std::endl;
+    std::cout << "=================\n" << std::endl;
+}
+
+// ============================================================================
+// SVFrameBuffer Implementation
+// ============================================================================
+
+void SVFrameBuffer::ensureGeometry(cv::Size size, int type) {
+    if (size != buf_size || type != buf_type) {
+        buf_size = size;
+        buf_type = type;
+        valid_mask = 0;
+    }
+}
+
+void SVFrameBuffer::syncGeometry() const {
+    if (valid_mask == 0) return;
+
+    cv::Size size;
+    int type = 0;
+    if (valid_mask & bit(SVResidency::HOST)) {
+        size = host_mat.size();
+        type = host_mat.type();
+    }
+#ifndef SV_CPU_ONLY
+    else if (valid_mask & bit(SVResidency::DEVICE)) {
+        size = device_mat.size();
+        type = device_mat.type();
+    } else if (valid_mask & bit(SVResidency::PINNED)) {
+        size = pinned_mem.size();
+        type = pinned_mem.type();
+    } else if (valid_mask & bit(SVResidency::MAPPED)) {
+        size = mapped_mem.size();
+        type = mapped_mem.type();
+    }
+#endif
+    buf_size = size;
+    buf_type = type;
+}
+
+void SVFrameBuffer::dropStaleAttachments() {
+    if (host_attached && !(valid_mask & bit(SVResidency::HOST))) {
+        host_mat = cv::Mat();
+        host_attached = false;
+    }
+#ifndef SV_CPU_ONLY
+    if (device_attached && !(valid_mask & bit(SVResidency::DEVICE))) {
+        device_mat = cv::cuda::GpuMat();
+        device_attached = false;
+    }
+#endif
+}
+
+void SVFrameBuffer::create(cv::Size size, int type) {
+    ensureGeometry(size, type);
+}
+
+void SVFrameBuffer::release() {
+    host_mat.release();
+#ifndef SV_CPU_ONLY
+    device_mat.release();
+    pinned_mem.release();
+    mapped_mem.release();
+#endif
+    buf_size = cv::Size();
+    buf_type = 0;
+    valid_mask = 0;
+    host_attached = false;
+    device_attached = false;
+}
+
+void SVFrameBuffer::invalidate() {
+    valid_mask = 0;
+    dropStaleAttachments();
+}
+
+bool SVFrameBuffer::isValid(SVResidency r) const {
+#ifdef SV_CPU_ONLY
+    (void)r;
+    return valid_mask != 0;
+#else
+    return (valid_mask & bit(r)) != 0;
+#endif
+}
+
+const cv::Mat& SVFrameBuffer::host() const {
+#ifdef SV_CPU_ONLY
+    host_mat.create(buf_size, buf_type);
+#else
+    cv::cuda::Stream& stream = cv::cuda::Stream::Null();
+    migrateTo(SVResidency::HOST, stream);
+#endif
+    return host_mat;
+}
+
+cv::Mat& SVFrameBuffer::writeHost() {
+    syncGeometry();
+    if (host_attached) {
+        host_mat = cv::Mat();
+        host_attached = false;
+    }
+    host_mat.create(buf_size, buf_type);
+    valid_mask = bit(SVResidency::HOST);
+    dropStaleAttachments();
+    return host_mat;
+}
+
+cv::Mat& SVFrameBuffer::modifyHost() {
+    host();
+    if (host_attached) {
+        // Copy-on-write: never modify memory owned by someone else
+        host_mat = host_mat.clone();
+        host_attached = false;
+    }
+    valid_mask = bit(SVResidency::HOST);
+    dropStaleAttachments();
+    return host_mat;
+}
+
+void SVFrameBuffer::attachHost(const cv::Mat& src) {
+    host_mat = src;
+    host_attached = true;
+    buf_size = src.size();
+    buf_type = src.type();
+    valid_mask = src.empty() ? 0 : bit(SVResidency::HOST);
+    dropStaleAttachments();
+}
+
+void SVFrameBuffer::readInto(cv::Mat& dst, SVResidency dst_kind) const {
+    if (empty()) return;
+    syncGeometry();
+    dst.create(buf_size, buf_type);
+
+#ifdef SV_CPU_ONLY
+    host_mat.copyTo(dst);
+    SVTransferStats::record(SVResidency::HOST, dst_kind, byteSize());
+#else
+    // Prefer a host-side source; fall back to a download
+    for (SVResidency src : {SVResidency::HOST, SVResidency::PINNED, SVResidency::MAPPED}) {
+        if (valid_mask & bit(src)) {
+            hostView(src).copyTo(dst);
+            SVTransferStats::record(src, dst_kind, byteSize());
+            return;
+        }
+    }
+    device_mat.download(dst);
+    SVTransferStats::record(SVResidency::DEVICE, dst_kind, byteSize());
+#endif
+}
+
+#ifndef SV_CPU_ONLY
+
+cv::Mat SVFrameBuffer::hostView(SVResidency r) const {
+    switch (r) {
+        case SVResidency::PINNED: return pinned_mem.createMatHeader();
+        case SVResidency::MAPPED: return mapped_mem.createMatHeader();
+        default:                  return host_mat;
+    }
+}
+
+void SVFrameBuffer::migrateTo(SVResidency target, cv::cuda::Stream& stream) const {
+    syncGeometry();
+
+    // Allocate the target storage (no-op if it already has the right geometry)
+    switch (target) {
+        case SVResidency::HOST:   host_mat.create(buf_size, buf_type); break;
+        case SVResidency::PINNED: pinned_mem.create(buf_size, buf_type); break;
+        case SVResidency::MAPPED: mapped_mem.create(buf_size, buf_type); break;
+        case SVResidency::DEVICE: device_mat.create(buf_size, buf_type); break;
+        default: break;
+    }
+
+    if (valid_mask == 0 || (valid_mask & bit(target))) {
+        return;
+    }
+
+    const size_t bytes = byteSize();
+
+    if (target == SVResidency::DEVICE) {
+        // Pinned uploads are DMA; mapped is a device-side copy; pageable is staged by the driver
+        if (valid_mask & bit(SVResidency::PINNED)) {
+            device_mat.upload(pinned_mem, stream);
+            SVTransferStats::record(SVResidency::PINNED, target, bytes);
+        } else if (valid_mask & bit(SVResidency::MAPPED)) {
+            mapped_mem.createGpuMatHeader().copyTo(device_mat, stream);
+            SVTransferStats::record(SVResidency::MAPPED, target, bytes);
+        } else {
+            device_mat.upload(host_mat, stream);
+            SVTransferStats::record(SVResidency::HOST, target, bytes);
+        }
+    } else {
+        cv::Mat dst = hostView(target);
+
+        // Any host-side copy is cheaper than a download
+        SVResidency src = SVResidency::DEVICE;
+        for (SVResidency r : {SVResidency::HOST, SVResidency::PINNED, SVResidency::MAPPED}) {
+            if (r != target && (valid_mask & bit(r))) {
+                src = r;
+                break;
+            }
+        }
+
+        if (src == SVResidency::DEVICE) {
+            if (target == SVResidency::MAPPED) {
+                cv::cuda::GpuMat dst_dev = mapped_mem.createGpuMatHeader();
+                device_mat.copyTo(dst_dev, stream);
+            } else {
+                device_mat.download(dst, stream);
+            }
+            // Host readers expect the data to be there on return
+            stream.waitForCompletion();
+        } else {
+            hostView(src).copyTo(dst);
+        }
+        SVTransferStats::record(src, target, bytes);
+    }
+
+    valid_mask |= bit(target);
+}
+
+const cv::cuda::GpuMat& SVFrameBuffer::device(cv::cuda::Stream& stream) const {
+    migrateTo(SVResidency::DEVICE, stream);
+    return device_mat;
+}
+
+const cv::cuda::HostMem& SVFrameBuffer::pinned(cv::cuda::Stream& stream) const {
+    migrateTo(SVResidency::PINNED, stream);
+    return pinned_mem;
+}
+
+const cv::cuda::HostMem& SVFrameBuffer::mapped(cv::cuda::Stream& stream) const {
+    migrateTo(SVResidency::MAPPED, stream);
+    return mapped_mem;
+}
+
+cv::cuda::GpuMat& SVFrameBuffer::writeDevice() {
+    syncGeometry();
+    if (device_attached) {
+        // Never write through into a buffer owned by someone else
+        device_mat = cv::cuda::GpuMat();
+        device_attached = false;
+    }
+    device_mat.create(buf_size, buf_type);
+    valid_mask = bit(SVResidency::DEVICE);
+    dropStaleAttachments();
+    return device_mat;
+}
+
+cv::cuda::GpuMat& SVFrameBuffer::modifyDevice(cv::cuda::Stream& stream) {
+    migrateTo(SVResidency::DEVICE, stream);
+    if (device_attached) {
+        cv::cuda::GpuMat own;
+        device_mat.copyTo(own, stream);
+        device_mat = own;
+        device_attached = false;
+    }
+    valid_mask = bit(SVResidency::DEVICE);
+    dropStaleAttachments();
+    return device_mat;
+}
+
+cv::cuda::HostMem& SVFrameBuffer::writePinned() {
+    syncGeometry();
+    pinned_mem.create(buf_size, buf_type);
+    valid_mask = bit(SVResidency::PINNED);
+    dropStaleAttachments();
+    return pinned_mem;
+}
+
+cv::cuda::HostMem& SVFrameBuffer::writeMapped() {
+    syncGeometry();
+    mapped_mem.create(buf_size, buf_type);
+    valid_mask = bit(SVResidency::MAPPED);
+    dropStaleAttachments();
+    return mapped_mem;
+}
+
+void SVFrameBuffer::attachDevice(const cv::cuda::GpuMat& src) {
+    device_mat = src;
+    device_attached = true;
+    buf_size = src.size();
+    buf_type = src.type();
+    valid_mask = src.empty() ? 0 : bit(SVResidency::DEVICE);
+    dropStaleAttachments();
+}
+
+// ============================================================================
+// Counted transfer helpers
+// ============================================================================
+
+void svDownload(const cv::cuda::GpuMat& src, cv::OutputArray dst,
+                SVResidency dst_kind, cv::cuda::Stream& stream) {
+    src.download(dst, stream);
+    SVTransferStats::record(SVResidency::DEVICE, dst_kind, src.rows * src.cols * src.elemSize());
+}
+
+void svUpload(cv::InputArray src, cv::cuda::GpuMat& dst,
+              SVResidency src_kind, cv::cuda::Stream& stream) {
+    dst.upload(src, stream);
+    SVTransferStats::record(src_kind, SVResidency::DEVICE, dst.rows * dst.cols * dst.elemSize());
+}
+
+#endif // SV_CPU_ONLY
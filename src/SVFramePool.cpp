@@ -0,0 +1,259 @@
+#include "SVFramePool.hpp"
+#include <atomic>
+#include <iostream>
+
+// ============================================================================
+// SVAllocTracker Implementation
+// ============================================================================
+
+namespace {
+
+std::atomic<uint64_t> g_host_allocs{0};
+std::atomic<uint64_t> g_device_allocs{0};
+
+// Snapshot taken by beginFrame()
+SVAllocTracker::Counts g_frame_start;
+
+/**
+ * Counts cv::Mat allocations and forwards everything to the wrapped allocator.
+ * The wrapped allocator becomes UMatData::currAllocator, so releases never
+ * come back through here.
+ */
+class HostCountingAllocator : public cv::MatAllocator {
+public:
+    cv::MatAllocator* base = nullptr;
+
+    cv::UMatData* allocate(int dims, const int* sizes, int type, void* data,
+                           size_t* step, cv::AccessFlag flags,
+                           cv::UMatUsageFlags usageFlags) const override {
+        if (!data) {
+            g_host_allocs.fetch_add(1, std::memory_order_relaxed);
+        }
+        return base->allocate(dims, sizes, type, data, step, flags, usageFlags);
+    }
+
+    bool allocate(cv::UMatData* data, cv::AccessFlag accessflags,
+                  cv::UMatUsageFlags usageFlags) const override {
+        return base->allocate(data, accessflags, usageFlags);
+    }
+
+    void deallocate(cv::UMatData* data) const override {
+        base->deallocate(data);
+    }
+
+    void map(cv::UMatData* data, cv::AccessFlag accessflags) const override {
+        base->map(data, accessflags);
+    }
+
+    void unmap(cv::UMatData* data) const override {
+        base->unmap(data);
+    }
+};
+
+#ifndef SV_CPU_ONLY
+/**
+ * Counts cv::cuda::GpuMat allocations. GpuMat keeps a pointer to the allocator
+ * that created it and frees through it, so this object must outlive every
+ * GpuMat - it is a function-local static and never destroyed.
+ */
+class DeviceCountingAllocator : public cv::cuda::GpuMat::Allocator {
+public:
+    cv::cuda::GpuMat::Allocator* base = nullptr;
+
+    bool allocate(cv::cuda::GpuMat* mat, int rows, int cols, size_t elemSize) override {
+        g_device_allocs.fetch_add(1, std::memory_order_relaxed);
+        return base->allocate(mat, rows, cols, elemSize);
+    }
+
+    void free(cv::cuda::GpuMat* mat) override {
+        base->free(mat);
+    }
+};
+
+DeviceCountingAllocator& deviceAllocator() {
+    static DeviceCountingAllocator allocator;
+    return allocator;
+}
+#endif
+
+HostCountingAllocator& hostAllocator() {
+    static HostCountingAllocator allocator;
+    return allocator;
+}
+
+bool g_installed = false;
+
+} // namespace
+
+void SVAllocTracker::install() {
+    if (g_installed) return;
+
+    hostAllocator().base = cv::Mat::getDefaultAllocator();
+    cv::Mat::setDefaultAllocator(&hostAllocator());
+
+#ifndef SV_CPU_ONLY
+    deviceAllocator().base = cv::cuda::GpuMat::defaultAllocator();
+    cv::cuda::GpuMat::setDefaultAllocator(&deviceAllocator());
+#endif
+
+    g_installed = true;
+}
+
+void SVAllocTracker::uninstall() {
+    if (!g_installed) return;
+
+    cv::Mat::setDefaultAllocator(hostAllocator().base);
+#ifndef SV_CPU_ONLY
+    cv::cuda::GpuMat::setDefaultAllocator(deviceAllocator().base);
+#endif
+
+    g_installed = false;
+}
+
+bool SVAllocTracker::isInstalled() {
+    return g_installed;
+}
+
+void SVAllocTracker::beginFrame() {
+    g_frame_start = total();
+}
+
+SVAllocTracker::Counts SVAllocTracker::endFrame() {
+    Counts now = total();
+    Counts delta;
+    delta.host = now.host - g_frame_start.host;
+    delta.device = now.device - g_frame_start.device;
+    return delta;
+}
+
+SVAllocTracker::Counts SVAllocTracker::total() {
+    Counts counts;
+    counts.host = g_host_allocs.load(std::memory_order_relaxed);
+    counts.device = g_device_allocs.load(std::memory_order_relaxed);
+    return counts;
+}
+
+// ============================================================================
+// SVFramePool Implementation
+// ============================================================================
+
+void SVFramePool::noteReservation(const char* kind, const std::string& label,
+                                  cv::Size size, int type) const {
+    if (frozen) {
+        std::cerr << "WARNING: Frame pool reservation after freeze: " << kind
+                  << " '" << label << "' " << size << " type=" << type << std::endl;
+    }
+}
+
+SVFramePool::Handle SVFramePool::reserveBuffer(cv::Size size, int type, SVResidency where,
+                                               const std::string& label) {
+    std::lock_guard<std::mutex> lock(reserve_mutex);
+    noteReservation(residencyName(where), label, size, type);
+
+    BufferSlot slot{SVFrameBuffer(size, type), label, where};
+
+    // Allocate the working location now, then mark it as holding no content
+#ifndef SV_CPU_ONLY
+    if (where == SVResidency::DEVICE) {
+        slot.mat.writeDevice();
+    } else
+#endif
+    {
+        slot.mat.writeHost();
+    }
+    slot.mat.invalidate();
+
+    buffer_slots.push_back(std::move(slot));
+    return static_cast<Handle>(buffer_slots.size() - 1);
+}
+
+SVFramePool::Handle SVFramePool::reserveHost(cv::Size size, int type, const std::string& label) {
+    std::lock_guard<std::mutex> lock(reserve_mutex);
+    noteReservation("host", label, size, type);
+    host_slots.push_back({cv::Mat(size, type), label});
+    return static_cast<Handle>(host_slots.size() - 1);
+}
+
+#ifndef SV_CPU_ONLY
+SVFramePool::Handle SVFramePool::reserveDevice(cv::Size size, int type, const std::string& label) {
+    std::lock_guard<std::mutex> lock(reserve_mutex);
+    noteReservation("device", label, size, type);
+    device_slots.push_back({cv::cuda::GpuMat(size, type), label});
+    return static_cast<Handle>(device_slots.size() - 1);
+}
+
+SVFramePool::Handle SVFramePool::reservePinned(cv::Size size, int type, const std::string& label) {
+    std::lock_guard<std::mutex> lock(reserve_mutex);
+    noteReservation("pinned", label, size, type);
+    pinned_slots.push_back({cv::cuda::HostMem(size, type, cv::cuda::HostMem::PAGE_LOCKED), label});
+    return static_cast<Handle>(pinned_slots.size() - 1);
+}
+
+SVFramePool::Handle SVFramePool::reserveStream(const std::string& label) {
+    std::lock_guard<std::mutex> lock(reserve_mutex);
+    noteReservation("stream", label, cv::Size(), 0);
+    stream_slots.push_back({cv::cuda::Stream(), label});
+    return static_cast<Handle>(stream_slots.size() - 1);
+}
+#endif
+
+size_t SVFramePool::deviceBytes() const {
+    size_t bytes = 0;
+    for (const auto& slot : buffer_slots) {
+        if (slot.where == SVResidency::DEVICE) {
+            bytes += slot.mat.byteSize();
+        }
+    }
+#ifndef SV_CPU_ONLY
+    for (const auto& slot : device_slots) {
+        bytes += slot.mat.step * slot.mat.rows;
+    }
+#endif
+    return bytes;
+}
+
+size_t SVFramePool::hostBytes() const {
+    size_t bytes = 0;
+    for (const auto& slot : buffer_slots) {
+        if (slot.where != SVResidency::DEVICE) {
+            bytes += slot.mat.byteSize();
+        }
+    }
+    for (const auto& slot : host_slots) {
+        bytes += slot.mat.total() * slot.mat.elemSize();
+    }
+#ifndef SV_CPU_ONLY
+    for (const auto& slot : pinned_slots) {
+        bytes += slot.mat.step * slot.mat.rows;
+    }
+#endif
+    return bytes;
+}
+
+void SVFramePool::printSummary() const {
+    std::cout << "\n=== Frame Pool ===" << std::endl;
+    for (const auto& slot : buffer_slots) {
+        std::cout << "  [" << residencyName(slot.where) << "] " << slot.label << ": " << slot.mat.size()
+                  << " (" << slot.mat.byteSize() / 1024 << " KB)" << std::endl;
+    }
+#ifndef SV_CPU_ONLY
+    for (const auto& slot : device_slots) {
+        std::cout << "  [device] " << slot.label << ": " << slot.mat.size()
+                  << " (" << (slot.mat.step * slot.mat.rows) / 1024 << " KB)" << std::endl;
+    }
+    for (const auto& slot : pinned_slots) {
+        std::cout << "  [pinned] " << slot.label << ": " << slot.mat.size()
+                  << " (" << (slot.mat.step * slot.mat.rows) / 1024 << " KB)" << std::endl;
+    }
+#endif
+    for (const auto& slot : host_slots) {
+        std::cout << "  [host]   " << slot.label << ": " << slot.mat.size()
+                  << " (" << (slot.mat.total() * slot.mat.elemSize()) / 1024 << " KB)" << std::endl;
+    }
+#ifndef SV_CPU_ONLY
+    std::cout << "  Streams: " << stream_slots.size() << std::endl;
+#endif
+    std::cout << "  Total: device " << deviceBytes() / (1024 * 1024) << " MB, host "
+              << hostBytes() / (1024 * 1024) << " MB" << std::endl;
+    std::cout << "==================\n" << std::endl;
+}
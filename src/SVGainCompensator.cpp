@@ -1,8 +1,11 @@
 #include <SVGainCompensator.hpp>
+#include <SVFrameBuffer.hpp>
 
 
+#ifndef SV_CPU_ONLY
 #include <opencv2/cudawarping.hpp>
 #include <opencv2/cudaarithm.hpp>
+#endif
 
 
 // ------------------------------- SVExposureCompensator --------------------------------
@@ -10,8 +13,35 @@ SVExposureCompensator::SVExposureCompensator(const size_t imgs_num_) : imgs_num(
 {
     warp = std::move(std::vector<cv::UMat>(imgs_num));
     mask = std::move(std::vector<cv::UMat>(imgs_num));
+    mask_src = std::vector<const uchar*>(imgs_num, nullptr);
 }
 
+void SVExposureCompensator::copyInputs(const std::vector<cv::Mat>& warp_imgs,
+                                       const std::vector<cv::Mat>& warp_masks)
+{
+    for (size_t i = 0; i < imgs_num; ++i){
+        warp_imgs[i].copyTo(warp[i]);
+        if (warp_masks[i].data != mask_src[i] || mask[i].size() != warp_masks[i].size()){
+            warp_masks[i].copyTo(mask[i]);
+            mask_src[i] = warp_masks[i].data;
+        }
+    }
+}
+
+#ifndef SV_CPU_ONLY
+void SVExposureCompensator::downloadInputs(const std::vector<cv::cuda::GpuMat>& warp_imgs,
+                                           const std::vector<cv::cuda::GpuMat>& warp_masks)
+{
+    for (size_t i = 0; i < imgs_num; ++i){
+        svDownload(warp_imgs[i], warp[i]);
+        if (warp_masks[i].data != mask_src[i] || mask[i].size() != warp_masks[i].size()){
+            svDownload(warp_masks[i], mask[i]);
+            mask_src[i] = warp_masks[i].data;
+        }
+    }
+}
+#endif
+
 // ------------------------------- SVGainCompensator --------------------------------
 SVGainCompensator::SVGainCompensator(const size_t imgs_num_, const int nr_feeds) : SVExposureCompensator(imgs_num_)
 {
@@ -21,15 +51,15 @@ SVGainCompensator::SVGainCompensator(const size_t imgs_num_, const int nr_feeds)
 }
 
 
-void SVGainCompensator::computeGains(const std::vector<cv::Point>& corners, const std::vector<cv::cuda::GpuMat>& warp_imgs,
-                                     const std::vector<cv::cuda::GpuMat>& warp_masks)
+void SVGainCompensator::computeGains(const std::vector<cv::Point>& corners, const std::vector<cv::Mat>& warp_imgs,
+                                     const std::vector<cv::Mat>& warp_masks)
 {
+    copyInputs(warp_imgs, warp_masks);
+    updateGains(corners);
+}
 
-    for (auto i = 0; i < imgs_num; ++i){
-        warp_imgs[i].download(warp[i]);
-        warp_masks[i].download(mask[i]);
-    }
-
+void SVGainCompensator::updateGains(const std::vector<cv::Point>& corners)
+{
     compens->feed(corners, warp, mask);
 
     std::vector<cv::Mat> gains_;
@@ -37,10 +67,19 @@ void SVGainCompensator::computeGains(const std::vector<cv::Point>& corners, cons
 
     gains = cv::Mat_<double>(gains_.size(), 1);
 
-    for (auto i = 0; i < gains_.size(); i++){
+    for (size_t i = 0; i < gains_.size(); i++){
        gains(i, 0) = gains_[i].at<double>(0, 0);
     }
 }
+
+#ifndef SV_CPU_ONLY
+void SVGainCompensator::computeGains(const std::vector<cv::Point>& corners, const std::vector<cv::cuda::GpuMat>& warp_imgs,
+                                     const std::vector<cv::cuda::GpuMat>& warp_masks)
+{
+    downloadInputs(warp_imgs, warp_masks);
+    updateGains(corners);
+}
+
 void SVGainCompensator::init(const std::vector<cv::cuda::GpuMat>& images, 
                               const std::vector<cv::Point>& corners,
                               const std::vector<cv::cuda::GpuMat>& masks)
@@ -63,7 +102,7 @@ void SVGainCompensator::recompute(const std::vector<cv::cuda::GpuMat>& images,
 
 bool SVGainCompensator::apply_compensator(const int idx, cv::cuda::GpuMat& warp_img, cv::cuda::Stream& streamObj)
 {
-   if (idx > imgs_num || imgs_num <= 0)
+   if (idx < 0 || static_cast<size_t>(idx) >= imgs_num)
      return false;
 
    cv::Scalar gain_scalar(gains(idx), gains(idx), gains(idx));
@@ -93,17 +132,14 @@ void SVGainBlocksCompensator::computeGains(const std::vector<cv::Point>& corners
                   const std::vector<cv::cuda::GpuMat>& warp_masks)
 {
 
-    for (auto i = 0; i < imgs_num; ++i){
-        warp_imgs[i].download(warp[i]);
-        warp_masks[i].download(mask[i]);
-    }
+    downloadInputs(warp_imgs, warp_masks);
 
     compens->feed(corners, warp, mask);
 
     std::vector<cv::Mat> gains_;
     compens->getMatGains(gains_);
 
-    for (auto i = 0; i < imgs_num; ++i){
+    for (size_t i = 0; i < imgs_num; ++i){
         gain_map[i].upload(gains_[i]);
         if (gain_map[i].channels() != 3){
             gain_map[i].convertTo(gain_channels[0], CV_8UC1);
@@ -116,7 +152,7 @@ void SVGainBlocksCompensator::computeGains(const std::vector<cv::Point>& corners
 
 bool SVGainBlocksCompensator::apply_compensator(const int idx, cv::cuda::GpuMat& warp_img, cv::cuda::Stream& streamObj)
 {
-    if (idx > imgs_num || imgs_num <= 0)
+    if (idx < 0 || static_cast<size_t>(idx) >= imgs_num)
       return false;
 
     cv::cuda::resize(gain_map.at(idx), gain[idx], warp_img.size(), 0, 0, cv::INTER_LINEAR, streamObj);
@@ -142,10 +178,7 @@ void SVChannelCompensator::computeGains(const std::vector<cv::Point>& corners, c
                   const std::vector<cv::cuda::GpuMat>& warp_masks)
 {
 
-    for (auto i = 0; i < imgs_num; ++i){
-        warp_imgs[i].download(warp[i]);
-        warp_masks[i].download(mask[i]);
-    }
+    downloadInputs(warp_imgs, warp_masks);
 
     compens->feed(corners, warp, mask);
 
@@ -154,7 +187,7 @@ void SVChannelCompensator::computeGains(const std::vector<cv::Point>& corners, c
 
     gains = cv::Mat_<double>(gains_.size(), 1);
 
-    for (auto i = 0; i < gains_.size(); i++){
+    for (size_t i = 0; i < gains_.size(); i++){
        gains(i, 0) = gains_[i].at<double>(0, 0);
     }
 
@@ -163,7 +196,7 @@ void SVChannelCompensator::computeGains(const std::vector<cv::Point>& corners, c
 
 bool SVChannelCompensator::apply_compensator(const int idx, cv::cuda::GpuMat& warp_img, cv::cuda::Stream& streamObj)
 {
-    if (idx > imgs_num || imgs_num <= 0)
+    if (idx < 0 || static_cast<size_t>(idx) >= imgs_num)
       return false;
 
     cv::Scalar gain_scalar(gains(idx), gains(idx), gains(idx));
@@ -172,4 +205,4 @@ bool SVChannelCompensator::apply_compensator(const int idx, cv::cuda::GpuMat& wa
 
     return true;
 }
-
+#endif
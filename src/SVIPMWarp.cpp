@@ -0,0 +1,298 @@
+#include "SVIPMWarp.hpp"
+#include "SVConfig.hpp"
+#include "SVThreadPool.hpp"
+#include <opencv2/calib3d.hpp>
+#include <opencv2/imgproc.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <iostream>
+#include <mutex>
+#include <vector>
+
+// ============================================================================
+// SVCameraCalib / SVIPMCanvas
+// ============================================================================
+
+bool SVCameraCalib::load(const std::string& path) {
+    cv::FileStorage fs(path, cv::FileStorage::READ);
+    if (!fs.isOpened()) {
+        std::cerr << "✗ Cannot open calibration: " << path << std::endl;
+        return false;
+    }
+
+    cv::Mat k_mat, r_mat, t_mat;
+    fs["Intrisic"] >> k_mat;
+    fs["Rotation"] >> r_mat;
+    fs["Translation"] >> t_mat;
+    fs["Distortion"] >> dist;
+
+    if (k_mat.total() != 9 || r_mat.total() != 9 || t_mat.total() != 3) {
+        std::cerr << "✗ Calibration needs Intrisic (3x3), Rotation (3x3) and Translation (3x1): "
+                  << path << std::endl;
+        return false;
+    }
+
+    k_mat.convertTo(k_mat, CV_64F);
+    r_mat.convertTo(r_mat, CV_64F);
+    t_mat.convertTo(t_mat, CV_64F);
+    K = cv::Matx33d(k_mat.ptr<double>());
+    R = cv::Matx33d(r_mat.ptr<double>());
+    t = cv::Vec3d(t_mat.ptr<double>());
+    if (!dist.empty()) {
+        dist.convertTo(dist, CV_64F);
+    }
+    return true;
+}
+
+void SVCameraCalib::scaleIntrinsics(cv::Size from, cv::Size to) {
+    if (from == to || from.area() == 0) return;
+    
+    // Pixel centres: x' = (x + 0.5) * s - 0.5
+    const double sx = static_cast<double>(to.width) / from.width;
+    const double sy = static_cast<double>(to.height) / from.height;
+    K(0, 0) *= sx;
+    K(0, 1) *= sx;
+    K(0, 2) = (K(0, 2) + 0.5) * sx - 0.5;
+    K(1, 1) *= sy;
+    K(1, 2) = (K(1, 2) + 0.5) * sy - 0.5;
+}
+
+int SVCameraCalib::project(const std::vector<cv::Point3d>& points, cv::Size image_size,
+                           std::vector<cv::Point2d>& image_points, std::vector<uchar>& visible) const {
+    const bool distorted = !dist.empty() && cv::countNonZero(dist) > 0;
+    cv::Mat rvec;
+    cv::Rodrigues(cv::Mat(R), rvec);
+    const cv::Mat k_mat(K);
+
+    // Distortion models fold far off-axis rays back into the image; only trust
+    // rays inside the field of view the image corners actually cover
+    double max_radius2 = 1e12;
+    if (distorted) {
+        std::vector<cv::Point2f> corners = {
+            {0.0f, 0.0f}, {(float)image_size.width, 0.0f},
+            {0.0f, (float)image_size.height}, {(float)image_size.width, (float)image_size.height}
+        };
+        std::vector<cv::Point2f> normalized;
+        cv::undistortPoints(corners, normalized, k_mat, dist);
+        max_radius2 = 0.0;
+        for (const auto& p : normalized) {
+            max_radius2 = std::max(max_radius2, (double)p.dot(p));
+        }
+        max_radius2 *= 1.1;
+    }
+
+    image_points.clear();
+    visible.resize(points.size());
+    if (points.empty()) return 0;
+
+    cv::projectPoints(points, rvec, cv::Mat(t), k_mat, distorted ? dist : cv::Mat(), image_points);
+
+    const double max_x = image_size.width - 1.0;
+    const double max_y = image_size.height - 1.0;
+    int count = 0;
+    for (size_t i = 0; i < points.size(); i++) {
+        const cv::Vec3d pc = R * cv::Vec3d(points[i].x, points[i].y, points[i].z) + t;
+        const double nx = pc[0] / pc[2], ny = pc[1] / pc[2];
+        const cv::Point2d& p = image_points[i];
+        visible[i] = pc[2] > 1e-3 && (nx * nx + ny * ny) < max_radius2 &&
+                     p.x >= 0.0 && p.y >= 0.0 && p.x <= max_x && p.y <= max_y;
+        count += visible[i];
+    }
+    return count;
+}
+
+float SVCameraCalib::viewScore(const cv::Point3d& point, const cv::Point2d& pixel, cv::Size image_size,
+                               float edge_feather_px) const {
+    const double edge = std::min({pixel.x, image_size.width - 1.0 - pixel.x,
+                                  pixel.y, image_size.height - 1.0 - pixel.y});
+    if (edge <= 0.0) return 0.0f;
+
+    const float feather = std::min(1.0f, static_cast<float>(edge) / edge_feather_px);
+    const cv::Vec3d pc = R * cv::Vec3d(point.x, point.y, point.z) + t;
+    const float facing = static_cast<float>(pc[2] / cv::norm(pc));
+    return std::max(0.0f, feather * facing);
+}
+
+int blendWeightsFromScores(const float* scores, int n, float* weights) {
+    int best = -1, second = -1;
+    for (int i = 0; i < n; i++) {
+        weights[i] = 0.0f;
+        if (scores[i] <= 0.0f) continue;
+        if (best < 0 || scores[i] > scores[best]) {
+            second = best;
+            best = i;
+        } else if (second < 0 || scores[i] > scores[second]) {
+            second = i;
+        }
+    }
+    if (best < 0) return 0;
+
+    const float wb = std::pow(scores[best], 4.0f);
+    const float ws = second >= 0 ? std::pow(scores[second], 4.0f) : 0.0f;
+    weights[best] = wb / (wb + ws);
+    if (second < 0) return 1;
+    weights[second] = ws / (wb + ws);
+    return 2;
+}
+
+SVIPMCanvas SVIPMCanvas::fromConfig() {
+    SVIPMCanvas canvas;
+    canvas.size = cv::Size(IPM_CANVAS_WIDTH, IPM_CANVAS_HEIGHT);
+    canvas.mm_per_px = IPM_MM_PER_PIXEL;
+    canvas.origin = cv::Point2f(IPM_CANVAS_WIDTH * 0.5f, IPM_CANVAS_HEIGHT * 0.5f);
+    return canvas;
+}
+
+// ============================================================================
+// IPM map generation
+// ============================================================================
+
+int buildIPMMaps(const SVCameraCalib& calib, const SVIPMCanvas& canvas, cv::Size image_size,
+                 cv::Mat& map_x, cv::Mat& map_y, cv::Mat* valid) {
+    map_x.create(canvas.size, CV_32F);
+    map_y.create(canvas.size, CV_32F);
+    if (valid) {
+        valid->create(canvas.size, CV_8U);
+    }
+
+    std::atomic<int> covered{0};
+
+    SVThreadPool::instance().parallelForRange(0, canvas.size.height, [&](int y0, int y1) {
+        std::vector<cv::Point3d> ground(canvas.size.width);
+        std::vector<cv::Point2d> projected;
+        std::vector<uchar> visible;
+
+        for (int y = y0; y < y1; y++) {
+            for (int x = 0; x < canvas.size.width; x++) {
+                const cv::Point2d g = canvas.groundAt(x, y);
+                ground[x] = cv::Point3d(g.x, g.y, 0.0);
+            }
+
+            covered += calib.project(ground, image_size, projected, visible);
+
+            float* xrow = map_x.ptr<float>(y);
+            float* yrow = map_y.ptr<float>(y);
+            uchar* vrow = valid ? valid->ptr<uchar>(y) : nullptr;
+            for (int x = 0; x < canvas.size.width; x++) {
+                const bool ok = visible[x] != 0;
+                xrow[x] = ok ? (float)projected[x].x : -1.0f;
+                yrow[x] = ok ? (float)projected[x].y : -1.0f;
+                if (vrow) vrow[x] = ok ? 255 : 0;
+            }
+        }
+    }, 8);
+
+    return covered;
+}
+
+// ============================================================================
+// Four-point homography maps
+// ============================================================================
+
+bool SVHomographyPoints::load(const std::string& path, int num_cameras) {
+    cv::FileStorage fs(path, cv::FileStorage::READ);
+    if (!fs.isOpened()) {
+        return false;
+    }
+
+    int saved_cameras = 0;
+    fs["num_cameras"] >> saved_cameras;
+    if (saved_cameras != num_cameras) {
+        std::cerr << "ERROR: Saved calibration has " << saved_cameras << " cameras, expected "
+                  << num_cameras << std::endl;
+        return false;
+    }
+    scale_factor = fs["scale_factor"].empty() ? 0.0f : static_cast<float>(fs["scale_factor"]);
+
+    src.assign(num_cameras, {});
+    dst.assign(num_cameras, {});
+    for (int i = 0; i < num_cameras; i++) {
+        fs["camera_" + std::to_string(i) + "_src_points"] >> src[i];
+        fs["camera_" + std::to_string(i) + "_dst_points"] >> dst[i];
+        if (src[i].size() != 4 || dst[i].size() != 4) {
+            std::cerr << "ERROR: Camera " << i << " needs 4 source and 4 destination points: "
+                      << path << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+cv::Matx33d SVHomographyPoints::homography(int camera, float scale) const {
+    std::vector<cv::Point2f> scaled = src[camera];
+    for (auto& pt : scaled) {
+        pt *= scale;
+    }
+    return cv::Matx33d(cv::getPerspectiveTransform(dst[camera], scaled));
+}
+
+void buildHomographyMaps(const cv::Matx33d& H, cv::Size output_size, cv::Mat& map_x, cv::Mat& map_y) {
+    map_x.create(output_size, CV_32F);
+    map_y.create(output_size, CV_32F);
+
+    // Rows are independent: split them across the shared pool
+    SVThreadPool::instance().parallelForRange(0, output_size.height, [&](int y0, int y1) {
+        for (int y = y0; y < y1; y++) {
+            float* xrow = map_x.ptr<float>(y);
+            float* yrow = map_y.ptr<float>(y);
+            for (int x = 0; x < output_size.width; x++) {
+                const double sx = H(0, 0) * x + H(0, 1) * y + H(0, 2);
+                const double sy = H(1, 0) * x + H(1, 1) * y + H(1, 2);
+                const double w = H(2, 0) * x + H(2, 1) * y + H(2, 2);
+
+                // w <= 0: the point lies behind the camera
+                xrow[x] = w > 1e-6 ? static_cast<float>(sx / w) : -1.0f;
+                yrow[x] = w > 1e-6 ? static_cast<float>(sy / w) : -1.0f;
+            }
+        }
+    }, 16);
+}
+
+cv::Rect warpSourceBounds(const cv::Mat& map_x, const cv::Mat& map_y, cv::Size source_size,
+                          const cv::Mat& valid) {
+    CV_Assert(map_x.type() == CV_32F && map_y.type() == CV_32F && map_x.size() == map_y.size());
+    CV_Assert(valid.empty() || (valid.type() == CV_8U && valid.size() == map_x.size()));
+
+    std::mutex mutex;
+    int x0 = source_size.width, y0 = source_size.height, x1 = -1, y1 = -1;
+
+    SVThreadPool::instance().parallelForRange(0, map_x.rows, [&](int r0, int r1) {
+        int bx0 = source_size.width, by0 = source_size.height, bx1 = -1, by1 = -1;
+        for (int r = r0; r < r1; r++) {
+            const float* xrow = map_x.ptr<float>(r);
+            const float* yrow = map_y.ptr<float>(r);
+            const uchar* vrow = valid.empty() ? nullptr : valid.ptr<uchar>(r);
+            for (int c = 0; c < map_x.cols; c++) {
+                if (vrow && !vrow[c]) continue;
+                const float sx = xrow[c];
+                const float sy = yrow[c];
+                // Reads pixels floor(s) and floor(s) + 1; anything partly inside counts
+                if (!(sx > -1.0f && sy > -1.0f && sx < source_size.width && sy < source_size.height)) continue;
+                const int fx = static_cast<int>(std::floor(sx));
+                const int fy = static_cast<int>(std::floor(sy));
+                bx0 = std::min(bx0, fx);
+                by0 = std::min(by0, fy);
+                bx1 = std::max(bx1, fx + 1);
+                by1 = std::max(by1, fy + 1);
+            }
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        x0 = std::min(x0, bx0);
+        y0 = std::min(y0, by0);
+        x1 = std::max(x1, bx1);
+        y1 = std::max(y1, by1);
+    }, 16);
+
+    if (x1 < 0) {
+        return cv::Rect();
+    }
+    // Pixels x0..x1 inclusive, clipped to the source
+    return cv::Rect(cv::Point(x0, y0), cv::Point(x1 + 1, y1 + 1)) & cv::Rect(cv::Point(), source_size);
+}
+
+void offsetWarpMaps(cv::Mat& map_x, cv::Mat& map_y, cv::Point2f origin) {
+    // -1 (not visible) stays outside the crop
+    cv::subtract(map_x, cv::Scalar(origin.x), map_x);
+    cv::subtract(map_y, cv::Scalar(origin.y), map_y);
+}
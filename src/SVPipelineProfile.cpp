@@ -0,0 +1,202 @@
+#include "SVPipelineProfile.hpp"
+#include <cctype>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <sys/utsname.h>
+
+std::string SVPipelineProfile::sinkChain(const cv::Size& size, const char* sinkName, const cv::Rect& crop) const {
+    std::ostringstream out;
+    out << " ! " << scaler
+        << " ! " << scaled_caps << ",width=" << size.width << ",height=" << size.height;
+    if (!crop.empty() && !converter_crops) {
+        // videocrop takes margins
+        out << " ! videocrop left=" << crop.x << " top=" << crop.y
+            << " right=" << size.width - crop.br().x << " bottom=" << size.height - crop.br().y;
+    }
+    out << " ! " << converter;
+    if (!crop.empty() && converter_crops) {
+        // Source rectangle edges, not margins
+        out << " left=" << crop.x << " top=" << crop.y
+            << " right=" << crop.br().x << " bottom=" << crop.br().y;
+    }
+    out << " ! video/x-raw,format=" << format;
+    if (!crop.empty()) {
+        out << ",width=" << crop.width << ",height=" << crop.height;
+    }
+    out << " ! appsink name=" << sinkName << " emit-signals=true max-buffers=" << sink_buffers
+        << " drop=true sync=false";
+    return out.str();
+}
+
+std::vector<std::string> SVPipelineProfile::elements() const {
+    std::vector<std::string> names;
+    for (const std::string* stage : {&decoder, &scaler, &converter}) {
+        names.push_back(stage->substr(0, stage->find(' ')));
+    }
+    if (!converter_crops) {
+        names.push_back("videocrop");
+    }
+    return names;
+}
+
+std::string SVPipelineProfile::rtpSource(const std::string& address, int port) {
+    std::ostringstream out;
+    out << "udpsrc address=" << address
+        << " port=" << port
+        << " ! application/x-rtp,media=video,clock-rate=90000,encoding-name=H264,payload=96 "
+        << " ! rtpjitterbuffer drop-on-latency=true latency=200 "
+        << " ! rtph264depay ";
+    return out.str();
+}
+
+bool SVPipelineProfile::load(const std::string& path) {
+    cv::FileStorage fs;
+    try {
+        if (!fs.open(path, cv::FileStorage::READ)) {
+            return false;
+        }
+    } catch (const cv::Exception&) {
+        return false;
+    }
+
+    SVPipelineProfile p;
+    fs["name"] >> p.name;
+    fs["decoder"] >> p.decoder;
+    fs["scaler"] >> p.scaler;
+    fs["scaled_caps"] >> p.scaled_caps;
+    fs["converter"] >> p.converter;
+    fs["format"] >> p.format;
+    int crops = p.converter_crops ? 1 : 0;
+    if (!fs["converter_crops"].empty()) fs["converter_crops"] >> crops;
+    p.converter_crops = crops != 0;
+    if (!fs["sink_buffers"].empty()) fs["sink_buffers"] >> p.sink_buffers;
+
+    if (p.decoder.empty() || p.scaler.empty() || p.scaled_caps.empty() || p.converter.empty() ||
+        (p.format != "BGRx" && p.format != "BGR") || p.sink_buffers < 1) {
+        std::cerr << "✗ Pipeline profile " << path << " is incomplete, ignored" << std::endl;
+        return false;
+    }
+    *this = p;
+    return true;
+}
+
+bool SVPipelineProfile::save(const std::string& path,
+                             const std::vector<std::pair<std::string, double>>& measured) const {
+    cv::FileStorage fs;
+    try {
+        if (!fs.open(path, cv::FileStorage::WRITE)) {
+            std::cerr << "✗ Cannot write pipeline profile " << path << std::endl;
+            return false;
+        }
+    } catch (const cv::Exception& e) {
+        std::cerr << "✗ Cannot write pipeline profile " << path << ": " << e.what() << std::endl;
+        return false;
+    }
+
+    fs << "platform" << platformId();
+    fs << "name" << name;
+    fs << "decoder" << decoder;
+    fs << "scaler" << scaler;
+    fs << "scaled_caps" << scaled_caps;
+    fs << "converter" << converter;
+    fs << "format" << format;
+    fs << "converter_crops" << (converter_crops ? 1 : 0);
+    fs << "sink_buffers" << sink_buffers;
+    if (!measured.empty()) {
+        fs << "measured" << "{";
+        for (const auto& m : measured) {
+            fs << m.first << m.second;
+        }
+        fs << "}";
+    }
+    return true;
+}
+
+std::vector<SVPipelineProfile> SVPipelineProfile::candidates() {
+    std::vector<SVPipelineProfile> list;
+
+    // Jetson: hardware decode, scaling and crop in NVMM
+    SVPipelineProfile jetson;
+    list.push_back(jetson);
+
+    SVPipelineProfile nodpb = jetson;
+    nodpb.name = "jetson-nvv4l2-nodpb";         // No reorder buffer: streams without B-frames
+    nodpb.decoder = "nvv4l2decoder enable-max-performance=1 disable-dpb=true";
+    list.push_back(nodpb);
+
+    SVPipelineProfile twobuf = jetson;
+    twobuf.name = "jetson-nvv4l2-2buf";
+    twobuf.sink_buffers = 2;
+    list.push_back(twobuf);
+
+    // Software decode (x86 or any target without a hardware decoder)
+    SVPipelineProfile sw;
+    sw.name = "sw-avdec";
+    sw.decoder = "avdec_h264";
+    sw.scaler = "videoscale";
+    sw.scaled_caps = "video/x-raw";
+    sw.converter = "videoconvert";
+    sw.converter_crops = false;
+    list.push_back(sw);
+
+    SVPipelineProfile swnothreads = sw;
+    swnothreads.name = "sw-avdec-1thread";      // No frame threading: one frame less in flight
+    swnothreads.decoder = "avdec_h264 max-threads=1";
+    list.push_back(swnothreads);
+
+    SVPipelineProfile swbgr = sw;
+    swbgr.name = "sw-avdec-bgr";                // Converted to BGR on the CPU instead of the GPU
+    swbgr.format = "BGR";
+    list.push_back(swbgr);
+
+    // Intel/AMD hardware decode
+    SVPipelineProfile vaapi = sw;
+    vaapi.name = "vaapi";
+    vaapi.decoder = "vaapih264dec";
+    vaapi.scaler = "vaapipostproc";
+    list.push_back(vaapi);
+
+    // NVIDIA desktop GPU (gst-plugins-bad nvcodec)
+    SVPipelineProfile nvdec = sw;
+    nvdec.name = "nvcodec";
+    nvdec.decoder = "nvh264dec";
+    list.push_back(nvdec);
+
+    return list;
+}
+
+static std::string readFirstLine(const std::string& path, const std::string& key = std::string()) {
+    std::ifstream in(path);
+    std::string line;
+    while (std::getline(in, line)) {
+        if (key.empty()) return line;
+        if (line.compare(0, key.size(), key) == 0) {
+            const size_t colon = line.find(':');
+            return colon == std::string::npos ? std::string() : line.substr(colon + 1);
+        }
+    }
+    return std::string();
+}
+
+std::string SVPipelineProfile::platformId() {
+    // Jetson and other boards name themselves in the device tree (NUL-terminated)
+    std::string model = readFirstLine("/proc/device-tree/model");
+    model = model.substr(0, model.find('\0'));
+    if (model.empty()) {
+        utsname u;
+        const std::string machine = uname(&u) == 0 ? u.machine : "unknown";
+        model = machine + " " + readFirstLine("/proc/cpuinfo", "model name");
+    }
+
+    std::string id;
+    for (char c : model) {
+        if (std::isalnum(static_cast<unsigned char>(c))) {
+            id += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        } else if (!id.empty() && id.back() != '_') {
+            id += '_';
+        }
+    }
+    while (!id.empty() && id.back() == '_') id.pop_back();
+    return id.empty() ? "unknown" : id.substr(0, 64);
+}
@@ -0,0 +1,322 @@
+#include "SVPipelineTuner.hpp"
+#include <gst/gst.h>
+#include <gst/app/gstappsink.h>
+#include <gst/app/gstappsrc.h>
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+namespace {
+
+int64_t steadyNs() {
+    return std::chrono::steady_clock::now().time_since_epoch().count();
+}
+
+double processCpuSeconds() {
+    timespec ts;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Shared by the parser probe and the appsink callback (both on streaming threads)
+struct Measurement {
+    std::mutex mutex;
+    bool counting_in = false;               // Units entering are stamped and counted
+    bool counting_out = false;              // Frames of stamped units are counted
+    std::map<uint64_t, int64_t> stamps;     // PTS -> time the unit left the parser
+    uint64_t units_in = 0;
+    uint64_t frames_out = 0;
+    std::vector<double> latencies_ms;
+};
+
+GstPadProbeReturn parserProbe(GstPad*, GstPadProbeInfo* info, gpointer data) {
+    auto* m = static_cast<Measurement*>(data);
+    GstBuffer* buffer = GST_PAD_PROBE_INFO_BUFFER(info);
+    if (!buffer || !GST_BUFFER_PTS_IS_VALID(buffer)) return GST_PAD_PROBE_OK;
+
+    std::lock_guard<std::mutex> lock(m->mutex);
+    if (!m->counting_in) return GST_PAD_PROBE_OK;
+    m->units_in++;
+    m->stamps[GST_BUFFER_PTS(buffer)] = steadyNs();
+    while (m->stamps.size() > 256) {
+        m->stamps.erase(m->stamps.begin());     // Never decoded; counted as a drop
+    }
+    return GST_PAD_PROBE_OK;
+}
+
+GstFlowReturn sinkSample(GstElement* sink, gpointer data) {
+    auto* m = static_cast<Measurement*>(data);
+    GstSample* sample = gst_app_sink_pull_sample(GST_APP_SINK(sink));
+    if (!sample) return GST_FLOW_OK;
+
+    const int64_t now = steadyNs();
+    GstBuffer* buffer = gst_sample_get_buffer(sample);
+    if (buffer && GST_BUFFER_PTS_IS_VALID(buffer)) {
+        std::lock_guard<std::mutex> lock(m->mutex);
+        auto it = m->stamps.find(GST_BUFFER_PTS(buffer));
+        if (m->counting_out && it != m->stamps.end()) {
+            m->frames_out++;
+            m->latencies_ms.push_back((now - it->second) * 1e-6);
+            m->stamps.erase(it);
+        }
+    }
+    gst_sample_unref(sample);
+    return GST_FLOW_OK;
+}
+
+double percentile(std::vector<double>& values, double p) {
+    if (values.empty()) return 0.0;
+    const size_t k = std::min(values.size() - 1, static_cast<size_t>(p * values.size()));
+    std::nth_element(values.begin(), values.begin() + k, values.end());
+    return values[k];
+}
+
+} // namespace
+
+void SVPipelineTuner::setLiveSource(const std::string& address_, int port_) {
+    address = address_;
+    port = port_;
+    session_camera = -1;
+    reader.close();
+}
+
+bool SVPipelineTuner::setSessionSource(const std::string& path, int camera) {
+    if (!reader.open(path)) {
+        return false;
+    }
+    if (camera < 0 || camera >= reader.cameraCount() || reader.unitCount(camera) == 0) {
+        std::cerr << "✗ Pipeline tuner: session " << path << " has no stream for camera " << camera << std::endl;
+        reader.close();
+        return false;
+    }
+    // A decoder cannot start without one
+    if (reader.findKeyframe(camera, reader.startNs()) == SVSessionReader::NO_UNIT) {
+        std::cerr << "✗ Pipeline tuner: session " << path << " has no keyframe for camera " << camera << std::endl;
+        reader.close();
+        return false;
+    }
+    session_camera = camera;
+    return true;
+}
+
+bool SVPipelineTuner::available(const SVPipelineProfile& profile, std::string* missing) {
+    static std::once_flag gst_initialized;
+    std::call_once(gst_initialized, [] { gst_init(nullptr, nullptr); });
+
+    for (const std::string& name : profile.elements()) {
+        GstElementFactory* factory = gst_element_factory_find(name.c_str());
+        if (!factory) {
+            if (missing) *missing = name;
+            return false;
+        }
+        gst_object_unref(factory);
+    }
+    return true;
+}
+
+void SVPipelineTuner::feedSession(GstElement* appsrc, const std::atomic<bool>& stop) {
+    // From the first keyframe at recorded speed, looping with continuing timestamps
+    const int cam = session_camera;
+    const size_t first = reader.findKeyframe(cam, reader.startNs());
+    if (first == SVSessionReader::NO_UNIT) {
+        // Rejected by setSessionSource(); the measurement then ends with the stream
+        gst_app_src_end_of_stream(GST_APP_SRC(appsrc));
+        return;
+    }
+    const size_t count = reader.unitCount(cam);
+    const int64_t first_pts = reader.unit(cam, first).pts_ns;
+    const int64_t last_pts = reader.unit(cam, count - 1).pts_ns;
+    const int64_t loop_ns = std::max<int64_t>(last_pts - first_pts + 33000000, 33000000);
+
+    const auto wall_start = std::chrono::steady_clock::now();
+    int64_t offset = 0;
+    for (size_t k = first; !stop; k++) {
+        if (k == count) {
+            k = first;
+            offset += loop_ns;
+        }
+        const SVSessionReader::Unit unit = reader.unit(cam, k);
+        const int64_t t = unit.pts_ns - first_pts + offset;
+        std::this_thread::sleep_until(wall_start + std::chrono::nanoseconds(t));
+
+        // Zero-copy: the mapping outlives the pipeline
+        GstBuffer* buffer = gst_buffer_new_wrapped_full(GST_MEMORY_FLAG_READONLY,
+            const_cast<uint8_t*>(unit.data), unit.size, 0, unit.size, nullptr, nullptr);
+        GST_BUFFER_PTS(buffer) = static_cast<GstClockTime>(t);
+        if (gst_app_src_push_buffer(GST_APP_SRC(appsrc), buffer) != GST_FLOW_OK) {
+            return;
+        }
+    }
+}
+
+SVPipelineTuner::Result SVPipelineTuner::measure(const SVPipelineProfile& profile, const Options& options) {
+    Result r;
+    r.profile = profile;
+
+    std::string missing;
+    if (!available(profile, &missing)) {
+        r.error = "no " + missing + " element";
+        return r;
+    }
+
+    std::ostringstream desc;
+    if (session_camera >= 0) {
+        desc << "appsrc name=src format=time is-live=true "
+             << "caps=video/x-h264,stream-format=byte-stream,alignment=au ";
+    } else {
+        desc << SVPipelineProfile::rtpSource(address, port);
+    }
+    desc << " ! h264parse name=parse ! " << profile.decoder
+         << profile.sinkChain(options.output_size, "sink");
+
+    GError* error = nullptr;
+    GstElement* pipeline = gst_parse_launch(desc.str().c_str(), &error);
+    if (!pipeline || error) {
+        r.error = error ? error->message : "pipeline failed";
+        if (error) g_error_free(error);
+        if (pipeline) gst_object_unref(pipeline);
+        return r;
+    }
+
+    Measurement m;
+    GstElement* parse = gst_bin_get_by_name(GST_BIN(pipeline), "parse");
+    GstPad* pad = gst_element_get_static_pad(parse, "src");
+    gst_pad_add_probe(pad, GST_PAD_PROBE_TYPE_BUFFER, parserProbe, &m, nullptr);
+    gst_object_unref(pad);
+    gst_object_unref(parse);
+    GstElement* sink = gst_bin_get_by_name(GST_BIN(pipeline), "sink");
+    g_signal_connect(sink, "new-sample", G_CALLBACK(sinkSample), &m);
+    gst_object_unref(sink);
+
+    GstBus* bus = gst_element_get_bus(pipeline);
+    GstElement* appsrc = session_camera >= 0 ? gst_bin_get_by_name(GST_BIN(pipeline), "src") : nullptr;
+    std::atomic<bool> stop_feed{false};
+    std::thread feeder;
+
+    const auto phase = [&](double seconds) {
+        // Errors end the candidate at once
+        const auto end = std::chrono::steady_clock::now() + std::chrono::duration<double>(seconds);
+        while (r.error.empty() && std::chrono::steady_clock::now() < end) {
+            GstMessage* msg = gst_bus_timed_pop_filtered(bus, 100 * GST_MSECOND,
+                static_cast<GstMessageType>(GST_MESSAGE_ERROR | GST_MESSAGE_EOS));
+            if (!msg) continue;
+            if (GST_MESSAGE_TYPE(msg) == GST_MESSAGE_ERROR) {
+                GError* err = nullptr;
+                gst_message_parse_error(msg, &err, nullptr);
+                r.error = err ? err->message : "pipeline error";
+                if (err) g_error_free(err);
+            } else {
+                r.error = "end of stream";
+            }
+            gst_message_unref(msg);
+        }
+    };
+
+    double cpu_start = 0.0;
+    int64_t wall_start = 0;
+    if (gst_element_set_state(pipeline, GST_STATE_PLAYING) == GST_STATE_CHANGE_FAILURE) {
+        r.error = "pipeline failed to start";
+    } else {
+        if (appsrc) {
+            feeder = std::thread(&SVPipelineTuner::feedSession, this, appsrc, std::cref(stop_feed));
+        }
+        phase(options.warmup_seconds);
+
+        {
+            std::lock_guard<std::mutex> lock(m.mutex);
+            m.counting_in = true;
+            m.counting_out = true;
+        }
+        cpu_start = processCpuSeconds();
+        wall_start = steadyNs();
+        phase(options.measure_seconds);
+
+        // Units still in the decoder get a moment to come out
+        {
+            std::lock_guard<std::mutex> lock(m.mutex);
+            m.counting_in = false;
+        }
+        const double cpu = processCpuSeconds() - cpu_start;
+        const double wall = (steadyNs() - wall_start) * 1e-9;
+        phase(0.3);
+        r.cpu_percent = wall > 0.0 ? 100.0 * cpu / wall : 0.0;
+    }
+
+    stop_feed = true;
+    if (appsrc) {
+        gst_app_src_end_of_stream(GST_APP_SRC(appsrc));
+    }
+    if (feeder.joinable()) feeder.join();
+    gst_element_set_state(pipeline, GST_STATE_NULL);
+    if (appsrc) gst_object_unref(appsrc);
+    gst_object_unref(bus);
+    gst_object_unref(pipeline);
+
+    // The pipeline is gone: no more callbacks
+    r.units_in = m.units_in;
+    r.frames_out = m.frames_out;
+    if (r.error.empty() && r.units_in == 0) {
+        r.error = "no stream";
+    }
+    r.ran = r.error.empty();
+    if (r.units_in > 0) {
+        r.drop_rate = 1.0 - std::min<double>(r.frames_out, r.units_in) / r.units_in;
+    }
+    r.latency_ms = percentile(m.latencies_ms, 0.5);
+    r.latency_p95_ms = percentile(m.latencies_ms, 0.95);
+    return r;
+}
+
+std::vector<SVPipelineTuner::Result> SVPipelineTuner::run(const std::vector<SVPipelineProfile>& candidates,
+                                                          const Options& options) {
+    std::cout << "Pipeline tuner: " << candidates.size() << " candidates on "
+              << (session_camera >= 0 ? "session camera " + std::to_string(session_camera)
+                                      : address + ":" + std::to_string(port))
+              << ", " << options.measure_seconds << " s each" << std::endl;
+
+    std::vector<Result> results;
+    for (const SVPipelineProfile& profile : candidates) {
+        results.push_back(measure(profile, options));
+        const Result& r = results.back();
+        std::ostringstream line;
+        line << "  " << std::left << std::setw(22) << profile.name << std::right << std::fixed << std::setprecision(1);
+        if (r.ran) {
+            line << " latency " << r.latency_ms << " ms (p95 " << r.latency_p95_ms << "), CPU "
+                 << r.cpu_percent << "%, drops " << 100.0 * r.drop_rate << "%";
+        } else {
+            line << " skipped: " << r.error;
+        }
+        std::cout << line.str() << std::endl;
+    }
+    return results;
+}
+
+const SVPipelineTuner::Result* SVPipelineTuner::best(const std::vector<Result>& results, double max_drop_rate) {
+    const auto usable = [max_drop_rate](const Result& r) {
+        return r.ran && r.frames_out > 0 && r.drop_rate <= max_drop_rate;
+    };
+
+    const Result* fastest = nullptr;
+    for (const Result& r : results) {
+        if (usable(r) && (!fastest || r.latency_ms < fastest->latency_ms)) {
+            fastest = &r;
+        }
+    }
+    if (!fastest) return nullptr;
+
+    // Latencies this close are within run-to-run noise: the cheaper one wins
+    const Result* pick = fastest;
+    for (const Result& r : results) {
+        if (usable(r) && r.latency_ms <= fastest->latency_ms * 1.1 && r.cpu_percent < pick->cpu_percent) {
+            pick = &r;
+        }
+    }
+    return pick;
+}
@@ -2,11 +2,16 @@
 #include "OGLShader.hpp"
 #include "Model.hpp"
 #include "Shader.hpp"
+#include "SVBowlView.hpp"
 #include <GL/gl.h>
 #include <GL/glext.h>
 #include <GLFW/glfw3.h>
 #include <iostream>
 #include "SVConfig.hpp"
+#include "SVFrameBuffer.hpp"
+#include "SVThreadPool.hpp"
+#include <algorithm>
+#include <cmath>
 // ✅ ADD THESE LINES:
 #include <opencv2/cudawarping.hpp>   // For cv::cuda::remap
 #include <opencv2/imgproc.hpp>        // For cv::INTER_LINEAR
@@ -57,21 +62,64 @@ void main()
 )";
 
 SVRenderSimple::SVRenderSimple(int width, int height)
-    : screen_width(width)
+    : window(nullptr)
+    , screen_width(width)
     , screen_height(height)
-    , window(nullptr)
     , quad_VAO(0)
     , quad_VBO(0)
     , texture_shader(nullptr)
+    , show_bowl(false)
+    , stitched_texture(0)
+    , readback_enabled(false)
+    , readback_pbos{0, 0}
+    , readback_filled{false, false}
+    , readback_index(0)
     , camera_frame_width(1280)    // Default to original resolution
     , camera_frame_height(800)
     , is_init(false) {
     
-    camera_textures.fill(0);
-    camera_pbos.fill(0);
+    setCameraRig(SVCameraRig::defaultRig());
+}
+
+void SVRenderSimple::setCameraRig(const SVCameraRig& rig_) {
+    if (is_init) {
+        std::cerr << "WARNING: Camera rig must be set before renderer init, ignoring" << std::endl;
+        return;
+    }
+    
+    rig = rig_;
+    camera_textures.assign(rig.size(), 0);
+    camera_pbos.assign(rig.size(), 0);
+    display_maps.assign(rig.size(), DisplayMap());
+    
+    // Group cameras by the side they look at (yaw counter-clockwise from front)
+    for (auto& cams : side_cameras) cams.clear();
+    std::vector<float> yaws(rig.size());
+    for (int i = 0; i < rig.size(); i++) {
+        float yaw = std::fmod(rig.camera(i).yaw_deg, 360.0f);
+        if (yaw < 0.0f) yaw += 360.0f;
+        yaws[i] = yaw;
+        
+        if (yaw >= 315.0f || yaw < 45.0f)  side_cameras[SIDE_FRONT].push_back(i);
+        else if (yaw < 135.0f)             side_cameras[SIDE_LEFT].push_back(i);
+        else if (yaw < 225.0f)             side_cameras[SIDE_REAR].push_back(i);
+        else                               side_cameras[SIDE_RIGHT].push_back(i);
+    }
+    
+    // On-screen order: front left-to-right, left top-to-bottom, rear left-to-right, right top-to-bottom
+    // (front yaws are compared signed so 350° sorts right of 10°)
+    auto signed_yaw = [&](int i) { return yaws[i] > 180.0f ? yaws[i] - 360.0f : yaws[i]; };
+    auto by_yaw = [&](int a, int b) { return yaws[a] < yaws[b]; };
+    auto by_yaw_desc = [&](int a, int b) { return yaws[a] > yaws[b]; };
+    std::sort(side_cameras[SIDE_FRONT].begin(), side_cameras[SIDE_FRONT].end(),
+              [&](int a, int b) { return signed_yaw(a) > signed_yaw(b); });
+    std::sort(side_cameras[SIDE_LEFT].begin(), side_cameras[SIDE_LEFT].end(), by_yaw);
+    std::sort(side_cameras[SIDE_REAR].begin(), side_cameras[SIDE_REAR].end(), by_yaw);
+    std::sort(side_cameras[SIDE_RIGHT].begin(), side_cameras[SIDE_RIGHT].end(), by_yaw_desc);
 }
 
 SVRenderSimple::~SVRenderSimple() {
+    bowl_view.reset();  // Owns GL objects, release while the context exists
     if (texture_shader) delete texture_shader;
     
     for (auto tex : camera_textures) {
@@ -82,6 +130,12 @@ SVRenderSimple::~SVRenderSimple() {
         if (pbo) glDeleteBuffers(1, &pbo);
     }
     
+    if (stitched_texture) glDeleteTextures(1, &stitched_texture);
+    
+    for (auto pbo : readback_pbos) {
+        if (pbo) glDeleteBuffers(1, &pbo);
+    }
+    
     if (quad_VAO) glDeleteVertexArrays(1, &quad_VAO);
     if (quad_VBO) glDeleteBuffers(1, &quad_VBO);
     
@@ -95,7 +149,7 @@ bool SVRenderSimple::init(const std::string& car_model_path,
                           const std::string& car_vert_shader,
                           const std::string& car_frag_shader) {
     
-    std::cout << "Initializing simplified 4-camera renderer..." << std::endl;
+    std::cout << "Initializing simplified " << rig.size() << "-camera renderer..." << std::endl;
     // std::cout << "=== RENDERER INITIALIZATION ===" << std::endl;
     // std::cout << "Screen dimensions: " << screen_width << " x " << screen_height << std::endl;
     // Initialize GLFW
@@ -109,8 +163,9 @@ bool SVRenderSimple::init(const std::string& car_model_path,
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
     
     // Create window
+    const std::string title = "Surround View - " + std::to_string(rig.size()) + " Camera Display";
     window = glfwCreateWindow(screen_width, screen_height, 
-                             "Surround View - 4 Camera Display", nullptr, nullptr);
+                             title.c_str(), nullptr, nullptr);
     if (!window) {
         std::cerr << "Failed to create GLFW window" << std::endl;
         glfwTerminate();
@@ -136,8 +191,8 @@ bool SVRenderSimple::init(const std::string& car_model_path,
     setupCarModel(car_model_path, car_vert_shader, car_frag_shader);
     std::cout << "  ✓ Car model loaded" << std::endl;
     
-    // Create textures and PBOs for 4 cameras
-    for (int i = 0; i < 4; i++) {
+    // Create textures and PBOs for every rig camera
+    for (size_t i = 0; i < camera_textures.size(); i++) {
         // Texture
         glGenTextures(1, &camera_textures[i]);
         glBindTexture(GL_TEXTURE_2D, camera_textures[i]);
@@ -156,7 +211,7 @@ bool SVRenderSimple::init(const std::string& car_model_path,
     
     glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
     
-    std::cout << "  ✓ Camera textures created (4 cameras)" << std::endl;
+    std::cout << "  ✓ Camera textures created (" << camera_textures.size() << " cameras)" << std::endl;
     
     is_init = true;
     std::cout << "✓ Renderer initialization complete!" << std::endl;
@@ -164,6 +219,50 @@ bool SVRenderSimple::init(const std::string& car_model_path,
     return true;
 }
 
+bool SVRenderSimple::initBowlView(const std::vector<SVCameraCalib>& calibs, cv::Size image_size) {
+    if (!is_init) {
+        std::cerr << "ERROR: Renderer must be initialized before the bowl view" << std::endl;
+        return false;
+    }
+    
+    std::cout << "Baking 3D bowl view..." << std::endl;
+    auto bowl = std::make_unique<SVBowlView>();
+    if (!bowl->build(calibs, image_size) || !bowl->initGL()) {
+        return false;
+    }
+    
+    bowl_view = std::move(bowl);
+    return true;
+}
+
+bool SVRenderSimple::hasBowlView() const {
+    return bowl_view && bowl_view->isReady();
+}
+
+void SVRenderSimple::drawBowlView(const std::vector<cv::cuda::GpuMat>& raw_frames,
+                                  int x, int y, int w, int h) {
+    bowl_view->uploadFrames(raw_frames);
+    
+    glViewport(x, y, w, h);
+    glEnable(GL_SCISSOR_TEST);
+    glScissor(x, y, w, h);
+    glClear(GL_DEPTH_BUFFER_BIT);
+    glDisable(GL_SCISSOR_TEST);
+    
+    glEnable(GL_DEPTH_TEST);
+    glDepthFunc(GL_LESS);
+    
+    // Behind and above the vehicle centre, looking at it (bowl units)
+    const float metres_per_unit = BOWL_SCALE_MM / 1000.0f;
+    const glm::vec3 eye(0.0f, CAMERA_POSITION_Y / metres_per_unit, CAMERA_POSITION_Z / metres_per_unit);
+    glm::mat4 view = glm::lookAt(eye, glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    glm::mat4 projection = glm::perspective(glm::radians(CAMERA_FOV), (float)w / h, 0.01f, 10.0f);
+    
+    bowl_view->draw(view, projection);
+    
+    glDisable(GL_DEPTH_TEST);
+}
+
 void SVRenderSimple::setupQuad() {
     glGenVertexArrays(1, &quad_VAO);
     glGenBuffers(1, &quad_VBO);
@@ -270,119 +369,60 @@ void SVRenderSimple::createTextureShader() {
     glDeleteShader(fragment);
 }
 
-// REPLACE the entire uploadTexture function with this memory-efficient version
+void SVRenderSimple::buildDisplayMap(int cam_idx, const cv::Size& frame_size) {
+    DisplayMap& dm = display_maps[cam_idx];
+    const SVDisplayRotation rotation = rig.camera(cam_idx).display;
+    const int rows = frame_size.height;
+    const int cols = frame_size.width;
+    
+    // 90° variants swap the output dimensions
+    const bool transposed = (rotation == SVDisplayRotation::TRANSPOSE ||
+                             rotation == SVDisplayRotation::TRANSVERSE);
+    const cv::Size out_size = transposed ? cv::Size(rows, cols) : frame_size;
+    
+    cv::Mat cpu_map_x(out_size, CV_32F);
+    cv::Mat cpu_map_y(out_size, CV_32F);
+    
+    SVThreadPool::instance().parallelFor(0, out_size.height, [&](int y) {
+        for (int x = 0; x < out_size.width; x++) {
+            float sx = x, sy = y;
+            switch (rotation) {
+                case SVDisplayRotation::FLIP_V:     sx = x;            sy = rows - 1 - y; break;
+                case SVDisplayRotation::FLIP_H:     sx = cols - 1 - x; sy = y;            break;
+                case SVDisplayRotation::TRANSPOSE:  sx = y;            sy = x;            break;
+                case SVDisplayRotation::TRANSVERSE: sx = cols - 1 - y; sy = rows - 1 - x; break;
+                case SVDisplayRotation::NONE:                                              break;
+            }
+            cpu_map_x.at<float>(y, x) = sx;
+            cpu_map_y.at<float>(y, x) = sy;
+        }
+    });
+    
+    dm.map_x.upload(cpu_map_x);
+    dm.map_y.upload(cpu_map_y);
+    dm.frame_size = frame_size;
+}
 
-void SVRenderSimple::uploadTexture(const cv::cuda::GpuMat& frame, unsigned int texture_id) {
+void SVRenderSimple::uploadTexture(const cv::cuda::GpuMat& frame, int cam_idx) {
     if (frame.empty()) return;
     
-    // Get PBO index (0-3)
-    unsigned int pbo_idx = 0;
-    for (int i = 0; i < 4; i++) {
-        if (camera_textures[i] == texture_id) {
-            pbo_idx = i;
-            break;
-        }
-    }
-    
     // ============================================================
-    // FLIP PROCESSING - Use static buffers to prevent memory leaks
+    // FLIP PROCESSING - Per-camera buffers reused every frame
     // ============================================================
     
-    // Static output buffers (one per camera, reused every frame)
-    static cv::cuda::GpuMat processed_frames[4];
-    cv::cuda::GpuMat& processed_frame = processed_frames[pbo_idx];
+    DisplayMap& dm = display_maps[cam_idx];
+    cv::cuda::GpuMat& processed_frame = dm.processed;
     
     #ifdef RENDER_PRESERVE_AS_CUSTOMHOMOGRAPHY
-    // Only apply rotation transformations if NOT using custom homography
-    // (Custom homography already includes rotations in warp maps)
-    
-    if (pbo_idx == 0) {
-        // Front camera: Vertical flip
-        static cv::cuda::GpuMat map_x, map_y;
-        static bool initialized = false;
-        
-        if (!initialized) {
-            cv::Mat cpu_map_x(frame.rows, frame.cols, CV_32F);
-            cv::Mat cpu_map_y(frame.rows, frame.cols, CV_32F);
-            
-            for (int y = 0; y < frame.rows; y++) {
-                for (int x = 0; x < frame.cols; x++) {
-                    cpu_map_x.at<float>(y, x) = x;
-                    cpu_map_y.at<float>(y, x) = frame.rows - 1 - y;
-                }
-            }
-            
-            map_x.upload(cpu_map_x);
-            map_y.upload(cpu_map_y);
-            initialized = true;
-        }
-        cv::cuda::remap(frame, processed_frame, map_x, map_y, cv::INTER_LINEAR);
-        
-    } else if (pbo_idx == 1) {
-        // Left camera: 90° CCW + vertical flip (transpose)
-        static cv::cuda::GpuMat map_x, map_y;
-        static bool initialized = false;
-        
-        if (!initialized) {
-            cv::Mat cpu_map_x(frame.cols, frame.rows, CV_32F);
-            cv::Mat cpu_map_y(frame.cols, frame.rows, CV_32F);
-            
-            for (int y = 0; y < frame.cols; y++) {
-                for (int x = 0; x < frame.rows; x++) {
-                    cpu_map_x.at<float>(y, x) = y;
-                    cpu_map_y.at<float>(y, x) = x;
-                }
-            }
-            
-            map_x.upload(cpu_map_x);
-            map_y.upload(cpu_map_y);
-            initialized = true;
-        }
-        cv::cuda::remap(frame, processed_frame, map_x, map_y, cv::INTER_LINEAR);
-        
-    } else if (pbo_idx == 2) {
-        // Rear camera: Horizontal flip
-        static cv::cuda::GpuMat map_x, map_y;
-        static bool initialized = false;
-        
-        if (!initialized) {
-            cv::Mat cpu_map_x(frame.rows, frame.cols, CV_32F);
-            cv::Mat cpu_map_y(frame.rows, frame.cols, CV_32F);
-            
-            for (int y = 0; y < frame.rows; y++) {
-                for (int x = 0; x < frame.cols; x++) {
-                    cpu_map_x.at<float>(y, x) = frame.cols - 1 - x;
-                    cpu_map_y.at<float>(y, x) = y;
-                }
-            }
-            
-            map_x.upload(cpu_map_x);
-            map_y.upload(cpu_map_y);
-            initialized = true;
+    // Turn each camera upright for its viewport (front: vertical flip,
+    // left: transpose, rear: horizontal flip, right: transverse on the default rig)
+    if (rig.camera(cam_idx).display == SVDisplayRotation::NONE) {
+        processed_frame = frame;
+    } else {
+        if (dm.frame_size != frame.size()) {
+            buildDisplayMap(cam_idx, frame.size());
         }
-        cv::cuda::remap(frame, processed_frame, map_x, map_y, cv::INTER_LINEAR);
-        
-    } else if (pbo_idx == 3) {
-        // Right camera: 90° CW + vertical flip
-        static cv::cuda::GpuMat map_x, map_y;
-        static bool initialized = false;
-        
-        if (!initialized) {
-            cv::Mat cpu_map_x(frame.cols, frame.rows, CV_32F);
-            cv::Mat cpu_map_y(frame.cols, frame.rows, CV_32F);
-            
-            for (int y = 0; y < frame.cols; y++) {
-                for (int x = 0; x < frame.rows; x++) {
-                    cpu_map_x.at<float>(y, x) = frame.cols - 1 - y;
-                    cpu_map_y.at<float>(y, x) = frame.rows - 1 - x;
-                }
-            }
-            
-            map_x.upload(cpu_map_x);
-            map_y.upload(cpu_map_y);
-            initialized = true;
-        }
-        cv::cuda::remap(frame, processed_frame, map_x, map_y, cv::INTER_LINEAR);
+        cv::cuda::remap(frame, processed_frame, dm.map_x, dm.map_y, cv::INTER_LINEAR);
     }
     
     #else
@@ -393,7 +433,7 @@ void SVRenderSimple::uploadTexture(const cv::cuda::GpuMat& frame, unsigned int t
     
     // Verify the processed frame is valid
     if (processed_frame.empty()) {
-        std::cerr << "ERROR: processed_frame is empty for camera " << pbo_idx << std::endl;
+        std::cerr << "ERROR: processed_frame is empty for camera " << cam_idx << std::endl;
         return;
     }
     
@@ -401,12 +441,12 @@ void SVRenderSimple::uploadTexture(const cv::cuda::GpuMat& frame, unsigned int t
     size_t required_size = processed_frame.cols * processed_frame.rows * 3;
     
     // Download from GPU to PBO
-    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, camera_pbos[pbo_idx]);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, camera_pbos[cam_idx]);
     
     // Reallocate PBO if needed
     GLint current_size = 0;
     glGetBufferParameteriv(GL_PIXEL_UNPACK_BUFFER, GL_BUFFER_SIZE, &current_size);
-    if (current_size < required_size) {
+    if (static_cast<size_t>(current_size) < required_size) {
         glBufferData(GL_PIXEL_UNPACK_BUFFER, required_size, nullptr, GL_STREAM_DRAW);
     }
     
@@ -415,17 +455,70 @@ void SVRenderSimple::uploadTexture(const cv::cuda::GpuMat& frame, unsigned int t
     
     if (ptr) {
         cv::Mat cpu_frame(processed_frame.rows, processed_frame.cols, CV_8UC3, ptr);
-        processed_frame.download(cpu_frame);
+        svDownload(processed_frame, cpu_frame, SVResidency::MAPPED);
         glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
     }
     
-    // Upload to texture
-    glBindTexture(GL_TEXTURE_2D, texture_id);
+    // Upload to texture; PBO rows are packed (cols * 3 bytes), and cropped
+    // widths need not make that a multiple of the default 4-byte alignment
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glBindTexture(GL_TEXTURE_2D, camera_textures[cam_idx]);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, processed_frame.cols, processed_frame.rows,
                  0, GL_BGR, GL_UNSIGNED_BYTE, 0);
     
     glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
 }
+
+void SVRenderSimple::setReadBackEnabled(bool enabled) {
+    if (enabled == readback_enabled) return;
+    readback_enabled = enabled;
+    readback_filled = {false, false};
+    if (!enabled || !window) return;
+    
+    int fb_width = 0, fb_height = 0;
+    glfwGetFramebufferSize(window, &fb_width, &fb_height);
+    readback_size = cv::Size(fb_width, fb_height);
+    
+    // Both buffers hold one full BGR frame; glReadPixels into a bound
+    // pack buffer returns immediately and the copy completes on the GPU
+    const size_t frame_bytes = static_cast<size_t>(readback_size.area()) * 3;
+    for (auto& pbo : readback_pbos) {
+        if (!pbo) glGenBuffers(1, &pbo);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, pbo);
+        glBufferData(GL_PIXEL_PACK_BUFFER, frame_bytes, nullptr, GL_STREAM_READ);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+}
+
+void SVRenderSimple::queueReadBack() {
+    if (!readback_enabled) return;
+    
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, readback_pbos[readback_index]);
+    glReadBuffer(GL_BACK);
+    glReadPixels(0, 0, readback_size.width, readback_size.height, GL_BGR, GL_UNSIGNED_BYTE, nullptr);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    
+    readback_filled[readback_index] = true;
+    readback_index ^= 1;
+}
+
+bool SVRenderSimple::readBackFrame(cv::Mat& bgr) {
+    // queueReadBack() flipped the index: it now names the buffer written a frame ago
+    const int idx = readback_index;
+    if (!readback_enabled || !readback_filled[idx]) return false;
+    
+    const size_t frame_bytes = static_cast<size_t>(readback_size.area()) * 3;
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, readback_pbos[idx]);
+    void* ptr = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, frame_bytes, GL_MAP_READ_BIT);
+    if (ptr) {
+        bgr.create(readback_size, CV_8UC3);
+        cv::Mat(readback_size, CV_8UC3, ptr).copyTo(bgr);
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    return ptr != nullptr;
+}
 #ifdef RENDER_PRESERVE_AS
 
     // Helper function to draw with aspect preservation
@@ -479,10 +572,38 @@ void SVRenderSimple::uploadTexture(const cv::cuda::GpuMat& frame, unsigned int t
         glBindVertexArray(0);
     }
 
+    void SVRenderSimple::drawSideViews(const std::array<cv::Rect, SIDE_COUNT>& regions,
+                                       const std::array<float, SIDE_COUNT>& aspects) {
+        for (int side = 0; side < SIDE_COUNT; side++) {
+            const std::vector<int>& cams = side_cameras[side];
+            for (size_t k = 0; k < cams.size(); k++) {
+                cv::Rect r = sideSlot(regions[side], side, static_cast<int>(k), static_cast<int>(cams.size()), false);
+                drawCameraViewWithAspect(camera_textures[cams[k]], r.x, r.y, r.width, r.height,
+                                         aspects[side]);
+            }
+        }
+    }
+
 
 
 #endif
 
+cv::Rect SVRenderSimple::sideSlot(const cv::Rect& region, int side, int k, int n, bool y_up) {
+    if (n <= 1) return region;
+    
+    if (side == SIDE_FRONT || side == SIDE_REAR) {
+        const int x0 = region.x + region.width * k / n;
+        const int x1 = region.x + region.width * (k + 1) / n;
+        return cv::Rect(x0, region.y, x1 - x0, region.height);
+    }
+    
+    // Slot 0 is the top one on screen
+    const int slot = y_up ? n - 1 - k : k;
+    const int y0 = region.y + region.height * slot / n;
+    const int y1 = region.y + region.height * (slot + 1) / n;
+    return cv::Rect(region.x, y0, region.width, y1 - y0);
+}
+
 #ifdef RENDER_NOPRESERVE_AS
     void SVRenderSimple::drawCameraView(unsigned int texture_id, int x, int y, int w, int h) {
         // Set viewport for this camera
@@ -509,6 +630,16 @@ void SVRenderSimple::uploadTexture(const cv::cuda::GpuMat& frame, unsigned int t
         glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
         glBindVertexArray(0);
     }
+
+    void SVRenderSimple::drawSideViewsStretched(const std::array<cv::Rect, SIDE_COUNT>& regions) {
+        for (int side = 0; side < SIDE_COUNT; side++) {
+            const std::vector<int>& cams = side_cameras[side];
+            for (size_t k = 0; k < cams.size(); k++) {
+                cv::Rect r = sideSlot(regions[side], side, static_cast<int>(k), static_cast<int>(cams.size()), true);
+                drawCameraView(camera_textures[cams[k]], r.x, r.y, r.width, r.height);
+            }
+        }
+    }
 #endif
 
 
@@ -679,18 +810,19 @@ void SVRenderSimple::uploadTexture(const cv::cuda::GpuMat& frame, unsigned int t
 // COMPLETE REPLACEMENT for the render() function in SVRenderSimple.cpp
 // This version draws the car FIRST, then cameras around it
 
-bool SVRenderSimple::render(const std::array<cv::cuda::GpuMat, 4>& camera_frames) {
+bool SVRenderSimple::render(const std::vector<cv::cuda::GpuMat>& camera_frames) {
     if (!is_init) return false;
     
     // Upload all camera textures and detect frame dimensions
-    for (int i = 0; i < 4; i++) {
+    const int num_frames = std::min<int>(camera_frames.size(), camera_textures.size());
+    for (int i = 0; i < num_frames; i++) {
         if (!camera_frames[i].empty()) {
             // Auto-detect frame dimensions from first frame
             if (i == 0) {
                 camera_frame_width = camera_frames[i].cols;
                 camera_frame_height = camera_frames[i].rows;
             }
-            uploadTexture(camera_frames[i], camera_textures[i]);
+            uploadTexture(camera_frames[i], i);
         }
     }
     
@@ -743,25 +875,14 @@ bool SVRenderSimple::render(const std::array<cv::cuda::GpuMat, 4>& camera_frames
         // Draw cameras FIRST (before car)
         glDisable(GL_DEPTH_TEST);
         
-        // Front camera (top center) - at the TOP
-        drawCameraViewWithAspect(camera_textures[0], 
-                                left_width, 0, 
-                                center_width, top_height, camera_aspect);
-        
-        // Left camera (full height on left)
-        drawCameraViewWithAspect(camera_textures[1], 
-                                0, 0, 
-                                left_width, screen_height, camera_aspect);
-        
-        // Right camera (full height on right)
-        drawCameraViewWithAspect(camera_textures[3], 
-                                screen_width - right_width, 0, 
-                                right_width, screen_height, camera_aspect);
+        // Front cameras at the TOP, left/right full height, rear at the BOTTOM
+        std::array<cv::Rect, SIDE_COUNT> regions;
+        regions[SIDE_FRONT] = cv::Rect(left_width, 0, center_width, top_height);
+        regions[SIDE_LEFT]  = cv::Rect(0, 0, left_width, screen_height);
+        regions[SIDE_REAR]  = cv::Rect(left_width, screen_height - bottom_height, center_width, bottom_height);
+        regions[SIDE_RIGHT] = cv::Rect(screen_width - right_width, 0, right_width, screen_height);
         
-        // Rear camera (bottom center) - at the BOTTOM
-        drawCameraViewWithAspect(camera_textures[2], 
-                                left_width, screen_height - bottom_height, 
-                                center_width, bottom_height, camera_aspect);
+        drawSideViews(regions, {camera_aspect, camera_aspect, camera_aspect, camera_aspect});
         
         // Now draw 3D car in the center (small viewport)
         if (car_model && car_shader) {
@@ -852,30 +973,20 @@ bool SVRenderSimple::render(const std::array<cv::cuda::GpuMat, 4>& camera_frames
         
         glDisable(GL_DEPTH_TEST);
         
-        // Front camera (top center)
-        drawCameraView(camera_textures[0], 
-                    side_width, screen_height * 2 / 3,
-                    center_width, row_height);
+        // Front top center, left/right middle row, rear bottom center (OpenGL coordinates)
+        std::array<cv::Rect, SIDE_COUNT> stretched_regions;
+        stretched_regions[SIDE_FRONT] = cv::Rect(side_width, screen_height * 2 / 3, center_width, row_height);
+        stretched_regions[SIDE_LEFT]  = cv::Rect(0, row_height, side_width, row_height);
+        stretched_regions[SIDE_REAR]  = cv::Rect(side_width, 0, center_width, row_height);
+        stretched_regions[SIDE_RIGHT] = cv::Rect(side_width + center_width, row_height, side_width, row_height);
         
-        // Left camera (middle left)
-        drawCameraView(camera_textures[1], 
-                    0, row_height,
-                    side_width, row_height);
-        
-        // Rear camera (bottom center)
-        drawCameraView(camera_textures[2], 
-                    side_width, 0,
-                    center_width, row_height);
-        
-        // Right camera (middle right)
-        drawCameraView(camera_textures[3], 
-                    side_width + center_width, row_height,
-                    side_width, row_height);
+        drawSideViewsStretched(stretched_regions);
     #endif
     
     // Restore full viewport
     glViewport(0, 0, screen_width, screen_height);
     
+    queueReadBack();
     glfwSwapBuffers(window);
     glfwPollEvents();
     
@@ -893,13 +1004,14 @@ bool SVRenderSimple::shouldClose() const {
     // ADD TO src/SVRenderSimple.cpp
     // ============================================================================
 
-    bool SVRenderSimple::renderSplitScreen(const std::array<cv::cuda::GpuMat, 4>& camera_frames, const cv::cuda::GpuMat& stitched_frame) {
+    bool SVRenderSimple::renderSplitScreen(const std::vector<cv::cuda::GpuMat>& camera_frames, const cv::cuda::GpuMat& stitched_frame) {
         if (!is_init) return false;
         
         // Upload camera textures (same as normal render)
-        for (int i = 0; i < 4; i++) {
+        const int num_frames = std::min<int>(camera_frames.size(), camera_textures.size());
+        for (int i = 0; i < num_frames; i++) {
             if (!camera_frames[i].empty()) {
-                uploadTexture(camera_frames[i], camera_textures[i]);
+                uploadTexture(camera_frames[i], i);
             }
         }
         
@@ -935,7 +1047,7 @@ bool SVRenderSimple::shouldClose() const {
             // Reallocate if needed
             GLint current_size = 0;
             glGetBufferParameteriv(GL_PIXEL_UNPACK_BUFFER, GL_BUFFER_SIZE, &current_size);
-            if (current_size < required_size) {
+            if (static_cast<size_t>(current_size) < required_size) {
                 glBufferData(GL_PIXEL_UNPACK_BUFFER, required_size, nullptr, GL_STREAM_DRAW);
             }
             
@@ -944,10 +1056,11 @@ bool SVRenderSimple::shouldClose() const {
             
             if (ptr) {
                 cv::Mat cpu_frame(stitched_frame.rows, stitched_frame.cols, CV_8UC3, ptr);
-                stitched_frame.download(cpu_frame);
+                svDownload(stitched_frame, cpu_frame);
                 glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
             }
             
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
             glBindTexture(GL_TEXTURE_2D, stitched_texture);
             glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, stitched_frame.cols, stitched_frame.rows,
                         0, GL_BGR, GL_UNSIGNED_BYTE, 0);
@@ -966,41 +1079,25 @@ bool SVRenderSimple::shouldClose() const {
         glDisable(GL_DEPTH_TEST);
         
         int half_width = screen_width / 2;
-        // Calculate camera aspect ratio from actual frame dimensions
-        float camera_aspect = (float)camera_frame_width / (float)camera_frame_height;
-        
         #ifdef RENDER_PRESERVE_AS
+            // Calculate camera aspect ratio from actual frame dimensions
+            float camera_aspect = (float)camera_frame_width / (float)camera_frame_height;
+            
             // ============================================
             // LEFT HALF: 4-Camera Layout (Smaller)
             // ============================================
             int left_cam_w = half_width * 0.35;
             int left_center_w = half_width * 0.30;
             int left_cam_h = screen_height * 0.35;
-            int left_center_h = screen_height * 0.30;
-            
-            // Front (top center)
-            drawCameraViewWithAspect(camera_textures[0],
-                                    left_cam_w, 0,
-                                    left_center_w, left_cam_h,
-                                    camera_aspect);
             
-            // Left (full height)
-            drawCameraViewWithAspect(camera_textures[1],
-                                    0, 0,
-                                    left_cam_w, screen_height,
-                                    camera_aspect);
+            // Front (top center), left/right (full height), rear (bottom center)
+            std::array<cv::Rect, SIDE_COUNT> regions;
+            regions[SIDE_FRONT] = cv::Rect(left_cam_w, 0, left_center_w, left_cam_h);
+            regions[SIDE_LEFT]  = cv::Rect(0, 0, left_cam_w, screen_height);
+            regions[SIDE_REAR]  = cv::Rect(left_cam_w, screen_height - left_cam_h, left_center_w, left_cam_h);
+            regions[SIDE_RIGHT] = cv::Rect(half_width - left_cam_w, 0, left_cam_w, screen_height);
             
-            // Right (full height)
-            drawCameraViewWithAspect(camera_textures[3],
-                                    half_width - left_cam_w, 0,
-                                    left_cam_w, screen_height,
-                                    camera_aspect);
-            
-            // Rear (bottom center)
-            drawCameraViewWithAspect(camera_textures[2],
-                                    left_cam_w, screen_height - left_cam_h,
-                                    left_center_w, left_cam_h,
-                                    camera_aspect);
+            drawSideViews(regions, {camera_aspect, camera_aspect, camera_aspect, camera_aspect});
             
             // Small car in center
             if (car_model && car_shader) {
@@ -1077,10 +1174,12 @@ bool SVRenderSimple::shouldClose() const {
             int center_w = half_width * 0.40;
             int row_h = screen_height / 3;
             
-            drawCameraView(camera_textures[0], side_w, screen_height * 2/3, center_w, row_h);
-            drawCameraView(camera_textures[1], 0, row_h, side_w, row_h);
-            drawCameraView(camera_textures[2], side_w, 0, center_w, row_h);
-            drawCameraView(camera_textures[3], side_w + center_w, row_h, side_w, row_h);
+            std::array<cv::Rect, SIDE_COUNT> regions;
+            regions[SIDE_FRONT] = cv::Rect(side_w, screen_height * 2/3, center_w, row_h);
+            regions[SIDE_LEFT]  = cv::Rect(0, row_h, side_w, row_h);
+            regions[SIDE_REAR]  = cv::Rect(side_w, 0, center_w, row_h);
+            regions[SIDE_RIGHT] = cv::Rect(side_w + center_w, row_h, side_w, row_h);
+            drawSideViewsStretched(regions);
             
             // Right: Stitched view
             glViewport(half_width, 0, half_width, screen_height);
@@ -1100,6 +1199,7 @@ bool SVRenderSimple::shouldClose() const {
         
         glViewport(0, 0, screen_width, screen_height);
         
+        queueReadBack();
         glfwSwapBuffers(window);
         glfwPollEvents();
         
@@ -1110,15 +1210,16 @@ bool SVRenderSimple::shouldClose() const {
     // SPLIT-VIEWPORT LAYOUT: Left half (3D car + 4 viewports) + Right half (stitched/black)
     // ============================================================================
 
-    bool SVRenderSimple::renderSplitViewportLayout(const std::array<cv::cuda::GpuMat, 4>& camera_frames,
+    bool SVRenderSimple::renderSplitViewportLayout(const std::vector<cv::cuda::GpuMat>& camera_frames,
                                                    bool show_right,
-                                                   const cv::cuda::GpuMat* stitched_frame) {
+                                                   const SVFrameBuffer* stitched_frame) {
         if (!is_init) return false;
         
         // Upload camera textures (same as normal render)
-        for (int i = 0; i < 4; i++) {
+        const int num_frames = std::min<int>(camera_frames.size(), camera_textures.size());
+        for (int i = 0; i < num_frames; i++) {
             if (!camera_frames[i].empty()) {
-                uploadTexture(camera_frames[i], camera_textures[i]);
+                uploadTexture(camera_frames[i], i);
             }
         }
         
@@ -1144,30 +1245,16 @@ bool SVRenderSimple::shouldClose() const {
             // Total height - (front height + rear height) = middle space
             int left_cam_h = screen_height - (2 * left_center_h);  // Use all remaining height
             
-            // Front (top center) - Landscape aspect 1.6:1
-            drawCameraViewWithAspect(camera_textures[0],
-                                    left_cam_w / 2, 0,
-                                    left_center_w, left_center_h,
-                                    camera_aspect);
-            
-            // Left (middle, centered vertically in remaining space) - Portrait aspect 0.625:1
+            // Front/Rear (top/bottom center) - Landscape aspect 1.6:1
+            // Left/Right (middle, between front and rear) - Portrait aspect 0.625:1
             int left_cam_y = left_center_h;  // Start after front camera
-            drawCameraViewWithAspect(camera_textures[1],
-                                    0, left_cam_y,
-                                    left_cam_w, left_cam_h,
-                                    camera_aspect_rotated);
-            
-            // Right (middle, centered vertically in remaining space) - Portrait aspect 0.625:1
-            drawCameraViewWithAspect(camera_textures[3],
-                                    half_width - left_cam_w, left_cam_y,
-                                    left_cam_w, left_cam_h,
-                                    camera_aspect_rotated);
+            std::array<cv::Rect, SIDE_COUNT> regions;
+            regions[SIDE_FRONT] = cv::Rect(left_cam_w / 2, 0, left_center_w, left_center_h);
+            regions[SIDE_LEFT]  = cv::Rect(0, left_cam_y, left_cam_w, left_cam_h);
+            regions[SIDE_REAR]  = cv::Rect(left_cam_w / 2, screen_height - left_center_h, left_center_w, left_center_h);
+            regions[SIDE_RIGHT] = cv::Rect(half_width - left_cam_w, left_cam_y, left_cam_w, left_cam_h);
             
-            // Rear (bottom center) - Landscape aspect 1.6:1
-            drawCameraViewWithAspect(camera_textures[2],
-                                    left_cam_w / 2, screen_height - left_center_h,
-                                    left_center_w, left_center_h,
-                                    camera_aspect);
+            drawSideViews(regions, {camera_aspect, camera_aspect_rotated, camera_aspect, camera_aspect_rotated});
             
             // Small car in center (between front and rear)
             if (car_model && car_shader) {
@@ -1212,21 +1299,37 @@ bool SVRenderSimple::shouldClose() const {
         #endif
         
         // ========================================================================
-        // RIGHT HALF: Black screen or stitched output
+        // RIGHT HALF: 3D bowl, stitched output or black screen
         // ========================================================================
-        if (show_right && stitched_frame && !stitched_frame->empty()) {
-            // Create temporary OpenGL texture for stitched frame
-            unsigned int stitched_texture = 0;
-            glGenTextures(1, &stitched_texture);
+        if (show_bowl && hasBowlView()) {
+            // Stitched in the fragment shader from the raw frames
+            drawBowlView(camera_frames, half_width, 0, half_width, screen_height);
+        } else if (show_right && stitched_frame && !stitched_frame->empty()) {
+            // Persistent texture: allocated on first use, then only re-specified
+            // if the stitched size changes. host() downloads only if the
+            // stitcher's backend left the frame on the device.
+            const cv::Mat& stitched_host = stitched_frame->host();
             
-            cv::Mat stitched_cpu;
-            stitched_frame->download(stitched_cpu);
+            if (stitched_texture == 0) {
+                glGenTextures(1, &stitched_texture);
+                glBindTexture(GL_TEXTURE_2D, stitched_texture);
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            }
             
+            // Rows at the Mat's own stride, which need not be 4-byte aligned
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+            glPixelStorei(GL_UNPACK_ROW_LENGTH, static_cast<GLint>(stitched_host.step / stitched_host.elemSize()));
             glBindTexture(GL_TEXTURE_2D, stitched_texture);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, stitched_cpu.cols, stitched_cpu.rows,
-                        0, GL_BGR, GL_UNSIGNED_BYTE, stitched_cpu.data);
+            if (stitched_texture_size != stitched_host.size()) {
+                glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, stitched_host.cols, stitched_host.rows,
+                            0, GL_BGR, GL_UNSIGNED_BYTE, stitched_host.data);
+                stitched_texture_size = stitched_host.size();
+            } else {
+                glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, stitched_host.cols, stitched_host.rows,
+                                GL_BGR, GL_UNSIGNED_BYTE, stitched_host.data);
+            }
+            glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
             
             // Draw stitched frame on right half
             glDisable(GL_DEPTH_TEST);
@@ -1243,8 +1346,6 @@ bool SVRenderSimple::shouldClose() const {
             glBindVertexArray(quad_VAO);
             glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
             glBindVertexArray(0);
-            
-            glDeleteTextures(1, &stitched_texture);
         }
         // else: Right half stays black (default clear color already applied)
         
@@ -1252,6 +1353,7 @@ bool SVRenderSimple::shouldClose() const {
         glViewport(0, 0, screen_width, screen_height);
         glEnable(GL_DEPTH_TEST);
         
+        queueReadBack();
         glfwSwapBuffers(window);
         glfwPollEvents();
         
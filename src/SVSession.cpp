@@ -0,0 +1,455 @@
+#include "SVSession.hpp"
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <fnmatch.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace {
+
+const char HEADER_MAGIC[8] = {'S', 'V', 'S', 'E', 'S', 'S', '0', '1'};
+const char TRAILER_MAGIC[8] = {'S', 'V', 'I', 'N', 'D', 'E', 'X', '1'};
+constexpr uint32_t RECORD_MAGIC = 0x55415653;      // "SVAU"
+constexpr size_t RECORD_HEADER_BYTES = 28;
+constexpr size_t TRAILER_BYTES = 16;
+constexpr uint16_t FLAG_KEYFRAME = 1;
+
+template <typename T>
+void put(std::vector<uint8_t>& out, T value) {
+    const size_t at = out.size();
+    out.resize(at + sizeof(T));
+    std::memcpy(out.data() + at, &value, sizeof(T));
+}
+
+void putString16(std::vector<uint8_t>& out, const std::string& s) {
+    put<uint16_t>(out, static_cast<uint16_t>(s.size()));
+    out.insert(out.end(), s.begin(), s.end());
+}
+
+// Bounds-checked reads from the mapping; any overrun clears ok
+struct Reader {
+    const uint8_t* base;
+    size_t length;
+    size_t pos;
+    bool ok = true;
+
+    template <typename T>
+    T get() {
+        T value{};
+        if (!ok || pos + sizeof(T) > length) {
+            ok = false;
+            return value;
+        }
+        std::memcpy(&value, base + pos, sizeof(T));
+        pos += sizeof(T);
+        return value;
+    }
+
+    std::string bytes(size_t n) {
+        if (!ok || pos + n > length) {
+            ok = false;
+            return std::string();
+        }
+        std::string s(reinterpret_cast<const char*>(base + pos), n);
+        pos += n;
+        return s;
+    }
+};
+
+}  // namespace
+
+// ============================================================================
+// SVSessionWriter
+// ============================================================================
+
+SVSessionWriter::~SVSessionWriter() {
+    close();
+}
+
+bool SVSessionWriter::open(const std::string& path,
+                           const std::vector<std::string>& camera_names,
+                           const std::vector<SVSessionCalibFile>& calibration,
+                           size_t max_queue_bytes_) {
+    close();
+
+    file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        std::cerr << "✗ Session: cannot create " << path << std::endl;
+        return false;
+    }
+    file_path = path;
+
+    std::vector<uint8_t> header(HEADER_MAGIC, HEADER_MAGIC + sizeof(HEADER_MAGIC));
+    put<uint32_t>(header, static_cast<uint32_t>(camera_names.size()));
+    for (const std::string& name : camera_names) {
+        putString16(header, name);
+    }
+    put<uint32_t>(header, static_cast<uint32_t>(calibration.size()));
+    for (const SVSessionCalibFile& calib : calibration) {
+        putString16(header, calib.name);
+        put<uint32_t>(header, static_cast<uint32_t>(calib.data.size()));
+        header.insert(header.end(), calib.data.begin(), calib.data.end());
+    }
+    std::fwrite(header.data(), 1, header.size(), file);
+    file_offset = header.size();
+
+    index.assign(camera_names.size(), {});
+    next_seq.assign(camera_names.size(), 0);
+    queue.clear();
+    queue_bytes = 0;
+    max_queue_bytes = max_queue_bytes_;
+    closing = false;
+    written_units = 0;
+    written_bytes = 0;
+    dropped_units = 0;
+    writer = std::thread(&SVSessionWriter::writerLoop, this);
+
+    std::cout << "✓ Session recording to " << path << " (" << camera_names.size() << " cameras, "
+              << calibration.size() << " calibration files)" << std::endl;
+    return true;
+}
+
+bool SVSessionWriter::append(int camera, const uint8_t* data, size_t size, int64_t pts_ns, bool keyframe) {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (!file || closing || camera < 0 || camera >= static_cast<int>(next_seq.size())) return false;
+
+    const uint64_t seq = next_seq[camera]++;
+    if (queue_bytes + size > max_queue_bytes) {
+        dropped_units.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    queue.push_back(Pending{camera, seq, pts_ns, keyframe, std::vector<uint8_t>(data, data + size)});
+    queue_bytes += size;
+    lock.unlock();
+
+    queued.notify_one();
+    return true;
+}
+
+void SVSessionWriter::writerLoop() {
+    std::vector<uint8_t> header;
+    header.reserve(RECORD_HEADER_BYTES);
+
+    for (;;) {
+        Pending unit;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            queued.wait(lock, [this] { return closing || !queue.empty(); });
+            if (queue.empty()) break;      // Closing and drained
+
+            unit = std::move(queue.front());
+            queue.pop_front();
+            queue_bytes -= unit.data.size();
+        }
+
+        header.clear();
+        put<uint32_t>(header, RECORD_MAGIC);
+        put<uint16_t>(header, static_cast<uint16_t>(unit.camera));
+        put<uint16_t>(header, unit.keyframe ? FLAG_KEYFRAME : 0);
+        put<uint64_t>(header, unit.seq);
+        put<int64_t>(header, unit.pts_ns);
+        put<uint32_t>(header, static_cast<uint32_t>(unit.data.size()));
+        std::fwrite(header.data(), 1, header.size(), file);
+        std::fwrite(unit.data.data(), 1, unit.data.size(), file);
+
+        const uint64_t payload = file_offset + header.size();
+        index[unit.camera].push_back(IndexEntry{unit.pts_ns, payload, unit.seq,
+                                                static_cast<uint32_t>(unit.data.size()),
+                                                unit.keyframe ? FLAG_KEYFRAME : 0u});
+        file_offset = payload + unit.data.size();
+
+        written_units.fetch_add(1, std::memory_order_relaxed);
+        written_bytes.fetch_add(unit.data.size(), std::memory_order_relaxed);
+    }
+}
+
+void SVSessionWriter::close() {
+    if (!file) return;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        closing = true;
+    }
+    queued.notify_one();
+    if (writer.joinable()) {
+        writer.join();
+    }
+
+    // Index, then the trailer that points at it
+    const uint64_t index_offset = file_offset;
+    std::vector<uint8_t> block;
+    put<uint32_t>(block, static_cast<uint32_t>(index.size()));
+    for (const std::vector<IndexEntry>& entries : index) {
+        put<uint64_t>(block, entries.size());
+        for (const IndexEntry& e : entries) {
+            put<int64_t>(block, e.pts_ns);
+            put<uint64_t>(block, e.offset);
+            put<uint64_t>(block, e.seq);
+            put<uint32_t>(block, e.size);
+            put<uint32_t>(block, e.flags);
+        }
+    }
+    put<uint64_t>(block, index_offset);
+    block.insert(block.end(), TRAILER_MAGIC, TRAILER_MAGIC + sizeof(TRAILER_MAGIC));
+    std::fwrite(block.data(), 1, block.size(), file);
+    std::fclose(file);
+    file = nullptr;
+
+    const Stats s = stats();
+    std::cout << "✓ Session " << file_path << " closed: " << s.units << " access units, "
+              << (s.bytes >> 20) << " MB, " << s.dropped << " dropped" << std::endl;
+    index.clear();
+}
+
+SVSessionWriter::Stats SVSessionWriter::stats() const {
+    Stats s;
+    s.units = written_units.load(std::memory_order_relaxed);
+    s.bytes = written_bytes.load(std::memory_order_relaxed);
+    s.dropped = dropped_units.load(std::memory_order_relaxed);
+    return s;
+}
+
+std::vector<SVSessionCalibFile> SVSessionWriter::readCalibFolder(const std::string& folder,
+                                                                 const std::vector<std::string>& patterns) {
+    std::vector<SVSessionCalibFile> files;
+
+    DIR* dir = opendir(folder.c_str());
+    if (!dir) return files;
+
+    while (dirent* entry = readdir(dir)) {
+        const std::string name = entry->d_name;
+        bool match = false;
+        for (const std::string& pattern : patterns) {
+            match |= fnmatch(pattern.c_str(), name.c_str(), 0) == 0;
+        }
+        if (!match) continue;
+
+        std::ifstream in(folder + "/" + name, std::ios::binary);
+        std::ostringstream data;
+        data << in.rdbuf();
+        files.push_back(SVSessionCalibFile{name, data.str()});
+    }
+    closedir(dir);
+
+    std::sort(files.begin(), files.end(),
+              [](const SVSessionCalibFile& a, const SVSessionCalibFile& b) { return a.name < b.name; });
+    return files;
+}
+
+// ============================================================================
+// SVSessionReader
+// ============================================================================
+
+SVSessionReader::~SVSessionReader() {
+    close();
+}
+
+bool SVSessionReader::open(const std::string& path) {
+    close();
+
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "✗ Session: cannot open " << path << std::endl;
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        ::close(fd);
+        std::cerr << "✗ Session: " << path << " is empty" << std::endl;
+        return false;
+    }
+
+    void* map = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (map == MAP_FAILED) {
+        std::cerr << "✗ Session: cannot map " << path << std::endl;
+        return false;
+    }
+    base = static_cast<const uint8_t*>(map);
+    length = static_cast<size_t>(st.st_size);
+
+    size_t records_begin = 0;
+    if (!readHeader(records_begin)) {
+        std::cerr << "✗ Session: " << path << " is not a session file" << std::endl;
+        close();
+        return false;
+    }
+
+    // Interrupted recordings have no trailer: rebuild the index from the records
+    bool indexed = false;
+    if (length >= records_begin + TRAILER_BYTES &&
+        std::memcmp(base + length - sizeof(TRAILER_MAGIC), TRAILER_MAGIC, sizeof(TRAILER_MAGIC)) == 0) {
+        uint64_t index_offset = 0;
+        std::memcpy(&index_offset, base + length - TRAILER_BYTES, sizeof(index_offset));
+        indexed = readIndex(index_offset);
+    }
+    if (!indexed) {
+        std::cout << "WARNING: Session " << path << " has no index (interrupted?), scanning records" << std::endl;
+        if (!scanRecords(records_begin)) {
+            close();
+            return false;
+        }
+    }
+
+    keyframes.assign(index.size(), {});
+    start_ns = INT64_MAX;
+    end_ns = INT64_MIN;
+    size_t total = 0;
+    for (size_t cam = 0; cam < index.size(); cam++) {
+        for (size_t k = 0; k < index[cam].size(); k++) {
+            if (index[cam][k].keyframe) keyframes[cam].push_back(k);
+        }
+        if (!index[cam].empty()) {
+            start_ns = std::min(start_ns, index[cam].front().pts_ns);
+            end_ns = std::max(end_ns, index[cam].back().pts_ns);
+        }
+        total += index[cam].size();
+    }
+    if (total == 0) {
+        start_ns = end_ns = 0;
+    }
+
+    std::cout << "✓ Session " << path << ": " << camera_names.size() << " cameras, " << total
+              << " access units, " << (end_ns - start_ns) / 1000000 << " ms" << std::endl;
+    return true;
+}
+
+void SVSessionReader::close() {
+    if (base) {
+        munmap(const_cast<uint8_t*>(base), length);
+    }
+    base = nullptr;
+    length = 0;
+    camera_names.clear();
+    calib_files.clear();
+    index.clear();
+    keyframes.clear();
+}
+
+bool SVSessionReader::readHeader(size_t& pos) {
+    if (length < sizeof(HEADER_MAGIC) || std::memcmp(base, HEADER_MAGIC, sizeof(HEADER_MAGIC)) != 0) {
+        return false;
+    }
+
+    Reader r{base, length, sizeof(HEADER_MAGIC)};
+    const uint32_t cameras = r.get<uint32_t>();
+    for (uint32_t i = 0; i < cameras && r.ok; i++) {
+        camera_names.push_back(r.bytes(r.get<uint16_t>()));
+    }
+    const uint32_t calibs = r.get<uint32_t>();
+    for (uint32_t i = 0; i < calibs && r.ok; i++) {
+        SVSessionCalibFile calib;
+        calib.name = r.bytes(r.get<uint16_t>());
+        calib.data = r.bytes(r.get<uint32_t>());
+        calib_files.push_back(std::move(calib));
+    }
+
+    index.assign(camera_names.size(), {});
+    pos = r.pos;
+    return r.ok;
+}
+
+bool SVSessionReader::readIndex(uint64_t index_offset) {
+    // Parsed aside: on any failure the index stays empty for scanRecords()
+    std::vector<std::vector<IndexEntry>> parsed(camera_names.size());
+    Reader r{base, length - TRAILER_BYTES, static_cast<size_t>(index_offset)};
+    if (r.get<uint32_t>() != camera_names.size()) return false;
+
+    for (size_t cam = 0; cam < parsed.size() && r.ok; cam++) {
+        const uint64_t count = r.get<uint64_t>();
+        if (count > length / 32) return false;
+
+        parsed[cam].resize(count);
+        for (IndexEntry& e : parsed[cam]) {
+            e.pts_ns = r.get<int64_t>();
+            e.offset = r.get<uint64_t>();
+            e.seq = r.get<uint64_t>();
+            e.size = r.get<uint32_t>();
+            e.keyframe = (r.get<uint32_t>() & FLAG_KEYFRAME) != 0;
+            if (e.offset + e.size > index_offset) r.ok = false;
+        }
+    }
+    if (!r.ok) return false;
+
+    index = std::move(parsed);
+    return true;
+}
+
+bool SVSessionReader::scanRecords(size_t pos) {
+    Reader r{base, length, pos};
+    while (r.pos + RECORD_HEADER_BYTES <= length) {
+        const size_t record = r.pos;
+        if (r.get<uint32_t>() != RECORD_MAGIC) {
+            r.pos = record;
+            break;
+        }
+        IndexEntry e;
+        const uint16_t cam = r.get<uint16_t>();
+        e.keyframe = (r.get<uint16_t>() & FLAG_KEYFRAME) != 0;
+        e.seq = r.get<uint64_t>();
+        e.pts_ns = r.get<int64_t>();
+        e.size = r.get<uint32_t>();
+        e.offset = r.pos;
+
+        // Truncated last record: stop at the last complete one
+        if (!r.ok || cam >= index.size() || e.offset + e.size > length) break;
+        index[cam].push_back(e);
+        r.pos += e.size;
+    }
+    return true;
+}
+
+bool SVSessionReader::writeCalibration(const std::string& folder) const {
+    mkdir(folder.c_str(), 0755);
+
+    bool ok = true;
+    for (const SVSessionCalibFile& calib : calib_files) {
+        // Names come from the file: none may point outside the folder
+        if (calib.name.empty() || calib.name.find_first_of("/\\") != std::string::npos ||
+            calib.name.find("..") != std::string::npos) {
+            std::cerr << "✗ Session: refusing calibration file name \"" << calib.name << "\"" << std::endl;
+            ok = false;
+            continue;
+        }
+        std::ofstream out(folder + "/" + calib.name, std::ios::binary);
+        out.write(calib.data.data(), calib.data.size());
+        ok &= static_cast<bool>(out);
+    }
+    return ok;
+}
+
+SVSessionReader::Unit SVSessionReader::unit(int camera, size_t k) const {
+    const IndexEntry& e = index[camera][k];
+    Unit u;
+    u.data = base + e.offset;
+    u.size = e.size;
+    u.pts_ns = e.pts_ns;
+    u.seq = e.seq;
+    u.keyframe = e.keyframe;
+    return u;
+}
+
+size_t SVSessionReader::findUnit(int camera, int64_t t_ns) const {
+    const auto& entries = index[camera];
+    auto it = std::upper_bound(entries.begin(), entries.end(), t_ns,
+                               [](int64_t t, const IndexEntry& e) { return t < e.pts_ns; });
+    if (it == entries.begin()) return NO_UNIT;
+    return static_cast<size_t>(it - entries.begin()) - 1;
+}
+
+size_t SVSessionReader::findKeyframe(int camera, int64_t t_ns) const {
+    const auto& keys = keyframes[camera];
+    if (keys.empty()) return NO_UNIT;
+
+    const auto& entries = index[camera];
+    auto it = std::upper_bound(keys.begin(), keys.end(), t_ns,
+                               [&](int64_t t, size_t k) { return t < entries[k].pts_ns; });
+    return it == keys.begin() ? keys.front() : *(it - 1);
+}
@@ -0,0 +1,656 @@
+#include "SVSessionManager.hpp"
+#include "SVBackendCPU.hpp"
+#include "SVIPMWarp.hpp"
+#include "SVSession.hpp"
+#include "SVSessionPlayer.hpp"
+#include "SVStitcherAuto.hpp"
+#include "SVVideoOutput.hpp"
+#include <opencv2/imgcodecs.hpp>
+#include <sys/stat.h>
+#include <algorithm>
+#include <cstdio>
+#include <exception>
+#include <iostream>
+
+namespace {
+
+std::string fileStem(const std::string& path) {
+    const size_t slash = path.find_last_of('/');
+    std::string name = slash == std::string::npos ? path : path.substr(slash + 1);
+    const size_t dot = name.find_last_of('.');
+    return dot == std::string::npos || dot == 0 ? name : name.substr(0, dot);
+}
+
+// FNV-1a, 64 bit: stable across runs, enough to tell calibrations apart
+struct Fnv1a {
+    uint64_t h = 1469598103934665603ull;
+
+    void add(const void* data, size_t size) {
+        const uint8_t* p = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < size; i++) {
+            h = (h ^ p[i]) * 1099511628211ull;
+        }
+    }
+    void add(const std::string& s) {
+        add(s.data(), s.size());
+        add(static_cast<uint64_t>(s.size()));
+    }
+    template <typename T>
+    void add(const T& v) {
+        add(&v, sizeof(v));
+    }
+};
+
+size_t matBytes(const cv::Mat& m) {
+    return m.total() * m.elemSize();
+}
+
+size_t bgrBytes(cv::Size size) {
+    return static_cast<size_t>(size.area()) * 3;
+}
+
+}  // namespace
+
+// ============================================================================
+// SVStitchAssets
+// ============================================================================
+
+void SVStitchAssets::warp(SVComputeBackend& backend, const std::vector<cv::Mat>& frames,
+                          std::vector<cv::Mat>& scaled, std::vector<SVFrameBuffer>& warped) const {
+    for (size_t i = 0; i < frames.size(); i++) {
+        const cv::Mat* src = &frames[i];
+        if (!ipm) {
+            backend.resize(*src, scaled[i], scaled_sizes[i], cv::INTER_LINEAR);
+            src = &scaled[i];
+        }
+        backend.remap(*src, backend.out(warped[i]), map_x[i], map_y[i], cv::INTER_LINEAR, cv::BORDER_CONSTANT);
+    }
+}
+
+// ============================================================================
+// Sessions and lanes
+// ============================================================================
+
+struct SVSessionManager::Session {
+    Job job;
+    SessionStats stats;
+};
+
+namespace {
+
+// One frame in flight: its own input, warp and stitch buffers and stitcher
+struct Lane {
+    std::vector<cv::Mat> frames;            // Decoded, one per camera
+    std::vector<cv::Mat> scaled;            // Homography only
+    std::vector<SVFrameBuffer> warped;
+    SVFrameBuffer stitched;
+    SVStitcherAuto stitcher;
+    std::unique_ptr<SVTaskGroup> task;
+    int64_t index = -1;                     // Frame number, -1 = idle
+    int64_t pts_ns = 0;
+    bool ok = false;
+};
+
+}  // namespace
+
+// ============================================================================
+// FairGate
+// ============================================================================
+
+void SVSessionManager::FairGate::acquire(int session) {
+    std::unique_lock<std::mutex> lock(mutex);
+    Waiter& me = sessions[session];
+    me.waiting = true;
+
+    // Granted when a slot is free and no other waiting session is further behind
+    freed.wait(lock, [&] {
+        if (total >= max_in_flight) return false;
+        for (const auto& entry : sessions) {
+            const Waiter& w = entry.second;
+            if (entry.first == session || !w.waiting) continue;
+            if (w.in_flight < me.in_flight || (w.in_flight == me.in_flight && w.last_grant < me.last_grant)) {
+                return false;
+            }
+        }
+        return true;
+    });
+
+    me.waiting = false;
+    me.in_flight++;
+    me.last_grant = ++ticks;
+    total++;
+    lock.unlock();
+
+    // Another slot may still be free for the next waiter in line
+    freed.notify_all();
+}
+
+void SVSessionManager::FairGate::release(int session) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = sessions.find(session);
+        if (it == sessions.end()) return;
+        it->second.in_flight--;
+        total--;
+        if (it->second.in_flight == 0 && !it->second.waiting) {
+            sessions.erase(it);
+        }
+    }
+    freed.notify_all();
+}
+
+int SVSessionManager::FairGate::inFlight() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return total;
+}
+
+// ============================================================================
+// SVSessionManager
+// ============================================================================
+
+SVSessionManager::SVSessionManager(const Options& options, SVThreadPool& pool_)
+    : opts(options)
+    , pool(pool_)
+    , backend(std::make_shared<SVBackendCPU>()) {
+    gate.setLimit(std::max(1, opts.max_frames_in_flight > 0 ? opts.max_frames_in_flight : 2 * pool.workerCount()));
+
+    const int num_runners = std::max(1, opts.max_sessions);
+    for (int i = 0; i < num_runners; i++) {
+        runners.emplace_back(&SVSessionManager::runnerLoop, this);
+    }
+    std::cout << "✓ Session manager: " << num_runners << " sessions at a time, " << gate.limit()
+              << " frames in flight on " << pool.workerCount() << " threads, "
+              << (opts.session_memory_cap >> 20) << " MB per session" << std::endl;
+}
+
+SVSessionManager::~SVSessionManager() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    changed.notify_all();
+    for (std::thread& t : runners) {
+        t.join();
+    }
+}
+
+int SVSessionManager::submit(const Job& job) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto session = std::make_unique<Session>();
+    session->job = job;
+    session->stats.id = static_cast<int>(all_sessions.size());
+    session->stats.path = job.session_path;
+    all_sessions.push_back(std::move(session));
+    queue.push_back(all_sessions.back()->stats.id);
+    unfinished++;
+    changed.notify_all();
+    return all_sessions.back()->stats.id;
+}
+
+int SVSessionManager::waitAll() {
+    std::unique_lock<std::mutex> lock(mutex);
+    changed.wait(lock, [this] { return unfinished == 0; });
+
+    int failed = 0;
+    for (const auto& s : all_sessions) {
+        failed += s->stats.state == State::FAILED;
+    }
+    return failed;
+}
+
+bool SVSessionManager::waitFor(std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(mutex);
+    return changed.wait_for(lock, timeout, [this] { return unfinished == 0; });
+}
+
+void SVSessionManager::runnerLoop() {
+    for (;;) {
+        Session* session = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            changed.wait(lock, [this] { return stopping || !queue.empty(); });
+            if (queue.empty()) return;
+
+            session = all_sessions[queue.front()].get();
+            queue.pop_front();
+            session->stats.state = State::RUNNING;
+            if (!started) {
+                first_start = std::chrono::steady_clock::now();
+                started = true;
+            }
+        }
+
+        bool ok = false;
+        try {
+            ok = runSession(*session);
+        } catch (const std::exception& e) {
+            std::cerr << "✗ " << session->job.session_path << ": " << e.what() << std::endl;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            session->stats.state = ok ? State::DONE : State::FAILED;
+            session->stats.lanes = 0;
+            unfinished--;
+        }
+        changed.notify_all();
+    }
+}
+
+bool SVSessionManager::runSession(Session& session) {
+    const Job& job = session.job;
+    const int id = session.stats.id;
+    const std::string tag = "[" + fileStem(job.session_path) + "] ";
+
+    SVSessionPlayer::Options player_opts;
+    player_opts.decoder = opts.decoder;
+    player_opts.realtime = false;
+    player_opts.loop = false;
+
+    SVSessionPlayer player;
+    if (!player.open(job.session_path, player_opts)) {
+        return false;
+    }
+
+    const SVCameraRig rig = SVCameraRig::fromConfig();
+    if (player.cameraCount() != rig.size()) {
+        std::cerr << "✗ " << tag << "Session has " << player.cameraCount() << " cameras, the rig " << rig.size()
+                  << " (set SV_RIG)" << std::endl;
+        return false;
+    }
+
+    std::string calib_folder = job.calib_folder;
+    if (calib_folder.empty()) {
+        // Keep the calibration next to the output: it documents what produced it
+        const size_t dot = job.output.find_last_of('.');
+        const size_t slash = job.output.find_last_of('/');
+        const bool has_ext = dot != std::string::npos && (slash == std::string::npos || dot > slash);
+        calib_folder = (has_ext && job.image_ext.empty() ? job.output.substr(0, dot) : job.output) + ".calib";
+        if (!player.session().writeCalibration(calib_folder)) {
+            return false;
+        }
+    }
+
+    // The first complete frame set sizes the maps and the stitchers
+    std::vector<cv::Mat> first;
+    int64_t first_pts = 0;
+    for (;;) {
+        if (!player.next(first, first_pts)) {
+            std::cerr << "✗ " << tag << "No frame set with every camera" << std::endl;
+            return false;
+        }
+        if (std::none_of(first.begin(), first.end(), [](const cv::Mat& m) { return m.empty(); })) break;
+    }
+
+    bool cache_hit = false;
+    const std::shared_ptr<const SVStitchAssets> assets = acquireAssets(calib_folder, rig, first, cache_hit);
+    if (!assets) {
+        std::cerr << "✗ " << tag << "Cannot set up the warp from " << calib_folder << std::endl;
+        return false;
+    }
+    const SVStitcherAuto& prepared = *assets->prepared;
+    const cv::Size canvas = prepared.getOutputSize();
+
+    // Per-lane memory: decoded, scaled and warped frames, the stitcher's
+    // per-frame buffers (accumulator and weights included) and the output
+    size_t lane_bytes = bgrBytes(canvas) + static_cast<size_t>(canvas.area()) * (12 + 4 + 1);
+    for (size_t i = 0; i < first.size(); i++) {
+        lane_bytes += matBytes(first[i]) + bgrBytes(assets->map_x[i].size()) * 2;
+        if (!assets->ipm) {
+            lane_bytes += bgrBytes(assets->scaled_sizes[i]);
+        }
+    }
+    if (lane_bytes > opts.session_memory_cap) {
+        std::cerr << "✗ " << tag << "One frame in flight needs " << (lane_bytes >> 20) << " MB, the cap is "
+                  << (opts.session_memory_cap >> 20) << " MB" << std::endl;
+        return false;
+    }
+    const int lane_limit = opts.max_lanes_per_session > 0 ? opts.max_lanes_per_session : gate.limit();
+    const int num_lanes = static_cast<int>(
+        std::max<size_t>(1, std::min<size_t>(lane_limit, opts.session_memory_cap / lane_bytes)));
+
+    std::vector<Lane> lanes(num_lanes);
+    for (Lane& lane : lanes) {
+        // Deep copies: the decoder later writes into each lane's own frames
+        lane.frames.resize(rig.size());
+        for (int i = 0; i < rig.size(); i++) {
+            first[i].copyTo(lane.frames[i]);
+        }
+        lane.scaled.resize(rig.size());
+        lane.warped.resize(rig.size());
+        lane.stitcher.setBackend(backend);
+        if (!lane.stitcher.initShared(prepared)) {
+            return false;
+        }
+        lane.task = std::make_unique<SVTaskGroup>(pool);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        session.stats.lanes = num_lanes;
+        session.stats.lane_bytes = lane_bytes;
+        session.stats.asset_key = assets->key;
+        session.stats.shared_assets = cache_hit;
+    }
+
+    // Output
+    std::unique_ptr<SVVideoOutput> video;
+    if (job.image_ext.empty()) {
+        SVVideoOutput::Options video_opts = SVVideoOutput::Options::file(job.output, canvas, opts.fps);
+        video_opts.encoder = opts.encoder;
+        video_opts.queue_depth = num_lanes;
+        video_opts.block_when_full = true;      // Offline: wait for the encoder, never drop
+        video = std::make_unique<SVVideoOutput>();
+        if (!video->start(video_opts)) {
+            return false;
+        }
+    } else {
+        mkdir(job.output.c_str(), 0755);
+    }
+
+    std::cout << tag << num_lanes << " frames in flight (" << (num_lanes * lane_bytes >> 20) << " MB), "
+              << (cache_hit ? "shared" : "new") << " calibration " << std::hex << assets->key << std::dec
+              << std::endl;
+
+    int64_t submitted = 0;
+    uint64_t written = 0;
+    uint64_t failed = 0;
+    const auto t_start = std::chrono::steady_clock::now();
+
+    // Wait for a lane's frame and hand it on; lanes are reused round-robin,
+    // so finishing them in that order writes the frames in order
+    auto finish = [&](Lane& lane) {
+        if (lane.index < 0) return;
+        try {
+            lane.task->wait();
+        } catch (const std::exception& e) {
+            std::cerr << "✗ " << tag << "Frame " << lane.index << ": " << e.what() << std::endl;
+            lane.ok = false;
+        }
+        if (!lane.ok) {
+            failed++;
+        } else if (video) {
+            video->push(lane.stitched.host(), lane.pts_ns);
+        }
+        written++;
+        lane.index = -1;
+        total_frames.fetch_add(1, std::memory_order_relaxed);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        session.stats.frames = written;
+        session.stats.failed_frames = failed;
+    };
+
+    for (;;) {
+        Lane& lane = lanes[submitted % num_lanes];
+        finish(lane);
+
+        if (job.max_frames >= 0 && submitted >= job.max_frames) break;
+        if (submitted == 0) {
+            lane.pts_ns = first_pts;        // Every lane already holds the first set
+        } else if (!player.next(lane.frames, lane.pts_ns)) {
+            break;
+        }
+
+        // Released by the task itself, so waiting sessions are served as soon as a frame is done
+        gate.acquire(id);
+        lane.index = submitted++;
+        Lane* l = &lane;
+        l->task->run([this, l, id, &job, &assets] {
+            struct Release {
+                FairGate& gate;
+                int id;
+                ~Release() { gate.release(id); }
+            } release{gate, id};
+
+            assets->warp(*backend, l->frames, l->scaled, l->warped);
+            l->ok = l->stitcher.stitch(l->warped, l->stitched);
+            if (l->ok && !job.image_ext.empty()) {
+                char name[32];
+                std::snprintf(name, sizeof(name), "/%06lld.", static_cast<long long>(l->index));
+                l->ok = cv::imwrite(job.output + name + job.image_ext, l->stitched.host());
+            }
+        });
+    }
+    for (int64_t i = std::max<int64_t>(0, submitted - num_lanes); i < submitted; i++) {
+        finish(lanes[i % num_lanes]);
+    }
+
+    if (video) {
+        video->stop();
+    }
+
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t_start).count();
+    const double recorded = (player.session().endNs() - player.session().startNs()) * 1e-9;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        session.stats.seconds = seconds;
+        session.stats.recorded_seconds = recorded;
+    }
+
+    std::cout << (failed ? "✗ " : "✓ ") << tag << written << " frames in " << seconds << " s ("
+              << static_cast<int>(written / std::max(seconds, 1e-9)) << " fps, "
+              << recorded / std::max(seconds, 1e-9) << "x real time)";
+    if (failed) {
+        std::cout << ", " << failed << " failed";
+    }
+    std::cout << std::endl;
+    return failed == 0;
+}
+
+// ============================================================================
+// Shared calibration assets
+// ============================================================================
+
+std::shared_ptr<const SVStitchAssets> SVSessionManager::acquireAssets(const std::string& calib_folder,
+                                                                      const SVCameraRig& rig,
+                                                                      const std::vector<cv::Mat>& first_frames,
+                                                                      bool& cache_hit) {
+    // Key: everything buildAssets() reads
+    Fnv1a hash;
+    for (const SVSessionCalibFile& file :
+         SVSessionWriter::readCalibFolder(calib_folder, {"Camparam*.yaml", "custom_homography_points.yaml"})) {
+        hash.add(file.name);
+        hash.add(file.data);
+    }
+    for (const cv::Mat& m : first_frames) {
+        hash.add(m.cols);
+        hash.add(m.rows);
+    }
+    hash.add(opts.warp);
+    hash.add(opts.scale);
+    hash.add(static_cast<int>(rig.layout));
+    hash.add(rig.canvas_size.width);
+    hash.add(rig.canvas_size.height);
+    hash.add(rig.fade_px);
+    for (const SVCameraInfo& cam : rig.cameras) {
+        hash.add(cam.yaw_deg);
+        hash.add(cam.canvas_origin.x);
+        hash.add(cam.canvas_origin.y);
+    }
+    const uint64_t key = hash.h;
+
+    std::shared_ptr<AssetSlot> slot;
+    {
+        std::lock_guard<std::mutex> lock(assets_mutex);
+        // Drop calibrations no session uses any more (and nobody is building)
+        for (auto it = asset_cache.begin(); it != asset_cache.end();) {
+            if (it->first != key && it->second.use_count() == 1 && it->second->assets.expired()) {
+                it = asset_cache.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        std::shared_ptr<AssetSlot>& entry = asset_cache[key];
+        if (!entry) {
+            entry = std::make_shared<AssetSlot>();
+        }
+        slot = entry;
+    }
+
+    // Sessions with the same calibration wait for the first one to build it
+    std::lock_guard<std::mutex> build(slot->build);
+    if (std::shared_ptr<const SVStitchAssets> assets = slot->assets.lock()) {
+        asset_hits++;
+        cache_hit = true;
+        return assets;
+    }
+
+    asset_misses++;
+    cache_hit = false;
+    auto assets = std::make_shared<SVStitchAssets>();
+    if (!buildAssets(calib_folder, rig, first_frames, *assets)) {
+        return nullptr;
+    }
+    assets->key = key;
+    slot->assets = assets;
+    slot->bytes = assets->bytes;
+    return assets;
+}
+
+bool SVSessionManager::buildAssets(const std::string& calib_folder, const SVCameraRig& rig,
+                                   const std::vector<cv::Mat>& first_frames, SVStitchAssets& assets) {
+    const int n = rig.size();
+    const std::string points_file = calib_folder + "/custom_homography_points.yaml";
+
+    for (const cv::Mat& m : first_frames) {
+        assets.image_sizes.push_back(m.size());
+    }
+
+    SVHomographyPoints points;
+    const bool have_points = points.load(points_file, n);
+    assets.ipm = opts.warp == "ipm" || (opts.warp.empty() && !have_points);
+    assets.rig = rig;
+    assets.map_x.resize(n);
+    assets.map_y.resize(n);
+
+    if (assets.ipm) {
+        // Same as the live WARPING_IPM path: one remap of the raw frame into the ground canvas
+        const SVIPMCanvas canvas = SVIPMCanvas::fromConfig();
+        assets.valid.resize(n);
+        assets.rig.canvas_size = canvas.size;
+        assets.rig.layout = SVStitchLayout::SECTORS;
+        for (auto& cam : assets.rig.cameras) {
+            cam.canvas_origin = cv::Point(0, 0);
+        }
+
+        for (int i = 0; i < n; i++) {
+            SVCameraCalib calib;
+            if (!calib.load(calib_folder + "/Camparam" + std::to_string(i) + ".yaml")) {
+                return false;
+            }
+            if (buildIPMMaps(calib, canvas, assets.image_sizes[i], assets.map_x[i], assets.map_y[i],
+                             &assets.valid[i]) == 0) {
+                std::cerr << "✗ Camera " << i << " does not see the ground canvas" << std::endl;
+                return false;
+            }
+        }
+        std::cout << "✓ Warp: IPM, canvas " << canvas.size << " at " << canvas.mm_per_px << " mm/px" << std::endl;
+    } else {
+        if (!have_points) {
+            std::cerr << "✗ No homography points in " << points_file << std::endl;
+            return false;
+        }
+
+        // Same as the live custom-homography path: scale, then remap with the 4-point homography
+        const float scale = opts.scale > 0.0f ? opts.scale : (points.scale_factor > 0.0f ? points.scale_factor : 0.5f);
+        assets.scaled_sizes.resize(n);
+        for (int i = 0; i < n; i++) {
+            assets.scaled_sizes[i] = cv::Size(cvRound(assets.image_sizes[i].width * scale),
+                                              cvRound(assets.image_sizes[i].height * scale));
+            buildHomographyMaps(points.homography(i, scale), assets.scaled_sizes[i], assets.map_x[i], assets.map_y[i]);
+        }
+        std::cout << "✓ Warp: homography at scale " << scale << " (" << points_file << ")" << std::endl;
+    }
+
+    // Blend masks and tile plan, from the first frame set
+    std::vector<cv::Mat> scaled(n);
+    std::vector<SVFrameBuffer> warped(n);
+    assets.warp(*backend, first_frames, scaled, warped);
+
+    assets.prepared = std::make_shared<SVStitcherAuto>();
+    assets.prepared->setRig(assets.rig);
+    assets.prepared->setBackend(backend);
+    if (assets.ipm) {
+        assets.prepared->setValidMasks(assets.valid);
+    }
+    if (!assets.prepared->init(warped)) {
+        return false;
+    }
+
+    for (int i = 0; i < n; i++) {
+        assets.bytes += matBytes(assets.map_x[i]) + matBytes(assets.map_y[i]);
+        if (assets.ipm) {
+            assets.bytes += matBytes(assets.valid[i]);
+        }
+    }
+    return true;
+}
+
+// ============================================================================
+// Metrics
+// ============================================================================
+
+SVSessionManager::Metrics SVSessionManager::metrics() const {
+    Metrics m;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const auto& s : all_sessions) {
+            switch (s->stats.state) {
+                case State::QUEUED:  m.queued++; break;
+                case State::RUNNING: m.running++; m.lane_bytes += s->stats.lanes * s->stats.lane_bytes; break;
+                case State::DONE:    m.done++; break;
+                case State::FAILED:  m.failed++; break;
+            }
+        }
+        m.frames = total_frames.load(std::memory_order_relaxed);
+        if (started) {
+            const double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - first_start).count();
+            m.fps = m.frames / std::max(s, 1e-9);
+        }
+    }
+    m.frames_in_flight = gate.inFlight();
+    {
+        std::lock_guard<std::mutex> lock(assets_mutex);
+        for (const auto& entry : asset_cache) {
+            if (!entry.second->assets.expired()) {
+                m.assets_cached++;
+                m.asset_bytes += entry.second->bytes;
+            }
+        }
+    }
+    m.asset_hits = asset_hits.load();
+    m.asset_misses = asset_misses.load();
+    return m;
+}
+
+std::vector<SVSessionManager::SessionStats> SVSessionManager::sessions() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<SessionStats> stats;
+    for (const auto& s : all_sessions) {
+        stats.push_back(s->stats);
+    }
+    return stats;
+}
+
+void SVSessionManager::printSummary() const {
+    const Metrics m = metrics();
+    std::cout << "\n=== Session Manager ===" << std::endl;
+    std::cout << "  Sessions:      " << m.done << " done, " << m.failed << " failed, " << m.running << " running, "
+              << m.queued << " queued" << std::endl;
+    std::cout << "  Frames:        " << m.frames << " (" << static_cast<int>(m.fps) << " fps overall, "
+              << m.frames_in_flight << " in flight)" << std::endl;
+    std::cout << "  Calibrations:  " << m.asset_misses << " built, " << m.asset_hits << " shared, "
+              << m.assets_cached << " in use (" << (m.asset_bytes >> 20) << " MB)" << std::endl;
+    for (const SessionStats& s : sessions()) {
+        if (s.state != State::DONE && s.state != State::FAILED) continue;
+        std::cout << "  " << (s.state == State::DONE ? "✓ " : "✗ ") << s.path << ": " << s.frames << " frames";
+        if (s.failed_frames) {
+            std::cout << " (" << s.failed_frames << " failed)";
+        }
+        if (s.seconds > 0.0) {
+            std::cout << ", " << s.recorded_seconds / s.seconds << "x real time";
+        }
+        std::cout << std::endl;
+    }
+}
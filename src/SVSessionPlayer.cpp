@@ -0,0 +1,205 @@
+#include "SVSessionPlayer.hpp"
+#include <gst/gst.h>
+#include <gst/app/gstappsink.h>
+#include <gst/app/gstappsrc.h>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+SVSessionPlayer::~SVSessionPlayer() {
+    close();
+}
+
+bool SVSessionPlayer::open(const std::string& path, const Options& options) {
+    close();
+    opts = options;
+
+    if (!reader.open(path)) return false;
+    if (reader.cameraCount() == 0 || reader.unitCount(0) == 0) {
+        std::cerr << "✗ Session " << path << " has no frames" << std::endl;
+        reader.close();
+        return false;
+    }
+
+    static std::once_flag gst_initialized;
+    std::call_once(gst_initialized, [] { gst_init(nullptr, nullptr); });
+
+    // seek() starts the decoders
+    decoders.assign(reader.cameraCount(), Decoder());
+    if (!seek(reader.startNs())) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void SVSessionPlayer::close() {
+    for (Decoder& dec : decoders) {
+        stopDecoder(dec);
+    }
+    decoders.clear();
+    reader.close();
+}
+
+bool SVSessionPlayer::startDecoder(Decoder& dec, int camera) {
+    std::ostringstream desc;
+    desc << "appsrc name=src format=time caps=video/x-h264,stream-format=byte-stream,alignment=au"
+         << " ! h264parse ! " << opts.decoder << " ! videoconvert";
+    if (!opts.output_size.empty()) {
+        desc << " ! videoscale";
+    }
+    desc << " ! video/x-raw,format=BGR";
+    if (!opts.output_size.empty()) {
+        desc << ",width=" << opts.output_size.width << ",height=" << opts.output_size.height;
+    }
+    desc << " ! appsink name=sink sync=false";
+
+    GError* error = nullptr;
+    dec.pipeline = gst_parse_launch(desc.str().c_str(), &error);
+    if (!dec.pipeline || error) {
+        std::cerr << "✗ Session decoder " << reader.cameraName(camera) << ": "
+                  << (error ? error->message : "unknown error") << std::endl;
+        if (error) g_error_free(error);
+        if (dec.pipeline) gst_object_unref(dec.pipeline);
+        dec.pipeline = nullptr;
+        return false;
+    }
+    dec.appsrc = gst_bin_get_by_name(GST_BIN(dec.pipeline), "src");
+    dec.appsink = gst_bin_get_by_name(GST_BIN(dec.pipeline), "sink");
+
+    if (gst_element_set_state(dec.pipeline, GST_STATE_PLAYING) == GST_STATE_CHANGE_FAILURE) {
+        std::cerr << "✗ Session decoder " << reader.cameraName(camera) << ": pipeline failed to start" << std::endl;
+        stopDecoder(dec);
+        return false;
+    }
+    return true;
+}
+
+void SVSessionPlayer::stopDecoder(Decoder& dec) {
+    if (dec.latest) gst_sample_unref(dec.latest);
+    dec.latest = nullptr;
+
+    if (dec.pipeline) gst_element_set_state(dec.pipeline, GST_STATE_NULL);
+    if (dec.appsrc) gst_object_unref(dec.appsrc);
+    if (dec.appsink) gst_object_unref(dec.appsink);
+    if (dec.pipeline) gst_object_unref(dec.pipeline);
+    dec.appsrc = nullptr;
+    dec.appsink = nullptr;
+    dec.pipeline = nullptr;
+}
+
+bool SVSessionPlayer::seek(int64_t t_ns) {
+    if (!reader.isOpen()) return false;
+
+    // Restart every decoder at the keyframe that opens t; next() then
+    // runs it forward to t, discarding the frames in between
+    for (int cam = 0; cam < reader.cameraCount(); cam++) {
+        Decoder& dec = decoders[cam];
+        stopDecoder(dec);
+        if (!startDecoder(dec, cam)) return false;
+
+        const size_t key = reader.findKeyframe(cam, t_ns);
+        dec.next_unit = key == SVSessionReader::NO_UNIT ? reader.unitCount(cam) : key;
+        dec.fed_pts = INT64_MIN;
+        dec.latest_pts = INT64_MIN;
+    }
+
+    const size_t first = reader.findUnit(0, t_ns);
+    master_unit = first == SVSessionReader::NO_UNIT ? 0 : first;
+
+    wall_start = std::chrono::steady_clock::now();
+    pts_start = reader.unit(0, master_unit).pts_ns;
+    return true;
+}
+
+bool SVSessionPlayer::next(std::vector<cv::Mat>& frames, int64_t& pts_ns) {
+    if (!reader.isOpen()) return false;
+
+    if (master_unit >= reader.unitCount(0)) {
+        if (!opts.loop || !seek(reader.startNs())) return false;
+    }
+
+    const int64_t t = reader.unit(0, master_unit).pts_ns;
+    master_unit++;
+
+    if (opts.realtime) {
+        std::this_thread::sleep_until(wall_start + std::chrono::nanoseconds(t - pts_start));
+    }
+
+    // Feed every camera before waiting on any: the decoders run concurrently
+    bool ok = true;
+    for (int cam = 0; cam < reader.cameraCount(); cam++) {
+        ok &= feedUntil(decoders[cam], cam, t + opts.sync_tolerance_ns);
+    }
+
+    frames.resize(reader.cameraCount());
+    for (int cam = 0; cam < reader.cameraCount(); cam++) {
+        Decoder& dec = decoders[cam];
+        collectDecoded(dec, cam);
+        if (dec.latest) {
+            ok &= copyFrame(dec.latest, frames[cam]);
+        }
+    }
+
+    pts_ns = t;
+    return ok;
+}
+
+bool SVSessionPlayer::feedUntil(Decoder& dec, int camera, int64_t t_ns) {
+    // Feed every unit captured up to t straight from the mapping
+    const size_t count = reader.unitCount(camera);
+    while (dec.next_unit < count) {
+        const SVSessionReader::Unit unit = reader.unit(camera, dec.next_unit);
+        if (unit.pts_ns > t_ns) break;
+
+        // Zero-copy: the buffer wraps the mapping, which outlives every decoder
+        GstBuffer* buffer = gst_buffer_new_wrapped_full(GST_MEMORY_FLAG_READONLY,
+            const_cast<uint8_t*>(unit.data), unit.size, 0, unit.size, nullptr, nullptr);
+        GST_BUFFER_PTS(buffer) = static_cast<GstClockTime>(unit.pts_ns - reader.startNs());
+        if (gst_app_src_push_buffer(GST_APP_SRC(dec.appsrc), buffer) != GST_FLOW_OK) {
+            return false;
+        }
+        dec.fed_pts = unit.pts_ns;
+        dec.next_unit++;
+    }
+    return true;
+}
+
+void SVSessionPlayer::collectDecoded(Decoder& dec, int camera) {
+    // One decoded frame per unit: wait until the last unit fed has come out
+    while (dec.latest_pts < dec.fed_pts) {
+        GstSample* sample = gst_app_sink_try_pull_sample(GST_APP_SINK(dec.appsink), GST_SECOND / 5);
+        if (!sample) {
+            std::cerr << "WARNING: Session decoder " << reader.cameraName(camera)
+                      << " is behind (decoder must not buffer frames)" << std::endl;
+            dec.latest_pts = dec.fed_pts;   // Keep the last frame, do not wait again for this one
+            return;
+        }
+        GstBuffer* buffer = gst_sample_get_buffer(sample);
+        dec.latest_pts = static_cast<int64_t>(GST_BUFFER_PTS(buffer)) + reader.startNs();
+        if (dec.latest) gst_sample_unref(dec.latest);
+        dec.latest = sample;
+    }
+}
+
+bool SVSessionPlayer::copyFrame(GstSample* sample, cv::Mat& frame) const {
+    GstStructure* s = gst_caps_get_structure(gst_sample_get_caps(sample), 0);
+    int width = 0, height = 0;
+    gst_structure_get_int(s, "width", &width);
+    gst_structure_get_int(s, "height", &height);
+
+    GstBuffer* buffer = gst_sample_get_buffer(sample);
+    GstMapInfo map;
+    if (width <= 0 || height <= 0 || !gst_buffer_map(buffer, &map, GST_MAP_READ)) return false;
+
+    // videoconvert pads BGR rows to 4 bytes
+    const size_t stride = (static_cast<size_t>(width) * 3 + 3) & ~static_cast<size_t>(3);
+    const bool ok = map.size >= stride * height;
+    if (ok) {
+        cv::Mat(height, width, CV_8UC3, map.data, stride).copyTo(frame);
+    }
+    gst_buffer_unmap(buffer, &map);
+    return ok;
+}
@@ -0,0 +1,248 @@
+#include "SVShmRing.hpp"
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <atomic>
+#include <cstring>
+#include <iostream>
+#include <new>
+
+namespace {
+
+const char RING_MAGIC[8] = {'S', 'V', 'S', 'H', 'M', 'R', 'G', '1'};
+constexpr uint32_t RING_VERSION = 1;
+constexpr size_t ALIGN = 64;
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "shared-memory atomics must be lock-free");
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "shared-memory atomics must be lock-free");
+
+// Layout shared by both processes: RingHeader, then slot_count x (SlotHeader + payload)
+struct alignas(ALIGN) RingHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t slot_count;
+    uint64_t slot_payload;          // Bytes of pixels per slot
+    uint64_t slot_stride;           // Bytes from one slot to the next
+    std::atomic<uint64_t> latest;   // Sequence of the newest committed frame, 0 = none
+    std::atomic<uint32_t> alive;
+    int32_t publisher_pid;
+};
+
+struct alignas(ALIGN) SlotHeader {
+    std::atomic<uint64_t> seq;      // 0 while being written, else the frame it holds
+    SVShmFrameInfo info;
+};
+
+constexpr size_t alignUp(size_t n) { return (n + ALIGN - 1) & ~(ALIGN - 1); }
+constexpr size_t SLOT_HEADER_BYTES = alignUp(sizeof(SlotHeader));
+
+std::string objectName(const std::string& name) {
+    return name.empty() || name[0] != '/' ? "/" + name : name;
+}
+
+const RingHeader* ringOf(const uint8_t* base) {
+    return reinterpret_cast<const RingHeader*>(base);
+}
+
+size_t slotOffset(const RingHeader* ring, uint64_t seq) {
+    return alignUp(sizeof(RingHeader)) + (seq % ring->slot_count) * ring->slot_stride;
+}
+
+}  // namespace
+
+// ============================================================================
+// SVShmPublisher
+// ============================================================================
+
+SVShmPublisher::~SVShmPublisher() {
+    close();
+}
+
+bool SVShmPublisher::create(const std::string& name, size_t max_frame_bytes, int slots) {
+    close();
+    if (slots < 2 || max_frame_bytes == 0) return false;
+
+    shm_name = objectName(name);
+    max_bytes = max_frame_bytes;
+
+    const size_t slot_stride = SLOT_HEADER_BYTES + alignUp(max_frame_bytes);
+    mapped_bytes = alignUp(sizeof(RingHeader)) + slots * slot_stride;
+
+    // A stale object from a crashed publisher is replaced, readers holding it keep their mapping
+    shm_unlink(shm_name.c_str());
+    const int fd = shm_open(shm_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0660);
+    if (fd < 0) {
+        std::cerr << "✗ Shared memory " << shm_name << ": cannot create" << std::endl;
+        return false;
+    }
+    if (ftruncate(fd, static_cast<off_t>(mapped_bytes)) != 0) {
+        ::close(fd);
+        shm_unlink(shm_name.c_str());
+        std::cerr << "✗ Shared memory " << shm_name << ": cannot size to " << mapped_bytes << " bytes" << std::endl;
+        return false;
+    }
+
+    void* map = mmap(nullptr, mapped_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (map == MAP_FAILED) {
+        shm_unlink(shm_name.c_str());
+        std::cerr << "✗ Shared memory " << shm_name << ": cannot map" << std::endl;
+        return false;
+    }
+    base = static_cast<uint8_t*>(map);
+
+    // ftruncate zero-fills: every slot starts out empty (seq 0)
+    RingHeader* ring = new (base) RingHeader;
+    std::memcpy(ring->magic, RING_MAGIC, sizeof(RING_MAGIC));
+    ring->version = RING_VERSION;
+    ring->slot_count = static_cast<uint32_t>(slots);
+    ring->slot_payload = max_frame_bytes;
+    ring->slot_stride = slot_stride;
+    ring->publisher_pid = static_cast<int32_t>(getpid());
+    for (int i = 0; i < slots; i++) {
+        new (base + slotOffset(ring, i)) SlotHeader;
+    }
+    ring->latest.store(0, std::memory_order_relaxed);
+    ring->alive.store(1, std::memory_order_release);
+    next_seq = 1;
+
+    std::cout << "✓ Shared memory " << shm_name << ": " << slots << " slots x "
+              << (max_frame_bytes >> 10) << " KB" << std::endl;
+    return true;
+}
+
+void SVShmPublisher::close() {
+    if (!base) return;
+
+    reinterpret_cast<RingHeader*>(base)->alive.store(0, std::memory_order_release);
+    munmap(base, mapped_bytes);
+    shm_unlink(shm_name.c_str());
+    base = nullptr;
+    mapped_bytes = 0;
+}
+
+uint8_t* SVShmPublisher::beginFrame() {
+    if (!base) return nullptr;
+
+    RingHeader* ring = reinterpret_cast<RingHeader*>(base);
+    SlotHeader* slot = reinterpret_cast<SlotHeader*>(base + slotOffset(ring, next_seq));
+
+    // Invalidate before touching the pixels: a reader that still holds this
+    // slot's previous frame sees the change in validate()
+    slot->seq.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    return reinterpret_cast<uint8_t*>(slot) + SLOT_HEADER_BYTES;
+}
+
+void SVShmPublisher::commitFrame(SVShmFrameInfo info) {
+    if (!base) return;
+
+    RingHeader* ring = reinterpret_cast<RingHeader*>(base);
+    SlotHeader* slot = reinterpret_cast<SlotHeader*>(base + slotOffset(ring, next_seq));
+
+    info.seq = next_seq;
+    slot->info = info;
+    slot->seq.store(next_seq, std::memory_order_release);
+    ring->latest.store(next_seq, std::memory_order_release);
+    next_seq++;
+}
+
+bool SVShmPublisher::publish(const uint8_t* data, size_t src_stride, SVShmFrameInfo info) {
+    const size_t bpp = info.format == SVShmFormat::GRAY8 ? 1 : 3;
+    const size_t row_bytes = static_cast<size_t>(info.width) * bpp;
+    if (!base || row_bytes * info.height > max_bytes) return false;
+
+    uint8_t* dst = beginFrame();
+    for (uint32_t y = 0; y < info.height; y++) {
+        std::memcpy(dst + y * row_bytes, data + y * src_stride, row_bytes);
+    }
+    info.stride = static_cast<uint32_t>(row_bytes);
+    commitFrame(info);
+    return true;
+}
+
+// ============================================================================
+// SVShmConsumer
+// ============================================================================
+
+SVShmConsumer::~SVShmConsumer() {
+    close();
+}
+
+bool SVShmConsumer::open(const std::string& name) {
+    close();
+
+    const std::string object = objectName(name);
+    const int fd = shm_open(object.c_str(), O_RDONLY, 0);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(RingHeader)) {
+        ::close(fd);
+        return false;
+    }
+    void* map = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (map == MAP_FAILED) return false;
+
+    base = static_cast<const uint8_t*>(map);
+    mapped_bytes = static_cast<size_t>(st.st_size);
+
+    const RingHeader* ring = ringOf(base);
+    if (std::memcmp(ring->magic, RING_MAGIC, sizeof(RING_MAGIC)) != 0 || ring->version != RING_VERSION ||
+        alignUp(sizeof(RingHeader)) + ring->slot_count * ring->slot_stride > mapped_bytes) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void SVShmConsumer::close() {
+    if (base) {
+        munmap(const_cast<uint8_t*>(base), mapped_bytes);
+    }
+    base = nullptr;
+    mapped_bytes = 0;
+}
+
+SVShmConsumer::View SVShmConsumer::latest() const {
+    View view;
+    if (!base) return view;
+
+    const RingHeader* ring = ringOf(base);
+
+    // Retry if the publisher laps us between reading latest and the slot
+    for (int attempt = 0; attempt < 4; attempt++) {
+        const uint64_t seq = ring->latest.load(std::memory_order_acquire);
+        if (seq == 0) return view;
+
+        const uint8_t* slot_base = base + slotOffset(ring, seq);
+        const SlotHeader* slot = reinterpret_cast<const SlotHeader*>(slot_base);
+        if (slot->seq.load(std::memory_order_acquire) != seq) continue;
+
+        view.info = slot->info;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot->seq.load(std::memory_order_relaxed) != seq) continue;
+
+        view.data = slot_base + SLOT_HEADER_BYTES;
+        return view;
+    }
+    return View();
+}
+
+bool SVShmConsumer::validate(const View& view) const {
+    if (!base || !view) return false;
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const SlotHeader* slot = reinterpret_cast<const SlotHeader*>(view.data - SLOT_HEADER_BYTES);
+    return slot->seq.load(std::memory_order_relaxed) == view.info.seq;
+}
+
+uint64_t SVShmConsumer::latestSeq() const {
+    return base ? ringOf(base)->latest.load(std::memory_order_acquire) : 0;
+}
+
+bool SVShmConsumer::publisherAlive() const {
+    return base && ringOf(base)->alive.load(std::memory_order_acquire) != 0;
+}
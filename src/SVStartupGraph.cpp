@@ -0,0 +1,156 @@
+#include "SVStartupGraph.hpp"
+#include <condition_variable>
+#include <cstdio>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+void SVStartupGraph::add(const std::string& name, const std::vector<std::string>& deps, Task task,
+                         Affinity affinity) {
+    Node node;
+    node.name = name;
+    node.dep_names = deps;
+    node.task = std::move(task);
+    node.affinity = affinity;
+    nodes.push_back(std::move(node));
+}
+
+bool SVStartupGraph::run() {
+    using clock = std::chrono::steady_clock;
+    const auto start = clock::now();
+    auto since_start = [&] {
+        return std::chrono::duration<double, std::milli>(clock::now() - start).count();
+    };
+
+    // Resolve dependency names
+    for (Node& node : nodes) {
+        node.deps.clear();
+        node.state = State::PENDING;
+        for (const std::string& dep : node.dep_names) {
+            int found = -1;
+            for (size_t k = 0; k < nodes.size(); k++) {
+                if (nodes[k].name == dep) found = static_cast<int>(k);
+            }
+            if (found < 0) {
+                std::cerr << "✗ Startup task '" << node.name << "' depends on unknown task '"
+                          << dep << "'" << std::endl;
+                return false;
+            }
+            node.deps.push_back(found);
+        }
+    }
+
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::vector<std::thread> threads;
+    int running = 0;
+    int finished = 0;
+
+    auto execute = [&](Node& node) {
+        const double t0 = since_start();
+        bool ok = false;
+        try {
+            ok = node.task();
+        } catch (const std::exception& e) {
+            std::cerr << "✗ Startup task '" << node.name << "' threw: " << e.what() << std::endl;
+        }
+        const double t1 = since_start();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        node.start_ms = t0;
+        node.duration_ms = t1 - t0;
+        node.state = ok ? State::DONE : State::FAILED;
+        running--;
+        finished++;
+        changed.notify_all();
+    };
+
+    std::unique_lock<std::mutex> lock(mutex);
+    while (finished < static_cast<int>(nodes.size())) {
+        Node* main_task = nullptr;
+        bool progressed = false;
+
+        for (Node& node : nodes) {
+            if (node.state != State::PENDING) continue;
+
+            bool ready = true;
+            bool blocked = false;
+            for (int dep : node.deps) {
+                const State s = nodes[dep].state;
+                if (s == State::FAILED || s == State::SKIPPED) blocked = true;
+                if (s != State::DONE) ready = false;
+            }
+
+            if (blocked) {
+                node.state = State::SKIPPED;
+                node.start_ms = since_start();
+                finished++;
+                progressed = true;
+            } else if (ready && node.affinity == Affinity::WORKER) {
+                node.state = State::RUNNING;
+                running++;
+                threads.emplace_back(execute, std::ref(node));
+                progressed = true;
+            } else if (ready && !main_task) {
+                main_task = &node;
+            }
+        }
+
+        if (main_task) {
+            main_task->state = State::RUNNING;
+            running++;
+            lock.unlock();
+            execute(*main_task);
+            lock.lock();
+            continue;
+        }
+
+        if (progressed) continue;
+
+        if (running == 0) {
+            // Nothing runs and nothing can start: the remaining tasks wait on each other
+            for (Node& node : nodes) {
+                if (node.state == State::PENDING) {
+                    std::cerr << "✗ Startup task '" << node.name << "' is part of a dependency cycle" << std::endl;
+                    node.state = State::SKIPPED;
+                    finished++;
+                }
+            }
+            continue;
+        }
+
+        changed.wait(lock);
+    }
+    lock.unlock();
+
+    for (std::thread& t : threads) {
+        t.join();
+    }
+
+    elapsed_ms = since_start();
+
+    bool all_ok = true;
+    for (const Node& node : nodes) {
+        all_ok &= node.state == State::DONE;
+    }
+    return all_ok;
+}
+
+void SVStartupGraph::report() const {
+    double serial_ms = 0.0;
+
+    std::cout << "\nStartup timeline (ms):" << std::endl;
+    for (const Node& node : nodes) {
+        const char* result = node.state == State::DONE ? "✓" :
+                             node.state == State::FAILED ? "✗ failed" : "✗ skipped";
+        char line[160];
+        std::snprintf(line, sizeof(line), "  %-16s %-6s start %7.1f  took %7.1f  %s",
+                      node.name.c_str(), node.affinity == Affinity::MAIN ? "main" : "worker",
+                      node.start_ms, node.duration_ms, result);
+        std::cout << line << std::endl;
+        serial_ms += node.duration_ms;
+    }
+
+    std::cout << "  Total " << static_cast<int>(elapsed_ms) << " ms (sequential would be ~"
+              << static_cast<int>(serial_ms) << " ms)" << std::endl;
+}
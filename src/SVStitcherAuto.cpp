@@ -1,39 +1,79 @@
 #include "SVStitcherAuto.hpp"
-#include <opencv2/cudawarping.hpp>
-#include <opencv2/cudaimgproc.hpp>
-#include <opencv2/cudaarithm.hpp>
+#include "SVThreadPool.hpp"
 #include <opencv2/imgproc.hpp>
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <numeric>
+
+namespace {
+
+// Wrap an angle in degrees to (-180, 180]
+float wrapDegrees(float deg) {
+    deg = std::fmod(deg, 360.0f);
+    if (deg > 180.0f) deg -= 360.0f;
+    if (deg <= -180.0f) deg += 360.0f;
+    return deg;
+}
+
+// Signed distance of a point at radius r, angle d (degrees) past a seam ray
+// Past 90° the point is behind the seam origin and counts as a full radius away
+float seamDistance(float r, float d) {
+    if (d >= 90.0f) return r;
+    if (d <= -90.0f) return -r;
+    return r * std::sin(d * static_cast<float>(CV_PI) / 180.0f);
+}
+
+} // namespace
 
 SVStitcherAuto::SVStitcherAuto() 
-    : is_init(false)
-    , num_cameras(NUM_CAMERAS)
+    : rig(SVCameraRig::defaultRig())
+    , use_gain_compensation(false)  // Set to false to disable gain compensation
+    , use_tiles(false)
+    , acc_handle(SVFramePool::INVALID_HANDLE)
+    , weight_handle(SVFramePool::INVALID_HANDLE)
+    , output_mask_handle(SVFramePool::INVALID_HANDLE)
+    , is_init(false)
+    , num_cameras(rig.size())
     , scale_factor(PROCESS_SCALE)
-    , frame_count(0)
-    , use_gain_compensation(false) {  // Set to false to disable gain compensation
+    , frame_count(0) {
 }
 
 SVStitcherAuto::~SVStitcherAuto() {
 }
 
-bool SVStitcherAuto::init(const std::vector<cv::cuda::GpuMat>& sample_frames,const std::vector<cv::cuda::GpuMat>& warp_x_maps,const std::vector<cv::cuda::GpuMat>& warp_y_maps,float scale) {
+void SVStitcherAuto::setRig(const SVCameraRig& rig_) {
+    if (is_init) {
+        std::cerr << "WARNING: Camera rig must be set before stitcher init, ignoring" << std::endl;
+        return;
+    }
+    rig = rig_;
+    num_cameras = rig.size();
+}
+
+bool SVStitcherAuto::init(const std::vector<SVFrameBuffer>& sample_frames) {
     if (is_init) {
         std::cerr << "Stitcher already initialized" << std::endl;
         return false;
     }
     
-    if (sample_frames.size() != num_cameras) {
+    if (static_cast<int>(sample_frames.size()) != num_cameras) {
         std::cerr << "Wrong number of frames: " << sample_frames.size() << std::endl;
         return false;
     }
     
-    scale_factor = scale;
-    
     std::cout << "\n========================================" << std::endl;
     std::cout << "SIMPLE ALPHA BLENDING STITCHER" << std::endl;
     std::cout << "========================================" << std::endl;
+    
+    if (!backend) {
+        backend = createComputeBackend(configuredBackendType());
+    }
+    
     std::cout << "Mode: Fast alpha blending with linear interpolation" << std::endl;
+    std::cout << "Backend: " << backend->name() << std::endl;
     std::cout << "Gain compensation: " << (use_gain_compensation ? "ENABLED" : "DISABLED") << std::endl;
+    std::cout << "Cameras: " << num_cameras << " (" << stitchLayoutName(rig.layout) << " layout)" << std::endl;
     std::cout << "========================================" << std::endl;
     
     // ============================================
@@ -43,11 +83,13 @@ bool SVStitcherAuto::init(const std::vector<cv::cuda::GpuMat>& sample_frames,con
     
     warp_corners.resize(num_cameras);
     warp_sizes.resize(num_cameras);
+    warp_types.resize(num_cameras);
     
     for (int i = 0; i < num_cameras; i++) {
         // sample_frames are already scaled and warped from SVAppSimple
-        // Note: sample_frames[i] are already at scale_factor (0.65) and warped
+        // Note: sample_frames[i] are already at scale_factor (0.5) and warped
         warp_sizes[i] = sample_frames[i].size();
+        warp_types[i] = sample_frames[i].type();
         
         std::cout << "  Camera " << i << ": size=" << warp_sizes[i] << std::endl;
     }
@@ -58,16 +100,13 @@ bool SVStitcherAuto::init(const std::vector<cv::cuda::GpuMat>& sample_frames,con
     std::cout << "\n[2/3] Computing output canvas and positions..." << std::endl;
     
     // Output size: Rotated surround view with cameras at canvas corners
-    // Canvas: 640×800 with each camera 640×400, rotated and positioned at corners
-    int canvas_w = 640;
-    int canvas_h = 800;
-    output_roi = cv::Rect(0, 0, canvas_w, canvas_h);
+    // Canvas: 640×800 with each camera 640×400 for the default rig
+    output_roi = computeStitchROI();
     output_size = output_roi.size();
     
-    std::cout << "  Output stitched view size: " << output_size << " (ROTATED CORNER LAYOUT)" << std::endl;
+    std::cout << "  Output stitched view size: " << output_size << std::endl;
     
-    // Rotated corner layout (640×800) - each camera 640×400
-    // Canvas corners with camera 0,0 placement:
+    // Default rig - rotated corner layout (640×800), each camera 640×400:
     //
     //  TL (0,0)              TR (640,0)
     //     ↓                      ↑
@@ -81,30 +120,14 @@ bool SVStitcherAuto::init(const std::vector<cv::cuda::GpuMat>& sample_frames,con
     //     ↓                  ↑
     //  BL (0,800)          BR (640,800)
     //
-    // Blending occurs along 4 diagonal lines through corners:
-    // - TL diagonal: top-left to center
-    // - TR diagonal: top-right to center
-    // - BL diagonal: bottom-left to center
-    // - BR diagonal: bottom-right to center
-    
-    // Camera 0 (Front): Top half, (0,0) anchor
-    warp_corners[0] = cv::Point(0, 0);
-    
-    // Camera 1 (Left): Bottom-left, rotated 90°, (0,720) anchor
-    warp_corners[1] = cv::Point(0, 720);
-    
-    // Camera 2 (Rear): Bottom, rotated 180°, (640,800) anchor
-    warp_corners[2] = cv::Point(640, 800);
-    
-    // Camera 3 (Right): Top-right, rotated 90°, (640,80) anchor
-    warp_corners[3] = cv::Point(640, 80);
-    
+    // Other rigs place each camera at its canvas_origin from the rig file
     for (int i = 0; i < num_cameras; i++) {
-        std::cout << "  Camera " << i << ": position=" << warp_corners[i] << " (corner anchor)" << std::endl;
+        warp_corners[i] = rig.camera(i).canvas_origin;
+        std::cout << "  Camera " << i << " (" << rig.camera(i).name << "): position="
+                  << warp_corners[i] << " yaw=" << rig.camera(i).yaw_deg << "°" << std::endl;
     }
     
-    std::cout << "  Canvas: 640x800 with rotated cameras at corners" << std::endl;
-    std::cout << "  Blend zones: 40px perpendicular to diagonal lines" << std::endl;
+    std::cout << "  Blend zones: " << rig.fade_px << "px around the seams" << std::endl;
     
     // ============================================
     // STEP 3: Create simple alpha masks
@@ -116,35 +139,35 @@ bool SVStitcherAuto::init(const std::vector<cv::cuda::GpuMat>& sample_frames,con
     }
     
     // ============================================
-    // STEP 4: Initialize simple blender
+    // STEP 4: Optional gain compensation
     // ============================================
-    blender = std::make_shared<SVBlender>();
-    // Initialize blender with the computed output ROI
-    blender->prepare(output_roi);
-    
-    std::cout << "  ✓ Simple alpha blender initialized" << std::endl;
+    if (use_gain_compensation) {
+        gain_comp = std::make_shared<SVGainCompensator>(num_cameras);
+        computeGains(sample_frames);
+        std::cout << "  ✓ Gain compensator initialized" << std::endl;
+    }
     
     // ============================================
-    // STEP 5: Optional gain compensation
+    // STEP 5: Tile plan (CPU backend)
     // ============================================
-    if (use_gain_compensation) {
-        gain_comp = std::make_shared<SVGainCompensator>(num_cameras);
-        
-        // Warp sample frames for gain initialization
-        std::vector<cv::cuda::GpuMat> warped_samples(num_cameras);
+    use_tiles = (STITCH_TILE_SIZE > 0 && backend->type() == SVBackendType::CPU);
+    if (use_tiles) {
+        std::vector<cv::Mat> host_masks(num_cameras);
         for (int i = 0; i < num_cameras; i++) {
-            cv::cuda::GpuMat scaled;
-            cv::cuda::resize(sample_frames[i], scaled, cv::Size(),
-                            scale_factor, scale_factor, cv::INTER_LINEAR);
-            cv::cuda::remap(scaled, warped_samples[i],
-                           warp_x_maps[i], warp_y_maps[i],
-                           cv::INTER_LINEAR, cv::BORDER_CONSTANT);
+            host_masks[i] = blend_masks[i].host();
         }
-        
-        gain_comp->init(warped_samples, warp_corners, blend_masks);
-        std::cout << "  ✓ Gain compensator initialized" << std::endl;
+        tiler.prepare(host_masks, warp_corners, output_size, STITCH_TILE_SIZE);
+        tile_inputs.assign(num_cameras, nullptr);
+        std::cout << "  ✓ Tile-parallel stitch enabled" << std::endl;
+        tiler.printSummary();
     }
     
+    // ============================================
+    // STEP 6: Reserve per-frame buffers
+    // ============================================
+    reserveBuffers();
+    std::cout << "  ✓ Per-frame buffers reserved" << std::endl;
+    
     std::cout << "\n========================================" << std::endl;
     std::cout << "✓ STITCHER READY!" << std::endl;
     std::cout << "========================================\n" << std::endl;
@@ -153,12 +176,101 @@ bool SVStitcherAuto::init(const std::vector<cv::cuda::GpuMat>& sample_frames,con
     return true;
 }
 
-bool SVStitcherAuto::createOverlapMasks(const std::vector<cv::cuda::GpuMat>& sample_frames) {
+bool SVStitcherAuto::initShared(const SVStitcherAuto& prepared) {
+    if (is_init || !prepared.is_init) {
+        std::cerr << "Stitcher already initialized or source not ready" << std::endl;
+        return false;
+    }
+    
+    // Read-only after init: cv::Mat copies share the pixels
+    rig = prepared.rig;
+    num_cameras = prepared.num_cameras;
+    backend = backend ? backend : prepared.backend;
+    use_gain_compensation = false;
+    blend_masks = prepared.blend_masks;
+    tiler = prepared.tiler;
+    use_tiles = prepared.use_tiles && backend->type() == SVBackendType::CPU;
+    tile_inputs.assign(num_cameras, nullptr);
+    warp_corners = prepared.warp_corners;
+    warp_sizes = prepared.warp_sizes;
+    warp_types = prepared.warp_types;
+    output_roi = prepared.output_roi;
+    output_size = prepared.output_size;
+    
+    reserveBuffers();
+    is_init = true;
+    return true;
+}
+
+bool SVStitcherAuto::createOverlapMasks(const std::vector<SVFrameBuffer>& sample_frames) {
     blend_masks.resize(num_cameras);
     
+    // Precomputed weights replace the layout entirely
+    if (!preset_masks.empty()) {
+        if (static_cast<int>(preset_masks.size()) != num_cameras) {
+            std::cerr << "Wrong number of blend masks: " << preset_masks.size() << std::endl;
+            return false;
+        }
+        for (int i = 0; i < num_cameras; i++) {
+            if (preset_masks[i].size() != sample_frames[i].size() || preset_masks[i].type() != CV_8U) {
+                std::cerr << "Blend mask " << i << " must be CV_8U " << sample_frames[i].size() << std::endl;
+                return false;
+            }
+            blend_masks[i].create(preset_masks[i].size(), CV_8U);
+            preset_masks[i].copyTo(blend_masks[i].writeHost());
+        }
+        std::cout << "  ✓ Precomputed blend masks" << std::endl;
+        return true;
+    }
+    
+    bool ok = (rig.layout == SVStitchLayout::DIAGONAL_X && num_cameras == 4)
+            ? createDiagonalMasks()
+            : createSectorMasks(sample_frames);
+    if (!ok || valid_masks.empty()) {
+        return ok;
+    }
+    
+    // Cameras only contribute where they see the canvas
+    if (static_cast<int>(valid_masks.size()) != num_cameras) {
+        std::cerr << "Wrong number of valid masks: " << valid_masks.size() << std::endl;
+        return false;
+    }
+    for (int i = 0; i < num_cameras; i++) {
+        if (valid_masks[i].size() != blend_masks[i].size()) {
+            std::cerr << "Valid mask " << i << " size " << valid_masks[i].size()
+                      << " doesn't match blend mask " << blend_masks[i].size() << std::endl;
+            return false;
+        }
+        blend_masks[i].modifyHost().setTo(0, valid_masks[i] == 0);
+    }
+    
+    // A sector whose owner cannot see a pixel goes to whichever cameras can
+    const cv::Rect canvas_rect(cv::Point(), output_size);
+    cv::Mat total = cv::Mat::zeros(output_size, CV_32F);
+    for (int i = 0; i < num_cameras; i++) {
+        cv::Rect dst = cv::Rect(warp_corners[i], blend_masks[i].size()) & canvas_rect;
+        if (dst.empty()) continue;
+        cv::Mat w;
+        blend_masks[i].host()(dst - warp_corners[i]).convertTo(w, CV_32F);
+        cv::Mat total_roi = total(dst);
+        total_roi += w;
+    }
+    for (int i = 0; i < num_cameras; i++) {
+        cv::Rect dst = cv::Rect(warp_corners[i], blend_masks[i].size()) & canvas_rect;
+        if (dst.empty()) continue;
+        cv::Rect src = dst - warp_corners[i];
+        cv::Mat holes = (total(dst) == 0) & valid_masks[i](src);
+        cv::Mat mask_roi = blend_masks[i].modifyHost()(src);
+        mask_roi.setTo(255, holes);
+    }
+    std::cout << "  ✓ Blend masks limited to camera coverage" << std::endl;
+    return true;
+}
+
+bool SVStitcherAuto::createDiagonalMasks() {
     std::cout << "Creating ROTATED CORNER blend masks with diagonal corner blending..." << std::endl;
     
-    int fade_dist = 40;  // Perpendicular distance from diagonal lines for fade zone
+    const int fade_dist = rig.fade_px;  // Perpendicular distance from diagonal lines for fade zone
     
     // All cameras are 640×400 (full width, half height)
     std::vector<cv::Size> target_sizes = {
@@ -184,7 +296,8 @@ bool SVStitcherAuto::createOverlapMasks(const std::vector<cv::cuda::GpuMat>& sam
     
     for (int i = 0; i < num_cameras; i++) {
         cv::Size target = target_sizes[i];
-        cv::Mat mask(target.height, target.width, CV_8U);
+        blend_masks[i].create(target, CV_8U);
+        cv::Mat& mask = blend_masks[i].writeHost();
         
         int w = target.width;   // 640
         int h = target.height;  // 400
@@ -192,41 +305,42 @@ bool SVStitcherAuto::createOverlapMasks(const std::vector<cv::cuda::GpuMat>& sam
         // Canvas position of this camera's origin
         cv::Point cam_origin = warp_corners[i];
         
-        // Create diagonal blend mask
-        for (int y = 0; y < h; y++) {
-            for (int x = 0; x < w; x++) {
-                // Convert camera-local coordinates to canvas coordinates
-                float canvas_x = x + cam_origin.x;
-                float canvas_y = y + cam_origin.y;
+        // Create diagonal blend mask (rows in parallel on the shared pool)
+        SVThreadPool::instance().parallelForRange(0, h, [&](int y0, int y1) {
+            for (int y = y0; y < y1; y++) {
+                uchar* mask_row = mask.ptr<uchar>(y);
+                for (int x = 0; x < w; x++) {
+                    // Convert camera-local coordinates to canvas coordinates
+                    float canvas_x = x + cam_origin.x;
+                    float canvas_y = y + cam_origin.y;
                 
-                // Calculate distance to both diagonal lines
-                // Line 1: y = 1.25x → distance = |y - 1.25x| / sqrt(1.25^2 + 1)
-                float dist_to_line1 = std::abs(canvas_y - diag_slope * canvas_x) / diag_normalizer;
+                    // Calculate distance to both diagonal lines
+                    // Line 1: y = 1.25x → distance = |y - 1.25x| / sqrt(1.25^2 + 1)
+                    float dist_to_line1 = std::abs(canvas_y - diag_slope * canvas_x) / diag_normalizer;
                 
-                // Line 2: y = -1.25x + 800 → distance = |y + 1.25x - 800| / sqrt(1.25^2 + 1)
-                float dist_to_line2 = std::abs(canvas_y + diag_slope * canvas_x - 800.0f) / diag_normalizer;
+                    // Line 2: y = -1.25x + 800 → distance = |y + 1.25x - 800| / sqrt(1.25^2 + 1)
+                    float dist_to_line2 = std::abs(canvas_y + diag_slope * canvas_x - 800.0f) / diag_normalizer;
                 
-                // Take minimum distance to either diagonal
-                float min_dist = std::min(dist_to_line1, dist_to_line2);
+                    // Take minimum distance to either diagonal
+                    float min_dist = std::min(dist_to_line1, dist_to_line2);
                 
-                // Calculate alpha based on distance to diagonals
-                float alpha;
-                if (min_dist < fade_dist) {
-                    // Linear fade within blend zone
-                    alpha = min_dist / fade_dist;
-                } else {
-                    // Full opacity outside blend zone
-                    alpha = 1.0f;
-                }
+                    // Calculate alpha based on distance to diagonals
+                    float alpha;
+                    if (min_dist < fade_dist) {
+                        // Linear fade within blend zone
+                        alpha = min_dist / fade_dist;
+                    } else {
+                        // Full opacity outside blend zone
+                        alpha = 1.0f;
+                    }
                 
-                // Smooth transition with ease-in-out curve: 3t^2 - 2t^3
-                alpha = alpha * alpha * (3.0f - 2.0f * alpha);
+                    // Smooth transition with ease-in-out curve: 3t^2 - 2t^3
+                    alpha = alpha * alpha * (3.0f - 2.0f * alpha);
                 
-                mask.at<uchar>(y, x) = (uchar)(255 * alpha);
+                    mask_row[x] = (uchar)(255 * alpha);
+                }
             }
-        }
-        
-        blend_masks[i].upload(mask);
+        }, 16);
         
         // Store the target size for later resizing
         warp_sizes[i] = target;
@@ -244,23 +358,118 @@ bool SVStitcherAuto::createOverlapMasks(const std::vector<cv::cuda::GpuMat>& sam
     return true;
 }
 
-cv::Rect SVStitcherAuto::computeStitchROI(const std::vector<cv::Point>& corners,
-                                          const std::vector<cv::Size>& sizes) {
-    // Fixed output size: 640×800 diagonal X-pattern surround view
+bool SVStitcherAuto::createSectorMasks(const std::vector<SVFrameBuffer>& sample_frames) {
+    std::cout << "Creating SECTOR blend masks for " << num_cameras << " cameras..." << std::endl;
+    
+    const float fade_dist = static_cast<float>(std::max(rig.fade_px, 1));
+    const cv::Point2f center(output_size.width * 0.5f, output_size.height * 0.5f);
+    
+    // Cameras in yaw order; each sector spans the bisectors to its two neighbours
+    std::vector<int> order(num_cameras);
+    std::iota(order.begin(), order.end(), 0);
+    auto yaw = [&](int i) {
+        float y = std::fmod(rig.camera(i).yaw_deg, 360.0f);
+        return y < 0.0f ? y + 360.0f : y;
+    };
+    std::sort(order.begin(), order.end(), [&](int a, int b) { return yaw(a) < yaw(b); });
+    
+    for (int k = 0; k < num_cameras; k++) {
+        const int i = order[k];
+        const float own = yaw(i);
+        const float prev = yaw(order[(k + num_cameras - 1) % num_cameras]);
+        const float next = yaw(order[(k + 1) % num_cameras]);
+        
+        // Gaps to the neighbours, going counter-clockwise (a single camera owns all 360°)
+        const float gap_lo = num_cameras > 1 ? std::fmod(own - prev + 360.0f, 360.0f) : 360.0f;
+        const float gap_hi = num_cameras > 1 ? std::fmod(next - own + 360.0f, 360.0f) : 360.0f;
+        const float seam_lo = own - gap_lo * 0.5f;
+        const float seam_hi = own + gap_hi * 0.5f;
+        
+        const cv::Size target = sample_frames[i].size();
+        blend_masks[i].create(target, CV_8U);
+        cv::Mat& mask = blend_masks[i].writeHost();
+        const cv::Point origin = warp_corners[i];
+        
+        SVThreadPool::instance().parallelForRange(0, target.height, [&](int y0, int y1) {
+            for (int y = y0; y < y1; y++) {
+                uchar* mask_row = mask.ptr<uchar>(y);
+                for (int x = 0; x < target.width; x++) {
+                    if (num_cameras == 1) {
+                        mask_row[x] = 255;
+                        continue;
+                    }
+                    
+                    // Direction from the vehicle centre: 0° = front (up), 90° = left
+                    const float dx = x + origin.x - center.x;
+                    const float dy = y + origin.y - center.y;
+                    const float r = std::sqrt(dx * dx + dy * dy);
+                    const float phi = std::atan2(-dx, -dy) * 180.0f / static_cast<float>(CV_PI);
+                    
+                    // Distance inside the sector: positive past both seams
+                    const float t = std::min(seamDistance(r, wrapDegrees(phi - seam_lo)),
+                                             seamDistance(r, wrapDegrees(seam_hi - phi)));
+                    
+                    // 0.5 on the seam, full weight fade_dist/2 inside, same ease-in-out as the diagonals
+                    float alpha = std::min(std::max(0.5f + t / fade_dist, 0.0f), 1.0f);
+                    alpha = alpha * alpha * (3.0f - 2.0f * alpha);
+                    
+                    mask_row[x] = (uchar)(255 * alpha);
+                }
+            }
+        }, 16);
+        
+        warp_sizes[i] = target;
+        
+        std::cout << "  Camera " << i << " (" << rig.camera(i).name << "): sector "
+                  << wrapDegrees(seam_lo) << "° → " << wrapDegrees(seam_hi) << "°, mask " << target
+                  << " at origin " << origin << std::endl;
+    }
+    
+    return true;
+}
+
+void SVStitcherAuto::reserveBuffers() {
+    if (!frame_pool) {
+        frame_pool = std::make_shared<SVFramePool>();
+    }
+    
+    // Every per-frame buffer lives where the backend works on it
+    const SVResidency where = backend->residency();
+    
+    resized_handles.resize(num_cameras);
+    gained_handles.assign(num_cameras, SVFramePool::INVALID_HANDLE);
+    
+    // resize() and applyGain() keep the input type, so reserve what the warp stage delivers
+    for (int i = 0; i < num_cameras; i++) {
+        const std::string cam = "stitch cam" + std::to_string(i);
+        resized_handles[i] = frame_pool->reserveBuffer(blend_masks[i].size(), warp_types[i], where, cam + " resized");
+        if (use_gain_compensation) {
+            gained_handles[i] = frame_pool->reserveBuffer(blend_masks[i].size(), warp_types[i], where, cam + " gained");
+        }
+    }
+    
+    // The tiled path blends straight into the output
+    if (!use_tiles) {
+        acc_handle = frame_pool->reserveBuffer(output_size, CV_32FC3, where, "stitch accumulator");
+        weight_handle = frame_pool->reserveBuffer(output_size, CV_32F, where, "stitch weight");
+        output_mask_handle = frame_pool->reserveBuffer(output_size, CV_8U, where, "stitch output mask");
+    }
+}
+
+cv::Rect SVStitcherAuto::computeStitchROI() {
+    // Fixed output size from the rig: 640×800 for the diagonal X-pattern surround view
     // This is scaled to fit in the right 50% of the split-screen display
     
-    return cv::Rect(0, 0, 640, 800);
+    return cv::Rect(cv::Point(0, 0), rig.canvas_size);
 }
 
-bool SVStitcherAuto::stitch(const std::vector<cv::cuda::GpuMat>& raw_frames,
-                            const std::vector<cv::cuda::GpuMat>& warped_frames,
-                            cv::cuda::GpuMat& output) {
+bool SVStitcherAuto::stitch(const std::vector<SVFrameBuffer>& warped_frames, SVFrameBuffer& output) {
     if (!is_init) {
         std::cerr << "Stitcher not initialized" << std::endl;
         return false;
     }
     
-    if (warped_frames.size() != num_cameras) {
+    if (static_cast<int>(warped_frames.size()) != num_cameras) {
         std::cerr << "Wrong number of frames" << std::endl;
         return false;
     }
@@ -277,75 +486,67 @@ bool SVStitcherAuto::stitch(const std::vector<cv::cuda::GpuMat>& raw_frames,
     // SIMPLE ALPHA BLENDING PIPELINE
     // ================================================
     
-    std::vector<cv::cuda::GpuMat> frames_to_blend(num_cameras);
-    
-    for (int i = 0; i < num_cameras; i++) {
-        // Validate frame size matches expected blend mask size
-        if (warped_frames[i].size() != blend_masks[i].size()) {
-            std::cerr << "WARNING: Frame " << i << " size " << warped_frames[i].size() 
-                      << " doesn't match mask size " << blend_masks[i].size() 
-                      << ". Resizing frame..." << std::endl;
-            
-            // Resize to match mask size
-            cv::cuda::GpuMat resized;
-            cv::cuda::resize(warped_frames[i], resized, blend_masks[i].size(), 
-                            0, 0, cv::INTER_LINEAR);
-            
-            // Convert to 16-bit for blending
-            cv::cuda::GpuMat frame_16s;
-            resized.convertTo(frame_16s, CV_16SC3);
+    try {
+        if (!use_tiles) {
+            backend->blendPrepare(output_size, backend->out(frame_pool->buffer(acc_handle)),
+                                  backend->out(frame_pool->buffer(weight_handle)));
+        }
+        
+        for (int i = 0; i < num_cameras; i++) {
+            const SVFrameBuffer* src = &warped_frames[i];
             
-            if (use_gain_compensation && gain_comp) {
-                gain_comp->apply(frame_16s, frames_to_blend[i], i);
-            } else {
-                frames_to_blend[i] = frame_16s;
+            // Validate frame size matches expected blend mask size
+            if (warped_frames[i].size() != blend_masks[i].size()) {
+                std::cerr << "WARNING: Frame " << i << " size " << warped_frames[i].size() 
+                          << " doesn't match mask size " << blend_masks[i].size() 
+                          << ". Resizing frame..." << std::endl;
+                
+                // Resize to match mask size
+                SVFrameBuffer& resized = frame_pool->buffer(resized_handles[i]);
+                backend->resize(backend->in(warped_frames[i]), backend->out(resized),
+                                blend_masks[i].size(), cv::INTER_LINEAR);
+                src = &resized;
             }
-        } else {
-            // Convert to 16-bit for blending (prevents overflow)
-            cv::cuda::GpuMat frame_16s;
-            warped_frames[i].convertTo(frame_16s, CV_16SC3);
             
             // Optional: Apply gain compensation
             if (use_gain_compensation && gain_comp) {
-                gain_comp->apply(frame_16s, frames_to_blend[i], i);
+                SVFrameBuffer& gained = frame_pool->buffer(gained_handles[i]);
+                backend->applyGain(backend->in(*src), backend->out(gained),
+                                   cv::Scalar::all(gain_comp->gain(i)));
+                src = &gained;
+            }
+            
+            if (use_tiles) {
+                tile_inputs[i] = &src->host();
             } else {
-                frames_to_blend[i] = frame_16s;
+                // Accumulate with the diagonal alpha mask (weighted in float, no overflow)
+                backend->blendFeed(backend->in(*src), backend->in(blend_masks[i]), warp_corners[i],
+                                   backend->inout(frame_pool->buffer(acc_handle)),
+                                   backend->inout(frame_pool->buffer(weight_handle)));
             }
         }
         
-        // Feed to simple blender with alpha mask
-        try {
-            blender->feed(frames_to_blend[i], blend_masks[i], warp_corners[i]);
-        } catch (const cv::Exception& e) {
-            std::cerr << "ERROR in blender->feed(): " << e.what() << std::endl;
-            return false;
+#ifdef DEBUG_FRAMES
+        std::cout << "Blending..." << std::endl;
+#endif
+        
+        if (use_tiles) {
+            tiler.stitch(tile_inputs, output.writeHost());
+        } else {
+            backend->blendFinish(backend->in(frame_pool->buffer(acc_handle)),
+                                 backend->in(frame_pool->buffer(weight_handle)),
+                                 backend->out(output),
+                                 backend->out(frame_pool->buffer(output_mask_handle)));
         }
-    }
-    
-    std::cout << "Blending..." << std::endl;
-    
-    // Get blended result
-    cv::cuda::GpuMat blended_result;
-    cv::cuda::GpuMat blended_mask;
-    cv::cuda::Stream stream;
-    
-    try {
-        blender->blend(blended_result, blended_mask, stream);
+        backend->synchronize();
     } catch (const cv::Exception& e) {
-        std::cerr << "ERROR in blender->blend(): " << e.what() << std::endl;
+        std::cerr << "ERROR in stitch backend (" << backend->name() << "): " << e.what() << std::endl;
         return false;
     }
     
-    // Convert back to 8-bit
-    if (blended_result.type() == CV_16SC3) {
-        cv::cuda::GpuMat result_8bit;
-        blended_result.convertTo(result_8bit, CV_8UC3);
-        output = result_8bit;
-    } else {
-        output = blended_result;
-    }
-    
+#ifdef DEBUG_FRAMES
     std::cout << "✓ Stitched output ready: " << output.size() << std::endl;
+#endif
     
     // Optional: Periodic gain update
     if (use_gain_compensation) {
@@ -358,11 +559,35 @@ bool SVStitcherAuto::stitch(const std::vector<cv::cuda::GpuMat>& raw_frames,
     return true;
 }
 
-void SVStitcherAuto::recomputeGain(const std::vector<cv::cuda::GpuMat>& warped_frames) {
+void SVStitcherAuto::recomputeGain(const std::vector<SVFrameBuffer>& warped_frames) {
     if (!is_init || !gain_comp || !use_gain_compensation) {
         return;
     }
     
-    gain_comp->recompute(warped_frames, warp_corners, blend_masks);
+    computeGains(warped_frames);
     std::cout << "Gain compensation updated (frame " << frame_count << ")" << std::endl;
-}
\ No newline at end of file
+}
+
+void SVStitcherAuto::computeGains(const std::vector<SVFrameBuffer>& warped_frames) {
+    // The solver runs on the host either way; device frames are downloaded by the compensator
+#ifndef SV_CPU_ONLY
+    if (backend->residency() == SVResidency::DEVICE) {
+        std::vector<cv::cuda::GpuMat> images(num_cameras);
+        std::vector<cv::cuda::GpuMat> masks(num_cameras);
+        for (int i = 0; i < num_cameras; i++) {
+            images[i] = warped_frames[i].device();
+            masks[i] = blend_masks[i].device();
+        }
+        gain_comp->computeGains(warp_corners, images, masks);
+        return;
+    }
+#endif
+    
+    std::vector<cv::Mat> images(num_cameras);
+    std::vector<cv::Mat> masks(num_cameras);
+    for (int i = 0; i < num_cameras; i++) {
+        images[i] = warped_frames[i].host();
+        masks[i] = blend_masks[i].host();
+    }
+    gain_comp->computeGains(warp_corners, images, masks);
+}
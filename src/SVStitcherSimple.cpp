@@ -316,27 +316,12 @@ bool SVStitcherSimple::stitch(const std::vector<cv::cuda::GpuMat>& frames,
         std::cout << "    Padding: " << (frames[i].step - expected_step) << " bytes" << std::endl;
         
         try {
-            // Try direct download (will likely fail)
-            std::cout << "\nAttempt 1: Direct download..." << std::endl;
-            cv::Mat cpu_frame;
-            frames[i].download(cpu_frame);
-            std::cout << "  SUCCESS! Direct download worked" << std::endl;
-            
-            // If we get here, continue with processing
-            std::cout << "Downloaded frame: " << cpu_frame.size() << std::endl;
-            
-            // Resize
-            std::cout << "Resizing..." << std::endl;
-            cv::Mat scaled_cpu;
-            cv::resize(cpu_frame, scaled_cpu, cv::Size(),
-                      scale_factor, scale_factor, cv::INTER_LINEAR);
-            std::cout << "  Resized to: " << scaled_cpu.size() << std::endl;
-            
-            // Upload
-            std::cout << "Uploading to GPU..." << std::endl;
+            // Resize on the device - the frame never leaves GPU memory
+            std::cout << "\nAttempt 1: Device resize..." << std::endl;
             cv::cuda::GpuMat scaled;
-            scaled.upload(scaled_cpu);
-            std::cout << "  Upload successful" << std::endl;
+            cv::cuda::resize(frames[i], scaled, cv::Size(),
+                            scale_factor, scale_factor, cv::INTER_LINEAR);
+            std::cout << "  Resized to: " << scaled.size() << std::endl;
             
             // Warp
             std::cout << "Warping..." << std::endl;
@@ -371,24 +356,17 @@ bool SVStitcherSimple::stitch(const std::vector<cv::cuda::GpuMat>& frames,
             std::cerr << "Line: " << e.line << std::endl;
             
             // Try alternative method
-            std::cout << "\nAttempt 2: Clone before download..." << std::endl;
+            std::cout << "\nAttempt 2: Clone before resize..." << std::endl;
             try {
                 cv::cuda::GpuMat cloned = frames[i].clone();
                 std::cout << "  Clone successful" << std::endl;
                 std::cout << "  Cloned size: " << cloned.size() << std::endl;
                 std::cout << "  Cloned step: " << cloned.step << std::endl;
                 
-                cv::Mat cpu_frame2;
-                cloned.download(cpu_frame2);
-                std::cout << "  Download after clone successful!" << std::endl;
-                
                 // Continue with this frame...
-                cv::Mat scaled_cpu;
-                cv::resize(cpu_frame2, scaled_cpu, cv::Size(),
-                          scale_factor, scale_factor, cv::INTER_LINEAR);
-                
                 cv::cuda::GpuMat scaled;
-                scaled.upload(scaled_cpu);
+                cv::cuda::resize(cloned, scaled, cv::Size(),
+                                scale_factor, scale_factor, cv::INTER_LINEAR);
                 
                 cv::cuda::GpuMat warped;
                 cv::cuda::remap(scaled, warped,
@@ -406,24 +384,13 @@ bool SVStitcherSimple::stitch(const std::vector<cv::cuda::GpuMat>& frames,
                 std::cerr << "What: " << e2.what() << std::endl;
                 
                 // Try completely CPU-based
-                std::cout << "\nAttempt 3: CPU-only method..." << std::endl;
+                std::cout << "\nAttempt 3: Blank frame..." << std::endl;
                 try {
-                    // Create a CPU mat and copy data manually
-                    cv::Mat manual_copy(frames[i].rows, frames[i].cols, frames[i].type());
-                    
-                    // Try to get the data somehow
-                    std::cout << "  Attempting manual data extraction..." << std::endl;
-                    
                     // This is a last resort - create dummy data for this frame
                     std::cout << "  WARNING: Using dummy frame for camera " << i << std::endl;
-                    manual_copy = cv::Mat::zeros(frames[i].rows, frames[i].cols, CV_8UC3);
-                    
-                    cv::Mat scaled_cpu;
-                    cv::resize(manual_copy, scaled_cpu, cv::Size(),
-                              scale_factor, scale_factor, cv::INTER_LINEAR);
-                    
-                    cv::cuda::GpuMat scaled;
-                    scaled.upload(scaled_cpu);
+                    cv::cuda::GpuMat scaled(cvRound(frames[i].rows * scale_factor),
+                                            cvRound(frames[i].cols * scale_factor), CV_8UC3);
+                    scaled.setTo(cv::Scalar::all(0));
                     
                     cv::cuda::GpuMat warped;
                     cv::cuda::remap(scaled, warped,
@@ -472,13 +439,7 @@ bool SVStitcherSimple::stitch(const std::vector<cv::cuda::GpuMat>& frames,
             std::cout << "Crop warp successful" << std::endl;
         } else {
             std::cout << "Resizing to output..." << std::endl;
-            cv::Mat cpu_blended;
-            blended_result.download(cpu_blended);
-            
-            cv::Mat resized_cpu;
-            cv::resize(cpu_blended, resized_cpu, output_size, 0, 0, cv::INTER_LINEAR);
-            
-            output.upload(resized_cpu);
+            cv::cuda::resize(blended_result, output, output_size, 0, 0, cv::INTER_LINEAR);
             std::cout << "Resize successful" << std::endl;
         }
         
@@ -0,0 +1,361 @@
+#include "SVThreadPool.hpp"
+#include "SVConfig.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <pthread.h>
+#include <sched.h>
+
+#if __has_include(<opencv2/core/parallel/parallel_backend.hpp>)
+#include <opencv2/core/parallel/parallel_backend.hpp>
+#define SV_HAS_CV_PARALLEL_BACKEND 1
+#endif
+
+namespace {
+
+thread_local const SVThreadPool* tls_pool = nullptr;
+thread_local int tls_worker = -1;
+
+std::vector<int> parseCpuList(const std::string& text) {
+    std::vector<int> cpus;
+    std::stringstream ss(text);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (!item.empty()) {
+            cpus.push_back(std::atoi(item.c_str()));
+        }
+    }
+    return cpus;
+}
+
+#ifdef SV_HAS_CV_PARALLEL_BACKEND
+/**
+ * OpenCV parallel_for_ backend that forwards to SVThreadPool
+ */
+class PoolParallelBackend : public cv::parallel::ParallelForAPI {
+public:
+    explicit PoolParallelBackend(SVThreadPool& pool_) : pool(pool_) {}
+
+    void parallel_for(int tasks, FN_parallel_for_body_cb_t body_callback, void* callback_data) override {
+        pool.parallelForRange(0, tasks, [&](int lo, int hi) {
+            body_callback(lo, hi, callback_data);
+        });
+    }
+
+    // Thread 0 is the caller, workers are 1..N
+    int getThreadNum() const override { return pool.currentWorker() + 1; }
+    int getNumThreads() const override { return pool.workerCount() + 1; }
+
+    // Pool size is fixed at startup (SV_THREADS); requests are ignored
+    int setNumThreads(int) override { return getNumThreads(); }
+
+    const char* getName() const override { return "SVThreadPool"; }
+
+private:
+    SVThreadPool& pool;
+};
+#endif
+
+} // namespace
+
+// ============================================================================
+// SVThreadPool Implementation
+// ============================================================================
+
+SVThreadPool& SVThreadPool::instance() {
+    // Never destroyed: OpenCV's parallel backend may still reference it during exit
+    static SVThreadPool* pool = [] {
+        int num_workers = THREAD_POOL_WORKERS;
+        if (const char* env = std::getenv("SV_THREADS")) {
+            num_workers = std::atoi(env);
+        }
+        if (num_workers <= 0) {
+            // Leave one hardware thread for the capture/render loop
+            num_workers = std::max(1, static_cast<int>(std::thread::hardware_concurrency()) - 1);
+        }
+
+        std::string cpu_list = THREAD_POOL_CPUS;
+        if (const char* env = std::getenv("SV_THREAD_CPUS")) {
+            cpu_list = env;
+        }
+
+        return new SVThreadPool(num_workers, parseCpuList(cpu_list));
+    }();
+    return *pool;
+}
+
+SVThreadPool::SVThreadPool(int num_workers, const std::vector<int>& cpus) {
+    num_workers = std::max(1, num_workers);
+
+    for (int i = 0; i < num_workers; i++) {
+        workers.push_back(std::make_unique<Worker>());
+        if (!cpus.empty()) {
+            workers.back()->cpu = cpus[i % cpus.size()];
+        }
+    }
+
+    // Start threads only after every deque exists (workers steal from each other)
+    for (int i = 0; i < num_workers; i++) {
+        Worker& w = *workers[i];
+        w.thread = std::thread(&SVThreadPool::workerLoop, this, i);
+
+        if (w.cpu >= 0) {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(w.cpu, &set);
+            if (pthread_setaffinity_np(w.thread.native_handle(), sizeof(set), &set) != 0) {
+                std::cerr << "WARNING: Could not pin pool worker " << i
+                          << " to CPU " << w.cpu << std::endl;
+                w.cpu = -1;
+            }
+        }
+    }
+}
+
+SVThreadPool::~SVThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleep_mtx);
+        stopping = true;
+    }
+    sleep_cv.notify_all();
+
+    for (auto& w : workers) {
+        if (w->thread.joinable()) {
+            w->thread.join();
+        }
+    }
+}
+
+int SVThreadPool::currentWorker() const {
+    return (tls_pool == this) ? tls_worker : -1;
+}
+
+void SVThreadPool::submit(Task task) {
+    int self = currentWorker();
+    int target = (self >= 0) ? self
+                             : static_cast<int>(next_worker.fetch_add(1, std::memory_order_relaxed) % workers.size());
+
+    {
+        std::lock_guard<std::mutex> lock(workers[target]->mtx);
+        workers[target]->tasks.push_back(std::move(task));
+    }
+    pending.fetch_add(1, std::memory_order_release);
+
+    // Take the sleep lock so a worker between its check and wait cannot miss this
+    {
+        std::lock_guard<std::mutex> lock(sleep_mtx);
+    }
+    sleep_cv.notify_one();
+}
+
+bool SVThreadPool::tryRunOne(int self) {
+    Task task;
+    const int n = static_cast<int>(workers.size());
+
+    // Own deque first, newest task (still warm in cache)
+    if (self >= 0) {
+        Worker& w = *workers[self];
+        std::lock_guard<std::mutex> lock(w.mtx);
+        if (!w.tasks.empty()) {
+            task = std::move(w.tasks.back());
+            w.tasks.pop_back();
+        }
+    }
+
+    // Otherwise steal the oldest task from someone else
+    if (!task) {
+        int start = (self >= 0) ? self + 1
+                                : static_cast<int>(next_worker.load(std::memory_order_relaxed));
+        for (int k = 0; k < n && !task; k++) {
+            int victim = (start + k) % n;
+            if (victim == self) continue;
+            Worker& v = *workers[victim];
+            std::lock_guard<std::mutex> lock(v.mtx);
+            if (!v.tasks.empty()) {
+                task = std::move(v.tasks.front());
+                v.tasks.pop_front();
+                if (self >= 0) {
+                    workers[self]->stolen.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        }
+    }
+
+    if (!task) {
+        return false;
+    }
+
+    pending.fetch_sub(1, std::memory_order_acq_rel);
+    task();
+    if (self >= 0) {
+        workers[self]->executed.fetch_add(1, std::memory_order_relaxed);
+    }
+    return true;
+}
+
+void SVThreadPool::workerLoop(int index) {
+    tls_pool = this;
+    tls_worker = index;
+
+    for (;;) {
+        if (tryRunOne(index)) {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleep_mtx);
+        sleep_cv.wait(lock, [this] {
+            return stopping.load() || pending.load(std::memory_order_acquire) > 0;
+        });
+        if (stopping && pending.load() == 0) {
+            return;
+        }
+    }
+}
+
+bool SVThreadPool::runPendingTask() {
+    return tryRunOne(currentWorker());
+}
+
+void SVThreadPool::parallelForRange(int begin, int end, const std::function<void(int, int)>& body,
+                                    int grain) {
+    if (end <= begin) return;
+
+    const int n = end - begin;
+    grain = std::max(1, grain);
+
+    // A few chunks per thread so stealing can even out uneven rows
+    const int max_chunks = (workerCount() + 1) * 4;
+    const int chunks = std::min((n + grain - 1) / grain, max_chunks);
+
+    if (chunks <= 1) {
+        body(begin, end);
+        return;
+    }
+
+    auto bound = [&](int c) {
+        return begin + static_cast<int>(static_cast<int64_t>(n) * c / chunks);
+    };
+
+    SVTaskGroup group(*this);
+    for (int c = 1; c < chunks; c++) {
+        int lo = bound(c);
+        int hi = bound(c + 1);
+        group.run([&body, lo, hi] { body(lo, hi); });
+    }
+
+    // The calling thread takes the first chunk itself
+    body(begin, bound(1));
+    group.wait();
+}
+
+void SVThreadPool::parallelFor(int begin, int end, const std::function<void(int)>& body) {
+    parallelForRange(begin, end, [&body](int lo, int hi) {
+        for (int i = lo; i < hi; i++) {
+            body(i);
+        }
+    });
+}
+
+std::vector<SVThreadPool::WorkerStats> SVThreadPool::stats() const {
+    std::vector<WorkerStats> result;
+    for (const auto& w : workers) {
+        WorkerStats s;
+        s.executed = w->executed.load(std::memory_order_relaxed);
+        s.stolen = w->stolen.load(std::memory_order_relaxed);
+        s.cpu = w->cpu;
+        result.push_back(s);
+    }
+    return result;
+}
+
+void SVThreadPool::printSummary() const {
+    std::cout << "\n=== Thread Pool ===" << std::endl;
+    std::cout << "  Workers: " << workers.size() << std::endl;
+    auto all = stats();
+    for (size_t i = 0; i < all.size(); i++) {
+        std::cout << "  [" << i << "] cpu=" << (all[i].cpu >= 0 ? std::to_string(all[i].cpu) : "any")
+                  << " tasks=" << all[i].executed << " stolen=" << all[i].stolen << std::endl;
+    }
+    std::cout << "===================\n" << std::endl;
+}
+
+bool SVThreadPool::installAsOpenCVBackend() {
+#ifdef SV_HAS_CV_PARALLEL_BACKEND
+    cv::parallel::setParallelForBackend(std::make_shared<PoolParallelBackend>(*this));
+    std::cout << "✓ OpenCV parallel_for_ routed through SVThreadPool ("
+              << workerCount() << " workers)" << std::endl;
+    return true;
+#else
+    std::cerr << "WARNING: OpenCV has no pluggable parallel backend; "
+              << "OpenCV CPU functions keep their own threads" << std::endl;
+    return false;
+#endif
+}
+
+// ============================================================================
+// SVTaskGroup Implementation
+// ============================================================================
+
+SVTaskGroup::SVTaskGroup(SVThreadPool& pool_) : pool(pool_) {}
+
+SVTaskGroup::~SVTaskGroup() {
+    try {
+        wait();
+    } catch (...) {
+        // Exceptions are only reported through an explicit wait()
+    }
+}
+
+void SVTaskGroup::run(SVThreadPool::Task task) {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        outstanding++;
+    }
+
+    pool.submit([this, task = std::move(task)] {
+        std::exception_ptr failure;
+        try {
+            task();
+        } catch (...) {
+            failure = std::current_exception();
+        }
+
+        // Notify under the lock: wait() may destroy the group as soon as it sees 0
+        std::lock_guard<std::mutex> lock(mtx);
+        if (failure && !error) {
+            error = failure;
+        }
+        if (--outstanding == 0) {
+            done_cv.notify_all();
+        }
+    });
+}
+
+void SVTaskGroup::wait() {
+    using namespace std::chrono_literals;
+
+    for (;;) {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            if (outstanding == 0) break;
+        }
+
+        // Help out instead of blocking; sleep briefly only when nothing is queued
+        if (!pool.runPendingTask()) {
+            std::unique_lock<std::mutex> lock(mtx);
+            done_cv.wait_for(lock, 200us, [this] { return outstanding == 0; });
+        }
+    }
+
+    std::exception_ptr failure;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        std::swap(failure, error);
+    }
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+}
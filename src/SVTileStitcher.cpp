@@ -0,0 +1,194 @@
+#include "SVTileStitcher.hpp"
+#include "SVThreadPool.hpp"
+#include <cstring>
+#include <iostream>
+
+namespace {
+
+const char* tileKindName(SVTileStitcher::TileKind kind) {
+    switch (kind) {
+        case SVTileStitcher::TileKind::EMPTY:       return "empty";
+        case SVTileStitcher::TileKind::COPY:        return "copy";
+        case SVTileStitcher::TileKind::MASKED_COPY: return "masked copy";
+        case SVTileStitcher::TileKind::BLEND:       return "blend";
+    }
+    return "?";
+}
+
+} // namespace
+
+// ============================================================================
+// SVTileStitcher Implementation
+// ============================================================================
+
+void SVTileStitcher::prepare(const std::vector<cv::Mat>& masks, const std::vector<cv::Point>& corners,
+                             cv::Size canvas, int tile_size) {
+    CV_Assert(masks.size() == corners.size());
+    CV_Assert(tile_size > 0);
+
+    tiles.clear();
+    camera_masks = masks;
+    canvas_size = canvas;
+    tile_edge = tile_size;
+    coverage = cv::Mat::zeros(canvas, CV_8U);
+
+    const cv::Rect canvas_rect(cv::Point(), canvas);
+    const int num_cams = static_cast<int>(masks.size());
+
+    for (int ty = 0; ty < canvas.height; ty += tile_size) {
+        for (int tx = 0; tx < canvas.width; tx += tile_size) {
+            Tile tile;
+            tile.rect = cv::Rect(tx, ty, tile_size, tile_size) & canvas_rect;
+
+            bool full_cover = false;
+            for (int cam = 0; cam < num_cams; cam++) {
+                CV_Assert(masks[cam].type() == CV_8U);
+
+                // Part of this camera's image that lands in the tile
+                cv::Rect dst_rect = cv::Rect(corners[cam], masks[cam].size()) & tile.rect;
+                if (dst_rect.empty()) continue;
+
+                cv::Rect src_rect = dst_rect - corners[cam];
+                int nonzero = cv::countNonZero(masks[cam](src_rect));
+                if (nonzero == 0) continue;
+
+                full_cover = (dst_rect == tile.rect && nonzero == dst_rect.area());
+                tile.sources.push_back({cam, src_rect, dst_rect.tl() - tile.rect.tl(), cv::Mat()});
+
+                cv::Mat covered = coverage(dst_rect);
+                cv::Mat contributes = masks[cam](src_rect) > 0;
+                cv::bitwise_or(covered, contributes, covered);
+            }
+
+            if (tile.sources.empty()) {
+                tile.kind = TileKind::EMPTY;
+            } else if (tile.sources.size() == 1) {
+                // One source: out = w * img / w = img wherever w > 0
+                tile.kind = full_cover ? TileKind::COPY : TileKind::MASKED_COPY;
+            } else {
+                tile.kind = TileKind::BLEND;
+
+                // Normalise the weights once: w_k / sum(w)
+                cv::Mat sum = cv::Mat::zeros(tile.rect.size(), CV_32F);
+                for (const auto& src : tile.sources) {
+                    cv::Mat w;
+                    masks[src.camera](src.src_rect).convertTo(w, CV_32F);
+                    cv::Mat sum_roi = sum(cv::Rect(src.dst_offset, src.src_rect.size()));
+                    sum_roi += w;
+                }
+                for (auto& src : tile.sources) {
+                    masks[src.camera](src.src_rect).convertTo(src.weight, CV_32F);
+                    cv::Mat sum_roi = sum(cv::Rect(src.dst_offset, src.src_rect.size()));
+                    cv::divide(src.weight, cv::max(sum_roi, 1e-5f), src.weight);
+                }
+            }
+
+            tiles.push_back(std::move(tile));
+        }
+    }
+}
+
+void SVTileStitcher::stitch(const std::vector<const cv::Mat*>& images, cv::Mat& dst) const {
+    CV_Assert(images.size() == camera_masks.size());
+    for (size_t i = 0; i < images.size(); i++) {
+        CV_Assert(images[i]->type() == CV_8UC3 && images[i]->size() == camera_masks[i].size());
+    }
+
+    dst.create(canvas_size, CV_8UC3);
+
+    SVThreadPool::instance().parallelFor(0, static_cast<int>(tiles.size()), [&](int t) {
+        stitchTile(tiles[t], images, dst);
+    });
+}
+
+void SVTileStitcher::stitchTile(const Tile& tile, const std::vector<const cv::Mat*>& images,
+                                cv::Mat& dst) const {
+    const cv::Rect& r = tile.rect;
+    const size_t row_bytes = static_cast<size_t>(r.width) * 3;
+
+    switch (tile.kind) {
+        case TileKind::EMPTY: {
+            for (int y = 0; y < r.height; y++) {
+                std::memset(dst.ptr<uchar>(r.y + y) + r.x * 3, 0, row_bytes);
+            }
+            break;
+        }
+
+        case TileKind::COPY: {
+            const TileSource& src = tile.sources[0];
+            const cv::Mat& img = *images[src.camera];
+            for (int y = 0; y < r.height; y++) {
+                std::memcpy(dst.ptr<uchar>(r.y + y) + r.x * 3,
+                            img.ptr<uchar>(src.src_rect.y + y) + src.src_rect.x * 3, row_bytes);
+            }
+            break;
+        }
+
+        case TileKind::MASKED_COPY: {
+            const TileSource& src = tile.sources[0];
+            const cv::Mat& img = *images[src.camera];
+            const cv::Mat& mask = camera_masks[src.camera];
+
+            for (int y = 0; y < r.height; y++) {
+                std::memset(dst.ptr<uchar>(r.y + y) + r.x * 3, 0, row_bytes);
+            }
+            for (int y = 0; y < src.src_rect.height; y++) {
+                const uchar* img_row = img.ptr<uchar>(src.src_rect.y + y) + src.src_rect.x * 3;
+                const uchar* mask_row = mask.ptr<uchar>(src.src_rect.y + y) + src.src_rect.x;
+                uchar* dst_row = dst.ptr<uchar>(r.y + src.dst_offset.y + y) + (r.x + src.dst_offset.x) * 3;
+                for (int x = 0; x < src.src_rect.width; x++) {
+                    if (mask_row[x]) {
+                        dst_row[3 * x + 0] = img_row[3 * x + 0];
+                        dst_row[3 * x + 1] = img_row[3 * x + 1];
+                        dst_row[3 * x + 2] = img_row[3 * x + 2];
+                    }
+                }
+            }
+            break;
+        }
+
+        case TileKind::BLEND: {
+            // Per-thread float tile, reused across tiles and frames
+            thread_local std::vector<float> acc;
+            const int acc_stride = r.width * 3;
+            acc.assign(static_cast<size_t>(acc_stride) * r.height, 0.0f);
+
+            for (const TileSource& src : tile.sources) {
+                const cv::Mat& img = *images[src.camera];
+                for (int y = 0; y < src.src_rect.height; y++) {
+                    const uchar* img_row = img.ptr<uchar>(src.src_rect.y + y) + src.src_rect.x * 3;
+                    const float* w_row = src.weight.ptr<float>(y);
+                    float* acc_row = acc.data() + (src.dst_offset.y + y) * acc_stride + src.dst_offset.x * 3;
+                    for (int x = 0; x < src.src_rect.width; x++) {
+                        float w = w_row[x];
+                        acc_row[3 * x + 0] += img_row[3 * x + 0] * w;
+                        acc_row[3 * x + 1] += img_row[3 * x + 1] * w;
+                        acc_row[3 * x + 2] += img_row[3 * x + 2] * w;
+                    }
+                }
+            }
+
+            for (int y = 0; y < r.height; y++) {
+                const float* acc_row = acc.data() + y * acc_stride;
+                uchar* dst_row = dst.ptr<uchar>(r.y + y) + r.x * 3;
+                for (int i = 0; i < acc_stride; i++) {
+                    dst_row[i] = cv::saturate_cast<uchar>(acc_row[i]);
+                }
+            }
+            break;
+        }
+    }
+}
+
+void SVTileStitcher::printSummary() const {
+    int counts[4] = {0, 0, 0, 0};
+    for (const auto& tile : tiles) {
+        counts[static_cast<int>(tile.kind)]++;
+    }
+
+    std::cout << "  Tiles: " << tiles.size() << " of " << tile_edge << "x" << tile_edge << " (";
+    for (int k = 0; k < 4; k++) {
+        std::cout << (k ? ", " : "") << counts[k] << " " << tileKindName(static_cast<TileKind>(k));
+    }
+    std::cout << ")" << std::endl;
+}
@@ -0,0 +1,299 @@
+#include "SVVehicleState.hpp"
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <fcntl.h>
+#include <linux/can.h>
+#include <linux/can/raw.h>
+#include <net/if.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+const char* gearName(SVGear gear) {
+    switch (gear) {
+        case SVGear::PARK:    return "P";
+        case SVGear::REVERSE: return "R";
+        case SVGear::NEUTRAL: return "N";
+        case SVGear::DRIVE:   return "D";
+        default:              return "?";
+    }
+}
+
+const char* turnSignalName(SVTurnSignal turn) {
+    switch (turn) {
+        case SVTurnSignal::LEFT:   return "left";
+        case SVTurnSignal::RIGHT:  return "right";
+        case SVTurnSignal::HAZARD: return "hazard";
+        default:                   return "none";
+    }
+}
+
+static bool parseGear(char c, SVGear& gear) {
+    switch (c) {
+        case 'P': case 'p': gear = SVGear::PARK;    return true;
+        case 'R': case 'r': gear = SVGear::REVERSE; return true;
+        case 'N': case 'n': gear = SVGear::NEUTRAL; return true;
+        case 'D': case 'd': gear = SVGear::DRIVE;   return true;
+        default:            return false;
+    }
+}
+
+SVVehicleInput::SVVehicleInput()
+    : kind(Kind::FILE)
+    , is_fifo(false)
+    , fd(-1)
+    , stop_fd(-1)
+    , stopping(false)
+    , update_count(0) {
+}
+
+SVVehicleInput::~SVVehicleInput() {
+    stop();
+}
+
+bool SVVehicleInput::start(const std::string& source, const Options& options) {
+    stop();
+    opts = options;
+
+    if (source.compare(0, 5, "file:") == 0) {
+        kind = Kind::FILE;
+        path = source.substr(5);
+    } else if (source.compare(0, 4, "can:") == 0) {
+        kind = Kind::CAN;
+        path = source.substr(4);
+    } else {
+        std::cerr << "✗ Vehicle state: unknown source '" << source << "' (file:<path> or can:<iface>)" << std::endl;
+        return false;
+    }
+
+    if (!(kind == Kind::FILE ? openFile() : openCan())) {
+        return false;
+    }
+
+    stop_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (stop_fd < 0) {
+        std::cerr << "✗ Vehicle state: eventfd failed: " << std::strerror(errno) << std::endl;
+        close(fd);
+        fd = -1;
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        current = SVVehicleState();
+    }
+    stopping = false;
+    thread = std::thread(&SVVehicleInput::loop, this);
+
+    std::cout << "✓ Vehicle state from " << source << std::endl;
+    return true;
+}
+
+void SVVehicleInput::stop() {
+    if (thread.joinable()) {
+        stopping = true;
+        const uint64_t one = 1;
+        if (write(stop_fd, &one, sizeof(one)) < 0) {
+            std::cerr << "✗ Vehicle state: cannot wake thread" << std::endl;
+        }
+        thread.join();
+    }
+    if (fd >= 0) {
+        close(fd);
+        fd = -1;
+    }
+    if (stop_fd >= 0) {
+        close(stop_fd);
+        stop_fd = -1;
+    }
+}
+
+bool SVVehicleInput::openFile() {
+    // Non-blocking: opening a FIFO must not wait for a writer
+    fd = open(path.c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0) {
+        std::cerr << "✗ Vehicle state: cannot open " << path << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    struct stat st;
+    is_fifo = fstat(fd, &st) == 0 && S_ISFIFO(st.st_mode);
+    return true;
+}
+
+bool SVVehicleInput::openCan() {
+    fd = socket(PF_CAN, SOCK_RAW | SOCK_NONBLOCK | SOCK_CLOEXEC, CAN_RAW);
+    if (fd < 0) {
+        std::cerr << "✗ Vehicle state: CAN socket failed: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    ifreq ifr;
+    std::memset(&ifr, 0, sizeof(ifr));
+    std::strncpy(ifr.ifr_name, path.c_str(), IFNAMSIZ - 1);
+    if (ioctl(fd, SIOCGIFINDEX, &ifr) < 0) {
+        std::cerr << "✗ Vehicle state: no CAN interface " << path << ": " << std::strerror(errno) << std::endl;
+        close(fd);
+        fd = -1;
+        return false;
+    }
+
+    // Only the vehicle-state frame reaches this socket
+    can_filter filter;
+    filter.can_id = opts.can_id;
+    filter.can_mask = CAN_SFF_MASK;
+    setsockopt(fd, SOL_CAN_RAW, CAN_RAW_FILTER, &filter, sizeof(filter));
+
+    sockaddr_can addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.can_family = AF_CAN;
+    addr.can_ifindex = ifr.ifr_ifindex;
+    if (bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        std::cerr << "✗ Vehicle state: cannot bind to " << path << ": " << std::strerror(errno) << std::endl;
+        close(fd);
+        fd = -1;
+        return false;
+    }
+    return true;
+}
+
+SVVehicleState SVVehicleInput::state() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    SVVehicleState s = current;
+    if (s.valid && opts.stale_ms > 0 && std::chrono::steady_clock::now() - s.updated > std::chrono::milliseconds(opts.stale_ms)) {
+        s.valid = false;
+    }
+    return s;
+}
+
+void SVVehicleInput::publish(const SVVehicleState& next) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        current = next;
+        current.valid = true;
+        current.updated = std::chrono::steady_clock::now();
+    }
+    update_count++;
+}
+
+bool SVVehicleInput::parseLine(const std::string& line, SVVehicleState& state) {
+    std::istringstream in(line);
+    std::string token;
+    bool any = false;
+
+    while (in >> token) {
+        const size_t eq = token.find('=');
+        if (eq == std::string::npos || eq + 1 >= token.size()) continue;
+        const std::string key = token.substr(0, eq);
+        const std::string value = token.substr(eq + 1);
+
+        if (key == "gear") {
+            any |= parseGear(value[0], state.gear);
+        } else if (key == "speed") {
+            char* end = nullptr;
+            const float v = std::strtof(value.c_str(), &end);
+            if (end != value.c_str()) {
+                state.speed_kmh = v;
+                any = true;
+            }
+        } else if (key == "turn") {
+            if (value == "none" || value == "off") {
+                state.turn = SVTurnSignal::NONE;
+            } else if (value == "left") {
+                state.turn = SVTurnSignal::LEFT;
+            } else if (value == "right") {
+                state.turn = SVTurnSignal::RIGHT;
+            } else if (value == "hazard") {
+                state.turn = SVTurnSignal::HAZARD;
+            } else {
+                continue;
+            }
+            any = true;
+        }
+    }
+    return any;
+}
+
+bool SVVehicleInput::parseCanFrame(const uint8_t* data, int len, SVVehicleState& state) {
+    if (len < 4) return false;
+
+    SVGear gear;
+    if (!parseGear(static_cast<char>(data[0]), gear) || data[3] > 3) {
+        return false;
+    }
+    state.gear = gear;
+    state.speed_kmh = (data[1] | (data[2] << 8)) * 0.01f;
+    state.turn = static_cast<SVTurnSignal>(data[3]);
+    return true;
+}
+
+void SVVehicleInput::loop() {
+    SVVehicleState next;
+    std::string pending;            // Partial line (file source)
+    char buffer[4096];
+
+    pollfd fds[2];
+    fds[0] = {fd, POLLIN, 0};
+    fds[1] = {stop_fd, POLLIN, 0};
+
+    while (!stopping) {
+        const int ready = poll(fds, 2, -1);
+        if (ready < 0) {
+            if (errno == EINTR) continue;
+            std::cerr << "✗ Vehicle state: poll failed: " << std::strerror(errno) << std::endl;
+            break;
+        }
+        if (stopping || (fds[1].revents & POLLIN)) {
+            break;
+        }
+
+        if (kind == Kind::CAN) {
+            can_frame frame;
+            while (read(fd, &frame, sizeof(frame)) == static_cast<ssize_t>(sizeof(frame))) {
+                if ((frame.can_id & CAN_SFF_MASK) == opts.can_id && parseCanFrame(frame.data, frame.can_dlc, next)) {
+                    publish(next);
+                }
+            }
+            continue;
+        }
+
+        const ssize_t len = read(fd, buffer, sizeof(buffer));
+        if (len > 0) {
+            pending.append(buffer, len);
+            size_t newline;
+            while ((newline = pending.find('\n')) != std::string::npos) {
+                if (parseLine(pending.substr(0, newline), next)) {
+                    publish(next);
+                }
+                pending.erase(0, newline + 1);
+            }
+            continue;
+        }
+        if (len < 0) {
+            if (errno == EAGAIN || errno == EINTR) continue;
+            std::cerr << "✗ Vehicle state: read failed: " << std::strerror(errno) << std::endl;
+            break;
+        }
+
+        // End of data
+        pending.clear();
+        if (is_fifo) {
+            // Writer gone; a reopened FIFO waits for the next one (otherwise poll reports POLLHUP forever)
+            close(fd);
+            if (!openFile()) break;
+            fds[0].fd = fd;
+        } else {
+            // Regular file: follow appended lines like tail -f, start over if it was truncated
+            struct stat st;
+            if (fstat(fd, &st) == 0 && st.st_size < lseek(fd, 0, SEEK_CUR)) {
+                lseek(fd, 0, SEEK_SET);
+            }
+            poll(&fds[1], 1, 100);
+        }
+    }
+}
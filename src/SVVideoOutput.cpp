@@ -0,0 +1,285 @@
+#include "SVVideoOutput.hpp"
+#include <gst/gst.h>
+#include <gst/app/gstappsrc.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+
+using namespace std::chrono_literals;
+
+SVVideoOutput::Options SVVideoOutput::Options::file(const std::string& path, cv::Size size, int fps) {
+    Options o;
+    o.name = path;
+    o.size = size;
+    o.fps = fps;
+
+    const bool mp4 = path.size() >= 4 && path.compare(path.size() - 4, 4, ".mp4") == 0;
+    std::ostringstream sink;
+    sink << (mp4 ? "mp4mux" : "matroskamux") << " ! filesink location=\"" << path << "\" sync=false";
+    o.sink = sink.str();
+    return o;
+}
+
+SVVideoOutput::Options SVVideoOutput::Options::rtp(const std::string& host, int port, cv::Size size, int fps) {
+    Options o;
+    o.name = "rtp://" + host + ":" + std::to_string(port);
+    o.size = size;
+    o.fps = fps;
+    o.queue_depth = 2;      // Late frames are worthless on a live stream: drop, do not queue
+
+    // Mirrors the camera input (udpsrc ! application/x-rtp,...,payload=96 ! rtph264depay)
+    std::ostringstream sink;
+    sink << "rtph264pay config-interval=-1 pt=96 mtu=1400"
+         << " ! udpsink host=" << host << " port=" << port << " sync=false async=false";
+    o.sink = sink.str();
+    return o;
+}
+
+std::string SVVideoOutput::x264Live(int bitrate_kbps, int gop, Latency latency, int fps) {
+    // No B-frames in any profile: frames leave the encoder in display order
+    std::ostringstream enc;
+    enc << "x264enc bitrate=" << bitrate_kbps << " key-int-max=" << std::max(1, gop) << " bframes=0";
+    switch (latency) {
+        case Latency::LOW:
+            enc << " tune=zerolatency speed-preset=ultrafast sliced-threads=true"
+                << " vbv-buf-capacity=" << (1000 + fps - 1) / std::max(1, fps);
+            break;
+        case Latency::BALANCED:
+            enc << " tune=zerolatency speed-preset=veryfast vbv-buf-capacity=300";
+            break;
+        case Latency::QUALITY:
+            enc << " speed-preset=faster rc-lookahead=" << std::max(1, fps / 2) << " vbv-buf-capacity=1000";
+            break;
+    }
+    return enc.str();
+}
+
+SVVideoOutput::SVVideoOutput()
+    : pipeline(nullptr)
+    , appsrc(nullptr)
+    , head(0)
+    , tail(0)
+    , running(false)
+    , failed(false)
+    , first_pts_ns(-1)
+    , pushed(0)
+    , dropped(0)
+    , encoded(0) {
+}
+
+SVVideoOutput::~SVVideoOutput() {
+    stop();
+}
+
+bool SVVideoOutput::start(const Options& options) {
+    stop();
+    opts = options;
+
+    if (opts.size.area() == 0 || opts.sink.empty()) {
+        std::cerr << "✗ Video output " << opts.name << ": size and sink are required" << std::endl;
+        return false;
+    }
+
+    static std::once_flag gst_initialized;
+    std::call_once(gst_initialized, [] { gst_init(nullptr, nullptr); });
+
+    // appsrc blocks the worker (never the frame loop) when the encoder falls behind;
+    // the ring in front of it then fills and push() starts dropping
+    const size_t frame_bytes = GST_ROUND_UP_4(static_cast<size_t>(opts.size.width) * 3) * opts.size.height;
+    std::ostringstream desc;
+    desc << "appsrc name=src is-live=true format=time block=true max-bytes=" << 2 * frame_bytes
+         << " caps=video/x-raw,format=BGR,width=" << opts.size.width << ",height=" << opts.size.height
+         << ",framerate=" << opts.fps << "/1 ! "
+         << (opts.flip_vertical ? "videoflip method=vertical-flip ! " : "");
+    if (opts.size.width % 2 || opts.size.height % 2) {
+        // 4:2:0 encoders refuse odd sizes (window read-back, view presets): drop the last column/row
+        desc << "videocrop right=" << opts.size.width % 2 << " bottom=" << opts.size.height % 2 << " ! ";
+    }
+    desc << "videoconvert ! " << opts.encoder << " ! h264parse ! " << opts.sink;
+
+    GError* error = nullptr;
+    pipeline = gst_parse_launch(desc.str().c_str(), &error);
+    if (!pipeline || error) {
+        std::cerr << "✗ Video output " << opts.name << ": " << (error ? error->message : "unknown error")
+                  << "\n  Pipeline: " << desc.str() << std::endl;
+        if (error) g_error_free(error);
+        if (pipeline) gst_object_unref(pipeline);
+        pipeline = nullptr;
+        return false;
+    }
+    appsrc = gst_bin_get_by_name(GST_BIN(pipeline), "src");
+
+    if (gst_element_set_state(pipeline, GST_STATE_PLAYING) == GST_STATE_CHANGE_FAILURE) {
+        std::cerr << "✗ Video output " << opts.name << ": pipeline failed to start" << std::endl;
+        checkBus();
+        gst_object_unref(appsrc);
+        gst_object_unref(pipeline);
+        appsrc = nullptr;
+        pipeline = nullptr;
+        return false;
+    }
+
+    // Preallocate every slot: push() only copies
+    slots.assign(std::max(2, opts.queue_depth), Slot());
+    for (Slot& slot : slots) {
+        slot.image.create(opts.size, CV_8UC3);
+    }
+    head = 0;
+    tail = 0;
+    first_pts_ns = -1;
+    pushed = 0;
+    dropped = 0;
+    encoded = 0;
+    failed = false;
+    running = true;
+    worker = std::thread(&SVVideoOutput::workerLoop, this);
+
+    std::cout << "✓ Video output " << opts.name << " started (" << opts.size << " @ "
+              << opts.fps << " fps)" << std::endl;
+    return true;
+}
+
+bool SVVideoOutput::push(const cv::Mat& bgr, int64_t pts_ns) {
+    if (!running || failed || bgr.size() != opts.size || bgr.type() != CV_8UC3) {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    const uint32_t h = head.load(std::memory_order_relaxed);
+    while (h - tail.load(std::memory_order_acquire) >= slots.size()) {
+        if (!opts.block_when_full || failed) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        // The worker does not take the mutex either: bounded wait
+        std::unique_lock<std::mutex> lock(wake_mutex);
+        space.wait_for(lock, 5ms);
+    }
+
+    Slot& slot = slots[h % slots.size()];
+    bgr.copyTo(slot.image);
+    slot.pts_ns = pts_ns;
+    head.store(h + 1, std::memory_order_release);
+    pushed.fetch_add(1, std::memory_order_relaxed);
+
+    wake.notify_one();
+    return true;
+}
+
+void SVVideoOutput::workerLoop() {
+    for (;;) {
+        const uint32_t t = tail.load(std::memory_order_relaxed);
+        if (t == head.load(std::memory_order_acquire)) {
+            if (!running) break;    // Drained after stop()
+
+            // push() does not take the mutex, so a wakeup can be missed: bounded wait
+            std::unique_lock<std::mutex> lock(wake_mutex);
+            wake.wait_for(lock, 5ms);
+            continue;
+        }
+
+        if (!failed && !pushToPipeline(slots[t % slots.size()])) {
+            failed = true;
+        }
+        tail.store(t + 1, std::memory_order_release);
+        space.notify_one();
+
+        if (!failed && !checkBus()) {
+            failed = true;
+        }
+    }
+}
+
+bool SVVideoOutput::pushToPipeline(const Slot& slot) {
+    if (first_pts_ns < 0) {
+        first_pts_ns = slot.pts_ns;
+    }
+
+    // BGR caps without a GstVideoMeta imply rows padded to 4 bytes
+    const size_t row_bytes = static_cast<size_t>(opts.size.width) * 3;
+    const size_t stride = GST_ROUND_UP_4(row_bytes);
+    GstBuffer* buffer = gst_buffer_new_allocate(nullptr, stride * opts.size.height, nullptr);
+    GstMapInfo map;
+    if (!gst_buffer_map(buffer, &map, GST_MAP_WRITE)) {
+        gst_buffer_unref(buffer);
+        return false;
+    }
+    for (int y = 0; y < opts.size.height; y++) {
+        std::memcpy(map.data + y * stride, slot.image.ptr(y), row_bytes);
+    }
+    gst_buffer_unmap(buffer, &map);
+
+    GST_BUFFER_PTS(buffer) = static_cast<GstClockTime>(std::max<int64_t>(0, slot.pts_ns - first_pts_ns));
+    GST_BUFFER_DURATION(buffer) = gst_util_uint64_scale_int(GST_SECOND, 1, opts.fps);
+
+    // Takes ownership; blocks while appsrc is full (block=true)
+    if (gst_app_src_push_buffer(GST_APP_SRC(appsrc), buffer) != GST_FLOW_OK) {
+        std::cerr << "✗ Video output " << opts.name << ": pipeline refused a frame" << std::endl;
+        return false;
+    }
+    encoded.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool SVVideoOutput::checkBus() {
+    if (!pipeline) return false;
+
+    GstBus* bus = gst_element_get_bus(pipeline);
+    GstMessage* msg = gst_bus_pop_filtered(bus, GST_MESSAGE_ERROR);
+    gst_object_unref(bus);
+    if (!msg) return true;
+
+    GError* err = nullptr;
+    gchar* debug = nullptr;
+    gst_message_parse_error(msg, &err, &debug);
+    std::cerr << "✗ Video output " << opts.name << ": " << (err ? err->message : "error") << std::endl;
+    if (err) g_error_free(err);
+    g_free(debug);
+    gst_message_unref(msg);
+    return false;
+}
+
+void SVVideoOutput::stop() {
+    if (!pipeline) return;
+
+    // Let the worker drain what is queued, then finish the stream
+    running = false;
+    wake.notify_one();
+    if (worker.joinable()) {
+        worker.join();
+    }
+
+    if (!failed) {
+        gst_app_src_end_of_stream(GST_APP_SRC(appsrc));
+
+        // The muxer writes its index on EOS
+        GstBus* bus = gst_element_get_bus(pipeline);
+        GstMessage* msg = gst_bus_timed_pop_filtered(bus, 5 * GST_SECOND,
+            static_cast<GstMessageType>(GST_MESSAGE_EOS | GST_MESSAGE_ERROR));
+        if (!msg || GST_MESSAGE_TYPE(msg) != GST_MESSAGE_EOS) {
+            std::cerr << "WARNING: Video output " << opts.name << " did not finish cleanly" << std::endl;
+        }
+        if (msg) gst_message_unref(msg);
+        gst_object_unref(bus);
+    }
+
+    gst_element_set_state(pipeline, GST_STATE_NULL);
+    gst_object_unref(appsrc);
+    gst_object_unref(pipeline);
+    appsrc = nullptr;
+    pipeline = nullptr;
+
+    const Stats s = stats();
+    std::cout << (failed ? "✗" : "✓") << " Video output " << opts.name << " closed: "
+              << s.encoded << " frames encoded, " << s.dropped << " dropped" << std::endl;
+}
+
+SVVideoOutput::Stats SVVideoOutput::stats() const {
+    Stats s;
+    s.pushed = pushed.load(std::memory_order_relaxed);
+    s.dropped = dropped.load(std::memory_order_relaxed);
+    s.encoded = encoded.load(std::memory_order_relaxed);
+    return s;
+}
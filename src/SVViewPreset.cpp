@@ -0,0 +1,197 @@
+#include "SVViewPreset.hpp"
+#include "SVConfig.hpp"
+#include "SVThreadPool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <iostream>
+
+namespace {
+
+// Bowl wall height (mm, >= 0) over ground point (x, y); matches the Bowl mesh:
+// flat inside BOWL_DISK_RADIUS, c * (x^2 / a^2 + y^2 / b^2) above the disk level outside
+double bowlHeight(double x, double y) {
+    const double u = x / BOWL_SCALE_MM;
+    const double w = y / BOWL_SCALE_MM;
+    if (u * u + w * w <= BOWL_DISK_RADIUS * BOWL_DISK_RADIUS) return 0.0;
+
+    const double a = BOWL_PARAB_A, b = BOWL_PARAB_B, c = BOWL_PARAB_C;
+    const double floor = c * BOWL_DISK_RADIUS * BOWL_DISK_RADIUS / std::pow(std::max(a, b), 2.0);
+    return std::max(0.0, c * (u * u / (a * a) + w * w / (b * b)) - floor) * BOWL_SCALE_MM;
+}
+
+// First point where the ray from eye along dir meets the bowl (false if it never does)
+bool intersectBowl(const cv::Vec3d& eye, const cv::Vec3d& dir, cv::Point3d& hit) {
+    // Height above the surface (Z is down)
+    auto above = [&](double t) {
+        const cv::Vec3d p = eye + t * dir;
+        return -p[2] - bowlHeight(p[0], p[1]);
+    };
+
+    // Ground hit inside the flat disk: the straight path there stays inside it
+    if (dir[2] > 1e-9) {
+        const double t = -eye[2] / dir[2];
+        const cv::Vec3d p = eye + t * dir;
+        if (bowlHeight(p[0], p[1]) == 0.0) {
+            hit = cv::Point3d(p[0], p[1], 0.0);
+            return true;
+        }
+    }
+
+    // Otherwise march out to the bowl rim and refine the crossing
+    const double max_range = 2.0 * BOWL_PARAB_RADIUS * BOWL_SCALE_MM;
+    const int steps = 256;
+    double t0 = 0.0;
+    for (int i = 1; i <= steps; i++) {
+        const double t1 = max_range * i / steps;
+        if (above(t1) <= 0.0) {
+            for (int k = 0; k < 24; k++) {
+                const double tm = 0.5 * (t0 + t1);
+                if (above(tm) > 0.0) t0 = tm; else t1 = tm;
+            }
+            const cv::Vec3d p = eye + t1 * dir;
+            hit = cv::Point3d(p[0], p[1], p[2]);
+            return true;
+        }
+        t0 = t1;
+    }
+    return false;
+}
+
+} // namespace
+
+std::vector<SVViewPresetSpec> defaultViewPresets() {
+    std::vector<SVViewPresetSpec> presets(5);
+
+    presets[0].name = "top";
+    presets[0].kind = SVViewKind::TOP;
+
+    // Behind and to the right, looking past the vehicle
+    presets[1].name = "rear_3_4";
+    presets[1].kind = SVViewKind::PERSPECTIVE;
+    presets[1].eye = cv::Point3d(2500.0, 6000.0, -3000.0);
+    presets[1].target = cv::Point3d(0.0, -500.0, 0.0);
+    presets[1].fov_deg = 60.0;
+
+    // Next to the front left wheel, looking down along the flank
+    presets[2].name = "front_wheel";
+    presets[2].kind = SVViewKind::PERSPECTIVE;
+    presets[2].eye = cv::Point3d(-1800.0, -3000.0, -1500.0);
+    presets[2].target = cv::Point3d(-900.0, -1400.0, 0.0);
+    presets[2].fov_deg = 70.0;
+
+    presets[3].name = "side_left";
+    presets[3].kind = SVViewKind::PERSPECTIVE;
+    presets[3].eye = cv::Point3d(-4500.0, 0.0, -2500.0);
+    presets[3].target = cv::Point3d(-900.0, 0.0, 0.0);
+    presets[3].fov_deg = 70.0;
+
+    presets[4].name = "side_right";
+    presets[4].kind = SVViewKind::PERSPECTIVE;
+    presets[4].eye = cv::Point3d(4500.0, 0.0, -2500.0);
+    presets[4].target = cv::Point3d(900.0, 0.0, 0.0);
+    presets[4].fov_deg = 70.0;
+
+    return presets;
+}
+
+std::shared_ptr<const SVViewLUT> SVViewLUT::build(const SVViewPresetSpec& spec,
+                                                  const std::vector<SVCameraCalib>& calibs,
+                                                  cv::Size image_size, cv::Size size) {
+    const int num_cameras = static_cast<int>(calibs.size());
+    if (num_cameras == 0 || size.area() == 0) {
+        std::cerr << "✗ View preset " << spec.name << ": no cameras or empty canvas" << std::endl;
+        return nullptr;
+    }
+
+    auto lut = std::make_shared<SVViewLUT>();
+    lut->name = spec.name;
+    lut->size = size;
+    lut->map_x.resize(num_cameras);
+    lut->map_y.resize(num_cameras);
+    lut->weights.resize(num_cameras);
+    for (int i = 0; i < num_cameras; i++) {
+        lut->map_x[i].create(size, CV_32F);
+        lut->map_y[i].create(size, CV_32F);
+        lut->weights[i].create(size, CV_8U);
+    }
+
+    // Surface point behind every canvas pixel (hit = 0 where the ray misses the bowl)
+    std::vector<cv::Point3d> points(size.area());
+    std::vector<uchar> hit(size.area(), 0);
+
+    if (spec.kind == SVViewKind::TOP) {
+        // Same canvas scale and origin as the IPM warp, squeezed or stretched to size
+        const SVIPMCanvas canvas = SVIPMCanvas::fromConfig();
+        const double sx = static_cast<double>(canvas.size.width) / size.width;
+        const double sy = static_cast<double>(canvas.size.height) / size.height;
+        for (int y = 0; y < size.height; y++) {
+            for (int x = 0; x < size.width; x++) {
+                const cv::Point2d g((x * sx - canvas.origin.x) * canvas.mm_per_px,
+                                    (y * sy - canvas.origin.y) * canvas.mm_per_px);
+                points[y * size.width + x] = cv::Point3d(g.x, g.y, 0.0);
+                hit[y * size.width + x] = 1;
+            }
+        }
+    } else {
+        // Virtual pinhole camera: x right, y down, z forward (OpenCV convention)
+        const cv::Vec3d eye(spec.eye.x, spec.eye.y, spec.eye.z);
+        const cv::Vec3d forward = cv::normalize(cv::Vec3d(spec.target.x, spec.target.y, spec.target.z) - eye);
+        const cv::Vec3d down(0.0, 0.0, 1.0);
+        cv::Vec3d right = down.cross(forward);
+        if (cv::norm(right) < 1e-6) right = cv::Vec3d(1.0, 0.0, 0.0);  // Looking straight down
+        right = cv::normalize(right);
+        const cv::Vec3d image_down = forward.cross(right);
+
+        const double f = 0.5 * size.width / std::tan(0.5 * spec.fov_deg * CV_PI / 180.0);
+        const double cx = 0.5 * size.width, cy = 0.5 * size.height;
+
+        SVThreadPool::instance().parallelForRange(0, size.height, [&](int y0, int y1) {
+            for (int y = y0; y < y1; y++) {
+                for (int x = 0; x < size.width; x++) {
+                    const cv::Vec3d dir = cv::normalize(forward + ((x + 0.5 - cx) / f) * right +
+                                                        ((y + 0.5 - cy) / f) * image_down);
+                    const int idx = y * size.width + x;
+                    hit[idx] = intersectBowl(eye, dir, points[idx]) ? 1 : 0;
+                }
+            }
+        }, 8);
+    }
+
+    // Project into every camera, then keep the two best per pixel
+    std::atomic<int> covered{0};
+    SVThreadPool::instance().parallelForRange(0, size.height, [&](int y0, int y1) {
+        std::vector<cv::Point3d> row(size.width);
+        std::vector<std::vector<cv::Point2d>> projected(num_cameras);
+        std::vector<std::vector<uchar>> visible(num_cameras);
+        std::vector<float> scores(num_cameras), weights(num_cameras);
+        int rows_covered = 0;
+
+        for (int y = y0; y < y1; y++) {
+            std::copy(points.begin() + y * size.width, points.begin() + (y + 1) * size.width, row.begin());
+            for (int i = 0; i < num_cameras; i++) {
+                calibs[i].project(row, image_size, projected[i], visible[i]);
+            }
+
+            for (int x = 0; x < size.width; x++) {
+                const bool on_bowl = hit[y * size.width + x] != 0;
+                for (int i = 0; i < num_cameras; i++) {
+                    const bool seen = on_bowl && visible[i][x];
+                    scores[i] = seen ? calibs[i].viewScore(row[x], projected[i][x], image_size,
+                                                           BOWL_EDGE_FEATHER_PX) : 0.0f;
+                    lut->map_x[i].ptr<float>(y)[x] = seen ? (float)projected[i][x].x : -1.0f;
+                    lut->map_y[i].ptr<float>(y)[x] = seen ? (float)projected[i][x].y : -1.0f;
+                }
+
+                rows_covered += blendWeightsFromScores(scores.data(), num_cameras, weights.data()) > 0;
+                for (int i = 0; i < num_cameras; i++) {
+                    lut->weights[i].ptr<uchar>(y)[x] = cv::saturate_cast<uchar>(weights[i] * 255.0f);
+                }
+            }
+        }
+        covered += rows_covered;
+    }, 8);
+
+    lut->coverage = static_cast<float>(covered) / size.area();
+    return lut;
+}
@@ -0,0 +1,180 @@
+#include "SVViewSwitcher.hpp"
+#include <opencv2/cudaarithm.hpp>
+#include <opencv2/cudawarping.hpp>
+#include <opencv2/imgproc.hpp>
+#include <iostream>
+
+SVViewSwitcher::SVViewSwitcher()
+    : transition_frame(0)
+    , num_cameras(0) {
+}
+
+bool SVViewSwitcher::init(const std::vector<SVViewPresetSpec>& specs,
+                          const SVCameraRig& rig,
+                          const std::vector<SVCameraCalib>& calibs,
+                          const std::vector<cv::cuda::GpuMat>& raw_samples,
+                          cv::Size size) {
+    num_cameras = rig.size();
+    canvas_size = size;
+    if (static_cast<int>(calibs.size()) != num_cameras ||
+        static_cast<int>(raw_samples.size()) != num_cameras) {
+        std::cerr << "✗ View presets need one calibration and one sample frame per camera" << std::endl;
+        return false;
+    }
+    if (!frame_pool) {
+        frame_pool = std::make_shared<SVFramePool>();
+    }
+
+    std::cout << "Building " << specs.size() << " view presets (" << size << ")..." << std::endl;
+
+    // Every preset blends on the same canvas, with its own weights
+    SVCameraRig canvas_rig = rig;
+    canvas_rig.canvas_size = size;
+    canvas_rig.layout = SVStitchLayout::SECTORS;
+    for (auto& cam : canvas_rig.cameras) {
+        cam.canvas_origin = cv::Point(0, 0);
+    }
+
+    const cv::Size image_size = raw_samples[0].size();
+    views.clear();
+    for (const SVViewPresetSpec& spec : specs) {
+        std::shared_ptr<const SVViewLUT> lut = SVViewLUT::build(spec, calibs, image_size, size);
+        if (!lut) continue;
+
+        auto view = std::make_shared<View>();
+        view->index = static_cast<int>(views.size());
+        view->lut = lut;
+        view->map_x.resize(num_cameras);
+        view->map_y.resize(num_cameras);
+        view->unseen.resize(num_cameras);
+
+        std::vector<SVFrameBuffer> samples(num_cameras);
+        for (int i = 0; i < num_cameras; i++) {
+            view->map_x[i].upload(lut->map_x[i]);
+            view->map_y[i].upload(lut->map_y[i]);
+            view->unseen[i].upload(cv::Mat(lut->map_x[i] < 0.0f));
+            cv::cuda::remap(raw_samples[i], samples[i].writeDevice(), view->map_x[i], view->map_y[i],
+                            cv::INTER_LINEAR, cv::BORDER_CONSTANT);
+        }
+
+        view->stitcher = std::make_shared<SVStitcherAuto>();
+        view->stitcher->setFramePool(frame_pool);
+        view->stitcher->setRig(canvas_rig);
+        view->stitcher->setBlendMasks(lut->weights);
+        if (!view->stitcher->init(samples)) {
+            std::cerr << "  ✗ View preset '" << spec.name << "': stitcher init failed" << std::endl;
+            continue;
+        }
+
+        std::cout << "  ✓ View preset '" << spec.name << "': "
+                  << static_cast<int>(lut->coverage * 100.0f) << "% covered" << std::endl;
+        views.push_back(view);
+    }
+
+    if (views.empty()) {
+        std::cerr << "✗ No usable view presets" << std::endl;
+        return false;
+    }
+
+    // Per-frame buffers shared by all presets
+    warped_handles.resize(num_cameras);
+    lerp_x_handles.resize(num_cameras);
+    lerp_y_handles.resize(num_cameras);
+    stitch_inputs.resize(num_cameras);
+    for (int i = 0; i < num_cameras; i++) {
+        const std::string cam = "view cam" + std::to_string(i);
+        warped_handles[i] = frame_pool->reserveDevice(size, CV_8UC3, cam + " mapped");
+        lerp_x_handles[i] = frame_pool->reserveDevice(size, CV_32F, cam + " transition x");
+        lerp_y_handles[i] = frame_pool->reserveDevice(size, CV_32F, cam + " transition y");
+    }
+
+    select(0);
+    return true;
+}
+
+bool SVViewSwitcher::select(int index, int transition_frames) {
+    if (index < 0 || index >= count()) {
+        return false;
+    }
+
+    std::shared_ptr<const Selection> current = std::atomic_load(&selection);
+    auto next = std::make_shared<Selection>();
+    next->to = views[index];
+    next->from = (current && transition_frames > 0) ? current->to : nullptr;
+    next->transition_frames = transition_frames;
+    std::atomic_store(&selection, std::shared_ptr<const Selection>(next));
+    return true;
+}
+
+bool SVViewSwitcher::select(const std::string& name, int transition_frames) {
+    for (const auto& view : views) {
+        if (view->lut->name == name) {
+            return select(view->index, transition_frames);
+        }
+    }
+    return false;
+}
+
+int SVViewSwitcher::activeIndex() const {
+    std::shared_ptr<const Selection> current = std::atomic_load(&selection);
+    return current ? current->to->index : -1;
+}
+
+const std::string& SVViewSwitcher::activeName() const {
+    static const std::string none;
+    std::shared_ptr<const Selection> current = std::atomic_load(&selection);
+    return current ? current->to->lut->name : none;
+}
+
+void SVViewSwitcher::interpolateMaps(const View& from, const View& to, float alpha) {
+    for (int i = 0; i < num_cameras; i++) {
+        cv::cuda::GpuMat& lx = frame_pool->device(lerp_x_handles[i]);
+        cv::cuda::GpuMat& ly = frame_pool->device(lerp_y_handles[i]);
+
+        cv::cuda::addWeighted(from.map_x[i], 1.0f - alpha, to.map_x[i], alpha, 0.0, lx);
+        cv::cuda::addWeighted(from.map_y[i], 1.0f - alpha, to.map_y[i], alpha, 0.0, ly);
+
+        // Where only one preset sees the pixel, follow that one
+        from.map_x[i].copyTo(lx, to.unseen[i]);
+        from.map_y[i].copyTo(ly, to.unseen[i]);
+        to.map_x[i].copyTo(lx, from.unseen[i]);
+        to.map_y[i].copyTo(ly, from.unseen[i]);
+    }
+}
+
+bool SVViewSwitcher::render(const std::vector<cv::cuda::GpuMat>& raw_frames, SVFrameBuffer& output) {
+    std::shared_ptr<const Selection> current = std::atomic_load(&selection);
+    if (!current || static_cast<int>(raw_frames.size()) != num_cameras) {
+        return false;
+    }
+
+    // A new selection restarts the transition
+    if (current != last_selection) {
+        last_selection = current;
+        transition_frame = 0;
+    }
+
+    const View& to = *current->to;
+    const View* stitch_view = &to;
+    bool transitioning = current->from && transition_frame < current->transition_frames;
+
+    if (transitioning) {
+        const float alpha = static_cast<float>(transition_frame + 1) / current->transition_frames;
+        interpolateMaps(*current->from, to, alpha);
+        if (alpha < 0.5f) {
+            stitch_view = current->from.get();
+        }
+        transition_frame++;
+    }
+
+    for (int i = 0; i < num_cameras; i++) {
+        const cv::cuda::GpuMat& mx = transitioning ? frame_pool->device(lerp_x_handles[i]) : to.map_x[i];
+        const cv::cuda::GpuMat& my = transitioning ? frame_pool->device(lerp_y_handles[i]) : to.map_y[i];
+        cv::cuda::GpuMat& mapped = frame_pool->device(warped_handles[i]);
+
+        cv::cuda::remap(raw_frames[i], mapped, mx, my, cv::INTER_LINEAR, cv::BORDER_CONSTANT);
+        stitch_inputs[i].attachDevice(mapped);
+    }
+
+    return stitch_view->stitcher->stitch(stitch_inputs, output);
+}
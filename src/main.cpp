@@ -13,7 +13,7 @@ void signalHandler(int signum) {
 
 
 
-    int main(int argc, char** argv) {
+    int main() {
         std::cout << "========================================" << std::endl;
         std::cout << "Ultra-Simple 4-Camera Display System" << std::endl;
         std::cout << "Direct Feed - No Stitching" << std::endl;
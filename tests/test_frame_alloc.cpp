@@ -0,0 +1,180 @@
+/**
+ * test_frame_alloc.cpp
+ * Steady-state frame loop performs no allocations, on the CPU backend and,
+ * in CUDA builds with a device, on the CUDA backend
+ *
+ *   1. Pool buffers written every frame keep their storage.
+ *   2. SVStitcherAuto (default rig, synthetic warped frames) allocates only
+ *      while warming up.
+ *   3. The whole-canvas blend (blendPrepare/Feed/Finish into pool buffers),
+ *      which the stitcher uses when tiling is off, allocates nothing either.
+ *
+ * SVAllocTracker counts every cv::Mat and cv::cuda::GpuMat allocation in the
+ * process, including those made on SVThreadPool workers.
+ */
+
+#include "SVFramePool.hpp"
+#include "SVComputeBackend.hpp"
+#include "SVStitcherAuto.hpp"
+#include <iostream>
+#include <memory>
+#include <vector>
+
+namespace {
+
+constexpr int WARMUP_FRAMES = 3;
+constexpr int MEASURED_FRAMES = 50;
+
+#define CHECK(cond)                                                                     \
+    do {                                                                                \
+        if (!(cond)) {                                                                  \
+            std::cerr << "✗ " << __FILE__ << ":" << __LINE__ << ": " #cond << std::endl; \
+            return 1;                                                                   \
+        }                                                                               \
+    } while (0)
+
+// Runs frame() for warm-up, then returns the allocations of the measured frames
+template <typename F>
+SVAllocTracker::Counts measureFrames(F&& frame, bool& ok) {
+    ok = true;
+    for (int n = 0; n < WARMUP_FRAMES && ok; n++) {
+        ok = frame(n);
+    }
+    SVAllocTracker::Counts counts;
+    for (int n = WARMUP_FRAMES; n < WARMUP_FRAMES + MEASURED_FRAMES && ok; n++) {
+        SVAllocTracker::beginFrame();
+        ok = frame(n);
+        const SVAllocTracker::Counts frame_counts = SVAllocTracker::endFrame();
+        counts.host += frame_counts.host;
+        counts.device += frame_counts.device;
+    }
+    return counts;
+}
+
+// New content in place, the way the warp stage refills its buffers
+void refresh(SVFrameBuffer& frame, int n) {
+    cv::Mat& mat = frame.modifyHost();
+    mat.row(n % mat.rows).setTo(cv::Scalar(n % 256, 255 - n % 256, 128));
+}
+
+int testPoolBuffers() {
+    SVFramePool pool;
+    const SVFramePool::Handle color = pool.reserveBuffer(cv::Size(640, 400), CV_8UC3, SVResidency::HOST, "color");
+    const SVFramePool::Handle acc = pool.reserveBuffer(cv::Size(640, 800), CV_32FC3, SVResidency::HOST, "acc");
+    const SVFramePool::Handle scratch = pool.reserveHost(cv::Size(320, 200), CV_8U, "scratch");
+    pool.setFrozen(true);
+
+    bool ok = false;
+    const SVAllocTracker::Counts counts = measureFrames([&](int n) {
+        pool.buffer(color).writeHost().setTo(cv::Scalar::all(n % 256));
+        pool.buffer(acc).writeHost().setTo(cv::Scalar::all(0));
+        pool.host(scratch).setTo(cv::Scalar::all(n % 256));
+        return true;
+    }, ok);
+    CHECK(ok);
+    CHECK(counts.sum() == 0);
+    std::cout << "✓ Pool buffers: no allocations over " << MEASURED_FRAMES << " frames" << std::endl;
+    return 0;
+}
+
+int testStitcher(const std::shared_ptr<SVComputeBackend>& backend) {
+    const SVCameraRig rig = SVCameraRig::defaultRig();
+    const int num_cameras = rig.size();
+
+    std::vector<SVFrameBuffer> warped(num_cameras);
+    for (int i = 0; i < num_cameras; i++) {
+        warped[i].create(cv::Size(640, 400), CV_8UC3);
+        cv::randu(warped[i].writeHost(), cv::Scalar::all(0), cv::Scalar::all(256));
+    }
+
+    auto pool = std::make_shared<SVFramePool>();
+    SVStitcherAuto stitcher;
+    stitcher.setRig(rig);
+    stitcher.setBackend(backend);
+    stitcher.setFramePool(pool);
+    CHECK(stitcher.init(warped));
+    pool->setFrozen(true);
+
+    SVFrameBuffer output;
+    bool ok = false;
+    const SVAllocTracker::Counts counts = measureFrames([&](int n) {
+        for (auto& frame : warped) {
+            refresh(frame, n);
+        }
+        return stitcher.stitch(warped, output);
+    }, ok);
+    CHECK(ok);
+    CHECK(output.size() == stitcher.getOutputSize() && output.type() == CV_8UC3);
+    CHECK(counts.sum() == 0);
+    std::cout << "✓ Stitcher (" << backend->name() << "): no allocations over "
+              << MEASURED_FRAMES << " frames" << std::endl;
+    return 0;
+}
+
+int testWholeCanvasBlend(const std::shared_ptr<SVComputeBackend>& backend) {
+    const cv::Size canvas(640, 800);
+    const cv::Size image(640, 400);
+
+    SVFramePool pool;
+    const SVResidency where = backend->residency();
+    const SVFramePool::Handle acc = pool.reserveBuffer(canvas, CV_32FC3, where, "acc");
+    const SVFramePool::Handle weight = pool.reserveBuffer(canvas, CV_32F, where, "weight");
+    const SVFramePool::Handle output = pool.reserveBuffer(canvas, CV_8UC3, where, "output");
+    const SVFramePool::Handle output_mask = pool.reserveBuffer(canvas, CV_8U, where, "output mask");
+    pool.setFrozen(true);
+
+    // Overlapping images, the last one hanging over the canvas edge
+    const std::vector<cv::Point> corners = {cv::Point(0, 0), cv::Point(0, 300), cv::Point(100, 600)};
+    std::vector<SVFrameBuffer> images(corners.size());
+    std::vector<SVFrameBuffer> masks(corners.size());
+    for (size_t i = 0; i < corners.size(); i++) {
+        images[i].create(image, CV_8UC3);
+        cv::randu(images[i].writeHost(), cv::Scalar::all(0), cv::Scalar::all(256));
+        masks[i].create(image, CV_8U);
+        cv::randu(masks[i].writeHost(), cv::Scalar::all(0), cv::Scalar::all(256));
+    }
+
+    bool ok = false;
+    const SVAllocTracker::Counts counts = measureFrames([&](int n) {
+        backend->blendPrepare(canvas, backend->out(pool.buffer(acc)), backend->out(pool.buffer(weight)));
+        for (size_t i = 0; i < images.size(); i++) {
+            refresh(images[i], n);
+            backend->blendFeed(backend->in(images[i]), backend->in(masks[i]), corners[i],
+                               backend->inout(pool.buffer(acc)), backend->inout(pool.buffer(weight)));
+        }
+        backend->blendFinish(backend->in(pool.buffer(acc)), backend->in(pool.buffer(weight)),
+                             backend->out(pool.buffer(output)), backend->out(pool.buffer(output_mask)));
+        backend->synchronize();
+        return true;
+    }, ok);
+    CHECK(ok);
+    CHECK(counts.sum() == 0);
+    std::cout << "✓ Whole-canvas blend (" << backend->name() << "): no allocations over "
+              << MEASURED_FRAMES << " frames" << std::endl;
+    return 0;
+}
+
+} // namespace
+
+int main() {
+    SVAllocTracker::install();
+    const std::shared_ptr<SVComputeBackend> backend = createComputeBackend(SVBackendType::CPU);
+
+    int failed = testPoolBuffers();
+    failed |= testStitcher(backend);
+    failed |= testWholeCanvasBlend(backend);
+
+#ifndef SV_CPU_ONLY
+    // Device buffers are counted as well; without a GPU the factory falls back to the CPU, already covered
+    const std::shared_ptr<SVComputeBackend> cuda = createComputeBackend(SVBackendType::CUDA);
+    if (cuda->type() == SVBackendType::CUDA) {
+        failed |= testStitcher(cuda);
+        failed |= testWholeCanvasBlend(cuda);
+    } else {
+        std::cout << "- No CUDA device, CUDA backend not tested" << std::endl;
+    }
+#endif
+
+    SVAllocTracker::uninstall();
+    return failed;
+}
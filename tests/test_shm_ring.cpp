@@ -0,0 +1,186 @@
+/**
+ * test_shm_ring.cpp
+ * SVShmPublisher and SVShmConsumer in two forked processes
+ *
+ *   1. The publisher streams frames while the consumer reads latest():
+ *      sequence numbers only increase, and every frame that validates
+ *      carries the pixels of its sequence number.
+ *   2. The consumer holds the newest frame; once the publisher has
+ *      written a full lap of slots, validate() must fail.
+ *   3. After the publisher's close(), publisherAlive() is false.
+ *
+ * The processes step through the phases over two pipes.
+ */
+
+#include "SVShmRing.hpp"
+#include <sys/wait.h>
+#include <unistd.h>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr int SLOTS = 4;
+constexpr uint32_t WIDTH = 64;
+constexpr uint32_t HEIGHT = 16;
+constexpr uint64_t STREAM_FRAMES = 20000;
+
+#define CHECK(cond)                                                                     \
+    do {                                                                                \
+        if (!(cond)) {                                                                  \
+            std::cerr << "✗ " << __FILE__ << ":" << __LINE__ << ": " #cond << std::endl; \
+            return 1;                                                                   \
+        }                                                                               \
+    } while (0)
+
+bool sendByte(int fd, char c) {
+    return write(fd, &c, 1) == 1;
+}
+
+bool expectByte(int fd, char expected) {
+    char c = 0;
+    return read(fd, &c, 1) == 1 && c == expected;
+}
+
+// Every byte of frame n is n & 0xff, so a torn frame is visible
+bool publishFrame(SVShmPublisher& publisher, uint64_t n) {
+    std::vector<uint8_t> pixels(WIDTH * HEIGHT, static_cast<uint8_t>(n & 0xff));
+    SVShmFrameInfo info;
+    info.timestamp_ns = static_cast<int64_t>(n);
+    info.width = WIDTH;
+    info.height = HEIGHT;
+    info.format = SVShmFormat::GRAY8;
+    info.source = 0;
+    return publisher.publish(pixels.data(), WIDTH, info);
+}
+
+int runPublisher(const std::string& name, int to_consumer, int from_consumer) {
+    SVShmPublisher publisher;
+    CHECK(publisher.create(name, WIDTH * HEIGHT, SLOTS));
+    CHECK(sendByte(to_consumer, 'R'));
+
+    // 1. Stream while the consumer reads, paced so it sees many frames
+    CHECK(expectByte(from_consumer, 'S'));
+    for (uint64_t n = 1; n <= STREAM_FRAMES; n++) {
+        CHECK(publishFrame(publisher, n));
+        usleep(20);
+    }
+
+    // 2. One full lap over the slot the consumer holds
+    CHECK(expectByte(from_consumer, 'L'));
+    for (uint64_t n = STREAM_FRAMES + 1; n <= STREAM_FRAMES + SLOTS; n++) {
+        CHECK(publishFrame(publisher, n));
+    }
+    CHECK(sendByte(to_consumer, 'A'));
+
+    // 3. Close
+    CHECK(expectByte(from_consumer, 'C'));
+    publisher.close();
+    CHECK(sendByte(to_consumer, 'A'));
+    return 0;
+}
+
+int runConsumer(const std::string& name, int from_publisher, int to_publisher) {
+    CHECK(expectByte(from_publisher, 'R'));
+    SVShmConsumer consumer;
+    CHECK(consumer.open(name));
+    CHECK(consumer.publisherAlive());
+    CHECK(sendByte(to_publisher, 'S'));
+
+    // 1. Sequence numbers only increase; a validated frame is never torn
+    std::vector<uint8_t> copy(WIDTH * HEIGHT);
+    uint64_t last_seq = 0;
+    uint64_t distinct = 0;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+    while (last_seq < STREAM_FRAMES) {
+        CHECK(std::chrono::steady_clock::now() < deadline);     // Publisher died mid-stream
+        const SVShmConsumer::View view = consumer.latest();
+        if (!view) continue;
+        CHECK(view.info.seq >= last_seq);
+        CHECK(view.info.seq == static_cast<uint64_t>(view.info.timestamp_ns));
+        CHECK(view.info.width == WIDTH && view.info.height == HEIGHT && view.info.stride == WIDTH);
+
+        std::memcpy(copy.data(), view.data, copy.size());
+        if (consumer.validate(view)) {
+            const uint8_t expected = static_cast<uint8_t>(view.info.seq & 0xff);
+            for (uint8_t px : copy) {
+                CHECK(px == expected);
+            }
+        }
+        if (view.info.seq > last_seq) distinct++;
+        last_seq = view.info.seq;
+    }
+    CHECK(consumer.latestSeq() == STREAM_FRAMES);
+    CHECK(distinct > 1);    // Read while the publisher was writing
+
+    // 2. The publisher is idle: the newest frame validates until it is lapped
+    const SVShmConsumer::View held = consumer.latest();
+    CHECK(held && held.info.seq == STREAM_FRAMES);
+    CHECK(consumer.validate(held));
+    CHECK(sendByte(to_publisher, 'L'));
+    CHECK(expectByte(from_publisher, 'A'));
+    CHECK(!consumer.validate(held));
+    CHECK(consumer.latest().info.seq == STREAM_FRAMES + SLOTS);
+
+    // 3. The mapping outlives the object; the ring reports the publisher gone
+    CHECK(consumer.publisherAlive());
+    CHECK(sendByte(to_publisher, 'C'));
+    CHECK(expectByte(from_publisher, 'A'));
+    CHECK(!consumer.publisherAlive());
+
+    std::cout << "✓ Consumer saw " << distinct << " of " << STREAM_FRAMES << " frames, in order" << std::endl;
+    return 0;
+}
+
+} // namespace
+
+int main() {
+    const std::string name = "sv_test_ring_" + std::to_string(getpid());
+
+    int to_consumer[2];
+    int to_publisher[2];
+    if (pipe(to_consumer) != 0 || pipe(to_publisher) != 0) {
+        std::perror("pipe");
+        return 1;
+    }
+
+    // Each side keeps only its own pipe ends, so when one fails the other reads EOF instead of blocking
+    const pid_t publisher = fork();
+    if (publisher == 0) {
+        close(to_consumer[0]);
+        close(to_publisher[1]);
+        _exit(runPublisher(name, to_consumer[1], to_publisher[0]));
+    }
+    const pid_t consumer = fork();
+    if (consumer == 0) {
+        close(to_consumer[1]);
+        close(to_publisher[0]);
+        _exit(runConsumer(name, to_consumer[0], to_publisher[1]));
+    }
+    if (publisher < 0 || consumer < 0) {
+        std::perror("fork");
+        return 1;
+    }
+
+    close(to_consumer[0]);
+    close(to_consumer[1]);
+    close(to_publisher[0]);
+    close(to_publisher[1]);
+
+    int failed = 0;
+    for (pid_t pid : {publisher, consumer}) {
+        int status = 0;
+        if (waitpid(pid, &status, 0) != pid || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            std::cerr << "✗ " << (pid == publisher ? "Publisher" : "Consumer") << " failed" << std::endl;
+            failed = 1;
+        }
+    }
+    if (!failed) {
+        std::cout << "✓ Shared-memory ring: ordering, lap detection and close all hold" << std::endl;
+    }
+    return failed;
+}
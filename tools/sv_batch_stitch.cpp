@@ -0,0 +1,221 @@
+/**
+ * @file sv_batch_stitch.cpp
+ * @brief Offline stitching of recorded sessions (.svs), faster than real time
+ *
+ * Decodes every camera of a session (SVSessionPlayer, unpaced), warps and
+ * stitches with the same maps, masks and blender as the live application
+ * (buildHomographyMaps / buildIPMMaps, SVStitcherAuto on the CPU backend)
+ * and writes a video or an image sequence.
+ *
+ * Sessions run side by side in one process (SVSessionManager): one thread
+ * pool, one copy of the maps and masks per distinct calibration, and a
+ * process-wide limit on frames in flight shared fairly between sessions.
+ * Within a session each frame in flight owns a "lane" (input, warp and
+ * stitch buffers plus its own stitcher) and results are written in frame
+ * order.
+ *
+ *   sv_batch_stitch -o out/ drive_0412.svs drive_0413.svs
+ *   SV_THREADS=32 sv_batch_stitch --images jpg --calib ../camparameters drive.svs
+ *   sv_batch_stitch --parallel-sessions 8 --session-mem-mb 256 -o out/ fleet/*.svs
+ */
+#include "SVConfig.hpp"
+#include "SVSessionManager.hpp"
+#include "SVThreadPool.hpp"
+#include <sys/stat.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Args {
+    std::vector<std::string> sessions;
+    std::string out_dir = ".";
+    std::string image_ext;                  // Empty = video
+    std::string calib_folder;               // Empty = calibration stored in each session
+    std::string warp;                       // "homography", "ipm" or empty = pick from the calibration
+    float scale = 0.0f;                     // Homography processing scale, 0 = saved scale_factor
+    int jobs = 0;                           // Frames in flight per session, 0 = no own limit
+    int parallel_sessions = 4;
+    int max_in_flight = 0;                  // All sessions, 0 = 2 x pool workers
+    int session_mem_mb = 512;
+    int fps = RECORD_FPS;
+    int64_t max_frames = -1;
+    std::string encoder = "x264enc speed-preset=medium bitrate=8000";
+    std::string decoder = SESSION_REPLAY_DECODER;
+};
+
+void printUsage(const char* prog) {
+    std::cout << "Usage: " << prog << " [options] <session.svs> [<session.svs> ...]\n"
+              << "\n"
+              << "  -o, --out <dir>         Output folder (default: .)\n"
+              << "  --images <jpg|png>      Write <dir>/<session>/<frame>.<ext> instead of <dir>/<session>.mkv\n"
+              << "  --calib <folder>        Calibration folder (default: the one stored in the session)\n"
+              << "  --warp <homography|ipm> Warp (default: homography if custom_homography_points.yaml exists)\n"
+              << "  --scale <f>             Homography processing scale (default: the saved scale_factor)\n"
+              << "  --jobs <n>              Frames in flight per session (default: up to --max-in-flight)\n"
+              << "  --parallel-sessions <n> Sessions processed at the same time (default: 4)\n"
+              << "  --max-in-flight <n>     Frames in flight over all sessions (default: 2 x thread pool size)\n"
+              << "  --session-mem-mb <n>    Frame buffer budget per session (default: 512)\n"
+              << "  --fps <n>               Output video frame rate (default: " << RECORD_FPS << ")\n"
+              << "  --max-frames <n>        Stop after n frames per session\n"
+              << "  --encoder \"<fragment>\"  GStreamer encoder (default: x264enc)\n"
+              << "  --decoder \"<fragment>\"  GStreamer decoder, one frame out per unit in\n"
+              << "\n"
+              << "Environment: SV_THREADS / SV_THREAD_CPUS (pool size and pinning), SV_RIG (camera rig)\n";
+}
+
+bool parseArgs(int argc, char** argv, Args& args) {
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        auto value = [&](std::string& dst) {
+            if (i + 1 >= argc) {
+                std::cerr << "✗ Missing value for " << arg << std::endl;
+                return false;
+            }
+            dst = argv[++i];
+            return true;
+        };
+
+        std::string v;
+        if (arg == "-h" || arg == "--help") {
+            return false;
+        } else if (arg == "-o" || arg == "--out") {
+            if (!value(args.out_dir)) return false;
+        } else if (arg == "--images") {
+            if (!value(args.image_ext)) return false;
+        } else if (arg == "--calib") {
+            if (!value(args.calib_folder)) return false;
+        } else if (arg == "--warp") {
+            if (!value(args.warp)) return false;
+        } else if (arg == "--scale") {
+            if (!value(v)) return false;
+            args.scale = std::stof(v);
+        } else if (arg == "--jobs") {
+            if (!value(v)) return false;
+            args.jobs = std::stoi(v);
+        } else if (arg == "--parallel-sessions") {
+            if (!value(v)) return false;
+            args.parallel_sessions = std::stoi(v);
+        } else if (arg == "--max-in-flight") {
+            if (!value(v)) return false;
+            args.max_in_flight = std::stoi(v);
+        } else if (arg == "--session-mem-mb") {
+            if (!value(v)) return false;
+            args.session_mem_mb = std::stoi(v);
+        } else if (arg == "--fps") {
+            if (!value(v)) return false;
+            args.fps = std::stoi(v);
+        } else if (arg == "--max-frames") {
+            if (!value(v)) return false;
+            args.max_frames = std::stoll(v);
+        } else if (arg == "--encoder") {
+            if (!value(args.encoder)) return false;
+        } else if (arg == "--decoder") {
+            if (!value(args.decoder)) return false;
+        } else if (!arg.empty() && arg[0] == '-') {
+            std::cerr << "✗ Unknown option " << arg << std::endl;
+            return false;
+        } else {
+            args.sessions.push_back(arg);
+        }
+    }
+
+    if (!args.warp.empty() && args.warp != "homography" && args.warp != "ipm") {
+        std::cerr << "✗ --warp must be homography or ipm" << std::endl;
+        return false;
+    }
+    if (!args.image_ext.empty() && args.image_ext != "jpg" && args.image_ext != "png") {
+        std::cerr << "✗ --images must be jpg or png" << std::endl;
+        return false;
+    }
+    return !args.sessions.empty();
+}
+
+std::string fileStem(const std::string& path) {
+    const size_t slash = path.find_last_of('/');
+    std::string name = slash == std::string::npos ? path : path.substr(slash + 1);
+    const size_t dot = name.find_last_of('.');
+    return dot == std::string::npos || dot == 0 ? name : name.substr(0, dot);
+}
+
+// Outputs are named after the session file only: two sessions with one name would overwrite each other
+bool uniqueStems(const std::vector<std::string>& sessions) {
+    std::map<std::string, const std::string*> owners;
+    bool ok = true;
+    for (const std::string& path : sessions) {
+        auto inserted = owners.emplace(fileStem(path), &path);
+        if (!inserted.second) {
+            std::cerr << "✗ " << *inserted.first->second << " and " << path << " would both write output \""
+                      << inserted.first->first << "\"; rename or process them separately" << std::endl;
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    Args args;
+    bool args_ok = false;
+    try {
+        args_ok = parseArgs(argc, argv, args);
+    } catch (const std::exception&) {
+        std::cerr << "✗ Invalid number in the arguments" << std::endl;
+    }
+    if (!args_ok) {
+        printUsage(argv[0]);
+        return 2;
+    }
+    if (!uniqueStems(args.sessions)) {
+        return 2;
+    }
+    mkdir(args.out_dir.c_str(), 0755);
+
+    // Frame-level tasks of every session on the shared pool; OpenCV's own
+    // parallel loops (remap, resize) nest on the same workers instead of oversubscribing
+    SVThreadPool& pool = SVThreadPool::instance();
+    pool.installAsOpenCVBackend();
+
+    SVSessionManager::Options opts;
+    opts.max_sessions = args.parallel_sessions;
+    opts.max_frames_in_flight = args.max_in_flight;
+    opts.max_lanes_per_session = args.jobs;
+    opts.session_memory_cap = static_cast<size_t>(std::max(1, args.session_mem_mb)) << 20;
+    opts.decoder = args.decoder;
+    opts.encoder = args.encoder;
+    opts.fps = args.fps;
+    opts.warp = args.warp;
+    opts.scale = args.scale;
+
+    SVSessionManager manager(opts, pool);
+    for (const std::string& path : args.sessions) {
+        SVSessionManager::Job job;
+        job.session_path = path;
+        job.calib_folder = args.calib_folder;
+        job.output = args.out_dir + "/" + fileStem(path) + (args.image_ext.empty() ? ".mkv" : "");
+        job.image_ext = args.image_ext;
+        job.max_frames = args.max_frames;
+        manager.submit(job);
+    }
+
+    while (!manager.waitFor(std::chrono::seconds(2))) {
+        const SVSessionManager::Metrics m = manager.metrics();
+        std::cout << "  " << m.running << " running, " << m.queued << " queued: " << m.frames << " frames, "
+                  << static_cast<int>(m.fps) << " fps, " << (m.lane_bytes >> 20) << " MB in lanes" << std::endl;
+    }
+    const int failures = manager.waitAll();
+
+    manager.printSummary();
+    pool.printSummary();
+    if (failures) {
+        std::cerr << "✗ " << failures << " of " << args.sessions.size() << " sessions failed" << std::endl;
+    }
+    return failures ? 1 : 0;
+}